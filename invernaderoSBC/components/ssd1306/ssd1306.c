@@ -25,11 +25,77 @@ void ssd1306_init(SSD1306_t * dev, int width, int height)
 		i2c_init(dev, width, height);
 	}
 	// Initialize internal buffer
-	for (int i=0;i<dev->_pages;i++) {
-		memset(dev->_page[i]._segs, 0, 128);
+	for (int i=0;i<SSD1306_MAX_PAGES;i++) {
+		memset(dev->_page[i]._segs, 0, SSD1306_MAX_WIDTH);
 	}
 }
 
+void ssd1306_set_controller(SSD1306_t * dev, ssd1306_controller_t controller)
+{
+	dev->_controller = controller;
+	// The SH1106 drives 128 of its 132 RAM columns, centered
+	dev->_offsetx = (controller == SSD1306_CTRL_SH1106) ? 2 : 0;
+}
+
+bool ssd1306_set_geometry(SSD1306_t * dev, int width, int height)
+{
+	// MUX ratio goes down to 16 rows; pages are whole
+	if (width < 1 || width > SSD1306_MAX_WIDTH || height < 16 || height > SSD1306_MAX_PAGES * 8 || height % 8) {
+		ESP_LOGE(TAG, "Unsupported geometry %dx%d (max %dx%d)", width, height, SSD1306_MAX_WIDTH, SSD1306_MAX_PAGES * 8);
+		return false;
+	}
+	dev->_width = width;
+	dev->_height = height;
+	dev->_pages = height / 8;
+	return true;
+}
+
+int ssd1306_init_commands(SSD1306_t * dev, bool horizontal, uint8_t * cmds)
+{
+	int n = 0;
+	cmds[n++] = OLED_CMD_DISPLAY_OFF;
+	cmds[n++] = OLED_CMD_SET_MUX_RATIO;
+	cmds[n++] = dev->_height - 1;
+	cmds[n++] = OLED_CMD_SET_DISPLAY_OFFSET;
+	cmds[n++] = 0x00;
+	cmds[n++] = OLED_CMD_SET_DISPLAY_START_LINE;
+	cmds[n++] = dev->_flip ? OLED_CMD_SET_SEGMENT_REMAP_0 : OLED_CMD_SET_SEGMENT_REMAP_1;
+	cmds[n++] = OLED_CMD_SET_COM_SCAN_MODE;
+	cmds[n++] = OLED_CMD_SET_DISPLAY_CLK_DIV;
+	cmds[n++] = 0x80;
+	cmds[n++] = OLED_CMD_SET_COM_PIN_MAP;
+	cmds[n++] = (dev->_height == 32) ? 0x02 : 0x12;
+	cmds[n++] = OLED_CMD_SET_CONTRAST;
+	cmds[n++] = 0xFF;
+	cmds[n++] = OLED_CMD_DISPLAY_RAM;
+	cmds[n++] = OLED_CMD_SET_VCOMH_DESELCT;
+	cmds[n++] = 0x40;
+	if (dev->_controller == SSD1306_CTRL_SH1106) {
+		// No addressing modes, charge pump or scroll engine: DC-DC on instead
+		cmds[n++] = SH1106_CMD_SET_DCDC;
+		cmds[n++] = 0x8B;
+	} else {
+		cmds[n++] = OLED_CMD_SET_MEMORY_ADDR_MODE;
+		cmds[n++] = horizontal ? OLED_CMD_SET_HORI_ADDR_MODE : OLED_CMD_SET_PAGE_ADDR_MODE;
+		cmds[n++] = OLED_CMD_SET_CHARGE_PUMP;
+		cmds[n++] = 0x14;
+		cmds[n++] = OLED_CMD_DEACTIVE_SCROLL;
+	}
+	cmds[n++] = OLED_CMD_DISPLAY_NORMAL;
+	cmds[n++] = OLED_CMD_DISPLAY_ON;
+	return n;
+}
+
+int ssd1306_page_commands(SSD1306_t * dev, int page, int seg, uint8_t * cmds)
+{
+	int col = seg + dev->_offsetx;
+	int _page = dev->_flip ? (dev->_pages - 1 - page) : page;
+	cmds[0] = 0x00 | (col & 0x0F);			// Lower column start address
+	cmds[1] = 0x10 | ((col >> 4) & 0x0F);	// Higher column start address
+	cmds[2] = 0xB0 | _page;					// Page start address
+	return 3;
+}
+
 int ssd1306_get_width(SSD1306_t * dev)
 {
 	return dev->_width;
@@ -48,9 +114,7 @@ int ssd1306_get_pages(SSD1306_t * dev)
 void ssd1306_show_buffer(SSD1306_t * dev)
 {
 	if (dev->_address == SPIAddress) {
-		for (int page=0; page<dev->_pages;page++) {
-			spi_display_image(dev, page, 0, dev->_page[page]._segs, dev->_width);
-		}
+		spi_display_frame(dev);
 	} else {
 		for (int page=0; page<dev->_pages;page++) {
 			i2c_display_image(dev, page, 0, dev->_page[page]._segs, dev->_width);
@@ -62,8 +126,8 @@ void ssd1306_set_buffer(SSD1306_t * dev, uint8_t * buffer)
 {
 	int index = 0;
 	for (int page=0; page<dev->_pages;page++) {
-		memcpy(&dev->_page[page]._segs, &buffer[index], 128);
-		index = index + 128;
+		memcpy(&dev->_page[page]._segs, &buffer[index], dev->_width);
+		index = index + dev->_width;
 	}
 }
 
@@ -71,8 +135,173 @@ void ssd1306_get_buffer(SSD1306_t * dev, uint8_t * buffer)
 {
 	int index = 0;
 	for (int page=0; page<dev->_pages;page++) {
-		memcpy(&buffer[index], &dev->_page[page]._segs, 128);
-		index = index + 128;
+		memcpy(&buffer[index], &dev->_page[page]._segs, dev->_width);
+		index = index + dev->_width;
+	}
+}
+
+// Columns of the same page closer than this are sent in one transfer:
+// restarting a transfer costs about as much as the bytes in between.
+#define DIFF_MERGE_GAP 6
+
+int ssd1306_flush_diff(SSD1306_t * dev, uint8_t * front)
+{
+	int sent = 0;
+	for (int page=0; page<dev->_pages; page++) {
+		uint8_t * back = dev->_page[page]._segs;
+		uint8_t * shown = &front[page * dev->_width];
+		int seg = 0;
+		while (seg < dev->_width) {
+			if (back[seg] == shown[seg]) {
+				seg++;
+				continue;
+			}
+			// Run of changed columns, absorbing short unchanged gaps
+			int start = seg;
+			int end = seg;
+			for (int i = seg + 1; i < dev->_width && i - end <= DIFF_MERGE_GAP; i++) {
+				if (back[i] != shown[i]) end = i;
+			}
+			int width = end - start + 1;
+			if (dev->_address == SPIAddress) {
+				spi_display_image(dev, page, start, &back[start], width);
+			} else {
+				i2c_display_image(dev, page, start, &back[start], width);
+			}
+			memcpy(&shown[start], &back[start], width);
+			sent += width;
+			seg = end + 1;
+		}
+	}
+	return sent;
+}
+
+void ssd1306_clear_buffer(SSD1306_t * dev, bool invert)
+{
+	for (int page=0; page<dev->_pages; page++) {
+		memset(dev->_page[page]._segs, invert ? 0xFF : 0x00, dev->_width);
+	}
+}
+
+void ssd1306_buffer_text(SSD1306_t * dev, int page, int seg, const char * text, int text_len, bool invert)
+{
+	if (page >= dev->_pages) return;
+	for (int i = 0; i < text_len && seg + 8 <= dev->_width; i++) {
+		uint8_t * dst = &dev->_page[page]._segs[seg];
+		memcpy(dst, font8x8_basic_tr[(uint8_t)text[i]], 8);
+		if (invert) ssd1306_invert(dst, 8);
+		if (dev->_flip) ssd1306_flip(dst, 8);
+		seg = seg + 8;
+	}
+}
+
+// Next code point of a UTF-8 string; malformed bytes come back as '?'
+static uint32_t utf8_next(const char ** text)
+{
+	const uint8_t * s = (const uint8_t *)*text;
+	uint32_t cp = s[0];
+	int len = 1;
+	if (cp >= 0xF0) { cp &= 0x07; len = 4; }
+	else if (cp >= 0xE0) { cp &= 0x0F; len = 3; }
+	else if (cp >= 0xC0) { cp &= 0x1F; len = 2; }
+	else if (cp >= 0x80) { *text += 1; return '?'; }
+	for (int i = 1; i < len; i++) {
+		if ((s[i] & 0xC0) != 0x80) { *text += i; return '?'; }
+		cp = (cp << 6) | (s[i] & 0x3F);
+	}
+	*text += len;
+	return cp;
+}
+
+static int font_glyph(const ssd1306_font_t * font, uint32_t cp)
+{
+	if (cp >= font->first && cp <= font->last) return cp - font->first;
+	for (int i = 0; i < font->extra_count; i++) {
+		if (font->extra_codes[i] == cp) return font->last - font->first + 1 + i;
+	}
+	return '?' - font->first;
+}
+
+int ssd1306_text_width(const ssd1306_font_t * font, const char * text)
+{
+	int w = 0;
+	while (*text) {
+		w += font->width[font_glyph(font, utf8_next(&text))] + font->spacing;
+	}
+	return w ? w - font->spacing : 0;
+}
+
+int ssd1306_buffer_string(SSD1306_t * dev, const ssd1306_font_t * font, int page, int x, const char * text, bool invert)
+{
+	uint8_t fill = invert ? 0xFF : 0x00;
+	if (dev->_flip) fill = ssd1306_rotate_byte(fill);
+	while (*text && x < dev->_width) {
+		int g = font_glyph(font, utf8_next(&text));
+		int w = font->width[g];
+		const uint8_t * src = &font->data[font->offset[g]];
+		// Visible columns of glyph plus spacing
+		int c0 = (x < 0) ? -x : 0;
+		int c1 = w + font->spacing;
+		if (x + c1 > dev->_width) c1 = dev->_width - x;
+		for (int p = 0; p < font->pages; p++, src += w) {
+			if (page + p < 0 || page + p >= dev->_pages) continue;
+			uint8_t * dst = dev->_page[page + p]._segs;
+			int c = c0;
+			if (!invert && !dev->_flip) {
+				int n = (c1 < w ? c1 : w) - c;
+				if (n > 0) {
+					memcpy(dst + x + c, src + c, n);
+					c += n;
+				}
+			}
+			for (; c < c1 && c < w; c++) {
+				uint8_t v = invert ? (uint8_t)~src[c] : src[c];
+				dst[x + c] = dev->_flip ? ssd1306_rotate_byte(v) : v;
+			}
+			for (; c < c1; c++) dst[x + c] = fill;
+		}
+		x += w + font->spacing;
+	}
+	return x;
+}
+
+void ssd1306_buffer_string_aligned(SSD1306_t * dev, const ssd1306_font_t * font, int page, ssd1306_align_t align, const char * text, bool invert)
+{
+	int x = 0;
+	if (align != SSD1306_ALIGN_LEFT) {
+		int room = dev->_width - ssd1306_text_width(font, text);
+		x = (align == SSD1306_ALIGN_CENTER) ? room / 2 : room;
+	}
+	ssd1306_buffer_string(dev, font, page, x, text, invert);
+}
+
+// Vertical run of pixels y0..y1 (inclusive) in column seg. Each page touched
+// gets a single read-modify-write with a mask, instead of one call per pixel.
+void ssd1306_buffer_vspan(SSD1306_t * dev, int seg, int y0, int y1, bool invert)
+{
+	if (seg < 0 || seg >= dev->_width) return;
+	if (y0 > y1) { int t = y0; y0 = y1; y1 = t; }
+	if (y0 < 0) y0 = 0;
+	if (y1 >= dev->_height) y1 = dev->_height - 1;
+	if (y0 > y1) return;
+	int p1 = y1 >> 3;
+	for (int page = y0 >> 3; page <= p1; page++) {
+		uint8_t mask = 0xFF;
+		if (page == (y0 >> 3)) mask &= (uint8_t)(0xFF << (y0 & 7));
+		if (page == p1) mask &= (uint8_t)(0xFF >> (7 - (y1 & 7)));
+		if (dev->_flip) mask = ssd1306_rotate_byte(mask);
+		uint8_t * dst = &dev->_page[page]._segs[seg];
+		*dst = invert ? (*dst & ~mask) : (*dst | mask);
+	}
+}
+
+void ssd1306_display_power(SSD1306_t * dev, bool on)
+{
+	if (dev->_address == SPIAddress) {
+		uint8_t cmd = on ? OLED_CMD_DISPLAY_ON : OLED_CMD_DISPLAY_OFF;
+		spi_send_commands(dev, &cmd, 1);
+	} else {
+		i2c_display_power(dev, on);
 	}
 }
 
@@ -91,7 +320,7 @@ void ssd1306_display_text(SSD1306_t * dev, int page, char * text, int text_len,
 {
 	if (page >= dev->_pages) return;
 	int _text_len = text_len;
-	if (_text_len > 16) _text_len = 16;
+	if (_text_len > dev->_width / 8) _text_len = dev->_width / 8;
 
 	uint8_t seg = 0;
 	uint8_t image[8];
@@ -117,7 +346,7 @@ ssd1306_display_text_x3(SSD1306_t * dev, int page, char * text, int text_len, bo
 {
 	if (page >= dev->_pages) return;
 	int _text_len = text_len;
-	if (_text_len > 5) _text_len = 5;
+	if (_text_len > dev->_width / 24) _text_len = dev->_width / 24;
 
 	uint8_t seg = 0;
 
@@ -167,18 +396,18 @@ ssd1306_display_text_x3(SSD1306_t * dev, int page, char * text, int text_len, bo
 
 void ssd1306_clear_screen(SSD1306_t * dev, bool invert)
 {
-	char space[16];
+	char space[SSD1306_MAX_WIDTH / 8];
 	memset(space, 0x00, sizeof(space));
 	for (int page = 0; page < dev->_pages; page++) {
-		ssd1306_display_text(dev, page, space, sizeof(space), invert);
+		ssd1306_display_text(dev, page, space, dev->_width / 8, invert);
 	}
 }
 
 void ssd1306_clear_line(SSD1306_t * dev, int page, bool invert)
 {
-	char space[16];
+	char space[SSD1306_MAX_WIDTH / 8];
 	memset(space, 0x00, sizeof(space));
-	ssd1306_display_text(dev, page, space, sizeof(space), invert);
+	ssd1306_display_text(dev, page, space, dev->_width / 8, invert);
 }
 
 void ssd1306_contrast(SSD1306_t * dev, int contrast)
@@ -223,18 +452,16 @@ void ssd1306_scroll_text(SSD1306_t * dev, char * text, int text_len, bool invert
 	while(1) {
 		int dstIndex = srcIndex + dev->_scDirection;
 		ESP_LOGD(TAG, "srcIndex=%d dstIndex=%d", srcIndex,dstIndex);
-		for(int seg = 0; seg < dev->_width; seg++) {
-			dev->_page[dstIndex]._segs[seg] = dev->_page[srcIndex]._segs[seg];
-		}
-		(*func)(dev, dstIndex, 0, dev->_page[dstIndex]._segs, sizeof(dev->_page[dstIndex]._segs));
+		memcpy(dev->_page[dstIndex]._segs, dev->_page[srcIndex]._segs, dev->_width);
+		(*func)(dev, dstIndex, 0, dev->_page[dstIndex]._segs, dev->_width);
 		if (srcIndex == dev->_scStart) break;
 		srcIndex = srcIndex - dev->_scDirection;
 	}
 	
 	int _text_len = text_len;
-	if (_text_len > 16) _text_len = 16;
+	if (_text_len > dev->_width / 8) _text_len = dev->_width / 8;
 	
-	ssd1306_display_text(dev, srcIndex, text, text_len, invert);
+	ssd1306_display_text(dev, srcIndex, text, _text_len, invert);
 }
 
 void ssd1306_scroll_clear(SSD1306_t * dev)
@@ -253,156 +480,185 @@ void ssd1306_scroll_clear(SSD1306_t * dev)
 }
 
 
+// Whole panel, one step every 2 frames. Vertical scrolls move one row per
+// step and, as before, also shift page 0 sideways.
 void ssd1306_hardware_scroll(SSD1306_t * dev, ssd1306_scroll_type_t scroll)
 {
-	if (dev->_address == SPIAddress) {
-		spi_hardware_scroll(dev, scroll);
+	bool vertical = (scroll == SCROLL_UP || scroll == SCROLL_DOWN);
+	ssd1306_scroll_cfg_t cfg = {
+		.dir = scroll,
+		.start_page = 0,
+		.end_page = vertical ? 0 : dev->_pages - 1,
+		.interval = 2,
+		.v_offset = 1,
+	};
+	ssd1306_hardware_scroll_config(dev, &cfg);
+}
+
+// Time interval codes of 26h/27h/29h/2Ah (datasheet 10.2.1), by frames per step
+static int scroll_interval_code(uint16_t frames)
+{
+	switch (frames) {
+	case 5:   return 0x00;
+	case 64:  return 0x01;
+	case 128: return 0x02;
+	case 256: return 0x03;
+	case 3:   return 0x04;
+	case 4:   return 0x05;
+	case 25:  return 0x06;
+	case 2:   return 0x07;
+	default:  return -1;
+	}
+}
+
+int ssd1306_scroll_commands(SSD1306_t * dev, const ssd1306_scroll_cfg_t * cfg, uint8_t * cmds)
+{
+	// The SH1106 has no scroll engine (and other meanings for 26h..2Fh)
+	if (dev->_controller != SSD1306_CTRL_SSD1306) return -1;
+
+	int n = 0;
+	// Parameters must not change while a scroll is running
+	cmds[n++] = OLED_CMD_DEACTIVE_SCROLL;
+	if (cfg->dir == SCROLL_STOP) return n;
+
+	int code = scroll_interval_code(cfg->interval);
+	if (code < 0 || cfg->start_page > cfg->end_page || cfg->end_page >= dev->_pages) return -1;
+
+	if (cfg->dir == SCROLL_RIGHT || cfg->dir == SCROLL_LEFT) {
+		cmds[n++] = (cfg->dir == SCROLL_RIGHT) ? OLED_CMD_HORIZONTAL_RIGHT : OLED_CMD_HORIZONTAL_LEFT;
+		cmds[n++] = 0x00;			// Dummy byte
+		cmds[n++] = cfg->start_page;
+		cmds[n++] = code;
+		cmds[n++] = cfg->end_page;
+		cmds[n++] = 0x00;			// Dummy bytes
+		cmds[n++] = 0xFF;
+	} else if (cfg->dir == SCROLL_UP || cfg->dir == SCROLL_DOWN) {
+		int rows = cfg->area_rows ? cfg->area_rows : dev->_height - cfg->area_top;
+		if (cfg->area_top + rows > dev->_height || cfg->v_offset == 0 || cfg->v_offset >= rows) return -1;
+		cmds[n++] = OLED_CMD_VERTICAL;
+		cmds[n++] = cfg->area_top;
+		cmds[n++] = rows;
+		cmds[n++] = OLED_CMD_CONTINUOUS_SCROLL;
+		cmds[n++] = 0x00;			// Dummy byte
+		cmds[n++] = cfg->start_page;
+		cmds[n++] = code;
+		cmds[n++] = cfg->end_page;
+		// The offset moves the area up; down is the complementary offset
+		cmds[n++] = (cfg->dir == SCROLL_UP) ? cfg->v_offset : rows - cfg->v_offset;
 	} else {
-		i2c_hardware_scroll(dev, scroll);
+		return -1;
 	}
+	cmds[n++] = OLED_CMD_ACTIVE_SCROLL;
+	return n;
 }
 
-// delay = 0 : display with no wait
-// delay > 0 : display with wait
-// delay < 0 : no display
-void ssd1306_wrap_arround(SSD1306_t * dev, ssd1306_scroll_type_t scroll, int start, int end, int8_t delay)
+bool ssd1306_hardware_scroll_config(SSD1306_t * dev, const ssd1306_scroll_cfg_t * cfg)
 {
-	if (scroll == SCROLL_RIGHT) {
-		int _start = start; // 0 to 7
-		int _end = end; // 0 to 7
-		if (_end >= dev->_pages) _end = dev->_pages - 1;
-		uint8_t wk;
-		//for (int page=0;page<dev->_pages;page++) {
-		for (int page=_start;page<=_end;page++) {
-			wk = dev->_page[page]._segs[127];
-			for (int seg=127;seg>0;seg--) {
-				dev->_page[page]._segs[seg] = dev->_page[page]._segs[seg-1];
-			}
-			dev->_page[page]._segs[0] = wk;
-		}
+	uint8_t cmds[SSD1306_SCROLL_CMDS_MAX];
+	int n = ssd1306_scroll_commands(dev, cfg, cmds);
+	if (n < 0) {
+		if (dev->_controller == SSD1306_CTRL_SSD1306) ESP_LOGE(TAG, "Invalid scroll configuration");
+		return false;
+	}
+	if (dev->_address == SPIAddress) {
+		spi_send_commands(dev, cmds, n);
+	} else {
+		i2c_send_commands(dev, cmds, n);
+	}
+	return true;
+}
 
-	} else if (scroll == SCROLL_LEFT) {
-		int _start = start; // 0 to 7
-		int _end = end; // 0 to 7
-		if (_end >= dev->_pages) _end = dev->_pages - 1;
-		uint8_t wk;
-		//for (int page=0;page<dev->_pages;page++) {
-		for (int page=_start;page<=_end;page++) {
-			wk = dev->_page[page]._segs[0];
-			for (int seg=0;seg<127;seg++) {
-				dev->_page[page]._segs[seg] = dev->_page[page]._segs[seg+1];
-			}
-			dev->_page[page]._segs[127] = wk;
-		}
+// Four columns of one page byte-shifted at once: rows r.. of a, then the
+// first r rows of b (the page below). With _flip the bytes are bit-reversed,
+// so the same move is a shift the other way.
+static inline uint32_t wrap_word(uint32_t a, uint32_t b, int r, bool flip)
+{
+	const uint32_t ones = 0x01010101;
+	if (r == 0) return a;
+	if (!flip) {
+		return ((a >> r) & (ones * (0xFF >> r))) | ((b << (8 - r)) & (ones * (uint8_t)(0xFF << (8 - r))));
+	}
+	return ((a << r) & (ones * (uint8_t)(0xFF << r))) | ((b >> (8 - r)) & (ones * (0xFF >> (8 - r))));
+}
 
-	} else if (scroll == SCROLL_UP) {
-		int _start = start; // 0 to {width-1}
-		int _end = end; // 0 to {width-1}
-		if (_end >= dev->_width) _end = dev->_width - 1;
-		uint8_t wk0;
-		uint8_t wk1;
-		uint8_t wk2;
-		uint8_t save[128];
-		// Save pages 0
-		for (int seg=0;seg<128;seg++) {
-			save[seg] = dev->_page[0]._segs[seg];
-		}
-		// Page0 to Page6
-		for (int page=0;page<dev->_pages-1;page++) {
-			//for (int seg=0;seg<128;seg++) {
-			for (int seg=_start;seg<=_end;seg++) {
-				wk0 = dev->_page[page]._segs[seg];
-				wk1 = dev->_page[page+1]._segs[seg];
-				if (dev->_flip) wk0 = ssd1306_rotate_byte(wk0);
-				if (dev->_flip) wk1 = ssd1306_rotate_byte(wk1);
-				if (seg == 0) {
-					ESP_LOGD(TAG, "b page=%d wk0=%02x wk1=%02x", page, wk0, wk1);
-				}
-				wk0 = wk0 >> 1;
-				wk1 = wk1 & 0x01;
-				wk1 = wk1 << 7;
-				wk2 = wk0 | wk1;
-				if (seg == 0) {
-					ESP_LOGD(TAG, "a page=%d wk0=%02x wk1=%02x wk2=%02x", page, wk0, wk1, wk2);
-				}
-				if (dev->_flip) wk2 = ssd1306_rotate_byte(wk2);
-				dev->_page[page]._segs[seg] = wk2;
+// Rotates part of the internal buffer by step pixels, wrapping around. Not show it.
+// Horizontal: pages start..end move as whole rows with memmove.
+// Vertical: columns start..end move 4 at a time as 32-bit words; a step of
+// 8q + r rows is a page rotation by q plus a byte-wise shift by r.
+void ssd1306_buffer_wrap(SSD1306_t * dev, ssd1306_scroll_type_t scroll, int start, int end, int step)
+{
+	if (step <= 0) return;
+	if (scroll == SCROLL_RIGHT || scroll == SCROLL_LEFT) {
+		int width = dev->_width;
+		step %= width;
+		if (step == 0) return;
+		if (start < 0) start = 0;
+		if (end >= dev->_pages) end = dev->_pages - 1;
+		uint8_t save[SSD1306_MAX_WIDTH];
+		for (int page=start;page<=end;page++) {
+			uint8_t * segs = dev->_page[page]._segs;
+			if (scroll == SCROLL_RIGHT) {
+				memcpy(save, &segs[width - step], step);
+				memmove(&segs[step], segs, width - step);
+				memcpy(segs, save, step);
+			} else {
+				memcpy(save, segs, step);
+				memmove(segs, &segs[step], width - step);
+				memcpy(&segs[width - step], save, step);
 			}
 		}
-		// Page7
-		int pages = dev->_pages-1;
-		//for (int seg=0;seg<128;seg++) {
-		for (int seg=_start;seg<=_end;seg++) {
-			wk0 = dev->_page[pages]._segs[seg];
-			wk1 = save[seg];
-			if (dev->_flip) wk0 = ssd1306_rotate_byte(wk0);
-			if (dev->_flip) wk1 = ssd1306_rotate_byte(wk1);
-			wk0 = wk0 >> 1;
-			wk1 = wk1 & 0x01;
-			wk1 = wk1 << 7;
-			wk2 = wk0 | wk1;
-			if (dev->_flip) wk2 = ssd1306_rotate_byte(wk2);
-			dev->_page[pages]._segs[seg] = wk2;
-		}
 
-	} else if (scroll == SCROLL_DOWN) {
-		int _start = start; // 0 to {width-1}
-		int _end = end; // 0 to {width-1}
-		if (_end >= dev->_width) _end = dev->_width - 1;
-		uint8_t wk0;
-		uint8_t wk1;
-		uint8_t wk2;
-		uint8_t save[128];
-		// Save pages 7
-		int pages = dev->_pages-1;
-		for (int seg=0;seg<128;seg++) {
-			save[seg] = dev->_page[pages]._segs[seg];
+	} else if (scroll == SCROLL_UP || scroll == SCROLL_DOWN) {
+		int pages = dev->_pages;
+		int height = pages * 8;
+		step %= height;
+		if (step == 0) return;
+		if (start < 0) start = 0;
+		if (end >= dev->_width) end = dev->_width - 1;
+		// Down by step is up by height - step
+		if (scroll == SCROLL_DOWN) step = height - step;
+		int q = step / 8;
+		int r = step % 8;
+		uint8_t pa[SSD1306_MAX_PAGES];
+		uint8_t pb[SSD1306_MAX_PAGES];
+		for (int page=0;page<pages;page++) {
+			pa[page] = (page + q) % pages;
+			pb[page] = (page + q + 1) % pages;
 		}
-		// Page7 to Page1
-		for (int page=pages;page>0;page--) {
-			//for (int seg=0;seg<128;seg++) {
-			for (int seg=_start;seg<=_end;seg++) {
-				wk0 = dev->_page[page]._segs[seg];
-				wk1 = dev->_page[page-1]._segs[seg];
-				if (dev->_flip) wk0 = ssd1306_rotate_byte(wk0);
-				if (dev->_flip) wk1 = ssd1306_rotate_byte(wk1);
-				if (seg == 0) {
-					ESP_LOGD(TAG, "b page=%d wk0=%02x wk1=%02x", page, wk0, wk1);
+		uint32_t w[SSD1306_MAX_PAGES];
+		for (int seg=start & ~3;seg<=end;seg+=4) {
+			for (int page=0;page<pages;page++) memcpy(&w[page], &dev->_page[page]._segs[seg], 4);
+			for (int page=0;page<pages;page++) {
+				uint32_t v = wrap_word(w[pa[page]], w[pb[page]], r, dev->_flip);
+				uint8_t * dst = &dev->_page[page]._segs[seg];
+				if (seg >= start && seg + 3 <= end) {
+					memcpy(dst, &v, 4);
+				} else {
+					// Partial group at either end of the range
+					uint8_t b[4];
+					memcpy(b, &v, 4);
+					for (int i=0;i<4;i++) {
+						if (seg + i >= start && seg + i <= end) dst[i] = b[i];
+					}
 				}
-				wk0 = wk0 << 1;
-				wk1 = wk1 & 0x80;
-				wk1 = wk1 >> 7;
-				wk2 = wk0 | wk1;
-				if (seg == 0) {
-					ESP_LOGD(TAG, "a page=%d wk0=%02x wk1=%02x wk2=%02x", page, wk0, wk1, wk2);
-				}
-				if (dev->_flip) wk2 = ssd1306_rotate_byte(wk2);
-				dev->_page[page]._segs[seg] = wk2;
 			}
 		}
-		// Page0
-		//for (int seg=0;seg<128;seg++) {
-		for (int seg=_start;seg<=_end;seg++) {
-			wk0 = dev->_page[0]._segs[seg];
-			wk1 = save[seg];
-			if (dev->_flip) wk0 = ssd1306_rotate_byte(wk0);
-			if (dev->_flip) wk1 = ssd1306_rotate_byte(wk1);
-			wk0 = wk0 << 1;
-			wk1 = wk1 & 0x80;
-			wk1 = wk1 >> 7;
-			wk2 = wk0 | wk1;
-			if (dev->_flip) wk2 = ssd1306_rotate_byte(wk2);
-			dev->_page[0]._segs[seg] = wk2;
-		}
-
 	}
+}
+
+// delay = 0 : display with no wait
+// delay > 0 : display with wait
+// delay < 0 : no display
+void ssd1306_wrap_arround(SSD1306_t * dev, ssd1306_scroll_type_t scroll, int start, int end, int8_t delay)
+{
+	ssd1306_buffer_wrap(dev, scroll, start, end, 1);
 
 	if (delay >= 0) {
 		for (int page=0;page<dev->_pages;page++) {
 			if (dev->_address == SPIAddress) {
-				spi_display_image(dev, page, 0, dev->_page[page]._segs, 128);
+				spi_display_image(dev, page, 0, dev->_page[page]._segs, dev->_width);
 			} else {
-				i2c_display_image(dev, page, 0, dev->_page[page]._segs, 128);
+				i2c_display_image(dev, page, 0, dev->_page[page]._segs, dev->_width);
 			}
 			if (delay) vTaskDelay(delay);
 		}
@@ -410,57 +666,121 @@ void ssd1306_wrap_arround(SSD1306_t * dev, ssd1306_scroll_type_t scroll, int sta
 
 }
 
-void ssd1306_bitmaps(SSD1306_t * dev, int xpos, int ypos, uint8_t * bitmap, int width, int height, bool invert)
+// Transpose an 8x8 block: rows (MSB = leftmost pixel) in, columns out
+// (bit n = row n, as stored in the page buffer). Hacker's Delight, 32-bit.
+static inline void transpose8(const uint8_t row[8], uint8_t col[8])
+{
+	uint32_t x = ((uint32_t)row[7] << 24) | ((uint32_t)row[6] << 16) | ((uint32_t)row[5] << 8) | row[4];
+	uint32_t y = ((uint32_t)row[3] << 24) | ((uint32_t)row[2] << 16) | ((uint32_t)row[1] << 8) | row[0];
+	uint32_t t;
+	t = (x ^ (x >> 7)) & 0x00AA00AA;  x = x ^ t ^ (t << 7);
+	t = (y ^ (y >> 7)) & 0x00AA00AA;  y = y ^ t ^ (t << 7);
+	t = (x ^ (x >> 14)) & 0x0000CCCC; x = x ^ t ^ (t << 14);
+	t = (y ^ (y >> 14)) & 0x0000CCCC; y = y ^ t ^ (t << 14);
+	t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+	y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+	x = t;
+	col[0] = x >> 24; col[1] = x >> 16; col[2] = x >> 8; col[3] = x;
+	col[4] = y >> 24; col[5] = y >> 16; col[6] = y >> 8; col[7] = y;
+}
+
+// One raster op over a run of column bytes; the switch stays out of the loop
+static inline void rop_run(uint8_t * dst, const uint8_t * src, int n, uint8_t mask, ssd1306_rop_t rop)
+{
+	switch (rop) {
+	case SSD1306_ROP_OR:
+		for (int i = 0; i < n; i++) dst[i] |= src[i] & mask;
+		break;
+	case SSD1306_ROP_AND:
+		for (int i = 0; i < n; i++) dst[i] &= src[i] | (uint8_t)~mask;
+		break;
+	case SSD1306_ROP_XOR:
+		for (int i = 0; i < n; i++) dst[i] ^= src[i] & mask;
+		break;
+	default:
+		if (mask == 0xFF) memcpy(dst, src, n);
+		else for (int i = 0; i < n; i++) dst[i] = (dst[i] & ~mask) | (src[i] & mask);
+		break;
+	}
+}
+
+static const uint8_t rotate_table[256];
+
+// Set bitmap to internal buffer. Not show it.
+// The bitmap is row-major, width/8 bytes per row, MSB first. Each band of 8
+// source rows is transposed in 8x8 blocks and lands on at most two pages,
+// shifted by ypos % 8. Pixels outside the panel are clipped.
+void ssd1306_buffer_bitmap(SSD1306_t * dev, int xpos, int ypos, const uint8_t * bitmap, int width, int height, bool invert, ssd1306_rop_t rop)
 {
 	if ( (width % 8) != 0) {
 		ESP_LOGE(TAG, "width must be a multiple of 8");
 		return;
 	}
-	int _width = width / 8;
-	uint8_t wk0;
-	uint8_t wk1;
-	uint8_t wk2;
-	uint8_t page = (ypos / 8);
-	uint8_t _seg = xpos;
-	uint8_t dstBits = (ypos % 8);
-	ESP_LOGD(TAG, "ypos=%d page=%d dstBits=%d", ypos, page, dstBits);
-	int offset = 0;
-	for(int _height=0;_height<height;_height++) {
-		for (int index=0;index<_width;index++) {
-			for (int srcBits=7; srcBits>=0; srcBits--) {
-				wk0 = dev->_page[page]._segs[_seg];
-				if (dev->_flip) wk0 = ssd1306_rotate_byte(wk0);
-
-				wk1 = bitmap[index+offset];
-				if (invert) wk1 = ~wk1;
-
-				//wk2 = ssd1306_copy_bit(bitmap[index+offset], srcBits, wk0, dstBits);
-				wk2 = ssd1306_copy_bit(wk1, srcBits, wk0, dstBits);
-				if (dev->_flip) wk2 = ssd1306_rotate_byte(wk2);
-
-				ESP_LOGD(TAG, "index=%d offset=%d page=%d _seg=%d, wk2=%02x", index, offset, page, _seg, wk2);
-				dev->_page[page]._segs[_seg] = wk2;
-				_seg++;
-			}
+	int stride = width / 8;
+	uint8_t inv = invert ? 0xFF : 0x00;
+	bool flip = dev->_flip;
+	uint8_t row[8];
+	uint8_t col[8];
+	uint8_t lo[8];
+	uint8_t hi[8];
+	for (int band = 0; band < height; band += 8) {
+		int rows = (height - band < 8) ? height - band : 8;
+		int y0 = ypos + band;
+		if (y0 + rows <= 0) continue;
+		if (y0 >= dev->_height) break;
+		int page = (y0 < 0) ? (y0 - 7) / 8 : y0 / 8;
+		int shift = y0 - page * 8;
+		uint8_t vmask = (uint8_t)(0xFF >> (8 - rows));
+		// Rows of the band that fall below the panel
+		if (y0 + rows > dev->_height) vmask &= (uint8_t)(0xFF >> (8 - (dev->_height - y0)));
+		uint8_t mask_lo = (uint8_t)(vmask << shift);
+		uint8_t mask_hi = shift ? (uint8_t)(vmask >> (8 - shift)) : 0;
+		uint8_t * dst_lo = (page >= 0 && page < dev->_pages) ? dev->_page[page]._segs : NULL;
+		uint8_t * dst_hi = (mask_hi && page + 1 >= 0 && page + 1 < dev->_pages) ? dev->_page[page + 1]._segs : NULL;
+		if (flip) {
+			mask_lo = rotate_table[mask_lo];
+			mask_hi = rotate_table[mask_hi];
 		}
-		vTaskDelay(1);
-		offset = offset + _width;
-		dstBits++;
-		_seg = xpos;
-		if (dstBits == 8) {
-			page++;
-			dstBits=0;
+		// Page-aligned opaque copy: the transpose writes straight into the buffer
+		bool direct = dst_lo && !dst_hi && !flip && rop == SSD1306_ROP_COPY && mask_lo == 0xFF;
+		const uint8_t * src = &bitmap[band * stride];
+
+		for (int bx = 0; bx < stride; bx++, src++) {
+			int x = xpos + bx * 8;
+			if (x + 8 <= 0) continue;
+			if (x >= dev->_width) break;
+			if (rows == 8) {
+				for (int r = 0; r < 8; r++) row[r] = src[r * stride] ^ inv;
+			} else {
+				for (int r = 0; r < 8; r++) row[r] = (r < rows) ? src[r * stride] ^ inv : 0;
+			}
+			int c0 = (x < 0) ? -x : 0;
+			int c1 = (x + 8 > dev->_width) ? dev->_width - x : 8;
+			if (direct && c0 == 0 && c1 == 8) {
+				transpose8(row, &dst_lo[x]);
+				continue;
+			}
+			transpose8(row, col);
+			for (int i = c0; i < c1; i++) {
+				lo[i] = (uint8_t)(col[i] << shift);
+				hi[i] = shift ? (uint8_t)(col[i] >> (8 - shift)) : 0;
+			}
+			if (flip) {
+				for (int i = c0; i < c1; i++) {
+					lo[i] = rotate_table[lo[i]];
+					hi[i] = rotate_table[hi[i]];
+				}
+			}
+			if (dst_lo) rop_run(&dst_lo[x + c0], &lo[c0], c1 - c0, mask_lo, rop);
+			if (dst_hi) rop_run(&dst_hi[x + c0], &hi[c0], c1 - c0, mask_hi, rop);
 		}
 	}
+}
 
-#if 0
-	for (int _seg=ypos;_seg<ypos+width;_seg++) {
-		ssd1306_dump_page(dev, page-1, _seg);
-	}
-	for (int _seg=ypos;_seg<ypos+width;_seg++) {
-		ssd1306_dump_page(dev, page, _seg);
-	}
-#endif
+// Set bitmap to internal buffer and show it.
+void ssd1306_bitmaps(SSD1306_t * dev, int xpos, int ypos, uint8_t * bitmap, int width, int height, bool invert)
+{
+	ssd1306_buffer_bitmap(dev, xpos, ypos, bitmap, width, height, invert, SSD1306_ROP_COPY);
 	ssd1306_show_buffer(dev);
 }
 
@@ -568,13 +888,17 @@ uint8_t ssd1306_copy_bit(uint8_t src, int srcBits, uint8_t dst, int dstBits)
 
 // Rotate 8-bit data
 // 0x12-->0x48
+// Bit reversal of every byte value, built at compile time
+#define R2(n) n, n + 2*64, n + 1*64, n + 3*64
+#define R4(n) R2(n), R2(n + 2*16), R2(n + 1*16), R2(n + 3*16)
+#define R6(n) R4(n), R4(n + 2*4 ), R4(n + 1*4 ), R4(n + 3*4 )
+static const uint8_t rotate_table[256] = { R6(0), R6(2), R6(1), R6(3) };
+#undef R2
+#undef R4
+#undef R6
+
 uint8_t ssd1306_rotate_byte(uint8_t ch1) {
-	uint8_t ch2 = 0;
-	for (int j=0;j<8;j++) {
-		ch2 = (ch2 << 1) + (ch1 & 0x01);
-		ch1 = ch1 >> 1;
-	}
-	return ch2;
+	return rotate_table[ch1];
 }
 
 
@@ -596,7 +920,7 @@ void ssd1306_fadeout(SSD1306_t * dev)
 			} else {
 				image[0] = image[0] << 1;
 			}
-			for(int seg=0; seg<128; seg++) {
+			for(int seg=0; seg<dev->_width; seg++) {
 				(*func)(dev, page, seg, image, 1);
 				dev->_page[page]._segs[seg] = image[0];
 			}
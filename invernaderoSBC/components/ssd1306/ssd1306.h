@@ -64,14 +64,30 @@ Usage:
 // Scrolling Command
 #define OLED_CMD_HORIZONTAL_RIGHT       0x26
 #define OLED_CMD_HORIZONTAL_LEFT        0x27
-#define OLED_CMD_CONTINUOUS_SCROLL      0x29
+#define OLED_CMD_CONTINUOUS_SCROLL      0x29    // vertical + right horizontal
+#define OLED_CMD_CONTINUOUS_SCROLL_LEFT 0x2A    // vertical + left horizontal
 #define OLED_CMD_DEACTIVE_SCROLL        0x2E
 #define OLED_CMD_ACTIVE_SCROLL          0x2F
 #define OLED_CMD_VERTICAL               0xA3
 
+// SH1106 only
+#define SH1106_CMD_SET_DCDC             0xAD    // follow with 0x8B = on
+
 #define I2CAddress 0x3C
 #define SPIAddress 0xFF
 
+// Largest panel the internal buffer holds. Geometry is set at init time and
+// may be smaller (128x32, 96x16 ...): everything works on _width/_pages.
+#define SSD1306_MAX_WIDTH	128
+#define SSD1306_MAX_PAGES	8
+
+#define SSD1306_INIT_CMDS_MAX	32
+
+typedef enum {
+	SSD1306_CTRL_SSD1306 = 0,
+	SSD1306_CTRL_SH1106			// 132-column RAM, page addressing only, no scroll engine
+} ssd1306_controller_t;
+
 typedef enum {
 	SCROLL_RIGHT = 1,
 	SCROLL_LEFT = 2,
@@ -80,12 +96,64 @@ typedef enum {
 	SCROLL_STOP = 5
 } ssd1306_scroll_type_t;
 
+typedef enum {
+	SSD1306_ROP_COPY = 0,	// dst = src
+	SSD1306_ROP_OR,			// set pixels
+	SSD1306_ROP_AND,		// clear pixels where src is 0
+	SSD1306_ROP_XOR			// toggle pixels
+} ssd1306_rop_t;
+
+typedef enum {
+	SSD1306_ALIGN_LEFT = 0,
+	SSD1306_ALIGN_CENTER,
+	SSD1306_ALIGN_RIGHT
+} ssd1306_align_t;
+
+// Proportional font atlas in page format (see ssd1306_fonts.c). Glyph i
+// occupies pages * width[i] bytes at data + offset[i], one page after another.
+typedef struct {
+	uint8_t pages;			// Glyph height in pages
+	uint8_t spacing;		// Blank columns after each glyph
+	uint8_t first;			// Contiguous ASCII block
+	uint8_t last;
+	const uint16_t * extra_codes;	// Code points stored after the ASCII block
+	uint8_t extra_count;
+	const uint16_t * offset;
+	const uint8_t * width;
+	const uint8_t * data;
+} ssd1306_font_t;
+
+extern const ssd1306_font_t ssd1306_font_small;		// 8 px
+extern const ssd1306_font_t ssd1306_font_medium;	// 16 px
+extern const ssd1306_font_t ssd1306_font_large;		// 24 px
+
+// Continuous scroll run by the panel controller. Horizontal scrolls move
+// pages start_page..end_page; vertical ones move rows area_top..area_top +
+// area_rows - 1 by v_offset rows per step, and also shift start_page..end_page
+// sideways (the SSD1306 has no purely vertical continuous scroll).
+typedef struct {
+	ssd1306_scroll_type_t dir;
+	uint8_t start_page;
+	uint8_t end_page;
+	uint16_t interval;		// Frames per step: 2, 3, 4, 5, 25, 64, 128 or 256
+	uint8_t v_offset;		// Rows per step, vertical only
+	uint8_t area_top;		// Fixed rows above the vertical area
+	uint8_t area_rows;		// 0 = down to the bottom of the panel
+} ssd1306_scroll_cfg_t;
+
+#define SSD1306_SCROLL_CMDS_MAX	12
+
 typedef struct {
 	bool _valid; // Not using it anymore
 	int _segLen; // Not using it anymore
-	uint8_t _segs[128];
+	uint8_t _segs[SSD1306_MAX_WIDTH];
 } PAGE_t;
 
+struct ssd1306_spi_queue;
+
+// I2C through an external bus manager: buf is a whole transaction, control byte first
+typedef esp_err_t (*ssd1306_i2c_write_t)(void * ctx, const uint8_t * buf, size_t len);
+
 typedef struct {
 	int _address;
 	int _width;
@@ -98,8 +166,14 @@ typedef struct {
 	int _scStart;
 	int _scEnd;
 	int _scDirection;
-	PAGE_t _page[8];
+	PAGE_t _page[SSD1306_MAX_PAGES];
 	bool _flip;
+	struct ssd1306_spi_queue * _spiQueue;	// SPI only, see ssd1306_spi.c
+	i2c_master_bus_handle_t _i2c_bus_handle;	// I2C only, may be shared by several panels
+	ssd1306_i2c_write_t _i2c_write;			// Replaces _i2c_dev_handle when set
+	void * _i2c_ctx;
+	ssd1306_controller_t _controller;
+	int _offsetx;				// RAM column of the first visible pixel
 } SSD1306_t;
 
 #ifdef __cplusplus
@@ -108,12 +182,37 @@ extern "C"
 #endif
 
 void ssd1306_init(SSD1306_t * dev, int width, int height);
+// Before ssd1306_init. Also sets the controller's usual column offset (2 on
+// the SH1106); adjust _offsetx afterwards for modules wired differently.
+void ssd1306_set_controller(SSD1306_t * dev, ssd1306_controller_t controller);
+// Validates and stores width/height; false if the buffer can't hold them
+bool ssd1306_set_geometry(SSD1306_t * dev, int width, int height);
+// Controller command backend, used by the transports. Power-up sequence, at
+// most SSD1306_INIT_CMDS_MAX bytes; horizontal addressing is SSD1306 only.
+int ssd1306_init_commands(SSD1306_t * dev, bool horizontal, uint8_t * cmds);
+// Page addressing: write pointer to (page, seg), with flip and column offset. 3 bytes
+int ssd1306_page_commands(SSD1306_t * dev, int page, int seg, uint8_t * cmds);
 int ssd1306_get_width(SSD1306_t * dev);
 int ssd1306_get_height(SSD1306_t * dev);
 int ssd1306_get_pages(SSD1306_t * dev);
 void ssd1306_show_buffer(SSD1306_t * dev);
 void ssd1306_set_buffer(SSD1306_t * dev, uint8_t * buffer);
 void ssd1306_get_buffer(SSD1306_t * dev, uint8_t * buffer);
+// Off-screen composition: these only touch the internal buffer (_page[]._segs)
+void ssd1306_clear_buffer(SSD1306_t * dev, bool invert);
+void ssd1306_buffer_text(SSD1306_t * dev, int page, int seg, const char * text, int text_len, bool invert);
+// UTF-8 text in an atlas font, starting at column x (may be negative) of page.
+// Returns the column after the last glyph.
+int ssd1306_buffer_string(SSD1306_t * dev, const ssd1306_font_t * font, int page, int x, const char * text, bool invert);
+void ssd1306_buffer_string_aligned(SSD1306_t * dev, const ssd1306_font_t * font, int page, ssd1306_align_t align, const char * text, bool invert);
+// Width in columns, without the spacing after the last glyph
+int ssd1306_text_width(const ssd1306_font_t * font, const char * text);
+void ssd1306_buffer_bitmap(SSD1306_t * dev, int xpos, int ypos, const uint8_t * bitmap, int width, int height, bool invert, ssd1306_rop_t rop);
+void ssd1306_buffer_vspan(SSD1306_t * dev, int seg, int y0, int y1, bool invert);
+// Sends the columns that differ from front (_pages * _width bytes, what the panel shows)
+// and updates front. Returns the number of data bytes sent.
+int ssd1306_flush_diff(SSD1306_t * dev, uint8_t * front);
+void ssd1306_display_power(SSD1306_t * dev, bool on);
 void ssd1306_display_image(SSD1306_t * dev, int page, int seg, uint8_t * images, int width);
 void ssd1306_display_text(SSD1306_t * dev, int page, char * text, int text_len, bool invert);
 void ssd1306_display_text_x3(SSD1306_t * dev, int page, char * text, int text_len, bool invert);
@@ -124,6 +223,14 @@ void ssd1306_software_scroll(SSD1306_t * dev, int start, int end);
 void ssd1306_scroll_text(SSD1306_t * dev, char * text, int text_len, bool invert);
 void ssd1306_scroll_clear(SSD1306_t * dev);
 void ssd1306_hardware_scroll(SSD1306_t * dev, ssd1306_scroll_type_t scroll);
+// Stops any running scroll, then starts cfg (SCROLL_STOP only stops). After a
+// stop the scrolled area of GDDRAM must be rewritten. False if nothing was
+// sent: invalid cfg, or a controller without scroll engine.
+bool ssd1306_hardware_scroll_config(SSD1306_t * dev, const ssd1306_scroll_cfg_t * cfg);
+// Command bytes for cfg, at most SSD1306_SCROLL_CMDS_MAX. Returns the count, -1 if invalid
+int ssd1306_scroll_commands(SSD1306_t * dev, const ssd1306_scroll_cfg_t * cfg, uint8_t * cmds);
+// Off-screen wrap-around by step pixels; start/end are pages (left/right) or columns (up/down)
+void ssd1306_buffer_wrap(SSD1306_t * dev, ssd1306_scroll_type_t scroll, int start, int end, int step);
 void ssd1306_wrap_arround(SSD1306_t * dev, ssd1306_scroll_type_t scroll, int start, int end, int8_t delay);
 void ssd1306_bitmaps(SSD1306_t * dev, int xpos, int ypos, uint8_t * bitmap, int width, int height, bool invert);
 void _ssd1306_pixel(SSD1306_t * dev, int xpos, int ypos, bool invert);
@@ -137,10 +244,21 @@ void ssd1306_dump(SSD1306_t dev);
 void ssd1306_dump_page(SSD1306_t * dev, int page, int seg);
 
 void i2c_master_init(SSD1306_t * dev, int16_t sda, int16_t scl, int16_t reset);
+// Panel at address on a bus that already exists (another panel's _i2c_bus_handle,
+// or the one shared with the sensors)
+void i2c_device_add(SSD1306_t * dev, i2c_master_bus_handle_t bus, uint16_t address, uint32_t scl_speed_hz, int16_t reset);
+// Panel driven through write (a bus manager that owns the bus)
+void i2c_device_attach(SSD1306_t * dev, uint16_t address, ssd1306_i2c_write_t write, void * ctx);
+// Joins two queued transactions to the panel into one when the protocol allows:
+// command + command streams, or commands + data using the Co bit. false (buf
+// untouched) otherwise
+bool i2c_merge_writes(uint8_t * buf, size_t * len, size_t cap, const uint8_t * next, size_t next_len);
 void i2c_init(SSD1306_t * dev, int width, int height);
 void i2c_display_image(SSD1306_t * dev, int page, int seg, uint8_t * images, int width);
 void i2c_contrast(SSD1306_t * dev, int contrast);
+void i2c_display_power(SSD1306_t * dev, bool on);
 void i2c_hardware_scroll(SSD1306_t * dev, ssd1306_scroll_type_t scroll);
+void i2c_send_commands(SSD1306_t * dev, const uint8_t * cmds, int len);
 
 void spi_master_init(SSD1306_t * dev, int16_t GPIO_MOSI, int16_t GPIO_SCLK, int16_t GPIO_CS, int16_t GPIO_DC, int16_t GPIO_RESET);
 bool spi_master_write_byte(spi_device_handle_t SPIHandle, const uint8_t* Data, size_t DataLength );
@@ -148,8 +266,11 @@ bool spi_master_write_command(SSD1306_t * dev, uint8_t Command );
 bool spi_master_write_data(SSD1306_t * dev, const uint8_t* Data, size_t DataLength );
 void spi_init(SSD1306_t * dev, int width, int height);
 void spi_display_image(SSD1306_t * dev, int page, int seg, uint8_t * images, int width);
+void spi_display_frame(SSD1306_t * dev);
+void spi_wait_done(SSD1306_t * dev);
 void spi_contrast(SSD1306_t * dev, int contrast);
 void spi_hardware_scroll(SSD1306_t * dev, ssd1306_scroll_type_t scroll);
+void spi_send_commands(SSD1306_t * dev, const uint8_t * cmds, int len);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,712 @@
+/*
+ * ssd1306_fonts.c
+ *
+ * Generated by tools/gen_fonts.py from font8x8_basic.h. Do not edit.
+ */
+
+#include "ssd1306.h"
+
+// Code points past the ASCII block, in glyph order after U+007E
+static const uint16_t extra_codes[] = {
+	0x00A1, 0x00B0, 0x00BF, 0x00C1, 0x00C9, 0x00CD, 0x00D1, 0x00D3, 0x00DA, 0x00E1, 0x00E9, 0x00ED, 0x00F1, 0x00F3, 0x00FA, 0x00FC
+};
+
+static const uint8_t small_data[668] = {
+	0x00, 0x00, 0x00, 0x06, 0x5F, 0x5F, 0x06, 0x03, 0x03, 0x00, 0x03, 0x03, 0x14, 0x7F, 0x7F, 0x14,
+	0x7F, 0x7F, 0x14, 0x24, 0x2E, 0x6B, 0x6B, 0x3A, 0x12, 0x46, 0x66, 0x30, 0x18, 0x0C, 0x66, 0x62,
+	0x30, 0x7A, 0x4F, 0x5D, 0x37, 0x7A, 0x48, 0x04, 0x07, 0x03, 0x1C, 0x3E, 0x63, 0x41, 0x41, 0x63,
+	0x3E, 0x1C, 0x08, 0x2A, 0x3E, 0x1C, 0x1C, 0x3E, 0x2A, 0x08, 0x08, 0x08, 0x3E, 0x3E, 0x08, 0x08,
+	0x80, 0xE0, 0x60, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x60, 0x60, 0x60, 0x30, 0x18, 0x0C, 0x06,
+	0x03, 0x01, 0x3E, 0x7F, 0x71, 0x59, 0x4D, 0x7F, 0x3E, 0x40, 0x42, 0x7F, 0x7F, 0x40, 0x40, 0x62,
+	0x73, 0x59, 0x49, 0x6F, 0x66, 0x22, 0x63, 0x49, 0x49, 0x7F, 0x36, 0x18, 0x1C, 0x16, 0x53, 0x7F,
+	0x7F, 0x50, 0x27, 0x67, 0x45, 0x45, 0x7D, 0x39, 0x3C, 0x7E, 0x4B, 0x49, 0x79, 0x30, 0x03, 0x03,
+	0x71, 0x79, 0x0F, 0x07, 0x36, 0x7F, 0x49, 0x49, 0x7F, 0x36, 0x06, 0x4F, 0x49, 0x69, 0x3F, 0x1E,
+	0x66, 0x66, 0x80, 0xE6, 0x66, 0x08, 0x1C, 0x36, 0x63, 0x41, 0x24, 0x24, 0x24, 0x24, 0x24, 0x24,
+	0x41, 0x63, 0x36, 0x1C, 0x08, 0x02, 0x03, 0x51, 0x59, 0x0F, 0x06, 0x3E, 0x7F, 0x41, 0x5D, 0x5D,
+	0x1F, 0x1E, 0x7C, 0x7E, 0x13, 0x13, 0x7E, 0x7C, 0x41, 0x7F, 0x7F, 0x49, 0x49, 0x7F, 0x36, 0x1C,
+	0x3E, 0x63, 0x41, 0x41, 0x63, 0x22, 0x41, 0x7F, 0x7F, 0x41, 0x63, 0x3E, 0x1C, 0x41, 0x7F, 0x7F,
+	0x49, 0x5D, 0x41, 0x63, 0x41, 0x7F, 0x7F, 0x49, 0x1D, 0x01, 0x03, 0x1C, 0x3E, 0x63, 0x41, 0x51,
+	0x73, 0x72, 0x7F, 0x7F, 0x08, 0x08, 0x7F, 0x7F, 0x41, 0x7F, 0x7F, 0x41, 0x30, 0x70, 0x40, 0x41,
+	0x7F, 0x3F, 0x01, 0x41, 0x7F, 0x7F, 0x08, 0x1C, 0x77, 0x63, 0x41, 0x7F, 0x7F, 0x41, 0x40, 0x60,
+	0x70, 0x7F, 0x7F, 0x0E, 0x1C, 0x0E, 0x7F, 0x7F, 0x7F, 0x7F, 0x06, 0x0C, 0x18, 0x7F, 0x7F, 0x1C,
+	0x3E, 0x63, 0x41, 0x63, 0x3E, 0x1C, 0x41, 0x7F, 0x7F, 0x49, 0x09, 0x0F, 0x06, 0x1E, 0x3F, 0x21,
+	0x71, 0x7F, 0x5E, 0x41, 0x7F, 0x7F, 0x09, 0x19, 0x7F, 0x66, 0x26, 0x6F, 0x4D, 0x59, 0x73, 0x32,
+	0x03, 0x41, 0x7F, 0x7F, 0x41, 0x03, 0x7F, 0x7F, 0x40, 0x40, 0x7F, 0x7F, 0x1F, 0x3F, 0x60, 0x60,
+	0x3F, 0x1F, 0x7F, 0x7F, 0x30, 0x18, 0x30, 0x7F, 0x7F, 0x43, 0x67, 0x3C, 0x18, 0x3C, 0x67, 0x43,
+	0x07, 0x4F, 0x78, 0x78, 0x4F, 0x07, 0x47, 0x63, 0x71, 0x59, 0x4D, 0x67, 0x73, 0x7F, 0x7F, 0x41,
+	0x41, 0x01, 0x03, 0x06, 0x0C, 0x18, 0x30, 0x60, 0x41, 0x41, 0x7F, 0x7F, 0x08, 0x0C, 0x06, 0x03,
+	0x06, 0x0C, 0x08, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x03, 0x07, 0x04, 0x20, 0x74,
+	0x54, 0x54, 0x3C, 0x78, 0x40, 0x41, 0x7F, 0x3F, 0x48, 0x48, 0x78, 0x30, 0x38, 0x7C, 0x44, 0x44,
+	0x6C, 0x28, 0x30, 0x78, 0x48, 0x49, 0x3F, 0x7F, 0x40, 0x38, 0x7C, 0x54, 0x54, 0x5C, 0x18, 0x48,
+	0x7E, 0x7F, 0x49, 0x03, 0x02, 0x98, 0xBC, 0xA4, 0xA4, 0xF8, 0x7C, 0x04, 0x41, 0x7F, 0x7F, 0x08,
+	0x04, 0x7C, 0x78, 0x44, 0x7D, 0x7D, 0x40, 0x60, 0xE0, 0x80, 0x80, 0xFD, 0x7D, 0x41, 0x7F, 0x7F,
+	0x10, 0x38, 0x6C, 0x44, 0x41, 0x7F, 0x7F, 0x40, 0x7C, 0x7C, 0x18, 0x38, 0x1C, 0x7C, 0x78, 0x7C,
+	0x7C, 0x04, 0x04, 0x7C, 0x78, 0x38, 0x7C, 0x44, 0x44, 0x7C, 0x38, 0x84, 0xFC, 0xF8, 0xA4, 0x24,
+	0x3C, 0x18, 0x18, 0x3C, 0x24, 0xA4, 0xF8, 0xFC, 0x84, 0x44, 0x7C, 0x78, 0x4C, 0x04, 0x1C, 0x18,
+	0x48, 0x5C, 0x54, 0x54, 0x74, 0x24, 0x04, 0x3E, 0x7F, 0x44, 0x24, 0x3C, 0x7C, 0x40, 0x40, 0x3C,
+	0x7C, 0x40, 0x1C, 0x3C, 0x60, 0x60, 0x3C, 0x1C, 0x3C, 0x7C, 0x70, 0x38, 0x70, 0x7C, 0x3C, 0x44,
+	0x6C, 0x38, 0x10, 0x38, 0x6C, 0x44, 0x9C, 0xBC, 0xA0, 0xA0, 0xFC, 0x7C, 0x4C, 0x64, 0x74, 0x5C,
+	0x4C, 0x64, 0x08, 0x08, 0x3E, 0x77, 0x41, 0x41, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x41,
+	0x41, 0x77, 0x3E, 0x08, 0x08, 0x02, 0x03, 0x01, 0x03, 0x02, 0x03, 0x01, 0x30, 0x7D, 0x7D, 0x30,
+	0x06, 0x09, 0x09, 0x06, 0x30, 0x78, 0x4D, 0x45, 0x60, 0x20, 0xF8, 0xF8, 0x24, 0x26, 0xFB, 0xF9,
+	0x84, 0xFC, 0xFC, 0x96, 0xBF, 0x85, 0xC4, 0x84, 0xFC, 0xFE, 0x87, 0x01, 0xFE, 0xFD, 0x09, 0x1A,
+	0x33, 0xFC, 0xFC, 0x38, 0x78, 0xC4, 0x86, 0xC7, 0x79, 0x38, 0xFC, 0xFC, 0x80, 0x82, 0xFF, 0xFD,
+	0x20, 0x74, 0x54, 0x56, 0x3F, 0x79, 0x40, 0x38, 0x7C, 0x54, 0x56, 0x5F, 0x19, 0x44, 0x7C, 0x7E,
+	0x43, 0x01, 0x7E, 0x7D, 0x05, 0x06, 0x7F, 0x78, 0x38, 0x7C, 0x44, 0x46, 0x7F, 0x39, 0x3C, 0x7C,
+	0x40, 0x42, 0x3F, 0x7D, 0x40, 0x3C, 0x7D, 0x41, 0x40, 0x3D, 0x7D, 0x40,
+};
+
+static const uint16_t small_offset[111] = {
+	0, 3, 7, 12, 19, 25, 32, 39, 42, 46, 50, 58,
+	64, 67, 73, 75, 82, 89, 95, 101, 107, 114, 120, 126,
+	132, 138, 144, 146, 149, 154, 160, 165, 171, 178, 184, 191,
+	198, 205, 212, 219, 226, 232, 236, 243, 250, 257, 264, 271,
+	278, 285, 291, 298, 304, 310, 316, 322, 329, 336, 342, 349,
+	353, 360, 364, 371, 379, 382, 389, 396, 402, 409, 415, 421,
+	428, 435, 439, 445, 452, 456, 463, 469, 475, 482, 489, 496,
+	502, 507, 514, 520, 527, 534, 540, 546, 552, 559, 565, 572,
+	576, 580, 586, 592, 599, 604, 611, 618, 624, 631, 637, 642,
+	648, 654, 661,
+};
+
+static const uint8_t small_width[111] = {
+	3, 4, 5, 7, 6, 7, 7, 3, 4, 4, 8, 6, 3, 6, 2, 7,
+	7, 6, 6, 6, 7, 6, 6, 6, 6, 6, 2, 3, 5, 6, 5, 6,
+	7, 6, 7, 7, 7, 7, 7, 7, 6, 4, 7, 7, 7, 7, 7, 7,
+	7, 6, 7, 6, 6, 6, 6, 7, 7, 6, 7, 4, 7, 4, 7, 8,
+	3, 7, 7, 6, 7, 6, 6, 7, 7, 4, 6, 7, 4, 7, 6, 6,
+	7, 7, 7, 6, 5, 7, 6, 7, 7, 6, 6, 6, 7, 6, 7, 4,
+	4, 6, 6, 7, 5, 7, 7, 6, 7, 6, 5, 6, 6, 7, 7,
+};
+
+const ssd1306_font_t ssd1306_font_small = {
+	.pages = 1,
+	.spacing = 1,
+	.first = 0x20,
+	.last = 0x7E,
+	.extra_codes = extra_codes,
+	.extra_count = 16,
+	.offset = small_offset,
+	.width = small_width,
+	.data = small_data,
+};
+
+static const uint8_t medium_data[2672] = {
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3C, 0x3C, 0xFF, 0xFF,
+	0xFF, 0xFF, 0x3C, 0x3C, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x0F, 0x0F, 0x0F, 0x0F,
+	0x00, 0x00, 0x0F, 0x0F, 0x0F, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x30, 0x30, 0xFF, 0xFF, 0xFF, 0xFF, 0x30, 0x30, 0xFF, 0xFF, 0xFF, 0xFF, 0x30, 0x30, 0x03, 0x03,
+	0x3F, 0x3F, 0x3F, 0x3F, 0x03, 0x03, 0x3F, 0x3F, 0x3F, 0x3F, 0x03, 0x03, 0x30, 0x30, 0xFC, 0xFC,
+	0xCF, 0xCF, 0xCF, 0xCF, 0xCC, 0xCC, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x3C, 0x3C, 0x3C, 0x3C,
+	0x0F, 0x0F, 0x03, 0x03, 0x3C, 0x3C, 0x3C, 0x3C, 0x00, 0x00, 0xC0, 0xC0, 0xF0, 0xF0, 0x3C, 0x3C,
+	0x0C, 0x0C, 0x30, 0x30, 0x3C, 0x3C, 0x0F, 0x0F, 0x03, 0x03, 0x00, 0x00, 0x3C, 0x3C, 0x3C, 0x3C,
+	0x00, 0x00, 0xCC, 0xCC, 0xFF, 0xFF, 0xF3, 0xF3, 0x3F, 0x3F, 0xCC, 0xCC, 0xC0, 0xC0, 0x0F, 0x0F,
+	0x3F, 0x3F, 0x30, 0x30, 0x33, 0x33, 0x0F, 0x0F, 0x3F, 0x3F, 0x30, 0x30, 0x30, 0x30, 0x3F, 0x3F,
+	0x0F, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0xF0, 0xFC, 0xFC, 0x0F, 0x0F, 0x03, 0x03,
+	0x03, 0x03, 0x0F, 0x0F, 0x3C, 0x3C, 0x30, 0x30, 0x03, 0x03, 0x0F, 0x0F, 0xFC, 0xFC, 0xF0, 0xF0,
+	0x30, 0x30, 0x3C, 0x3C, 0x0F, 0x0F, 0x03, 0x03, 0xC0, 0xC0, 0xCC, 0xCC, 0xFC, 0xFC, 0xF0, 0xF0,
+	0xF0, 0xF0, 0xFC, 0xFC, 0xCC, 0xCC, 0xC0, 0xC0, 0x00, 0x00, 0x0C, 0x0C, 0x0F, 0x0F, 0x03, 0x03,
+	0x03, 0x03, 0x0F, 0x0F, 0x0C, 0x0C, 0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xC0, 0xFC, 0xFC, 0xFC, 0xFC,
+	0xC0, 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x0F, 0x0F, 0x0F, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0xFC, 0xFC, 0x3C, 0x3C, 0xC0, 0xC0, 0xC0, 0xC0,
+	0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3C, 0x3C, 0x3C, 0x3C, 0x00, 0x00, 0x00, 0x00,
+	0xC0, 0xC0, 0xF0, 0xF0, 0x3C, 0x3C, 0x0F, 0x0F, 0x03, 0x03, 0x3C, 0x3C, 0x0F, 0x0F, 0x03, 0x03,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFC, 0xFC, 0xFF, 0xFF, 0x03, 0x03, 0xC3, 0xC3,
+	0xF3, 0xF3, 0xFF, 0xFF, 0xFC, 0xFC, 0x0F, 0x0F, 0x3F, 0x3F, 0x3F, 0x3F, 0x33, 0x33, 0x30, 0x30,
+	0x3F, 0x3F, 0x0F, 0x0F, 0x00, 0x00, 0x0C, 0x0C, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00,
+	0x30, 0x30, 0x30, 0x30, 0x3F, 0x3F, 0x3F, 0x3F, 0x30, 0x30, 0x30, 0x30, 0x0C, 0x0C, 0x0F, 0x0F,
+	0xC3, 0xC3, 0xC3, 0xC3, 0xFF, 0xFF, 0x3C, 0x3C, 0x3C, 0x3C, 0x3F, 0x3F, 0x33, 0x33, 0x30, 0x30,
+	0x3C, 0x3C, 0x3C, 0x3C, 0x0C, 0x0C, 0x0F, 0x0F, 0xC3, 0xC3, 0xC3, 0xC3, 0xFF, 0xFF, 0x3C, 0x3C,
+	0x0C, 0x0C, 0x3C, 0x3C, 0x30, 0x30, 0x30, 0x30, 0x3F, 0x3F, 0x0F, 0x0F, 0xC0, 0xC0, 0xF0, 0xF0,
+	0x3C, 0x3C, 0x0F, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+	0x33, 0x33, 0x3F, 0x3F, 0x3F, 0x3F, 0x33, 0x33, 0x3F, 0x3F, 0x3F, 0x3F, 0x33, 0x33, 0x33, 0x33,
+	0xF3, 0xF3, 0xC3, 0xC3, 0x0C, 0x0C, 0x3C, 0x3C, 0x30, 0x30, 0x30, 0x30, 0x3F, 0x3F, 0x0F, 0x0F,
+	0xF0, 0xF0, 0xFC, 0xFC, 0xCF, 0xCF, 0xC3, 0xC3, 0xC3, 0xC3, 0x00, 0x00, 0x0F, 0x0F, 0x3F, 0x3F,
+	0x30, 0x30, 0x30, 0x30, 0x3F, 0x3F, 0x0F, 0x0F, 0x0F, 0x0F, 0x0F, 0x0F, 0x03, 0x03, 0xC3, 0xC3,
+	0xFF, 0xFF, 0x3F, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x3F, 0x3F, 0x3F, 0x3F, 0x00, 0x00, 0x00, 0x00,
+	0x3C, 0x3C, 0xFF, 0xFF, 0xC3, 0xC3, 0xC3, 0xC3, 0xFF, 0xFF, 0x3C, 0x3C, 0x0F, 0x0F, 0x3F, 0x3F,
+	0x30, 0x30, 0x30, 0x30, 0x3F, 0x3F, 0x0F, 0x0F, 0x3C, 0x3C, 0xFF, 0xFF, 0xC3, 0xC3, 0xC3, 0xC3,
+	0xFF, 0xFF, 0xFC, 0xFC, 0x00, 0x00, 0x30, 0x30, 0x30, 0x30, 0x3C, 0x3C, 0x0F, 0x0F, 0x03, 0x03,
+	0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x00, 0x00, 0x3C, 0x3C, 0x3C, 0x3C, 0xC0, 0xC0,
+	0xFC, 0xFC, 0x3C, 0x3C, 0xC0, 0xC0, 0xF0, 0xF0, 0x3C, 0x3C, 0x0F, 0x0F, 0x03, 0x03, 0x00, 0x00,
+	0x03, 0x03, 0x0F, 0x0F, 0x3C, 0x3C, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+	0x30, 0x30, 0x30, 0x30, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C,
+	0x03, 0x03, 0x0F, 0x0F, 0x3C, 0x3C, 0xF0, 0xF0, 0xC0, 0xC0, 0x30, 0x30, 0x3C, 0x3C, 0x0F, 0x0F,
+	0x03, 0x03, 0x00, 0x00, 0x0C, 0x0C, 0x0F, 0x0F, 0x03, 0x03, 0xC3, 0xC3, 0xFF, 0xFF, 0x3C, 0x3C,
+	0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0xFC, 0xFC, 0xFF, 0xFF,
+	0x03, 0x03, 0xF3, 0xF3, 0xF3, 0xF3, 0xFF, 0xFF, 0xFC, 0xFC, 0x0F, 0x0F, 0x3F, 0x3F, 0x30, 0x30,
+	0x33, 0x33, 0x33, 0x33, 0x03, 0x03, 0x03, 0x03, 0xF0, 0xF0, 0xFC, 0xFC, 0x0F, 0x0F, 0x0F, 0x0F,
+	0xFC, 0xFC, 0xF0, 0xF0, 0x3F, 0x3F, 0x3F, 0x3F, 0x03, 0x03, 0x03, 0x03, 0x3F, 0x3F, 0x3F, 0x3F,
+	0x03, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0xC3, 0xC3, 0xC3, 0xC3, 0xFF, 0xFF, 0x3C, 0x3C, 0x30, 0x30,
+	0x3F, 0x3F, 0x3F, 0x3F, 0x30, 0x30, 0x30, 0x30, 0x3F, 0x3F, 0x0F, 0x0F, 0xF0, 0xF0, 0xFC, 0xFC,
+	0x0F, 0x0F, 0x03, 0x03, 0x03, 0x03, 0x0F, 0x0F, 0x0C, 0x0C, 0x03, 0x03, 0x0F, 0x0F, 0x3C, 0x3C,
+	0x30, 0x30, 0x30, 0x30, 0x3C, 0x3C, 0x0C, 0x0C, 0x03, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0x03, 0x03,
+	0x0F, 0x0F, 0xFC, 0xFC, 0xF0, 0xF0, 0x30, 0x30, 0x3F, 0x3F, 0x3F, 0x3F, 0x30, 0x30, 0x3C, 0x3C,
+	0x0F, 0x0F, 0x03, 0x03, 0x03, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0xC3, 0xC3, 0xF3, 0xF3, 0x03, 0x03,
+	0x0F, 0x0F, 0x30, 0x30, 0x3F, 0x3F, 0x3F, 0x3F, 0x30, 0x30, 0x33, 0x33, 0x30, 0x30, 0x3C, 0x3C,
+	0x03, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0xC3, 0xC3, 0xF3, 0xF3, 0x03, 0x03, 0x0F, 0x0F, 0x30, 0x30,
+	0x3F, 0x3F, 0x3F, 0x3F, 0x30, 0x30, 0x03, 0x03, 0x00, 0x00, 0x00, 0x00, 0xF0, 0xF0, 0xFC, 0xFC,
+	0x0F, 0x0F, 0x03, 0x03, 0x03, 0x03, 0x0F, 0x0F, 0x0C, 0x0C, 0x03, 0x03, 0x0F, 0x0F, 0x3C, 0x3C,
+	0x30, 0x30, 0x33, 0x33, 0x3F, 0x3F, 0x3F, 0x3F, 0xFF, 0xFF, 0xFF, 0xFF, 0xC0, 0xC0, 0xC0, 0xC0,
+	0xFF, 0xFF, 0xFF, 0xFF, 0x3F, 0x3F, 0x3F, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x3F, 0x3F, 0x3F, 0x3F,
+	0x03, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0x03, 0x03, 0x30, 0x30, 0x3F, 0x3F, 0x3F, 0x3F, 0x30, 0x30,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0x03, 0x03, 0x0F, 0x0F,
+	0x3F, 0x3F, 0x30, 0x30, 0x30, 0x30, 0x3F, 0x3F, 0x0F, 0x0F, 0x00, 0x00, 0x03, 0x03, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xC0, 0xC0, 0xF0, 0xF0, 0x3F, 0x3F, 0x0F, 0x0F, 0x30, 0x30, 0x3F, 0x3F, 0x3F, 0x3F,
+	0x00, 0x00, 0x03, 0x03, 0x3F, 0x3F, 0x3C, 0x3C, 0x03, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0x03, 0x03,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x30, 0x3F, 0x3F, 0x3F, 0x3F, 0x30, 0x30, 0x30, 0x30,
+	0x3C, 0x3C, 0x3F, 0x3F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFC, 0xFC, 0xF0, 0xF0, 0xFC, 0xFC, 0xFF, 0xFF,
+	0xFF, 0xFF, 0x3F, 0x3F, 0x3F, 0x3F, 0x00, 0x00, 0x03, 0x03, 0x00, 0x00, 0x3F, 0x3F, 0x3F, 0x3F,
+	0xFF, 0xFF, 0xFF, 0xFF, 0x3C, 0x3C, 0xF0, 0xF0, 0xC0, 0xC0, 0xFF, 0xFF, 0xFF, 0xFF, 0x3F, 0x3F,
+	0x3F, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x03, 0x03, 0x3F, 0x3F, 0x3F, 0x3F, 0xF0, 0xF0, 0xFC, 0xFC,
+	0x0F, 0x0F, 0x03, 0x03, 0x0F, 0x0F, 0xFC, 0xFC, 0xF0, 0xF0, 0x03, 0x03, 0x0F, 0x0F, 0x3C, 0x3C,
+	0x30, 0x30, 0x3C, 0x3C, 0x0F, 0x0F, 0x03, 0x03, 0x03, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0xC3, 0xC3,
+	0xC3, 0xC3, 0xFF, 0xFF, 0x3C, 0x3C, 0x30, 0x30, 0x3F, 0x3F, 0x3F, 0x3F, 0x30, 0x30, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xFC, 0xFC, 0xFF, 0xFF, 0x03, 0x03, 0x03, 0x03, 0xFF, 0xFF, 0xFC, 0xFC,
+	0x03, 0x03, 0x0F, 0x0F, 0x0C, 0x0C, 0x3F, 0x3F, 0x3F, 0x3F, 0x33, 0x33, 0x03, 0x03, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xC3, 0xC3, 0xC3, 0xC3, 0xFF, 0xFF, 0x3C, 0x3C, 0x30, 0x30, 0x3F, 0x3F, 0x3F, 0x3F,
+	0x00, 0x00, 0x03, 0x03, 0x3F, 0x3F, 0x3C, 0x3C, 0x3C, 0x3C, 0xFF, 0xFF, 0xF3, 0xF3, 0xC3, 0xC3,
+	0x0F, 0x0F, 0x0C, 0x0C, 0x0C, 0x0C, 0x3C, 0x3C, 0x30, 0x30, 0x33, 0x33, 0x3F, 0x3F, 0x0F, 0x0F,
+	0x0F, 0x0F, 0x03, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0x03, 0x03, 0x0F, 0x0F, 0x00, 0x00, 0x30, 0x30,
+	0x3F, 0x3F, 0x3F, 0x3F, 0x30, 0x30, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00,
+	0xFF, 0xFF, 0xFF, 0xFF, 0x3F, 0x3F, 0x3F, 0x3F, 0x30, 0x30, 0x30, 0x30, 0x3F, 0x3F, 0x3F, 0x3F,
+	0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x03, 0x03, 0x0F, 0x0F,
+	0x3C, 0x3C, 0x3C, 0x3C, 0x0F, 0x0F, 0x03, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0xC0, 0xC0,
+	0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x3F, 0x3F, 0x3F, 0x3F, 0x0F, 0x0F, 0x03, 0x03, 0x0F, 0x0F,
+	0x3F, 0x3F, 0x3F, 0x3F, 0x0F, 0x0F, 0x3F, 0x3F, 0xF0, 0xF0, 0xC0, 0xC0, 0xF0, 0xF0, 0x3F, 0x3F,
+	0x0F, 0x0F, 0x30, 0x30, 0x3C, 0x3C, 0x0F, 0x0F, 0x03, 0x03, 0x0F, 0x0F, 0x3C, 0x3C, 0x30, 0x30,
+	0x3F, 0x3F, 0xFF, 0xFF, 0xC0, 0xC0, 0xC0, 0xC0, 0xFF, 0xFF, 0x3F, 0x3F, 0x00, 0x00, 0x30, 0x30,
+	0x3F, 0x3F, 0x3F, 0x3F, 0x30, 0x30, 0x00, 0x00, 0x3F, 0x3F, 0x0F, 0x0F, 0x03, 0x03, 0xC3, 0xC3,
+	0xF3, 0xF3, 0x3F, 0x3F, 0x0F, 0x0F, 0x30, 0x30, 0x3C, 0x3C, 0x3F, 0x3F, 0x33, 0x33, 0x30, 0x30,
+	0x3C, 0x3C, 0x3F, 0x3F, 0xFF, 0xFF, 0xFF, 0xFF, 0x03, 0x03, 0x03, 0x03, 0x3F, 0x3F, 0x3F, 0x3F,
+	0x30, 0x30, 0x30, 0x30, 0x03, 0x03, 0x0F, 0x0F, 0x3C, 0x3C, 0xF0, 0xF0, 0xC0, 0xC0, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x03, 0x0F, 0x0F, 0x3C, 0x3C,
+	0x03, 0x03, 0x03, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0x30, 0x30, 0x30, 0x30, 0x3F, 0x3F, 0x3F, 0x3F,
+	0xC0, 0xC0, 0xF0, 0xF0, 0x3C, 0x3C, 0x0F, 0x0F, 0x3C, 0x3C, 0xF0, 0xF0, 0xC0, 0xC0, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xC0,
+	0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x0F, 0x0F, 0x3F, 0x3F,
+	0x30, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+	0xF0, 0xF0, 0xC0, 0xC0, 0x00, 0x00, 0x0C, 0x0C, 0x3F, 0x3F, 0x33, 0x33, 0x33, 0x33, 0x0F, 0x0F,
+	0x3F, 0x3F, 0x30, 0x30, 0x03, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+	0x00, 0x00, 0x30, 0x30, 0x3F, 0x3F, 0x0F, 0x0F, 0x30, 0x30, 0x30, 0x30, 0x3F, 0x3F, 0x0F, 0x0F,
+	0xC0, 0xC0, 0xF0, 0xF0, 0x30, 0x30, 0x30, 0x30, 0xF0, 0xF0, 0xC0, 0xC0, 0x0F, 0x0F, 0x3F, 0x3F,
+	0x30, 0x30, 0x30, 0x30, 0x3C, 0x3C, 0x0C, 0x0C, 0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xC0, 0xC3, 0xC3,
+	0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x0F, 0x0F, 0x3F, 0x3F, 0x30, 0x30, 0x30, 0x30, 0x0F, 0x0F,
+	0x3F, 0x3F, 0x30, 0x30, 0xC0, 0xC0, 0xF0, 0xF0, 0x30, 0x30, 0x30, 0x30, 0xF0, 0xF0, 0xC0, 0xC0,
+	0x0F, 0x0F, 0x3F, 0x3F, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x03, 0x03, 0xC0, 0xC0, 0xFC, 0xFC,
+	0xFF, 0xFF, 0xC3, 0xC3, 0x0F, 0x0F, 0x0C, 0x0C, 0x30, 0x30, 0x3F, 0x3F, 0x3F, 0x3F, 0x30, 0x30,
+	0x00, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0xF0, 0xF0, 0x30, 0x30, 0x30, 0x30, 0xC0, 0xC0, 0xF0, 0xF0,
+	0x30, 0x30, 0xC3, 0xC3, 0xCF, 0xCF, 0xCC, 0xCC, 0xCC, 0xCC, 0xFF, 0xFF, 0x3F, 0x3F, 0x00, 0x00,
+	0x03, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0xC0, 0xC0, 0x30, 0x30, 0xF0, 0xF0, 0xC0, 0xC0, 0x30, 0x30,
+	0x3F, 0x3F, 0x3F, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x3F, 0x3F, 0x3F, 0x3F, 0x30, 0x30, 0xF3, 0xF3,
+	0xF3, 0xF3, 0x00, 0x00, 0x30, 0x30, 0x3F, 0x3F, 0x3F, 0x3F, 0x30, 0x30, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xF3, 0xF3, 0xF3, 0xF3, 0x3C, 0x3C, 0xFC, 0xFC, 0xC0, 0xC0, 0xC0, 0xC0,
+	0xFF, 0xFF, 0x3F, 0x3F, 0x03, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0xC0, 0xC0, 0xF0, 0xF0,
+	0x30, 0x30, 0x30, 0x30, 0x3F, 0x3F, 0x3F, 0x3F, 0x03, 0x03, 0x0F, 0x0F, 0x3C, 0x3C, 0x30, 0x30,
+	0x03, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x30, 0x30, 0x3F, 0x3F, 0x3F, 0x3F, 0x30, 0x30,
+	0xF0, 0xF0, 0xF0, 0xF0, 0xC0, 0xC0, 0xC0, 0xC0, 0xF0, 0xF0, 0xF0, 0xF0, 0xC0, 0xC0, 0x3F, 0x3F,
+	0x3F, 0x3F, 0x03, 0x03, 0x0F, 0x0F, 0x03, 0x03, 0x3F, 0x3F, 0x3F, 0x3F, 0xF0, 0xF0, 0xF0, 0xF0,
+	0x30, 0x30, 0x30, 0x30, 0xF0, 0xF0, 0xC0, 0xC0, 0x3F, 0x3F, 0x3F, 0x3F, 0x00, 0x00, 0x00, 0x00,
+	0x3F, 0x3F, 0x3F, 0x3F, 0xC0, 0xC0, 0xF0, 0xF0, 0x30, 0x30, 0x30, 0x30, 0xF0, 0xF0, 0xC0, 0xC0,
+	0x0F, 0x0F, 0x3F, 0x3F, 0x30, 0x30, 0x30, 0x30, 0x3F, 0x3F, 0x0F, 0x0F, 0x30, 0x30, 0xF0, 0xF0,
+	0xC0, 0xC0, 0x30, 0x30, 0x30, 0x30, 0xF0, 0xF0, 0xC0, 0xC0, 0xC0, 0xC0, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xCC, 0xCC, 0x0C, 0x0C, 0x0F, 0x0F, 0x03, 0x03, 0xC0, 0xC0, 0xF0, 0xF0, 0x30, 0x30, 0x30, 0x30,
+	0xC0, 0xC0, 0xF0, 0xF0, 0x30, 0x30, 0x03, 0x03, 0x0F, 0x0F, 0x0C, 0x0C, 0xCC, 0xCC, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xC0, 0xC0, 0x30, 0x30, 0xF0, 0xF0, 0xC0, 0xC0, 0xF0, 0xF0, 0x30, 0x30, 0xF0, 0xF0,
+	0xC0, 0xC0, 0x30, 0x30, 0x3F, 0x3F, 0x3F, 0x3F, 0x30, 0x30, 0x00, 0x00, 0x03, 0x03, 0x03, 0x03,
+	0xC0, 0xC0, 0xF0, 0xF0, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x33, 0x33,
+	0x33, 0x33, 0x33, 0x33, 0x3F, 0x3F, 0x0C, 0x0C, 0x30, 0x30, 0xFC, 0xFC, 0xFF, 0xFF, 0x30, 0x30,
+	0x30, 0x30, 0x00, 0x00, 0x0F, 0x0F, 0x3F, 0x3F, 0x30, 0x30, 0x0C, 0x0C, 0xF0, 0xF0, 0xF0, 0xF0,
+	0x00, 0x00, 0x00, 0x00, 0xF0, 0xF0, 0xF0, 0xF0, 0x00, 0x00, 0x0F, 0x0F, 0x3F, 0x3F, 0x30, 0x30,
+	0x30, 0x30, 0x0F, 0x0F, 0x3F, 0x3F, 0x30, 0x30, 0xF0, 0xF0, 0xF0, 0xF0, 0x00, 0x00, 0x00, 0x00,
+	0xF0, 0xF0, 0xF0, 0xF0, 0x03, 0x03, 0x0F, 0x0F, 0x3C, 0x3C, 0x3C, 0x3C, 0x0F, 0x0F, 0x03, 0x03,
+	0xF0, 0xF0, 0xF0, 0xF0, 0x00, 0x00, 0xC0, 0xC0, 0x00, 0x00, 0xF0, 0xF0, 0xF0, 0xF0, 0x0F, 0x0F,
+	0x3F, 0x3F, 0x3F, 0x3F, 0x0F, 0x0F, 0x3F, 0x3F, 0x3F, 0x3F, 0x0F, 0x0F, 0x30, 0x30, 0xF0, 0xF0,
+	0xC0, 0xC0, 0x00, 0x00, 0xC0, 0xC0, 0xF0, 0xF0, 0x30, 0x30, 0x30, 0x30, 0x3C, 0x3C, 0x0F, 0x0F,
+	0x03, 0x03, 0x0F, 0x0F, 0x3C, 0x3C, 0x30, 0x30, 0xF0, 0xF0, 0xF0, 0xF0, 0x00, 0x00, 0x00, 0x00,
+	0xF0, 0xF0, 0xF0, 0xF0, 0xC3, 0xC3, 0xCF, 0xCF, 0xCC, 0xCC, 0xCC, 0xCC, 0xFF, 0xFF, 0x3F, 0x3F,
+	0xF0, 0xF0, 0x30, 0x30, 0x30, 0x30, 0xF0, 0xF0, 0xF0, 0xF0, 0x30, 0x30, 0x30, 0x30, 0x3C, 0x3C,
+	0x3F, 0x3F, 0x33, 0x33, 0x30, 0x30, 0x3C, 0x3C, 0xC0, 0xC0, 0xC0, 0xC0, 0xFC, 0xFC, 0x3F, 0x3F,
+	0x03, 0x03, 0x03, 0x03, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x0F, 0x3F, 0x3F, 0x30, 0x30, 0x30, 0x30,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3F, 0x3F,
+	0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x03, 0x03, 0x03, 0x03,
+	0x3F, 0x3F, 0xFC, 0xFC, 0xC0, 0xC0, 0xC0, 0xC0, 0x30, 0x30, 0x30, 0x30, 0x3F, 0x3F, 0x0F, 0x0F,
+	0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x0F, 0x0F, 0x03, 0x03, 0x0F, 0x0F, 0x0C, 0x0C, 0x0F, 0x0F,
+	0x03, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0xF3, 0xF3, 0xF3, 0xF3, 0x00, 0x00, 0x0F, 0x0F, 0x3F, 0x3F, 0x3F, 0x3F, 0x0F, 0x0F,
+	0x3C, 0x3C, 0xC3, 0xC3, 0xC3, 0xC3, 0x3C, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0xC0, 0xC0, 0xF3, 0xF3, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x0F, 0x3F, 0x3F,
+	0x30, 0x30, 0x30, 0x30, 0x3C, 0x3C, 0x0C, 0x0C, 0xC0, 0xC0, 0xC0, 0xC0, 0x30, 0x30, 0x3C, 0x3C,
+	0xCF, 0xCF, 0xC3, 0xC3, 0xFF, 0xFF, 0xFF, 0xFF, 0x0C, 0x0C, 0x0C, 0x0C, 0xFF, 0xFF, 0xFF, 0xFF,
+	0x30, 0x30, 0xF0, 0xF0, 0xF0, 0xF0, 0x3C, 0x3C, 0xFF, 0xFF, 0x33, 0x33, 0x30, 0x30, 0xC0, 0xC0,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xC3, 0xC3, 0xCF, 0xCF, 0xC0, 0xC0, 0xF0, 0xF0, 0x30, 0x30, 0xF0, 0xF0,
+	0xFC, 0xFC, 0x3F, 0x3F, 0x03, 0x03, 0xC0, 0xC0, 0xFF, 0xFF, 0xFF, 0xFF, 0xC0, 0xC0, 0x00, 0x00,
+	0xFC, 0xFC, 0xF3, 0xF3, 0xC3, 0xC3, 0xCC, 0xCC, 0x0F, 0x0F, 0xF0, 0xF0, 0xF0, 0xF0, 0xFF, 0xFF,
+	0xFF, 0xFF, 0x00, 0x00, 0x03, 0x03, 0x0F, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xC0, 0xC0, 0xC0, 0xC0,
+	0x30, 0x30, 0x3C, 0x3C, 0x3F, 0x3F, 0xC3, 0xC3, 0xC0, 0xC0, 0x0F, 0x0F, 0x3F, 0x3F, 0xF0, 0xF0,
+	0xC0, 0xC0, 0xF0, 0xF0, 0x3F, 0x3F, 0x0F, 0x0F, 0xF0, 0xF0, 0xF0, 0xF0, 0x00, 0x00, 0x0C, 0x0C,
+	0xFF, 0xFF, 0xF3, 0xF3, 0xFF, 0xFF, 0xFF, 0xFF, 0xC0, 0xC0, 0xC0, 0xC0, 0xFF, 0xFF, 0xFF, 0xFF,
+	0x00, 0x00, 0x30, 0x30, 0x30, 0x30, 0x3C, 0x3C, 0xFF, 0xFF, 0xC3, 0xC3, 0x00, 0x00, 0x0C, 0x0C,
+	0x3F, 0x3F, 0x33, 0x33, 0x33, 0x33, 0x0F, 0x0F, 0x3F, 0x3F, 0x30, 0x30, 0xC0, 0xC0, 0xF0, 0xF0,
+	0x30, 0x30, 0x3C, 0x3C, 0xFF, 0xFF, 0xC3, 0xC3, 0x0F, 0x0F, 0x3F, 0x3F, 0x33, 0x33, 0x33, 0x33,
+	0x33, 0x33, 0x03, 0x03, 0x30, 0x30, 0xF0, 0xF0, 0xFC, 0xFC, 0x0F, 0x0F, 0x03, 0x03, 0x30, 0x30,
+	0x3F, 0x3F, 0x3F, 0x3F, 0x30, 0x30, 0x00, 0x00, 0xFC, 0xFC, 0xF3, 0xF3, 0x33, 0x33, 0x3C, 0x3C,
+	0xFF, 0xFF, 0xC0, 0xC0, 0x3F, 0x3F, 0x3F, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x3F, 0x3F, 0x3F, 0x3F,
+	0xC0, 0xC0, 0xF0, 0xF0, 0x30, 0x30, 0x3C, 0x3C, 0xFF, 0xFF, 0xC3, 0xC3, 0x0F, 0x0F, 0x3F, 0x3F,
+	0x30, 0x30, 0x30, 0x30, 0x3F, 0x3F, 0x0F, 0x0F, 0xF0, 0xF0, 0xF0, 0xF0, 0x00, 0x00, 0x0C, 0x0C,
+	0xFF, 0xFF, 0xF3, 0xF3, 0x00, 0x00, 0x0F, 0x0F, 0x3F, 0x3F, 0x30, 0x30, 0x30, 0x30, 0x0F, 0x0F,
+	0x3F, 0x3F, 0x30, 0x30, 0xF0, 0xF0, 0xF3, 0xF3, 0x03, 0x03, 0x00, 0x00, 0xF3, 0xF3, 0xF3, 0xF3,
+	0x00, 0x00, 0x0F, 0x0F, 0x3F, 0x3F, 0x30, 0x30, 0x30, 0x30, 0x0F, 0x0F, 0x3F, 0x3F, 0x30, 0x30,
+};
+
+static const uint16_t medium_offset[111] = {
+	0, 12, 28, 48, 76, 100, 128, 156, 168, 184, 200, 232,
+	256, 268, 292, 300, 328, 356, 380, 404, 428, 456, 480, 504,
+	528, 552, 576, 584, 596, 616, 640, 660, 684, 712, 736, 764,
+	792, 820, 848, 876, 904, 928, 944, 972, 1000, 1028, 1056, 1084,
+	1112, 1140, 1164, 1192, 1216, 1240, 1264, 1288, 1316, 1344, 1368, 1396,
+	1412, 1440, 1456, 1484, 1516, 1528, 1556, 1584, 1608, 1636, 1660, 1684,
+	1712, 1740, 1756, 1780, 1808, 1824, 1852, 1876, 1900, 1928, 1956, 1984,
+	2008, 2028, 2056, 2080, 2108, 2136, 2160, 2184, 2208, 2236, 2260, 2288,
+	2304, 2320, 2344, 2368, 2396, 2416, 2444, 2472, 2496, 2524, 2548, 2568,
+	2592, 2616, 2644,
+};
+
+static const uint8_t medium_width[111] = {
+	6, 8, 10, 14, 12, 14, 14, 6, 8, 8, 16, 12, 6, 12, 4, 14,
+	14, 12, 12, 12, 14, 12, 12, 12, 12, 12, 4, 6, 10, 12, 10, 12,
+	14, 12, 14, 14, 14, 14, 14, 14, 12, 8, 14, 14, 14, 14, 14, 14,
+	14, 12, 14, 12, 12, 12, 12, 14, 14, 12, 14, 8, 14, 8, 14, 16,
+	6, 14, 14, 12, 14, 12, 12, 14, 14, 8, 12, 14, 8, 14, 12, 12,
+	14, 14, 14, 12, 10, 14, 12, 14, 14, 12, 12, 12, 14, 12, 14, 8,
+	8, 12, 12, 14, 10, 14, 14, 12, 14, 12, 10, 12, 12, 14, 14,
+};
+
+const ssd1306_font_t ssd1306_font_medium = {
+	.pages = 2,
+	.spacing = 2,
+	.first = 0x20,
+	.last = 0x7E,
+	.extra_codes = extra_codes,
+	.extra_count = 16,
+	.offset = medium_offset,
+	.width = medium_width,
+	.data = medium_data,
+};
+
+static const uint8_t large_data[6012] = {
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF8, 0xF8, 0xF8, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xF8, 0xF8, 0xF8, 0x01, 0x01, 0x01, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F,
+	0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x00, 0x00, 0x00, 0x3F,
+	0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x00, 0x00, 0x00, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xC0, 0xC0, 0xC0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xC0, 0xC0,
+	0xC0, 0x71, 0x71, 0x71, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x71, 0x71, 0x71, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0x71, 0x71, 0x71, 0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x00,
+	0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xF8, 0xF8,
+	0xF8, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x81, 0x81, 0x81,
+	0x8F, 0x8F, 0x8F, 0x8E, 0x8E, 0x8E, 0x8E, 0x8E, 0x8E, 0xFE, 0xFE, 0xFE, 0x70, 0x70, 0x70, 0x03,
+	0x03, 0x03, 0x03, 0x03, 0x03, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x03, 0x03, 0x03, 0x00, 0x00,
+	0x00, 0xF8, 0xF8, 0xF8, 0xF8, 0xF8, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0xC0,
+	0xF8, 0xF8, 0xF8, 0x38, 0x38, 0x38, 0x01, 0x01, 0x01, 0x81, 0x81, 0x81, 0xF0, 0xF0, 0xF0, 0x7E,
+	0x7E, 0x7E, 0x0F, 0x0F, 0x0F, 0x81, 0x81, 0x81, 0x80, 0x80, 0x80, 0x1C, 0x1C, 0x1C, 0x1F, 0x1F,
+	0x1F, 0x03, 0x03, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F,
+	0x00, 0x00, 0x00, 0x38, 0x38, 0x38, 0xFF, 0xFF, 0xFF, 0xC7, 0xC7, 0xC7, 0xFF, 0xFF, 0xFF, 0x38,
+	0x38, 0x38, 0x00, 0x00, 0x00, 0xF0, 0xF0, 0xF0, 0xFE, 0xFE, 0xFE, 0x0F, 0x0F, 0x0F, 0x7F, 0x7F,
+	0x7F, 0xF1, 0xF1, 0xF1, 0xFE, 0xFE, 0xFE, 0x0E, 0x0E, 0x0E, 0x03, 0x03, 0x03, 0x1F, 0x1F, 0x1F,
+	0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x03, 0x03, 0x03, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0xC0,
+	0xC0, 0xC0, 0xFF, 0xFF, 0xFF, 0x3F, 0x3F, 0x3F, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xF8, 0xF8, 0xF8,
+	0x3F, 0x3F, 0x3F, 0x07, 0x07, 0x07, 0x7F, 0x7F, 0x7F, 0xFF, 0xFF, 0xFF, 0x80, 0x80, 0x80, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x03, 0x03, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0x07, 0x07,
+	0x07, 0x3F, 0x3F, 0x3F, 0xF8, 0xF8, 0xF8, 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0x80, 0x80, 0x80,
+	0xFF, 0xFF, 0xFF, 0x7F, 0x7F, 0x7F, 0x1C, 0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x03, 0x03, 0x03, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x38, 0x38, 0x38, 0xF8, 0xF8, 0xF8, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+	0xC0, 0xF8, 0xF8, 0xF8, 0x38, 0x38, 0x38, 0x00, 0x00, 0x00, 0x0E, 0x0E, 0x0E, 0x8E, 0x8E, 0x8E,
+	0xFF, 0xFF, 0xFF, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0xFF, 0xFF, 0xFF, 0x8E, 0x8E, 0x8E, 0x0E,
+	0x0E, 0x0E, 0x00, 0x00, 0x00, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xF8, 0xF8, 0xF8, 0xF8, 0xF8, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0E, 0x0E, 0x0E, 0x0E,
+	0x0E, 0x0E, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x80, 0x80, 0x80,
+	0x80, 0x80, 0xE0, 0xE0, 0xE0, 0xFF, 0xFF, 0xFF, 0x1F, 0x1F, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0E, 0x0E, 0x0E,
+	0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x1F, 0x1F, 0x1F,
+	0x1F, 0x1F, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xF8,
+	0xF8, 0xF8, 0x3F, 0x3F, 0x3F, 0x07, 0x07, 0x07, 0x80, 0x80, 0x80, 0xF0, 0xF0, 0xF0, 0x7E, 0x7E,
+	0x7E, 0x0F, 0x0F, 0x0F, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F,
+	0x03, 0x03, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0xF8, 0xF8, 0xF8, 0xFF, 0xFF, 0xFF, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0xC7, 0xC7,
+	0xC7, 0xFF, 0xFF, 0xFF, 0xF8, 0xF8, 0xF8, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0, 0xF0, 0xF0,
+	0x7E, 0x7E, 0x7E, 0x0F, 0x0F, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x03, 0x03, 0x03, 0x1F,
+	0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x03, 0x03,
+	0x03, 0x00, 0x00, 0x00, 0x38, 0x38, 0x38, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F,
+	0x1F, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x38, 0x38, 0x38, 0x3F, 0x3F, 0x3F, 0x07, 0x07, 0x07,
+	0x07, 0x07, 0x07, 0xFF, 0xFF, 0xFF, 0xF8, 0xF8, 0xF8, 0x80, 0x80, 0x80, 0xF0, 0xF0, 0xF0, 0x7E,
+	0x7E, 0x7E, 0x0E, 0x0E, 0x0E, 0x8F, 0x8F, 0x8F, 0x81, 0x81, 0x81, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F,
+	0x1F, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x38, 0x38, 0x38,
+	0x3F, 0x3F, 0x3F, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0xFF, 0xFF, 0xFF, 0xF8, 0xF8, 0xF8, 0x80,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0xFF, 0xFF, 0xFF, 0xF1, 0xF1,
+	0xF1, 0x03, 0x03, 0x03, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1F, 0x1F, 0x1F,
+	0x03, 0x03, 0x03, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xF8, 0xF8, 0xF8, 0x3F, 0x3F, 0x3F, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x7E, 0x7E, 0x7E, 0x7F, 0x7F, 0x7F, 0x71, 0x71,
+	0x71, 0x70, 0x70, 0x70, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x70, 0x70, 0x70, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1C, 0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1C,
+	0x1C, 0x1C, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xC7, 0xC7, 0xC7, 0xC7, 0xC7, 0xC7, 0xC7, 0xC7,
+	0xC7, 0x07, 0x07, 0x07, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+	0xFF, 0xFF, 0xFF, 0xFE, 0xFE, 0xFE, 0x03, 0x03, 0x03, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0x1C,
+	0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x03, 0x03, 0x03, 0xC0, 0xC0, 0xC0, 0xF8, 0xF8, 0xF8, 0x3F, 0x3F,
+	0x3F, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0xFE, 0xFE, 0xFE, 0xF0, 0xF0, 0xF0, 0x03, 0x03, 0x03, 0x1F,
+	0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x03, 0x03, 0x03, 0x3F, 0x3F,
+	0x3F, 0x3F, 0x3F, 0x3F, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0xF0, 0xF0, 0xFE, 0xFE, 0xFE, 0x0F, 0x0F, 0x0F, 0x01,
+	0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xF8, 0xF8, 0xF8, 0xFF, 0xFF, 0xFF, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07,
+	0xFF, 0xFF, 0xFF, 0xF8, 0xF8, 0xF8, 0xF1, 0xF1, 0xF1, 0xFF, 0xFF, 0xFF, 0x0E, 0x0E, 0x0E, 0x0E,
+	0x0E, 0x0E, 0xFF, 0xFF, 0xFF, 0xF1, 0xF1, 0xF1, 0x03, 0x03, 0x03, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C,
+	0x1C, 0x1C, 0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x03, 0x03, 0x03, 0xF8, 0xF8, 0xF8, 0xFF, 0xFF, 0xFF,
+	0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0xFF, 0xFF, 0xFF, 0xF8, 0xF8, 0xF8, 0x01, 0x01, 0x01, 0x0F,
+	0x0F, 0x0F, 0x0E, 0x0E, 0x0E, 0x8E, 0x8E, 0x8E, 0xFF, 0xFF, 0xFF, 0x7F, 0x7F, 0x7F, 0x00, 0x00,
+	0x00, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x03, 0x03, 0x03, 0x00, 0x00, 0x00,
+	0xF8, 0xF8, 0xF8, 0xF8, 0xF8, 0xF8, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x1F, 0x1F, 0x1F, 0x1F,
+	0x1F, 0x1F, 0x00, 0x00, 0x00, 0xF8, 0xF8, 0xF8, 0xF8, 0xF8, 0xF8, 0x00, 0x00, 0x00, 0x81, 0x81,
+	0x81, 0x81, 0x81, 0x81, 0xE0, 0xE0, 0xE0, 0xFF, 0xFF, 0xFF, 0x1F, 0x1F, 0x1F, 0x00, 0x00, 0x00,
+	0xC0, 0xC0, 0xC0, 0xF8, 0xF8, 0xF8, 0x3F, 0x3F, 0x3F, 0x07, 0x07, 0x07, 0x0E, 0x0E, 0x0E, 0x7F,
+	0x7F, 0x7F, 0xF1, 0xF1, 0xF1, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x03, 0x03, 0x03, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+	0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x81, 0x81, 0x81, 0x81,
+	0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x03, 0x03,
+	0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+	0x07, 0x07, 0x07, 0x3F, 0x3F, 0x3F, 0xF8, 0xF8, 0xF8, 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x80, 0x80, 0x80, 0xF1, 0xF1, 0xF1, 0x7F, 0x7F, 0x7F, 0x0E, 0x0E, 0x0E, 0x1C, 0x1C,
+	0x1C, 0x1F, 0x1F, 0x1F, 0x03, 0x03, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x38, 0x38, 0x38,
+	0x3F, 0x3F, 0x3F, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0xFF, 0xFF, 0xFF, 0xF8, 0xF8, 0xF8, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x70, 0x70, 0x70, 0x7E, 0x7E, 0x7E, 0x0F, 0x0F, 0x0F, 0x01, 0x01,
+	0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0xF8, 0xF8, 0xF8, 0xFF, 0xFF, 0xFF, 0x07, 0x07, 0x07, 0xC7, 0xC7, 0xC7, 0xC7,
+	0xC7, 0xC7, 0xFF, 0xFF, 0xFF, 0xF8, 0xF8, 0xF8, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00,
+	0x00, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x03, 0x03, 0x03,
+	0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xF8, 0xF8, 0xF8, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0xF8, 0xF8,
+	0xF8, 0xC0, 0xC0, 0xC0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x07, 0x07, 0x07, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0xFF, 0xFF, 0xFF, 0xF8, 0xF8, 0xF8, 0x00, 0x00, 0x00,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0xFF, 0xFF, 0xFF, 0xF1,
+	0xF1, 0xF1, 0x1C, 0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C,
+	0x1C, 0x1F, 0x1F, 0x1F, 0x03, 0x03, 0x03, 0xC0, 0xC0, 0xC0, 0xF8, 0xF8, 0xF8, 0x3F, 0x3F, 0x3F,
+	0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x3F, 0x3F, 0x3F, 0x38, 0x38, 0x38, 0x7F, 0x7F, 0x7F, 0xFF,
+	0xFF, 0xFF, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x80, 0x00, 0x00, 0x00, 0x03, 0x03, 0x03, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C,
+	0x1F, 0x1F, 0x1F, 0x03, 0x03, 0x03, 0x07, 0x07, 0x07, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x07,
+	0x07, 0x07, 0x3F, 0x3F, 0x3F, 0xF8, 0xF8, 0xF8, 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x80, 0x80, 0x80, 0xFF, 0xFF, 0xFF, 0x7F, 0x7F, 0x7F,
+	0x1C, 0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x03,
+	0x03, 0x03, 0x00, 0x00, 0x00, 0x07, 0x07, 0x07, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x07, 0x07,
+	0x07, 0xC7, 0xC7, 0xC7, 0x07, 0x07, 0x07, 0x3F, 0x3F, 0x3F, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0x0E, 0x0E, 0x0E, 0x7F, 0x7F, 0x7F, 0x00, 0x00, 0x00, 0x80, 0x80, 0x80, 0x1C,
+	0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C,
+	0x1C, 0x1F, 0x1F, 0x1F, 0x07, 0x07, 0x07, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x07, 0x07, 0x07,
+	0xC7, 0xC7, 0xC7, 0x07, 0x07, 0x07, 0x3F, 0x3F, 0x3F, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0x0E, 0x0E, 0x0E, 0x7F, 0x7F, 0x7F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1C, 0x1C,
+	0x1C, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xF8, 0xF8, 0xF8, 0x3F, 0x3F, 0x3F, 0x07, 0x07, 0x07, 0x07,
+	0x07, 0x07, 0x3F, 0x3F, 0x3F, 0x38, 0x38, 0x38, 0x7F, 0x7F, 0x7F, 0xFF, 0xFF, 0xFF, 0x80, 0x80,
+	0x80, 0x00, 0x00, 0x00, 0x70, 0x70, 0x70, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0x00, 0x00, 0x00,
+	0x03, 0x03, 0x03, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x1F,
+	0x1F, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x07, 0x07, 0x07, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x07, 0x07, 0x07, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00,
+	0x1C, 0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0x07, 0x07, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x07, 0x07,
+	0x07, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x03, 0x03, 0x03, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0x1C,
+	0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x03, 0x03, 0x03, 0x00, 0x00, 0x00, 0x07, 0x07, 0x07, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xFF, 0xFF, 0xFF, 0x3F, 0x3F, 0x3F,
+	0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x0E, 0x0E, 0x0E, 0x7F, 0x7F, 0x7F, 0xF1,
+	0xF1, 0xF1, 0x80, 0x80, 0x80, 0x1C, 0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x07, 0x07, 0x07, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0x07, 0x07, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x80,
+	0x80, 0xF0, 0xF0, 0xF0, 0x1C, 0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C,
+	0x1C, 0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF8,
+	0xF8, 0xF8, 0xC0, 0xC0, 0xC0, 0xF8, 0xF8, 0xF8, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0x0F, 0x0F, 0x0F, 0x7F, 0x7F, 0x7F, 0x0F, 0x0F, 0x0F, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF8, 0xF8,
+	0xF8, 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0x01, 0x01, 0x01, 0x0F, 0x0F, 0x0F, 0x7E, 0x7E, 0x7E, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0xC0, 0xC0, 0xC0, 0xF8, 0xF8, 0xF8, 0x3F, 0x3F, 0x3F,
+	0x07, 0x07, 0x07, 0x3F, 0x3F, 0x3F, 0xF8, 0xF8, 0xF8, 0xC0, 0xC0, 0xC0, 0x7F, 0x7F, 0x7F, 0xFF,
+	0xFF, 0xFF, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x80, 0x80, 0x80, 0xFF, 0xFF, 0xFF, 0x7F, 0x7F,
+	0x7F, 0x00, 0x00, 0x00, 0x03, 0x03, 0x03, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0x1F, 0x1F, 0x1F,
+	0x03, 0x03, 0x03, 0x00, 0x00, 0x00, 0x07, 0x07, 0x07, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x07,
+	0x07, 0x07, 0x07, 0x07, 0x07, 0xFF, 0xFF, 0xFF, 0xF8, 0xF8, 0xF8, 0x00, 0x00, 0x00, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0F, 0x0F, 0x0F, 0x01, 0x01, 0x01,
+	0x1C, 0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0xF8, 0xF8, 0xF8, 0xFF, 0xFF, 0xFF, 0x07, 0x07, 0x07, 0x07, 0x07,
+	0x07, 0xFF, 0xFF, 0xFF, 0xF8, 0xF8, 0xF8, 0x7F, 0x7F, 0x7F, 0xFF, 0xFF, 0xFF, 0x80, 0x80, 0x80,
+	0xF0, 0xF0, 0xF0, 0xFF, 0xFF, 0xFF, 0x7F, 0x7F, 0x7F, 0x00, 0x00, 0x00, 0x03, 0x03, 0x03, 0x03,
+	0x03, 0x03, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0x07, 0x07, 0x07, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0xFF, 0xFF, 0xFF, 0xF8, 0xF8, 0xF8,
+	0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x0E, 0x0E, 0x0E, 0x7E, 0x7E, 0x7E, 0xFF,
+	0xFF, 0xFF, 0x81, 0x81, 0x81, 0x1C, 0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0xF8, 0xF8, 0xF8, 0xFF, 0xFF, 0xFF,
+	0xC7, 0xC7, 0xC7, 0x07, 0x07, 0x07, 0x3F, 0x3F, 0x3F, 0x38, 0x38, 0x38, 0x81, 0x81, 0x81, 0x8F,
+	0x8F, 0x8F, 0x0F, 0x0F, 0x0F, 0x7E, 0x7E, 0x7E, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0x03, 0x03,
+	0x03, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x03, 0x03, 0x03,
+	0x3F, 0x3F, 0x3F, 0x07, 0x07, 0x07, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x07, 0x07, 0x07, 0x3F,
+	0x3F, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1C, 0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F,
+	0x1C, 0x1C, 0x1C, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F,
+	0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x7F, 0x7F,
+	0x7F, 0xFF, 0xFF, 0xFF, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0xFF, 0xFF, 0xFF, 0x7F, 0x7F, 0x7F,
+	0x00, 0x00, 0x00, 0x03, 0x03, 0x03, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x03, 0x03, 0x03, 0x00,
+	0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0, 0xF0, 0xF0,
+	0x7E, 0x7E, 0x7E, 0xF0, 0xF0, 0xF0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x1F, 0x1F, 0x1F, 0x1F,
+	0x1F, 0x1F, 0x03, 0x03, 0x03, 0x00, 0x00, 0x00, 0x03, 0x03, 0x03, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F,
+	0x1F, 0x3F, 0x3F, 0x3F, 0xFF, 0xFF, 0xFF, 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0xC0,
+	0xFF, 0xFF, 0xFF, 0x3F, 0x3F, 0x3F, 0x00, 0x00, 0x00, 0x81, 0x81, 0x81, 0xFF, 0xFF, 0xFF, 0x7E,
+	0x7E, 0x7E, 0xFF, 0xFF, 0xFF, 0x81, 0x81, 0x81, 0x00, 0x00, 0x00, 0x1C, 0x1C, 0x1C, 0x1F, 0x1F,
+	0x1F, 0x03, 0x03, 0x03, 0x00, 0x00, 0x00, 0x03, 0x03, 0x03, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0x01, 0x01, 0x01, 0x0F, 0x0F, 0x0F, 0xFE, 0xFE, 0xFE, 0xFE, 0xFE, 0xFE, 0x0F, 0x0F,
+	0x0F, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x1C, 0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F,
+	0x1C, 0x1C, 0x1C, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0x3F, 0x3F, 0x3F, 0x07, 0x07, 0x07, 0x07,
+	0x07, 0x07, 0xC7, 0xC7, 0xC7, 0xFF, 0xFF, 0xFF, 0x3F, 0x3F, 0x3F, 0x01, 0x01, 0x01, 0x80, 0x80,
+	0x80, 0xF0, 0xF0, 0xF0, 0x7E, 0x7E, 0x7E, 0x0F, 0x0F, 0x0F, 0x81, 0x81, 0x81, 0xF0, 0xF0, 0xF0,
+	0x1C, 0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1F,
+	0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x07, 0x07, 0x07, 0x07, 0x07,
+	0x07, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F,
+	0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x07, 0x07, 0x07, 0x3F, 0x3F, 0x3F, 0xF8,
+	0xF8, 0xF8, 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x0F, 0x0F, 0x0F, 0x7E, 0x7E, 0x7E, 0xF0, 0xF0, 0xF0,
+	0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x03, 0x03, 0x03, 0x1F, 0x1F, 0x1F, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x00, 0x00, 0x00, 0xC0,
+	0xC0, 0xC0, 0xF8, 0xF8, 0xF8, 0x3F, 0x3F, 0x3F, 0xF8, 0xF8, 0xF8, 0xC0, 0xC0, 0xC0, 0x00, 0x00,
+	0x00, 0x0E, 0x0E, 0x0E, 0x0F, 0x0F, 0x0F, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01,
+	0x0F, 0x0F, 0x0F, 0x0E, 0x0E, 0x0E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0,
+	0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0,
+	0xE0, 0xE0, 0xE0, 0x3F, 0x3F, 0x3F, 0xFF, 0xFF, 0xFF, 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0x01,
+	0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x80, 0x80, 0x80, 0xF1, 0xF1, 0xF1, 0x71, 0x71, 0x71, 0x71, 0x71, 0x71, 0xFF,
+	0xFF, 0xFF, 0xFE, 0xFE, 0xFE, 0x00, 0x00, 0x00, 0x03, 0x03, 0x03, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C,
+	0x1C, 0x1C, 0x1C, 0x1C, 0x03, 0x03, 0x03, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0x07, 0x07, 0x07,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E,
+	0x0E, 0xFE, 0xFE, 0xFE, 0xF0, 0xF0, 0xF0, 0x1C, 0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x03, 0x03, 0x03,
+	0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x03, 0x03, 0x03, 0x00, 0x00, 0x00, 0xC0,
+	0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0xFE, 0xFE,
+	0xFE, 0xFF, 0xFF, 0xFF, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x8F, 0x8F, 0x8F, 0x8E, 0x8E, 0x8E,
+	0x03, 0x03, 0x03, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x03,
+	0x03, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0x07, 0x07, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0xF0, 0xF0, 0xF0, 0xFE, 0xFE, 0xFE, 0x0E, 0x0E, 0x0E,
+	0x0E, 0x0E, 0x0E, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x03, 0x03, 0x03, 0x1F,
+	0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x03, 0x03, 0x03, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C,
+	0x1C, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+	0x00, 0x00, 0x00, 0xFE, 0xFE, 0xFE, 0xFF, 0xFF, 0xFF, 0x71, 0x71, 0x71, 0x71, 0x71, 0x71, 0x7F,
+	0x7F, 0x7F, 0x7E, 0x7E, 0x7E, 0x03, 0x03, 0x03, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C,
+	0x1C, 0x1C, 0x1C, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF8, 0xF8, 0xF8, 0xFF, 0xFF, 0xFF,
+	0x07, 0x07, 0x07, 0x3F, 0x3F, 0x3F, 0x38, 0x38, 0x38, 0x0E, 0x0E, 0x0E, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0x0E, 0x0E, 0x0E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1C, 0x1C, 0x1C, 0x1F, 0x1F,
+	0x1F, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xC0,
+	0xC0, 0xC0, 0x7E, 0x7E, 0x7E, 0xFF, 0xFF, 0xFF, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0xFE, 0xFE,
+	0xFE, 0xFF, 0xFF, 0xFF, 0x01, 0x01, 0x01, 0xE0, 0xE0, 0xE0, 0xE3, 0xE3, 0xE3, 0xE3, 0xE3, 0xE3,
+	0xE3, 0xE3, 0xE3, 0xFF, 0xFF, 0xFF, 0x1F, 0x1F, 0x1F, 0x00, 0x00, 0x00, 0x07, 0x07, 0x07, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x0E, 0x0E, 0x0E, 0x01, 0x01, 0x01,
+	0xFF, 0xFF, 0xFF, 0xFE, 0xFE, 0xFE, 0x1C, 0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0xC0, 0xC0, 0xC0, 0xC7, 0xC7,
+	0xC7, 0xC7, 0xC7, 0xC7, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0x00, 0x00, 0x00, 0x1C, 0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC7, 0xC7, 0xC7, 0xC7, 0xC7,
+	0xC7, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0x1F, 0x1F, 0x1F, 0xFF, 0xFF, 0xFF, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xFF,
+	0xFF, 0xFF, 0x1F, 0x1F, 0x1F, 0x07, 0x07, 0x07, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0x70, 0x70, 0x70, 0xFE, 0xFE, 0xFE, 0x8F, 0x8F, 0x8F, 0x01, 0x01, 0x01, 0x1C,
+	0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x00, 0x00, 0x00, 0x03, 0x03, 0x03, 0x1F, 0x1F,
+	0x1F, 0x1C, 0x1C, 0x1C, 0x07, 0x07, 0x07, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x1C, 0x1C, 0x1C, 0x1F,
+	0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0x7E, 0x7E, 0x7E, 0xFE, 0xFE, 0xFE, 0x7F, 0x7F, 0x7F, 0xFF, 0xFF, 0xFF, 0xFE,
+	0xFE, 0xFE, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x00, 0x00, 0x00, 0x03, 0x03, 0x03, 0x00, 0x00,
+	0x00, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+	0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01,
+	0x01, 0x01, 0x01, 0x01, 0x01, 0xFF, 0xFF, 0xFF, 0xFE, 0xFE, 0xFE, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F,
+	0x1F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x00, 0x00, 0x00,
+	0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0xFE,
+	0xFE, 0xFE, 0xFF, 0xFF, 0xFF, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0xFF, 0xFF, 0xFF, 0xFE, 0xFE,
+	0xFE, 0x03, 0x03, 0x03, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1F, 0x1F, 0x1F,
+	0x03, 0x03, 0x03, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xC0,
+	0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0xFF, 0xFF, 0xFF, 0xFE, 0xFE,
+	0xFE, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0xFF, 0xFF, 0xFF, 0x7E, 0x7E, 0x7E, 0xE0, 0xE0, 0xE0,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xE3, 0xE3, 0xE3, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x00, 0x00,
+	0x00, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x7E, 0x7E, 0x7E, 0xFF, 0xFF, 0xFF, 0x81, 0x81, 0x81,
+	0x81, 0x81, 0x81, 0xFE, 0xFE, 0xFE, 0xFF, 0xFF, 0xFF, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x03,
+	0x03, 0x03, 0x03, 0x03, 0x03, 0xE3, 0xE3, 0xE3, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xE0, 0xE0,
+	0xE0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+	0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0xFF, 0xFF, 0xFF, 0xFE, 0xFE, 0xFE, 0x0F,
+	0x0F, 0x0F, 0x01, 0x01, 0x01, 0x7F, 0x7F, 0x7F, 0x7E, 0x7E, 0x7E, 0x1C, 0x1C, 0x1C, 0x1F, 0x1F,
+	0x1F, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+	0xC0, 0xC0, 0x0E, 0x0E, 0x0E, 0x7F, 0x7F, 0x7F, 0x71, 0x71, 0x71, 0x71, 0x71, 0x71, 0xF1, 0xF1,
+	0xF1, 0x81, 0x81, 0x81, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C,
+	0x1F, 0x1F, 0x1F, 0x03, 0x03, 0x03, 0xC0, 0xC0, 0xC0, 0xF8, 0xF8, 0xF8, 0xFF, 0xFF, 0xFF, 0xC0,
+	0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x01, 0x01, 0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01, 0x01,
+	0x01, 0x81, 0x81, 0x81, 0x00, 0x00, 0x00, 0x03, 0x03, 0x03, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C,
+	0x03, 0x03, 0x03, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0,
+	0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x03, 0x03, 0x03,
+	0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x03, 0x03, 0x03, 0x1F, 0x1F, 0x1F, 0x1C,
+	0x1C, 0x1C, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0xC0,
+	0xC0, 0xC0, 0xC0, 0xC0, 0x7F, 0x7F, 0x7F, 0xFF, 0xFF, 0xFF, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0xFF, 0xFF, 0xFF, 0x7F, 0x7F, 0x7F, 0x00, 0x00, 0x00, 0x03, 0x03, 0x03, 0x1F, 0x1F, 0x1F, 0x1F,
+	0x1F, 0x1F, 0x03, 0x03, 0x03, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xF0, 0xF0, 0xF0, 0xFE, 0xFE, 0xFE, 0xF0, 0xF0, 0xF0, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0x03, 0x03, 0x03, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x03, 0x03, 0x03, 0x1F, 0x1F,
+	0x1F, 0x1F, 0x1F, 0x1F, 0x03, 0x03, 0x03, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x01, 0x01, 0x01, 0x8F,
+	0x8F, 0x8F, 0xFE, 0xFE, 0xFE, 0x70, 0x70, 0x70, 0xFE, 0xFE, 0xFE, 0x8F, 0x8F, 0x8F, 0x01, 0x01,
+	0x01, 0x1C, 0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x03, 0x03, 0x03, 0x00, 0x00, 0x00, 0x03, 0x03, 0x03,
+	0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x7F, 0x7F, 0x7F, 0xFF, 0xFF, 0xFF, 0x80, 0x80,
+	0x80, 0x80, 0x80, 0x80, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xE0, 0xE0, 0xE0, 0xE3, 0xE3, 0xE3,
+	0xE3, 0xE3, 0xE3, 0xE3, 0xE3, 0xE3, 0xFF, 0xFF, 0xFF, 0x1F, 0x1F, 0x1F, 0xC0, 0xC0, 0xC0, 0xC0,
+	0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x0F, 0x0F,
+	0x0F, 0x81, 0x81, 0x81, 0xF1, 0xF1, 0xF1, 0x7F, 0x7F, 0x7F, 0x0F, 0x0F, 0x0F, 0x81, 0x81, 0x81,
+	0x1C, 0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1F,
+	0x1F, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF8, 0xF8, 0xF8, 0xFF, 0xFF, 0xFF, 0x07, 0x07,
+	0x07, 0x07, 0x07, 0x07, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0xFF, 0xFF, 0xFF, 0xF1, 0xF1, 0xF1,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x03, 0x03, 0x1F,
+	0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F,
+	0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0xFF, 0xFF, 0xFF,
+	0xF8, 0xF8, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF1,
+	0xF1, 0xF1, 0xFF, 0xFF, 0xFF, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C,
+	0x1C, 0x1F, 0x1F, 0x1F, 0x03, 0x03, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x38, 0x38, 0x38,
+	0x3F, 0x3F, 0x3F, 0x07, 0x07, 0x07, 0x3F, 0x3F, 0x3F, 0x38, 0x38, 0x38, 0x3F, 0x3F, 0x3F, 0x07,
+	0x07, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC7,
+	0xC7, 0xC7, 0xC7, 0xC7, 0xC7, 0x00, 0x00, 0x00, 0xF0, 0xF0, 0xF0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xF0, 0xF0, 0xF0, 0x03, 0x03, 0x03, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x03, 0x03, 0x03,
+	0xF8, 0xF8, 0xF8, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0xF8, 0xF8, 0xF8, 0x01, 0x01, 0x01, 0x0E,
+	0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC7, 0xC7, 0xC7, 0xC7, 0xC7, 0xC7,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0xF0, 0xF0, 0xFE, 0xFE, 0xFE, 0x0F, 0x0F, 0x0F, 0x01,
+	0x01, 0x01, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x03, 0x03, 0x03, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C,
+	0x1C, 0x1C, 0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x03, 0x03, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xC0, 0xC0, 0xC0, 0xF8, 0xF8, 0xF8, 0x3F, 0x3F, 0x3F, 0x07, 0x07, 0x07, 0xFE, 0xFE, 0xFE, 0xFE,
+	0xFE, 0xFE, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0xFE, 0xFE, 0xFE, 0xFE, 0xFE, 0xFE, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xF8, 0xF8, 0xF8, 0xFF, 0xFF, 0xFF, 0xC7,
+	0xC7, 0xC7, 0xC0, 0xC0, 0xC0, 0x01, 0x01, 0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x71, 0x71,
+	0x71, 0xFF, 0xFF, 0xFF, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0xE0, 0xE0, 0xE0, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xE0, 0xE0, 0xE0, 0xE3, 0xE3, 0xE3, 0xE0, 0xE0, 0xE0, 0xFC, 0xFC, 0xFC, 0xC0,
+	0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xF8, 0xF8, 0xF8, 0xFF, 0xFF, 0xFF, 0x07, 0x07, 0x07, 0x01, 0x01,
+	0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0xE0, 0xE0, 0xE0,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xE0, 0xE0, 0xE0, 0x00, 0x00, 0x00, 0xF8, 0xF8, 0xF8, 0xC7,
+	0xC7, 0xC7, 0x07, 0x07, 0x07, 0x38, 0x38, 0x38, 0x3F, 0x3F, 0x3F, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+	0xC0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x0E, 0x0E, 0x0E, 0x7E, 0x7E, 0x7E, 0xF0, 0xF0, 0xF0,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x03, 0x03, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0xC0, 0xC0, 0xC0, 0xF8, 0xF8, 0xF8, 0xFF, 0xFF, 0xFF, 0x07, 0x07, 0x07, 0x00, 0x00, 0x00,
+	0xFE, 0xFE, 0xFE, 0xFE, 0xFE, 0xFE, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0xFE,
+	0xFE, 0xFE, 0xFE, 0xFE, 0xFE, 0x03, 0x03, 0x03, 0x1F, 0x1F, 0x1F, 0xFC, 0xFC, 0xFC, 0xE0, 0xE0,
+	0xE0, 0xFC, 0xFC, 0xFC, 0x1F, 0x1F, 0x1F, 0x03, 0x03, 0x03, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+	0x00, 0x00, 0x00, 0x38, 0x38, 0x38, 0xFF, 0xFF, 0xFF, 0xC7, 0xC7, 0xC7, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0x00, 0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xF8, 0xF8, 0xF8, 0xFF, 0xFF, 0xFF, 0x07,
+	0x07, 0x07, 0x00, 0x00, 0x00, 0x80, 0x80, 0x80, 0xF1, 0xF1, 0xF1, 0x71, 0x71, 0x71, 0x71, 0x71,
+	0x71, 0xFF, 0xFF, 0xFF, 0xFE, 0xFE, 0xFE, 0x00, 0x00, 0x00, 0x03, 0x03, 0x03, 0x1F, 0x1F, 0x1F,
+	0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x03, 0x03, 0x03, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0x00,
+	0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xF8, 0xF8, 0xF8, 0xFF, 0xFF, 0xFF, 0x07, 0x07,
+	0x07, 0xFE, 0xFE, 0xFE, 0xFF, 0xFF, 0xFF, 0x71, 0x71, 0x71, 0x71, 0x71, 0x71, 0x7F, 0x7F, 0x7F,
+	0x7E, 0x7E, 0x7E, 0x03, 0x03, 0x03, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C,
+	0x1C, 0x1C, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xF8, 0xF8, 0xF8, 0x3F, 0x3F,
+	0x3F, 0x07, 0x07, 0x07, 0x01, 0x01, 0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x1C, 0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0x00,
+	0x00, 0x00, 0xF8, 0xF8, 0xF8, 0xC7, 0xC7, 0xC7, 0xC7, 0xC7, 0xC7, 0xF8, 0xF8, 0xF8, 0xFF, 0xFF,
+	0xFF, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+	0xFF, 0xFF, 0xFF, 0xFE, 0xFE, 0xFE, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+	0xC0, 0xF8, 0xF8, 0xF8, 0xFF, 0xFF, 0xFF, 0x07, 0x07, 0x07, 0xFE, 0xFE, 0xFE, 0xFF, 0xFF, 0xFF,
+	0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0xFF, 0xFF, 0xFF, 0xFE, 0xFE, 0xFE, 0x03, 0x03, 0x03, 0x1F,
+	0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1F, 0x1F, 0x1F, 0x03, 0x03, 0x03, 0xC0, 0xC0,
+	0xC0, 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0x38, 0x38, 0x38, 0xFF, 0xFF, 0xFF, 0xC7, 0xC7, 0xC7,
+	0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x03, 0x03, 0x03, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C,
+	0x1C, 0x1C, 0x1C, 0x1C, 0x03, 0x03, 0x03, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C, 0xC0, 0xC0, 0xC0,
+	0xC7, 0xC7, 0xC7, 0x07, 0x07, 0x07, 0x00, 0x00, 0x00, 0xC7, 0xC7, 0xC7, 0xC7, 0xC7, 0xC7, 0x00,
+	0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x03, 0x03, 0x03, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C,
+	0x1C, 0x1C, 0x1C, 0x03, 0x03, 0x03, 0x1F, 0x1F, 0x1F, 0x1C, 0x1C, 0x1C,
+};
+
+static const uint16_t large_offset[111] = {
+	0, 27, 63, 108, 171, 225, 288, 351, 378, 414, 450, 522,
+	576, 603, 657, 675, 738, 801, 855, 909, 963, 1026, 1080, 1134,
+	1188, 1242, 1296, 1314, 1341, 1386, 1440, 1485, 1539, 1602, 1656, 1719,
+	1782, 1845, 1908, 1971, 2034, 2088, 2124, 2187, 2250, 2313, 2376, 2439,
+	2502, 2565, 2619, 2682, 2736, 2790, 2844, 2898, 2961, 3024, 3078, 3141,
+	3177, 3240, 3276, 3339, 3411, 3438, 3501, 3564, 3618, 3681, 3735, 3789,
+	3852, 3915, 3951, 4005, 4068, 4104, 4167, 4221, 4275, 4338, 4401, 4464,
+	4518, 4563, 4626, 4680, 4743, 4806, 4860, 4914, 4968, 5031, 5085, 5148,
+	5184, 5220, 5274, 5328, 5391, 5436, 5499, 5562, 5616, 5679, 5733, 5778,
+	5832, 5886, 5949,
+};
+
+static const uint8_t large_width[111] = {
+	9, 12, 15, 21, 18, 21, 21, 9, 12, 12, 24, 18, 9, 18, 6, 21,
+	21, 18, 18, 18, 21, 18, 18, 18, 18, 18, 6, 9, 15, 18, 15, 18,
+	21, 18, 21, 21, 21, 21, 21, 21, 18, 12, 21, 21, 21, 21, 21, 21,
+	21, 18, 21, 18, 18, 18, 18, 21, 21, 18, 21, 12, 21, 12, 21, 24,
+	9, 21, 21, 18, 21, 18, 18, 21, 21, 12, 18, 21, 12, 21, 18, 18,
+	21, 21, 21, 18, 15, 21, 18, 21, 21, 18, 18, 18, 21, 18, 21, 12,
+	12, 18, 18, 21, 15, 21, 21, 18, 21, 18, 15, 18, 18, 21, 21,
+};
+
+const ssd1306_font_t ssd1306_font_large = {
+	.pages = 3,
+	.spacing = 3,
+	.first = 0x20,
+	.last = 0x7E,
+	.extra_codes = extra_codes,
+	.extra_count = 16,
+	.offset = large_offset,
+	.width = large_width,
+	.data = large_data,
+};
+
@@ -11,45 +11,45 @@
 // Define el puerto I2C que se va a utilizar. I2C_NUM_0 es el más común.
 #define I2C_MASTER_PORT I2C_NUM_0
 
+// Acotado: un bus colgado no bloquea a quien llama
+#define I2C_TIMEOUT_MS 100
+
+/*
+ * Una transacción completa: por el gestor de bus si lo hay, si no directa.
+ */
+static esp_err_t ssd1306_i2c_write(SSD1306_t *dev, const uint8_t *buffer, int len) {
+    if (dev->_i2c_write) return dev->_i2c_write(dev->_i2c_ctx, buffer, len);
+    return i2c_master_transmit(dev->_i2c_dev_handle, buffer, len, I2C_TIMEOUT_MS);
+}
+
 /*
  * Función interna para enviar un buffer de comandos al OLED.
- * Encapsula la nueva API de i2c_master.
+ * El byte de control va delante en un buffer de pila: sin malloc por
+ * transferencia, así varias pantallas comparten bus sin copias en el heap.
  */
 static esp_err_t ssd1306_i2c_send_cmds(SSD1306_t *dev, const uint8_t *cmds, int len) {
-    // Se crea un buffer temporal que incluye el byte de control I2C.
-    uint8_t *buffer = malloc(len + 1);
-    if (buffer == NULL) {
-        ESP_LOGE(tag, "Failed to allocate memory for command buffer");
-        return ESP_ERR_NO_MEM;
-    }
-    
+    uint8_t buffer[1 + SSD1306_INIT_CMDS_MAX];
+    if (len > SSD1306_INIT_CMDS_MAX) return ESP_ERR_INVALID_SIZE;
+
     buffer[0] = OLED_CONTROL_BYTE_CMD_STREAM; // Byte de control para un stream de comandos
     memcpy(buffer + 1, cmds, len);
-    
+
     // Se transmite el buffer completo en una sola transacción.
-    esp_err_t ret = i2c_master_transmit(dev->_i2c_dev_handle, buffer, len + 1, -1); // -1 para timeout infinito
-    
-    free(buffer);
-    return ret;
+    return ssd1306_i2c_write(dev, buffer, len + 1);
 }
 
 /*
  * Función interna para enviar un buffer de datos (píxeles) al OLED.
+ * Como mucho una fila de página: SSD1306_MAX_WIDTH bytes.
  */
 static esp_err_t ssd1306_i2c_send_data(SSD1306_t *dev, const uint8_t *data, int len) {
-    uint8_t *buffer = malloc(len + 1);
-     if (buffer == NULL) {
-        ESP_LOGE(tag, "Failed to allocate memory for data buffer");
-        return ESP_ERR_NO_MEM;
-    }
+    uint8_t buffer[1 + SSD1306_MAX_WIDTH];
+    if (len > SSD1306_MAX_WIDTH) return ESP_ERR_INVALID_SIZE;
 
     buffer[0] = OLED_CONTROL_BYTE_DATA_STREAM; // Byte de control para un stream de datos
     memcpy(buffer + 1, data, len);
 
-    esp_err_t ret = i2c_master_transmit(dev->_i2c_dev_handle, buffer, len + 1, -1);
-
-    free(buffer);
-    return ret;
+    return ssd1306_i2c_write(dev, buffer, len + 1);
 }
 
 
@@ -71,16 +71,24 @@ void i2c_master_init(SSD1306_t * dev, int16_t sda, int16_t scl, int16_t reset) {
     i2c_master_bus_handle_t bus_handle;
     ESP_ERROR_CHECK(i2c_new_master_bus(&i2c_bus_config, &bus_handle));
 
-    // 2. Configuración del dispositivo OLED en el bus
+    // 2. El OLED en el bus recién creado
+    i2c_device_add(dev, bus_handle, I2CAddress, 400000, reset);
+}
+
+/*
+ * Añade el OLED a un bus ya creado. Otra pantalla o los sensores pueden
+ * compartirlo: cada SSD1306_t guarda solo su handle de dispositivo.
+ */
+void i2c_device_add(SSD1306_t * dev, i2c_master_bus_handle_t bus, uint16_t address, uint32_t scl_speed_hz, int16_t reset) {
     i2c_device_config_t dev_config = {
         .dev_addr_length = I2C_ADDR_BIT_LEN_7,
-        .device_address = I2CAddress, // Dirección I2C del OLED (definida en ssd1306.h)
-        .scl_speed_hz = 400000,        // Frecuencia de reloj a 400 kHz
+        .device_address = address,     // 0x3C o 0x3D según el puente SA0
+        .scl_speed_hz = scl_speed_hz,  // La del bus si lo comparte con sensores más lentos
     };
     // Se añade el dispositivo al bus y se guarda el handle en la estructura dev
-    ESP_ERROR_CHECK(i2c_master_bus_add_device(bus_handle, &dev_config, &dev->_i2c_dev_handle));
+    ESP_ERROR_CHECK(i2c_master_bus_add_device(bus, &dev_config, &dev->_i2c_dev_handle));
 
-    // 3. Lógica de reset del pin (sin cambios)
+    // Lógica de reset del pin (sin cambios)
     if (reset >= 0) {
         gpio_reset_pin(reset);
         gpio_set_direction(reset, GPIO_MODE_OUTPUT);
@@ -88,42 +96,73 @@ void i2c_master_init(SSD1306_t * dev, int16_t sda, int16_t scl, int16_t reset) {
         vTaskDelay(50 / portTICK_PERIOD_MS);
         gpio_set_level(reset, 1);
     }
-    dev->_address = I2CAddress;
+    dev->_i2c_bus_handle = bus;
+    dev->_i2c_write = NULL;
+    dev->_address = address;
+    dev->_flip = false;
+    // SSD1306 por defecto; ssd1306_set_controller antes de ssd1306_init para el SH1106
+    ssd1306_set_controller(dev, SSD1306_CTRL_SSD1306);
+}
+
+/*
+ * El OLED lo maneja un gestor de bus ajeno (dueño del bus y de su tarea):
+ * cada transacción se le entrega entera a write.
+ */
+void i2c_device_attach(SSD1306_t * dev, uint16_t address, ssd1306_i2c_write_t write, void * ctx) {
+    dev->_i2c_dev_handle = NULL;
+    dev->_i2c_bus_handle = NULL;
+    dev->_i2c_write = write;
+    dev->_i2c_ctx = ctx;
+    dev->_address = address;
     dev->_flip = false;
+    ssd1306_set_controller(dev, SSD1306_CTRL_SSD1306);
+}
+
+/*
+ * Fusión de dos transacciones seguidas al panel. Un stream de comandos admite
+ * más comandos detrás. Comandos seguidos de datos van en una transacción si
+ * cada comando lleva su byte de control con Co = 1 (80h) y los datos van al
+ * final tras 40h, hasta el STOP: ahorra un START, la dirección y el coste fijo
+ * del driver por transacción. Después ya no se puede añadir nada.
+ */
+bool i2c_merge_writes(uint8_t * buf, size_t * len, size_t cap, const uint8_t * next, size_t next_len) {
+    if (*len < 2 || next_len < 2 || buf[0] != OLED_CONTROL_BYTE_CMD_STREAM) return false;
+
+    if (next[0] == OLED_CONTROL_BYTE_CMD_STREAM) {
+        if (*len + next_len - 1 > cap) return false;
+        memcpy(buf + *len, next + 1, next_len - 1);
+        *len += next_len - 1;
+        return true;
+    }
+    if (next[0] == OLED_CONTROL_BYTE_DATA_STREAM) {
+        size_t ncmd = *len - 1;
+        if (2 * ncmd + next_len > cap) return false;
+        // Sobre el mismo buffer, de atrás adelante: el comando k pasa de k a 2k - 1
+        for (size_t k = ncmd; k > 0; k--) {
+            buf[2 * k - 1] = buf[k];
+            buf[2 * k - 2] = OLED_CONTROL_BYTE_CMD_SINGLE;
+        }
+        memcpy(buf + 2 * ncmd, next, next_len);
+        *len = 2 * ncmd + next_len;
+        return true;
+    }
+    return false;
 }
 
 /*
  * Envía la secuencia de inicialización al display (NUEVA VERSIÓN)
  */
 void i2c_init(SSD1306_t * dev, int width, int height) {
-    dev->_width = width;
-    dev->_height = height;
-    dev->_pages = (height == 32) ? 4 : 8;
-
-    // Array con todos los comandos de inicialización
-    uint8_t init_cmds[] = {
-        OLED_CMD_DISPLAY_OFF,
-        OLED_CMD_SET_MUX_RATIO, (height == 32) ? (uint8_t)0x1F : (uint8_t)0x3F,
-        OLED_CMD_SET_DISPLAY_OFFSET, 0x00,
-        OLED_CMD_SET_DISPLAY_START_LINE,
-        dev->_flip ? OLED_CMD_SET_SEGMENT_REMAP_0 : OLED_CMD_SET_SEGMENT_REMAP_1,
-        OLED_CMD_SET_COM_SCAN_MODE,
-        OLED_CMD_SET_DISPLAY_CLK_DIV, 0x80,
-        OLED_CMD_SET_COM_PIN_MAP, (height == 32) ? (uint8_t)0x02 : (uint8_t)0x12,
-        OLED_CMD_SET_CONTRAST, 0xFF,
-        OLED_CMD_DISPLAY_RAM,
-        OLED_CMD_SET_VCOMH_DESELCT, 0x40,
-        OLED_CMD_SET_MEMORY_ADDR_MODE, OLED_CMD_SET_PAGE_ADDR_MODE,
-        OLED_CMD_SET_CHARGE_PUMP, 0x14,
-        OLED_CMD_DEACTIVE_SCROLL,
-        OLED_CMD_DISPLAY_NORMAL,
-        OLED_CMD_DISPLAY_ON
-    };
+    if (!ssd1306_set_geometry(dev, width, height)) return;
+
+    // Secuencia del controlador (SSD1306 o SH1106), en direccionamiento por páginas
+    uint8_t init_cmds[SSD1306_INIT_CMDS_MAX];
+    int n = ssd1306_init_commands(dev, false, init_cmds);
 
-    esp_err_t espRc = ssd1306_i2c_send_cmds(dev, init_cmds, sizeof(init_cmds));
+    esp_err_t espRc = ssd1306_i2c_send_cmds(dev, init_cmds, n);
 
     if (espRc == ESP_OK) {
-        ESP_LOGI(tag, "OLED configured successfully");
+        ESP_LOGI(tag, "OLED 0x%02X configured successfully (%dx%d)", dev->_address, dev->_width, dev->_height);
     } else {
         ESP_LOGE(tag, "OLED configuration failed. code: 0x%.2X", espRc);
     }
@@ -134,19 +173,12 @@ void i2c_init(SSD1306_t * dev, int width, int height) {
  */
 void i2c_display_image(SSD1306_t * dev, int page, int seg, uint8_t * images, int width) {
     if (page >= dev->_pages || seg >= dev->_width) return;
+    if (seg + width > dev->_width) width = dev->_width - seg;
 
-    // Se ha eliminado CONFIG_OFFSETX para que sea más genérico
-    uint8_t columLow = seg & 0x0F;
-    uint8_t columHigh = (seg >> 4) & 0x0F;
-    int _page = dev->_flip ? (dev->_pages - 1 - page) : page;
+    // Comandos para posicionar el cursor de escritura (con el desplazamiento de columna del controlador)
+    uint8_t cmds[3];
+    ssd1306_page_commands(dev, page, seg, cmds);
 
-    // Comandos para posicionar el cursor de escritura
-    uint8_t cmds[] = {
-        (uint8_t)(0x00 | columLow),      // Set Lower Column Start Address
-        (uint8_t)(0x10 | columHigh),     // Set Higher Column Start Address
-        (uint8_t)(0xB0 | _page)         // Set Page Start Address
-    };
-    
     // Se envían los comandos de posicionamiento y luego los datos de la imagen
     ssd1306_i2c_send_cmds(dev, cmds, sizeof(cmds));
     ssd1306_i2c_send_data(dev, images, width);
@@ -161,45 +193,28 @@ void i2c_contrast(SSD1306_t * dev, int contrast) {
     ssd1306_i2c_send_cmds(dev, cmds, sizeof(cmds));
 }
 
+/*
+ * Enciende o apaga el panel; la GDDRAM conserva su contenido
+ */
+void i2c_display_power(SSD1306_t * dev, bool on) {
+    uint8_t cmd = on ? OLED_CMD_DISPLAY_ON : OLED_CMD_DISPLAY_OFF;
+    ssd1306_i2c_send_cmds(dev, &cmd, 1);
+}
+
 
 /*
- * Configura el scroll por hardware (NUEVA VERSIÓN)
+ * Lista de comandos en una sola transacción (p. ej. la configuración de scroll)
  */
-void i2c_hardware_scroll(SSD1306_t * dev, ssd1306_scroll_type_t scroll) {
-    uint8_t cmd_buf[8]; // Buffer para los comandos de scroll
-    int cmd_len = 0;
-
-    switch(scroll) {
-        case SCROLL_RIGHT:
-            cmd_buf[0] = OLED_CMD_HORIZONTAL_RIGHT; cmd_buf[1] = 0x00; cmd_buf[2] = 0x00;
-            cmd_buf[3] = 0x07; cmd_buf[4] = 0x07; cmd_buf[5] = 0x00; cmd_buf[6] = 0xFF;
-            cmd_buf[7] = OLED_CMD_ACTIVE_SCROLL;
-            cmd_len = 8;
-            break;
-        case SCROLL_LEFT:
-            cmd_buf[0] = OLED_CMD_HORIZONTAL_LEFT; cmd_buf[1] = 0x00; cmd_buf[2] = 0x00;
-            cmd_buf[3] = 0x07; cmd_buf[4] = 0x07; cmd_buf[5] = 0x00; cmd_buf[6] = 0xFF;
-            cmd_buf[7] = OLED_CMD_ACTIVE_SCROLL;
-            cmd_len = 8;
-            break;
-        case SCROLL_STOP:
-            cmd_buf[0] = OLED_CMD_DEACTIVE_SCROLL;
-            cmd_len = 1;
-            break;
-        // Los scrolls verticales son más complejos, se dejan como estaban para simplificar
-        // y se pueden refactorizar de la misma manera si se necesitan.
-        case SCROLL_DOWN:
-        case SCROLL_UP:
-            ESP_LOGW(tag, "Vertical scroll not fully refactored in this version.");
-            return; // Evita ejecutar código no refactorizado
+void i2c_send_commands(SSD1306_t * dev, const uint8_t * cmds, int len) {
+    esp_err_t espRc = ssd1306_i2c_send_cmds(dev, cmds, len);
+    if (espRc != ESP_OK) {
+        ESP_LOGE(tag, "Command list failed. code: 0x%.2X", espRc);
     }
+}
 
-    if (cmd_len > 0) {
-        esp_err_t espRc = ssd1306_i2c_send_cmds(dev, cmd_buf, cmd_len);
-        if (espRc == ESP_OK) {
-            ESP_LOGD(tag, "Scroll command succeeded");
-        } else {
-            ESP_LOGE(tag, "Scroll command failed. code: 0x%.2X", espRc);
-        }
-    }
+/*
+ * Scroll por hardware del panel completo; la configuración está en ssd1306_hardware_scroll_config
+ */
+void i2c_hardware_scroll(SSD1306_t * dev, ssd1306_scroll_type_t scroll) {
+    ssd1306_hardware_scroll(dev, scroll);
 }
\ No newline at end of file
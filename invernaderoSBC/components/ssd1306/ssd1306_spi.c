@@ -1,3 +1,4 @@
+#include <stdlib.h>
 #include <string.h>
 
 #include "freertos/FreeRTOS.h"
@@ -6,6 +7,7 @@
 #include "driver/spi_master.h"
 #include "driver/gpio.h"
 #include "esp_log.h"
+#include "esp_heap_caps.h"
 
 #include "ssd1306.h"
 
@@ -23,6 +25,87 @@ static const int SPI_Command_Mode = 0;
 static const int SPI_Data_Mode = 1;
 static const int SPI_Frequency = 1000000; // 1MHz
 
+/*
+ * Transactions are queued with spi_device_queue_trans and collected lazily,
+ * so the caller goes back to work while DMA feeds the panel. Every queued
+ * transfer owns a slot: the transaction plus a DMA-capable copy of its bytes,
+ * so callers may reuse their buffers at once. DC is driven from the
+ * pre-transfer callback, taken from t->user. Results come back in queue
+ * order, so the slots form a ring.
+ */
+#define SPI_QUEUE_DEPTH	8
+#define SPI_SLOT_BYTES	128		// One page row
+
+struct ssd1306_spi_queue {
+	spi_transaction_t trans[SPI_QUEUE_DEPTH];
+	uint8_t * slot;				// SPI_QUEUE_DEPTH * SPI_SLOT_BYTES, DMA capable
+	uint8_t * frame;			// Whole framebuffer for one-burst flushes, DMA capable
+	uint32_t queued;			// Transactions queued since init
+	uint32_t done;				// Transactions collected
+	uint32_t frame_seq;			// queued count after the last frame burst
+};
+
+// t->user: ((dc gpio + 1) << 1) | level; 0 = leave DC alone
+static void IRAM_ATTR spi_pre_transfer_callback(spi_transaction_t * t)
+{
+	intptr_t v = (intptr_t)t->user;
+	if (v) gpio_set_level((v >> 1) - 1, v & 1);
+}
+
+static void spi_collect(SSD1306_t * dev, uint32_t until)
+{
+	struct ssd1306_spi_queue * q = dev->_spiQueue;
+	spi_transaction_t * rt;
+	while ((int32_t)(until - q->done) > 0) {
+		if (spi_device_get_trans_result(dev->_SPIHandle, &rt, portMAX_DELAY) != ESP_OK) break;
+		q->done++;
+	}
+}
+
+// Queues len bytes (copied) with DC at level; len up to SPI_SLOT_BYTES, or
+// any length when data already lives in DMA memory that stays put (frame)
+static void spi_queue(SSD1306_t * dev, int level, const uint8_t * data, size_t len, bool in_place)
+{
+	struct ssd1306_spi_queue * q = dev->_spiQueue;
+	if (q->queued - q->done >= SPI_QUEUE_DEPTH) spi_collect(dev, q->done + 1);
+
+	int i = q->queued % SPI_QUEUE_DEPTH;
+	spi_transaction_t * t = &q->trans[i];
+	memset(t, 0, sizeof(*t));
+	t->length = len * 8;
+	t->user = (void *)(intptr_t)(((dev->_dc + 1) << 1) | level);
+	if (len <= 4) {
+		t->flags = SPI_TRANS_USE_TXDATA;
+		memcpy(t->tx_data, data, len);
+	} else if (in_place) {
+		t->tx_buffer = data;
+	} else {
+		uint8_t * buf = &q->slot[i * SPI_SLOT_BYTES];
+		memcpy(buf, data, len);
+		t->tx_buffer = buf;
+	}
+	if (spi_device_queue_trans(dev->_SPIHandle, t, portMAX_DELAY) == ESP_OK) {
+		q->queued++;
+	} else {
+		ESP_LOGE(TAG, "spi_device_queue_trans failed");
+	}
+}
+
+static void spi_queue_bytes(SSD1306_t * dev, int level, const uint8_t * data, size_t len)
+{
+	while (len) {
+		size_t n = (len > SPI_SLOT_BYTES) ? SPI_SLOT_BYTES : len;
+		spi_queue(dev, level, data, n, false);
+		data += n;
+		len -= n;
+	}
+}
+
+void spi_wait_done(SSD1306_t * dev)
+{
+	if (dev->_spiQueue) spi_collect(dev, dev->_spiQueue->queued);
+}
+
 void spi_master_init(SSD1306_t * dev, int16_t GPIO_MOSI, int16_t GPIO_SCLK, int16_t GPIO_CS, int16_t GPIO_DC, int16_t GPIO_RESET)
 {
 	esp_err_t ret;
@@ -52,7 +135,7 @@ void spi_master_init(SSD1306_t * dev, int16_t GPIO_MOSI, int16_t GPIO_SCLK, int1
 		.sclk_io_num = GPIO_SCLK,
 		.quadwp_io_num = -1,
 		.quadhd_io_num = -1,
-		.max_transfer_sz = 0,
+		.max_transfer_sz = SSD1306_MAX_PAGES * SSD1306_MAX_WIDTH,	// Whole framebuffer in one burst
 		.flags = 0
 	};
 
@@ -65,7 +148,8 @@ void spi_master_init(SSD1306_t * dev, int16_t GPIO_MOSI, int16_t GPIO_SCLK, int1
 	memset( &devcfg, 0, sizeof( spi_device_interface_config_t ) );
 	devcfg.clock_speed_hz = SPI_Frequency;
 	devcfg.spics_io_num = GPIO_CS;
-	devcfg.queue_size = 1;
+	devcfg.queue_size = SPI_QUEUE_DEPTH;
+	devcfg.pre_cb = spi_pre_transfer_callback;
 
 	spi_device_handle_t handle;
 	ret = spi_bus_add_device( HOST_ID, &devcfg, &handle);
@@ -75,9 +159,20 @@ void spi_master_init(SSD1306_t * dev, int16_t GPIO_MOSI, int16_t GPIO_SCLK, int1
 	dev->_SPIHandle = handle;
 	dev->_address = SPIAddress;
 	dev->_flip = false;
+	ssd1306_set_controller(dev, SSD1306_CTRL_SSD1306);
+	dev->_offsetx = CONFIG_OFFSETX;
+
+	struct ssd1306_spi_queue * q = calloc(1, sizeof(struct ssd1306_spi_queue));
+	assert(q != NULL);
+	q->slot = heap_caps_malloc(SPI_QUEUE_DEPTH * SPI_SLOT_BYTES, MALLOC_CAP_DMA);
+	q->frame = heap_caps_malloc(SSD1306_MAX_PAGES * SSD1306_MAX_WIDTH, MALLOC_CAP_DMA);
+	assert(q->slot != NULL && q->frame != NULL);
+	dev->_spiQueue = q;
 }
 
 
+// Standalone blocking transfer. Not for a handle with queued transactions
+// (spi_device_transmit would collect theirs): the driver uses spi_queue.
 bool spi_master_write_byte(spi_device_handle_t SPIHandle, const uint8_t* Data, size_t DataLength )
 {
 	spi_transaction_t SPITransaction;
@@ -92,90 +187,96 @@ bool spi_master_write_byte(spi_device_handle_t SPIHandle, const uint8_t* Data, s
 	return true;
 }
 
+// Blocking, as before: the command is out when this returns
 bool spi_master_write_command(SSD1306_t * dev, uint8_t Command )
 {
-	static uint8_t CommandByte = 0;
-	CommandByte = Command;
-	gpio_set_level( dev->_dc, SPI_Command_Mode );
-	return spi_master_write_byte( dev->_SPIHandle, &CommandByte, 1 );
+	spi_queue(dev, SPI_Command_Mode, &Command, 1, false);
+	spi_wait_done(dev);
+	return true;
 }
 
 bool spi_master_write_data(SSD1306_t * dev, const uint8_t* Data, size_t DataLength )
 {
-	gpio_set_level( dev->_dc, SPI_Data_Mode );
-	return spi_master_write_byte( dev->_SPIHandle, Data, DataLength );
+	spi_queue_bytes(dev, SPI_Data_Mode, Data, DataLength);
+	spi_wait_done(dev);
+	return true;
 }
 
 
+// Horizontal addressing: a column/page window takes any run, or the whole
+// framebuffer, as a single data transfer. The SH1106 only has page addressing.
+static bool spi_windowed(SSD1306_t * dev)
+{
+	return dev->_controller == SSD1306_CTRL_SSD1306;
+}
+
 void spi_init(SSD1306_t * dev, int width, int height)
 {
-	dev->_width = width;
-	dev->_height = height;
-	dev->_pages = 8;
-	if (dev->_height == 32) dev->_pages = 4;
-
-	spi_master_write_command(dev, OLED_CMD_DISPLAY_OFF);			// AE
-	spi_master_write_command(dev, OLED_CMD_SET_MUX_RATIO);			// A8
-	if (dev->_height == 64) spi_master_write_command(dev, 0x3F);
-	if (dev->_height == 32) spi_master_write_command(dev, 0x1F);
-	spi_master_write_command(dev, OLED_CMD_SET_DISPLAY_OFFSET);		// D3
-	spi_master_write_command(dev, 0x00);
-	spi_master_write_command(dev, OLED_CONTROL_BYTE_DATA_STREAM);	// 40
-	if (dev->_flip) {
-		spi_master_write_command(dev, OLED_CMD_SET_SEGMENT_REMAP_0);	// A0
-	} else {
-		spi_master_write_command(dev, OLED_CMD_SET_SEGMENT_REMAP_1);	// A1
-	}
-	//spi_master_write_command(dev, OLED_CMD_SET_SEGMENT_REMAP);		// A1
-	spi_master_write_command(dev, OLED_CMD_SET_COM_SCAN_MODE);		// C8
-	spi_master_write_command(dev, OLED_CMD_SET_DISPLAY_CLK_DIV);	// D5
-	spi_master_write_command(dev, 0x80);
-	spi_master_write_command(dev, OLED_CMD_SET_COM_PIN_MAP);		// DA
-	if (dev->_height == 64) spi_master_write_command(dev, 0x12);
-	if (dev->_height == 32) spi_master_write_command(dev, 0x02);
-	spi_master_write_command(dev, OLED_CMD_SET_CONTRAST);			// 81
-	spi_master_write_command(dev, 0xFF);
-	spi_master_write_command(dev, OLED_CMD_DISPLAY_RAM);			// A4
-	spi_master_write_command(dev, OLED_CMD_SET_VCOMH_DESELCT);		// DB
-	spi_master_write_command(dev, 0x40);
-	spi_master_write_command(dev, OLED_CMD_SET_MEMORY_ADDR_MODE);	// 20
-	//spi_master_write_command(dev, OLED_CMD_SET_HORI_ADDR_MODE);	// 00
-	spi_master_write_command(dev, OLED_CMD_SET_PAGE_ADDR_MODE);		// 02
-	// Set Lower Column Start Address for Page Addressing Mode
-	spi_master_write_command(dev, 0x00);
-	// Set Higher Column Start Address for Page Addressing Mode
-	spi_master_write_command(dev, 0x10);
-	spi_master_write_command(dev, OLED_CMD_SET_CHARGE_PUMP);		// 8D
-	spi_master_write_command(dev, 0x14);
-	spi_master_write_command(dev, OLED_CMD_DEACTIVE_SCROLL);		// 2E
-	spi_master_write_command(dev, OLED_CMD_DISPLAY_NORMAL);			// A6
-	spi_master_write_command(dev, OLED_CMD_DISPLAY_ON);				// AF
+	if (!ssd1306_set_geometry(dev, width, height)) return;
+
+	uint8_t cmds[SSD1306_INIT_CMDS_MAX];
+	int n = ssd1306_init_commands(dev, spi_windowed(dev), cmds);
+	spi_queue_bytes(dev, SPI_Command_Mode, cmds, n);
+	spi_wait_done(dev);
 }
 
 
+// Queued: returns before the bytes are on the wire
 void spi_display_image(SSD1306_t * dev, int page, int seg, uint8_t * images, int width)
 {
 	if (page >= dev->_pages) return;
 	if (seg >= dev->_width) return;
+	if (seg + width > dev->_width) width = dev->_width - seg;
+
+	if (!spi_windowed(dev)) {
+		uint8_t cmds[3];
+		ssd1306_page_commands(dev, page, seg, cmds);
+		spi_queue(dev, SPI_Command_Mode, cmds, sizeof(cmds), false);
+		spi_queue(dev, SPI_Data_Mode, images, width, false);
+		return;
+	}
 
-	int _seg = seg + CONFIG_OFFSETX;
-	uint8_t columLow = _seg & 0x0F;
-	uint8_t columHigh = (_seg >> 4) & 0x0F;
-
+	int _seg = seg + dev->_offsetx;
 	int _page = page;
 	if (dev->_flip) {
 		_page = (dev->_pages - page) - 1;
 	}
 
-	// Set Lower Column Start Address for Page Addressing Mode
-	spi_master_write_command(dev, (0x00 + columLow));
-	// Set Higher Column Start Address for Page Addressing Mode
-	spi_master_write_command(dev, (0x10 + columHigh));
-	// Set Page Start Address for Page Addressing Mode
-	spi_master_write_command(dev, 0xB0 | _page);
-
-	spi_master_write_data(dev, images, width);
+	uint8_t cmds[] = {
+		OLED_CMD_SET_COLUMN_RANGE, _seg, _seg + width - 1,
+		OLED_CMD_SET_PAGE_RANGE, _page, _page,
+	};
+	spi_queue(dev, SPI_Command_Mode, cmds, sizeof(cmds), false);
+	spi_queue(dev, SPI_Data_Mode, images, width, false);
+}
 
+// Whole internal buffer as one DMA burst (one per page without windows)
+void spi_display_frame(SSD1306_t * dev)
+{
+	struct ssd1306_spi_queue * q = dev->_spiQueue;
+	// The previous burst may still be reading the staging buffer
+	spi_collect(dev, q->frame_seq);
+	for (int page = 0; page < dev->_pages; page++) {
+		int _page = dev->_flip ? (dev->_pages - page) - 1 : page;
+		memcpy(&q->frame[_page * dev->_width], dev->_page[page]._segs, dev->_width);
+	}
+	if (spi_windowed(dev)) {
+		uint8_t cmds[] = {
+			OLED_CMD_SET_COLUMN_RANGE, dev->_offsetx, dev->_offsetx + dev->_width - 1,
+			OLED_CMD_SET_PAGE_RANGE, 0, dev->_pages - 1,
+		};
+		spi_queue(dev, SPI_Command_Mode, cmds, sizeof(cmds), false);
+		spi_queue(dev, SPI_Data_Mode, q->frame, dev->_pages * dev->_width, true);
+	} else {
+		for (int page = 0; page < dev->_pages; page++) {
+			uint8_t cmds[3];
+			ssd1306_page_commands(dev, page, 0, cmds);
+			int _page = dev->_flip ? (dev->_pages - page) - 1 : page;
+			spi_queue(dev, SPI_Command_Mode, cmds, sizeof(cmds), false);
+			spi_queue(dev, SPI_Data_Mode, &q->frame[_page * dev->_width], dev->_width, true);
+		}
+	}
+	q->frame_seq = q->queued;
 }
 
 void spi_contrast(SSD1306_t * dev, int contrast) {
@@ -183,72 +284,17 @@ void spi_contrast(SSD1306_t * dev, int contrast) {
 	if (contrast < 0x0) _contrast = 0;
 	if (contrast > 0xFF) _contrast = 0xFF;
 
-	spi_master_write_command(dev, OLED_CMD_SET_CONTRAST);			// 81
-	spi_master_write_command(dev, _contrast);
+	uint8_t cmds[] = { OLED_CMD_SET_CONTRAST, _contrast };			// 81
+	spi_queue(dev, SPI_Command_Mode, cmds, sizeof(cmds), false);
 }
 
-void spi_hardware_scroll(SSD1306_t * dev, ssd1306_scroll_type_t scroll)
+void spi_send_commands(SSD1306_t * dev, const uint8_t * cmds, int len)
 {
+	spi_queue_bytes(dev, SPI_Command_Mode, cmds, len);
+}
 
-	if (scroll == SCROLL_RIGHT) {
-		spi_master_write_command(dev, OLED_CMD_HORIZONTAL_RIGHT);	// 26
-		spi_master_write_command(dev, 0x00); // Dummy byte
-		spi_master_write_command(dev, 0x00); // Define start page address
-		spi_master_write_command(dev, 0x07); // Frame frequency
-		spi_master_write_command(dev, 0x07); // Define end page address
-		spi_master_write_command(dev, 0x00); //
-		spi_master_write_command(dev, 0xFF); //
-		spi_master_write_command(dev, OLED_CMD_ACTIVE_SCROLL);		// 2F
-	} 
-
-	if (scroll == SCROLL_LEFT) {
-		spi_master_write_command(dev, OLED_CMD_HORIZONTAL_LEFT);	// 27
-		spi_master_write_command(dev, 0x00); // Dummy byte
-		spi_master_write_command(dev, 0x00); // Define start page address
-		spi_master_write_command(dev, 0x07); // Frame frequency
-		spi_master_write_command(dev, 0x07); // Define end page address
-		spi_master_write_command(dev, 0x00); //
-		spi_master_write_command(dev, 0xFF); //
-		spi_master_write_command(dev, OLED_CMD_ACTIVE_SCROLL);		// 2F
-	} 
-
-	if (scroll == SCROLL_DOWN) {
-		spi_master_write_command(dev, OLED_CMD_CONTINUOUS_SCROLL);	// 29
-		spi_master_write_command(dev, 0x00); // Dummy byte
-		spi_master_write_command(dev, 0x00); // Define start page address
-		spi_master_write_command(dev, 0x07); // Frame frequency
-		//spi_master_write_command(dev, 0x01); // Define end page address
-		spi_master_write_command(dev, 0x00); // Define end page address
-		spi_master_write_command(dev, 0x3F); // Vertical scrolling offset
-
-		spi_master_write_command(dev, OLED_CMD_VERTICAL);			// A3
-		spi_master_write_command(dev, 0x00);
-		if (dev->_height == 64)
-			spi_master_write_command(dev, 0x40);
-		if (dev->_height == 32)
-			spi_master_write_command(dev, 0x20);
-		spi_master_write_command(dev, OLED_CMD_ACTIVE_SCROLL);		// 2F
-	}
-
-	if (scroll == SCROLL_UP) {
-		spi_master_write_command(dev, OLED_CMD_CONTINUOUS_SCROLL);	// 29
-		spi_master_write_command(dev, 0x00); // Dummy byte
-		spi_master_write_command(dev, 0x00); // Define start page address
-		spi_master_write_command(dev, 0x07); // Frame frequency
-		//spi_master_write_command(dev, 0x01); // Define end page address
-		spi_master_write_command(dev, 0x00); // Define end page address
-		spi_master_write_command(dev, 0x01); // Vertical scrolling offset
-
-		spi_master_write_command(dev, OLED_CMD_VERTICAL);			// A3
-		spi_master_write_command(dev, 0x00);
-		if (dev->_height == 64)
-			spi_master_write_command(dev, 0x40);
-		if (dev->_height == 32)
-			spi_master_write_command(dev, 0x20);
-		spi_master_write_command(dev, OLED_CMD_ACTIVE_SCROLL);		// 2F
-	}
-
-	if (scroll == SCROLL_STOP) {
-		spi_master_write_command(dev, OLED_CMD_DEACTIVE_SCROLL);	// 2E
-	}
+// Whole-panel scroll; see ssd1306_hardware_scroll_config for the full set
+void spi_hardware_scroll(SSD1306_t * dev, ssd1306_scroll_type_t scroll)
+{
+	ssd1306_hardware_scroll(dev, scroll);
 }
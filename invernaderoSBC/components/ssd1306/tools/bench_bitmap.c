@@ -0,0 +1,232 @@
+/*
+ * Host benchmark and equivalence check of ssd1306_buffer_bitmap() against the
+ * routine it replaced (the bit-by-bit ssd1306_bitmaps(), kept below with its
+ * per-row vTaskDelay(1), ESP_LOGD and ssd1306_show_buffer() removed, so only
+ * CPU work is compared).
+ *
+ *     cc -O2 -I../../../host_test/stubs -I.. -o /tmp/bench_bitmap bench_bitmap.c
+ *     /tmp/bench_bitmap
+ *
+ * The current driver is compiled in from ../ssd1306.c against the host stubs
+ * of host_test/; panel I/O is stubbed out, nothing here touches a bus.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../ssd1306.c"
+
+int host_log_verbose = 0;
+
+// Panel I/O referenced by ssd1306.c, never reached by the buffer routines
+void i2c_display_image(SSD1306_t * dev, int page, int seg, uint8_t * images, int width) {}
+void i2c_contrast(SSD1306_t * dev, int contrast) {}
+void i2c_display_power(SSD1306_t * dev, bool on) {}
+void i2c_hardware_scroll(SSD1306_t * dev, ssd1306_scroll_type_t scroll) {}
+void i2c_send_commands(SSD1306_t * dev, const uint8_t * cmds, int len) {}
+void i2c_init(SSD1306_t * dev, int width, int height) {}
+void spi_display_image(SSD1306_t * dev, int page, int seg, uint8_t * images, int width) {}
+void spi_display_frame(SSD1306_t * dev) {}
+void spi_wait_done(SSD1306_t * dev) {}
+void spi_contrast(SSD1306_t * dev, int contrast) {}
+void spi_hardware_scroll(SSD1306_t * dev, ssd1306_scroll_type_t scroll) {}
+void spi_send_commands(SSD1306_t * dev, const uint8_t * cmds, int len) {}
+void spi_init(SSD1306_t * dev, int width, int height) {}
+void vTaskDelay(TickType_t ticks) {}
+
+// Helpers as they were before the blitter
+static uint8_t old_rotate_byte(uint8_t ch1)
+{
+	uint8_t ch2 = 0;
+	for (int j=0;j<8;j++) {
+		ch2 = (ch2 << 1) + (ch1 & 0x01);
+		ch1 = ch1 >> 1;
+	}
+	return ch2;
+}
+
+static uint8_t old_copy_bit(uint8_t src, int srcBits, uint8_t dst, int dstBits)
+{
+	uint8_t smask = 0x01 << srcBits;
+	uint8_t dmask = 0x01 << dstBits;
+	uint8_t _src = src & smask;
+	uint8_t _dst;
+	if (_src != 0) {
+		_dst = dst | dmask; // set bit
+	} else {
+		_dst = dst & ~(dmask); // clear bit
+	}
+	return _dst;
+}
+
+static void old_bitmaps(SSD1306_t * dev, int xpos, int ypos, uint8_t * bitmap, int width, int height, bool invert)
+{
+	int _width = width / 8;
+	uint8_t wk0;
+	uint8_t wk1;
+	uint8_t wk2;
+	uint8_t page = (ypos / 8);
+	uint8_t _seg = xpos;
+	uint8_t dstBits = (ypos % 8);
+	int offset = 0;
+	for(int _height=0;_height<height;_height++) {
+		for (int index=0;index<_width;index++) {
+			for (int srcBits=7; srcBits>=0; srcBits--) {
+				wk0 = dev->_page[page]._segs[_seg];
+				if (dev->_flip) wk0 = old_rotate_byte(wk0);
+
+				wk1 = bitmap[index+offset];
+				if (invert) wk1 = ~wk1;
+
+				wk2 = old_copy_bit(wk1, srcBits, wk0, dstBits);
+				if (dev->_flip) wk2 = old_rotate_byte(wk2);
+
+				dev->_page[page]._segs[_seg] = wk2;
+				_seg++;
+			}
+		}
+		offset = offset + _width;
+		dstBits++;
+		_seg = xpos;
+		if (dstBits == 8) {
+			page++;
+			dstBits=0;
+		}
+	}
+}
+
+// Pixel-by-pixel reference with clipping and raster ops, for what old_bitmaps() never did
+static void ref_bitmap(SSD1306_t * dev, int xpos, int ypos, const uint8_t * bitmap, int width, int height, bool invert, ssd1306_rop_t rop)
+{
+	for (int y = 0; y < height; y++) {
+		for (int x = 0; x < width; x++) {
+			int px = xpos + x, py = ypos + y;
+			if (px < 0 || px >= dev->_width || py < 0 || py >= dev->_height) continue;
+			bool on = (bitmap[y * (width / 8) + x / 8] >> (7 - x % 8)) & 1;
+			if (invert) on = !on;
+			int bit = dev->_flip ? 7 - py % 8 : py % 8;
+			uint8_t * dst = &dev->_page[py / 8]._segs[px];
+			bool cur = (*dst >> bit) & 1;
+			switch (rop) {
+			case SSD1306_ROP_OR:  on = cur || on; break;
+			case SSD1306_ROP_AND: on = cur && on; break;
+			case SSD1306_ROP_XOR: on = cur != on; break;
+			default: break;
+			}
+			*dst = on ? (*dst | (1 << bit)) : (*dst & ~(1 << bit));
+		}
+	}
+}
+
+static void panel(SSD1306_t * dev, bool flip, uint32_t seed)
+{
+	memset(dev, 0, sizeof(*dev));
+	dev->_width = 128;
+	dev->_height = 64;
+	dev->_pages = 8;
+	dev->_flip = flip;
+	srand(seed);
+	for (int p = 0; p < dev->_pages; p++)
+		for (int s = 0; s < dev->_width; s++) dev->_page[p]._segs[s] = rand();
+}
+
+static int equivalence(void)
+{
+	static SSD1306_t a, b;
+	static uint8_t bitmap[16 * 64];
+	for (int n = 0; n < 2000; n++) {
+		int width = 8 * (1 + rand() % 16);
+		int height = 1 + rand() % 64;
+		int xpos = rand() % (128 - width + 1);
+		int ypos = rand() % (64 - height + 1);
+		bool invert = rand() & 1;
+		bool flip = rand() & 1;
+		for (int i = 0; i < width / 8 * height; i++) bitmap[i] = rand();
+		uint32_t seed = rand();
+		panel(&a, flip, seed);
+		panel(&b, flip, seed);
+		old_bitmaps(&a, xpos, ypos, bitmap, width, height, invert);
+		ssd1306_buffer_bitmap(&b, xpos, ypos, bitmap, width, height, invert, SSD1306_ROP_COPY);
+		if (memcmp(a._page, b._page, sizeof(a._page)) != 0) {
+			printf("MISMATCH %dx%d at (%d,%d) invert=%d flip=%d\n", width, height, xpos, ypos, invert, flip);
+			return 1;
+		}
+	}
+	// Any position, partly or fully off the panel, every raster op
+	for (int n = 0; n < 20000; n++) {
+		int width = 8 * (1 + rand() % 16);
+		int height = 1 + rand() % 64;
+		int xpos = rand() % (128 + width + 16) - width - 8;
+		int ypos = rand() % (64 + height + 16) - height - 8;
+		bool invert = rand() & 1;
+		bool flip = rand() & 1;
+		ssd1306_rop_t rop = rand() % 4;
+		for (int i = 0; i < width / 8 * height; i++) bitmap[i] = rand();
+		uint32_t seed = rand();
+		panel(&a, flip, seed);
+		panel(&b, flip, seed);
+		ref_bitmap(&a, xpos, ypos, bitmap, width, height, invert, rop);
+		ssd1306_buffer_bitmap(&b, xpos, ypos, bitmap, width, height, invert, rop);
+		if (memcmp(a._page, b._page, sizeof(a._page)) != 0) {
+			printf("MISMATCH vs reference %dx%d at (%d,%d) invert=%d flip=%d rop=%d\n",
+				   width, height, xpos, ypos, invert, flip, rop);
+			return 1;
+		}
+	}
+	printf("equivalence: 2000 random bitmaps identical to the old routine, 20000 clipped/rop cases to a per-pixel reference\n");
+	return 0;
+}
+
+static double now_ns(void)
+{
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+typedef void (*draw_fn)(SSD1306_t * dev, int x, int y, uint8_t * bm, int w, int h);
+
+static void draw_old(SSD1306_t * dev, int x, int y, uint8_t * bm, int w, int h) { old_bitmaps(dev, x, y, bm, w, h, false); }
+static void draw_new(SSD1306_t * dev, int x, int y, uint8_t * bm, int w, int h) { ssd1306_buffer_bitmap(dev, x, y, bm, w, h, false, SSD1306_ROP_COPY); }
+
+static double time_draw(draw_fn fn, bool flip, int x, int y, uint8_t * bm, int w, int h)
+{
+	static SSD1306_t dev;
+	panel(&dev, flip, 1);
+	int iters = 1;
+	double dt;
+	// Grow the batch until it runs for at least 50 ms
+	for (;;) {
+		double t0 = now_ns();
+		for (int i = 0; i < iters; i++) {
+			fn(&dev, x, y, bm, w, h);
+			__asm__ volatile("" : : "r"(&dev) : "memory");
+		}
+		dt = now_ns() - t0;
+		if (dt > 50e6) break;
+		iters *= 2;
+	}
+	return dt / iters;
+}
+
+static void bench(const char * name, int x, int y, int w, int h)
+{
+	static uint8_t bm[16 * 64];
+	for (int i = 0; i < w / 8 * h; i++) bm[i] = rand();
+	for (int flip = 0; flip <= 1; flip++) {
+		double t_old = time_draw(draw_old, flip, x, y, bm, w, h);
+		double t_new = time_draw(draw_new, flip, x, y, bm, w, h);
+		printf("%-22s flip=%d  old %9.0f ns  new %7.0f ns  x%.1f\n", name, flip, t_old, t_new, t_old / t_new);
+	}
+}
+
+int main(void)
+{
+	srand(42);
+	if (equivalence()) return 1;
+	bench("128x64 at (0,0)", 0, 0, 128, 64);
+	bench("128x64 at (0,0) y+3", 0, 0, 128, 61);
+	bench("32x32 icon at (5,3)", 5, 3, 32, 32);
+	bench("16x16 icon at (64,16)", 64, 16, 16, 16);
+	return 0;
+}
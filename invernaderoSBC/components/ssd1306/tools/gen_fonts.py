@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+"""
+Generates ssd1306_fonts.c: proportional glyph atlases at 1x, 2x and 3x,
+pre-scaled and stored in page format so drawing a glyph is a straight copy
+into _page[]._segs.
+
+Source glyphs are font8x8_basic_tr (ASCII) plus the Latin-1 glyphs defined
+below (Spanish accents, inverted marks, degree sign).
+
+    python3 tools/gen_fonts.py > ssd1306_fonts.c
+"""
+import os
+import re
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+BASIC = os.path.join(HERE, '..', 'font8x8_basic.h')
+
+FIRST, LAST = 0x20, 0x7E        # ASCII range stored contiguously
+SPACE_WIDTH = 3                 # Columns of ' ' at 1x
+SCALES = [('small', 1), ('medium', 2), ('large', 3)]
+
+
+def load_basic():
+    glyphs = []
+    pat = re.compile(r'\{\s*((?:0x[0-9A-Fa-f]{2}\s*,?\s*){8})\}')
+    with open(BASIC) as f:
+        for line in f:
+            m = pat.search(line)
+            if m:
+                glyphs.append([int(v, 16) for v in re.findall(r'0x[0-9A-Fa-f]{2}', m.group(1))])
+    assert len(glyphs) == 128, len(glyphs)
+    return glyphs
+
+
+def art(rows):
+    """8 strings of 8 chars ('X' = on), row 0 first, to transposed columns."""
+    cols = [0] * 8
+    for y, row in enumerate(rows):
+        for x, c in enumerate(row.ljust(8, '.')):
+            if c == 'X':
+                cols[x] |= 1 << y
+    return cols
+
+
+ACUTE = art(['....XX..', '...XX...'])
+TILDE = art(['.XX.X...', 'X..XX...'])
+DIAER = art(['.XX.XX..', '........'])
+
+
+def accent(base, mark):
+    # Lowercase glyphs leave rows 0-1 free (i keeps its dot there: it is replaced)
+    return [(b & ~0x03) | m for b, m in zip(base, mark)]
+
+
+def flip_v(glyph, rows=7):
+    # Upside down within the first 'rows' rows, for ¡ and ¿
+    out = []
+    for col in glyph:
+        v = 0
+        for y in range(rows):
+            if col & (1 << y):
+                v |= 1 << (rows - 1 - y)
+        out.append(v)
+    return out
+
+
+def latin1(basic):
+    g = {}
+    for ch, base, mark in (('á', 'a', ACUTE), ('é', 'e', ACUTE), ('í', 'i', ACUTE),
+                           ('ó', 'o', ACUTE), ('ú', 'u', ACUTE), ('ñ', 'n', TILDE),
+                           ('ü', 'u', DIAER)):
+        g[ord(ch)] = accent(basic[ord(base)], mark)
+    # Uppercase fills rows 0-6: the letter is squeezed into rows 2-7 under the mark
+    for ch, base, mark in (('Á', 'A', ACUTE), ('É', 'E', ACUTE), ('Í', 'I', ACUTE),
+                           ('Ó', 'O', ACUTE), ('Ú', 'U', ACUTE), ('Ñ', 'N', TILDE)):
+        squeezed = []
+        for col, m in zip(basic[ord(base)], mark):
+            rows = [(col >> y) & 1 for y in (0, 2, 3, 4, 5, 6)]
+            v = sum(bit << (y + 2) for y, bit in enumerate(rows))
+            squeezed.append(v | m)
+        g[ord(ch)] = squeezed
+    g[ord('¡')] = flip_v(basic[ord('!')])
+    g[ord('¿')] = flip_v(list(reversed(basic[ord('?')]))[1:] + [0])
+    g[ord('°')] = art(['.XX.....', 'X..X....', 'X..X....', '.XX.....'])
+    return g
+
+
+def trim(cols):
+    lo = 0
+    while lo < len(cols) and cols[lo] == 0:
+        lo += 1
+    hi = len(cols)
+    while hi > lo and cols[hi - 1] == 0:
+        hi -= 1
+    return cols[lo:hi]
+
+
+def scale(cols, k):
+    """Scales a 1-page glyph by k; returns k pages, each a list of columns."""
+    pages = [[] for _ in range(k)]
+    for col in cols:
+        v = 0
+        for y in range(8):
+            if col & (1 << y):
+                v |= ((1 << k) - 1) << (y * k)
+        for _ in range(k):
+            for p in range(k):
+                pages[p].append((v >> (8 * p)) & 0xFF)
+    return pages
+
+
+def main():
+    basic = load_basic()
+    extra = latin1(basic)
+    codes = list(range(FIRST, LAST + 1)) + sorted(extra)
+    src = {c: basic[c] for c in range(FIRST, LAST + 1)}
+    src.update(extra)
+
+    out = sys.stdout
+    out.write('/*\n * ssd1306_fonts.c\n *\n * Generated by tools/gen_fonts.py from font8x8_basic.h. Do not edit.\n */\n\n')
+    out.write('#include "ssd1306.h"\n\n')
+    out.write('// Code points past the ASCII block, in glyph order after U+007E\n')
+    out.write('static const uint16_t extra_codes[] = {\n\t')
+    out.write(', '.join('0x%04X' % c for c in sorted(extra)))
+    out.write('\n};\n\n')
+
+    for name, k in SCALES:
+        offsets, widths, data = [], [], []
+        for c in codes:
+            cols = [0] * SPACE_WIDTH if c == 0x20 else trim(src[c])
+            pages = scale(cols, k)
+            offsets.append(len(data))
+            widths.append(len(cols) * k)
+            for p in pages:
+                data.extend(p)
+        assert len(data) < 65536
+        out.write('static const uint8_t %s_data[%d] = {\n' % (name, len(data)))
+        for i in range(0, len(data), 16):
+            out.write('\t' + ', '.join('0x%02X' % v for v in data[i:i + 16]) + ',\n')
+        out.write('};\n\n')
+        out.write('static const uint16_t %s_offset[%d] = {\n' % (name, len(offsets)))
+        for i in range(0, len(offsets), 12):
+            out.write('\t' + ', '.join('%d' % v for v in offsets[i:i + 12]) + ',\n')
+        out.write('};\n\n')
+        out.write('static const uint8_t %s_width[%d] = {\n' % (name, len(widths)))
+        for i in range(0, len(widths), 16):
+            out.write('\t' + ', '.join('%d' % v for v in widths[i:i + 16]) + ',\n')
+        out.write('};\n\n')
+        out.write('const ssd1306_font_t ssd1306_font_%s = {\n' % name)
+        out.write('\t.pages = %d,\n\t.spacing = %d,\n\t.first = 0x%02X,\n\t.last = 0x%02X,\n' % (k, k, FIRST, LAST))
+        out.write('\t.extra_codes = extra_codes,\n\t.extra_count = %d,\n' % len(extra))
+        out.write('\t.offset = %s_offset,\n\t.width = %s_width,\n\t.data = %s_data,\n};\n\n' % (name, name, name))
+
+
+if __name__ == '__main__':
+    main()
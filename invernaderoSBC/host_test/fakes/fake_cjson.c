@@ -0,0 +1,128 @@
+/*
+ * Analizador JSON mínimo con la interfaz de cJSON: objetos, arrays, números,
+ * cadenas sin escapes, true/false/null. Basta para las pruebas.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "cJSON.h"
+
+static const char *skip(const char *p) {
+    while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r') p++;
+    return p;
+}
+
+static const char *parse_value(cJSON *item, const char *p);
+
+static const char *parse_string(char **out, const char *p) {
+    if (*p != '"') return NULL;
+    const char *end = strchr(p + 1, '"');
+    if (!end) return NULL;
+    *out = strndup(p + 1, end - p - 1);
+    return end + 1;
+}
+
+// Elementos de un array u objeto hasta el cierre
+static const char *parse_children(cJSON *item, const char *p, char close, bool keys) {
+    cJSON *last = NULL;
+    p = skip(p + 1);
+    if (*p == close) return p + 1;
+    for (;;) {
+        cJSON *c = calloc(1, sizeof(*c));
+        if (last) {
+            last->next = c;
+            c->prev = last;
+        } else {
+            item->child = c;
+        }
+        last = c;
+        p = skip(p);
+        if (keys) {
+            if (!(p = parse_string(&c->string, p))) return NULL;
+            p = skip(p);
+            if (*p++ != ':') return NULL;
+        }
+        if (!(p = parse_value(c, skip(p)))) return NULL;
+        p = skip(p);
+        if (*p == close) return p + 1;
+        if (*p++ != ',') return NULL;
+    }
+}
+
+static const char *parse_value(cJSON *item, const char *p) {
+    if (*p == '{') {
+        item->type = cJSON_Object;
+        return parse_children(item, p, '}', true);
+    }
+    if (*p == '[') {
+        item->type = cJSON_Array;
+        return parse_children(item, p, ']', false);
+    }
+    if (*p == '"') {
+        item->type = cJSON_String;
+        return parse_string(&item->valuestring, p);
+    }
+    if (!strncmp(p, "true", 4)) {
+        item->type = cJSON_True;
+        item->valueint = 1;
+        return p + 4;
+    }
+    if (!strncmp(p, "false", 5)) {
+        item->type = cJSON_False;
+        return p + 5;
+    }
+    if (!strncmp(p, "null", 4)) {
+        item->type = cJSON_NULL;
+        return p + 4;
+    }
+    char *end;
+    item->valuedouble = strtod(p, &end);
+    if (end == p) return NULL;
+    item->type = cJSON_Number;
+    // Como cJSON: valueint saturado
+    if (item->valuedouble >= 2147483647.0) item->valueint = 2147483647;
+    else if (item->valuedouble <= -2147483648.0) item->valueint = -2147483647 - 1;
+    else item->valueint = (int)item->valuedouble;
+    return end;
+}
+
+cJSON *cJSON_Parse(const char *value) {
+    cJSON *root = calloc(1, sizeof(*root));
+    const char *end = value ? parse_value(root, skip(value)) : NULL;
+    if (!end || *skip(end)) {
+        cJSON_Delete(root);
+        return NULL;
+    }
+    return root;
+}
+
+void cJSON_Delete(cJSON *item) {
+    while (item) {
+        cJSON *next = item->next;
+        cJSON_Delete(item->child);
+        free(item->valuestring);
+        free(item->string);
+        free(item);
+        item = next;
+    }
+}
+
+cJSON *cJSON_GetObjectItem(const cJSON *object, const char *string) {
+    if (!object) return NULL;
+    for (cJSON *c = object->child; c; c = c->next) {
+        if (c->string && strcmp(c->string, string) == 0) return c;
+    }
+    return NULL;
+}
+
+int cJSON_GetArraySize(const cJSON *array) {
+    int n = 0;
+    for (cJSON *c = array ? array->child : NULL; c; c = c->next) n++;
+    return n;
+}
+
+cJSON *cJSON_GetArrayItem(const cJSON *array, int index) {
+    if (index < 0) return NULL;
+    cJSON *c = array ? array->child : NULL;
+    while (c && index-- > 0) c = c->next;
+    return index < 0 ? c : NULL;
+}
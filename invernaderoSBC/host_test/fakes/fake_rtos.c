@@ -0,0 +1,219 @@
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/queue.h"
+#include "esp_err.h"
+#include "esp_timer.h"
+#include "fake_rtos.h"
+
+#define FAKE_MAX_TASKS 8
+
+struct fake_queue {
+    uint8_t *buf;
+    UBaseType_t len, size, head, n;
+};
+
+struct fake_sem {
+    bool mutex;
+    UBaseType_t count, max;
+    int holder;
+};
+
+typedef struct {
+    const char *name;
+    TaskFunction_t fn;
+} fake_task_t;
+
+int host_log_verbose = 0;
+int fake_task = FAKE_TASK_MAIN;
+int64_t fake_now_us = 0;
+bool (*fake_pump)(void) = NULL;
+
+static fake_task_t s_tasks[FAKE_MAX_TASKS];
+
+void fake_fail(const char *fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    fprintf(stderr, "FALLO: ");
+    vfprintf(stderr, fmt, ap);
+    fprintf(stderr, "\n");
+    va_end(ap);
+    abort();
+}
+
+void fake_rtos_reset(void) {
+    fake_task = FAKE_TASK_MAIN;
+    fake_now_us = 0;
+    fake_pump = NULL;
+    memset(s_tasks, 0, sizeof(s_tasks));
+    host_log_verbose = getenv("HOST_TEST_VERBOSE") != NULL;
+}
+
+size_t fake_strlcpy(char *dst, const char *src, size_t size) {
+    size_t len = strlen(src);
+    if (size) {
+        size_t n = len < size - 1 ? len : size - 1;
+        memcpy(dst, src, n);
+        dst[n] = 0;
+    }
+    return len;
+}
+
+const char *esp_err_to_name(esp_err_t err) {
+    return err == ESP_OK ? "ESP_OK" : "ESP_ERR";
+}
+
+int64_t esp_timer_get_time(void) {
+    return fake_now_us;
+}
+
+TickType_t xTaskGetTickCount(void) {
+    return (TickType_t)(fake_now_us / 1000 / portTICK_PERIOD_MS);
+}
+
+void vTaskDelay(TickType_t ticks) {
+    fake_now_us += (int64_t)ticks * portTICK_PERIOD_MS * 1000;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack, void *arg,
+                       UBaseType_t prio, TaskHandle_t *out) {
+    for (int i = 0; i < FAKE_MAX_TASKS; i++) {
+        if (s_tasks[i].fn) continue;
+        s_tasks[i] = (fake_task_t){ name, fn };
+        if (out) *out = &s_tasks[i];
+        return pdPASS;
+    }
+    return pdFAIL;
+}
+
+TaskFunction_t fake_task_fn(const char *name) {
+    for (int i = 0; i < FAKE_MAX_TASKS; i++) {
+        if (s_tasks[i].fn && strcmp(s_tasks[i].name, name) == 0) return s_tasks[i].fn;
+    }
+    return NULL;
+}
+
+// Espera a que ready() se cumpla. false si vence
+static bool wait_for(bool (*ready)(void *), void *obj, TickType_t wait, const char *what) {
+    while (!ready(obj)) {
+        if (wait == 0) return false;
+        if (fake_pump && fake_pump()) continue;
+        if (wait == portMAX_DELAY) fake_fail("tarea %d bloqueada para siempre en %s", fake_task, what);
+        fake_now_us += (int64_t)wait * portTICK_PERIOD_MS * 1000;
+        return false;
+    }
+    return true;
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t len, UBaseType_t item_size) {
+    struct fake_queue *q = calloc(1, sizeof(*q));
+    q->buf = malloc((size_t)len * item_size);
+    q->len = len;
+    q->size = item_size;
+    return q;
+}
+
+void vQueueDelete(QueueHandle_t q) {
+    free(q->buf);
+    free(q);
+}
+
+static bool queue_has_room(void *obj) {
+    struct fake_queue *q = obj;
+    return q->n < q->len;
+}
+
+static bool queue_has_item(void *obj) {
+    return ((struct fake_queue *)obj)->n > 0;
+}
+
+BaseType_t xQueueSend(QueueHandle_t q, const void *item, TickType_t wait) {
+    if (!wait_for(queue_has_room, q, wait, "xQueueSend")) return pdFALSE;
+    memcpy(q->buf + ((q->head + q->n) % q->len) * q->size, item, q->size);
+    q->n++;
+    return pdTRUE;
+}
+
+BaseType_t xQueueOverwrite(QueueHandle_t q, const void *item) {
+    if (q->n == q->len) {
+        q->head = (q->head + 1) % q->len;
+        q->n--;
+    }
+    return xQueueSend(q, item, 0);
+}
+
+BaseType_t xQueuePeek(QueueHandle_t q, void *item, TickType_t wait) {
+    if (!wait_for(queue_has_item, q, wait, "xQueuePeek")) return pdFALSE;
+    memcpy(item, q->buf + q->head * q->size, q->size);
+    return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t q, void *item, TickType_t wait) {
+    if (!xQueuePeek(q, item, wait)) return pdFALSE;
+    q->head = (q->head + 1) % q->len;
+    q->n--;
+    return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q) {
+    return q->n;
+}
+
+static SemaphoreHandle_t sem_new(bool mutex, UBaseType_t max, UBaseType_t initial) {
+    struct fake_sem *s = calloc(1, sizeof(*s));
+    s->mutex = mutex;
+    s->max = max;
+    s->count = initial;
+    s->holder = -1;
+    return s;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void) {
+    return sem_new(true, 1, 1);
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void) {
+    return sem_new(false, 1, 0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t max, UBaseType_t initial) {
+    return sem_new(false, max, initial);
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t s) {
+    free(s);
+}
+
+static bool sem_available(void *obj) {
+    return ((struct fake_sem *)obj)->count > 0;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t s, TickType_t wait) {
+    if (s->mutex && s->holder == fake_task) fake_fail("tarea %d toma dos veces el mismo mutex", fake_task);
+    if (!sem_available(s) && s->mutex && wait == portMAX_DELAY && !fake_pump) {
+        fake_fail("interbloqueo: tarea %d espera un mutex de la tarea %d", fake_task, s->holder);
+    }
+    if (!wait_for(sem_available, s, wait, s->mutex ? "un mutex" : "un semáforo")) return pdFALSE;
+    s->count--;
+    if (s->mutex) s->holder = fake_task;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t s) {
+    if (s->mutex) {
+        if (s->holder != fake_task) fake_fail("tarea %d suelta un mutex de la tarea %d", fake_task, s->holder);
+        s->holder = -1;
+    }
+    if (s->count >= s->max) return pdFALSE;
+    s->count++;
+    return pdTRUE;
+}
+
+UBaseType_t uxSemaphoreGetCount(SemaphoreHandle_t s) {
+    return s->count;
+}
+
+int fake_mutex_holder(SemaphoreHandle_t s) {
+    return s->holder;
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+/*
+ * FreeRTOS simulado en un solo hilo.
+ *
+ * La prueba hace de planificador: fake_task dice qué tarea está corriendo y,
+ * cuando una espera bloquearía, se llama a fake_pump para que avancen las
+ * demás. Si nada avanza, una espera acotada vence (y el reloj avanza lo
+ * esperado) y una espera sin límite es un bloqueo: la prueba aborta. Tomar un
+ * mutex que tiene otra tarea sin que nadie lo suelte es un interbloqueo.
+ */
+
+#define FAKE_TASK_MAIN  0
+
+extern int fake_task;
+extern int64_t fake_now_us;
+extern bool (*fake_pump)(void);     // true si algo avanzó
+
+void fake_rtos_reset(void);
+// Tarea que tiene el mutex, -1 si está libre
+int fake_mutex_holder(SemaphoreHandle_t s);
+// Tareas creadas con xTaskCreate (no se ejecutan solas)
+TaskFunction_t fake_task_fn(const char *name);
+void fake_fail(const char *fmt, ...) __attribute__((noreturn, format(printf, 1, 2)));
+
+// newlib (ESP-IDF) tiene strlcpy; glibc solo desde 2.38
+size_t fake_strlcpy(char *dst, const char *src, size_t size);
+#define strlcpy fake_strlcpy
+
+#define CHECK(cond) do { if (!(cond)) fake_fail("%s:%d: %s", __FILE__, __LINE__, #cond); } while (0)
@@ -0,0 +1,39 @@
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+
+// Lo justo de cJSON; el analizador está en fakes/fake_cjson.c
+#define cJSON_False  (1 << 0)
+#define cJSON_True   (1 << 1)
+#define cJSON_NULL   (1 << 2)
+#define cJSON_Number (1 << 3)
+#define cJSON_String (1 << 4)
+#define cJSON_Array  (1 << 5)
+#define cJSON_Object (1 << 6)
+
+typedef struct cJSON {
+    struct cJSON *next;
+    struct cJSON *prev;
+    struct cJSON *child;
+    int type;
+    char *valuestring;
+    int valueint;
+    double valuedouble;
+    char *string;
+} cJSON;
+
+cJSON *cJSON_Parse(const char *value);
+void cJSON_Delete(cJSON *item);
+cJSON *cJSON_GetObjectItem(const cJSON *object, const char *string);
+int cJSON_GetArraySize(const cJSON *array);
+cJSON *cJSON_GetArrayItem(const cJSON *array, int index);
+
+static inline bool cJSON_IsBool(const cJSON *item) { return item && (item->type & (cJSON_True | cJSON_False)); }
+static inline bool cJSON_IsTrue(const cJSON *item) { return item && (item->type & cJSON_True); }
+static inline bool cJSON_IsNumber(const cJSON *item) { return item && (item->type & cJSON_Number); }
+static inline bool cJSON_IsString(const cJSON *item) { return item && (item->type & cJSON_String); }
+static inline bool cJSON_IsArray(const cJSON *item) { return item && (item->type & cJSON_Array); }
+static inline bool cJSON_IsObject(const cJSON *item) { return item && (item->type & cJSON_Object); }
+
+#define cJSON_ArrayForEach(element, array) \
+    for (element = (array) ? (array)->child : NULL; element; element = element->next)
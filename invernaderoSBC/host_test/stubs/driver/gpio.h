@@ -0,0 +1,15 @@
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+typedef int gpio_num_t;
+typedef enum { GPIO_MODE_INPUT, GPIO_MODE_OUTPUT, GPIO_MODE_INPUT_OUTPUT, GPIO_MODE_INPUT_OUTPUT_OD, GPIO_MODE_OUTPUT_OD } gpio_mode_t;
+typedef enum { GPIO_INTR_DISABLE } gpio_int_type_t;
+typedef struct { uint64_t pin_bit_mask; gpio_mode_t mode; int pull_up_en; int pull_down_en; gpio_int_type_t intr_type; } gpio_config_t;
+esp_err_t gpio_reset_pin(gpio_num_t); esp_err_t gpio_set_direction(gpio_num_t, gpio_mode_t);
+esp_err_t gpio_set_level(gpio_num_t, uint32_t); int gpio_get_level(gpio_num_t);
+esp_err_t gpio_config(const gpio_config_t*);
+esp_err_t gpio_set_pull_mode(gpio_num_t, int);
+#define GPIO_PULLUP_ONLY 0
@@ -0,0 +1,24 @@
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+typedef struct i2c_master_bus_t *i2c_master_bus_handle_t;
+typedef struct i2c_master_dev_t *i2c_master_dev_handle_t;
+typedef int i2c_port_num_t;
+#define I2C_NUM_0 0
+#define I2C_CLK_SRC_DEFAULT 0
+typedef enum { I2C_ADDR_BIT_LEN_7 } i2c_addr_bit_len_t;
+typedef struct { int clk_source; i2c_port_num_t i2c_port; int scl_io_num; int sda_io_num; int glitch_ignore_cnt; int intr_priority; size_t trans_queue_depth; struct { uint32_t enable_internal_pullup:1; } flags; } i2c_master_bus_config_t;
+typedef struct { i2c_addr_bit_len_t dev_addr_length; uint16_t device_address; uint32_t scl_speed_hz; uint32_t scl_wait_us; } i2c_device_config_t;
+esp_err_t i2c_new_master_bus(const i2c_master_bus_config_t*, i2c_master_bus_handle_t*);
+esp_err_t i2c_del_master_bus(i2c_master_bus_handle_t);
+esp_err_t i2c_master_bus_add_device(i2c_master_bus_handle_t, const i2c_device_config_t*, i2c_master_dev_handle_t*);
+esp_err_t i2c_master_bus_rm_device(i2c_master_dev_handle_t);
+esp_err_t i2c_master_probe(i2c_master_bus_handle_t, uint16_t, int);
+esp_err_t i2c_master_transmit(i2c_master_dev_handle_t, const uint8_t*, size_t, int);
+esp_err_t i2c_master_transmit_receive(i2c_master_dev_handle_t, const uint8_t*, size_t, uint8_t*, size_t, int);
+esp_err_t i2c_master_receive(i2c_master_dev_handle_t, uint8_t*, size_t, int);
+esp_err_t i2c_master_bus_reset(i2c_master_bus_handle_t);
+esp_err_t i2c_master_bus_wait_all_done(i2c_master_bus_handle_t, int);
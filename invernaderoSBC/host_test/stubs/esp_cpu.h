@@ -0,0 +1,10 @@
+#pragma once
+#include <stdint.h>
+#include <time.h>
+
+// En el host cuenta nanosegundos del reloj monótono: sirve para comparar codificadores
+static inline uint32_t esp_cpu_get_cycle_count(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000000000ull + ts.tv_nsec);
+}
@@ -0,0 +1,11 @@
+#pragma once
+#include <stdio.h>
+#include "esp_err.h"
+
+// Mudos salvo HOST_TEST_VERBOSE; el formato se sigue comprobando
+extern int host_log_verbose;
+#define HOST_LOG(tag, fmt, ...) do { if (host_log_verbose) printf("%s: " fmt "\n", tag, ##__VA_ARGS__); } while (0)
+#define ESP_LOGE(tag, fmt, ...) HOST_LOG(tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...) HOST_LOG(tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGI(tag, fmt, ...) HOST_LOG(tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGD(tag, fmt, ...) HOST_LOG(tag, fmt, ##__VA_ARGS__)
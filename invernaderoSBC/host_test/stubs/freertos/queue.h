@@ -0,0 +1,12 @@
+#pragma once
+#include "freertos/FreeRTOS.h"
+
+typedef struct fake_queue *QueueHandle_t;
+
+QueueHandle_t xQueueCreate(UBaseType_t len, UBaseType_t item_size);
+void vQueueDelete(QueueHandle_t q);
+BaseType_t xQueueSend(QueueHandle_t q, const void *item, TickType_t wait);
+BaseType_t xQueueOverwrite(QueueHandle_t q, const void *item);
+BaseType_t xQueueReceive(QueueHandle_t q, void *item, TickType_t wait);
+BaseType_t xQueuePeek(QueueHandle_t q, void *item, TickType_t wait);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q);
@@ -0,0 +1,333 @@
+/*
+ * Motor de alarmas segundo a segundo: umbrales de disparo y de vuelta con su
+ * histéresis, tiempos on_s/off_s, un solo aviso por transición, el intervalo
+ * mínimo con una entrada que oscila, el rearme de humid_continuo, la edad del
+ * sensor sin ninguna lectura, el recompilado al cambiar la fase y las forzadas.
+ */
+#include <stdio.h>
+#include "fake_rtos.h"
+#include "alarms.c"
+
+#define S(x) ((int64_t)(x) * 1000000)
+
+FaseCultivo fase_germinacion = {"Germinacion", 24.0, 28.0, 60.0, 70.0, 150.0};
+FaseCultivo fase_fructificacion = {"Fructificacion", 18.0, 23.0, 90.0, 95.0, 150.0};
+FaseCultivo *fase_actual = &fase_germinacion;
+
+int64_t time_epoch_ms(int64_t mono_us) {
+    return 0;
+}
+
+typedef struct {
+    int64_t t_us;
+    int rule;
+    bool raised;
+} seen_t;
+
+static alarm_inputs_t s_in;
+static bool s_fresh;                // Llega una lectura válida en cada segundo
+static int64_t s_now;
+static seen_t s_seen[512];
+static int s_seen_n;
+
+static int rule(const char *name) {
+    for (int i = 0; i < RULE_COUNT; i++) {
+        if (strcmp(s_rules[i].name, name) == 0) return i;
+    }
+    fake_fail("regla %s", name);
+}
+
+static void reset(void) {
+    memset(s_state, 0, sizeof(s_state));
+    memset(&s_stats, 0, sizeof(s_stats));
+    s_compiled = false;
+    s_overrides = 0;
+    s_fan_since = s_humid_since = 0;
+    fase_actual = &fase_germinacion;
+    s_in = (alarm_inputs_t){ .temp = 26.0f, .hum = 65.0f, .dew_margin = 5.0f, .iaq = 50 };
+    s_fresh = true;
+    s_now = S(1000);
+    s_seen_n = 0;
+}
+
+static void run(int seconds) {
+    alarm_event_t ev[ALARM_MAX_EVENTS];
+    for (int s = 0; s < seconds; s++) {
+        s_now += S(1);
+        if (s_fresh) s_in.sample_us = s_now;
+        int n = alarms_evaluate(&s_in, s_now, ev, ALARM_MAX_EVENTS);
+        for (int i = 0; i < n; i++) {
+            const alarm_rule_t *r = &s_rules[ev[i].rule];
+            CHECK(ev[i].t_us == s_now && ev[i].limit == s_comp[ev[i].rule].on);
+            CHECK(ev[i].actions == (r->actions & ALARM_ACT_NOTIFY) && ev[i].actions);
+            CHECK(s_seen_n < (int)(sizeof(s_seen) / sizeof(s_seen[0])));
+            s_seen[s_seen_n++] = (seen_t){ s_now, ev[i].rule, ev[i].raised };
+        }
+    }
+}
+
+static bool active(int r) {
+    alarm_stats_t st;
+    alarms_get_stats(&st);
+    CHECK(!!(st.active & (1u << r)) == s_state[r].active);
+    return s_state[r].active;
+}
+
+// Disparo en el segundo on_s + 1 de condición y vuelta en el off_s + 1, solo por fuera de la histéresis
+static void test_thresholds(void) {
+    reset();
+    int r = rule("temp_alta");
+    run(1);
+    CHECK(s_comp[r].on == 30.0f && s_comp[r].off == 29.0f);
+
+    s_in.temp = 30.0f;                  // Justo en el umbral: no lo cruza
+    run(1000);
+    CHECK(!active(r));
+    s_in.temp = 30.1f;
+    run(200);
+    s_in.temp = 29.5f;                  // Un respiro reinicia la cuenta
+    run(1);
+    s_in.temp = 30.1f;
+    run(300);
+    CHECK(!active(r) && s_seen_n == 0);
+    run(1);
+    CHECK(active(r) && s_seen_n == 1 && s_seen[0].rule == r && s_seen[0].raised);
+
+    run(3600);                          // Sigue activa: ningún aviso más
+    s_in.temp = 29.5f;                  // Dentro de la histéresis: sigue activa
+    run(3600);
+    CHECK(active(r) && s_seen_n == 1);
+    s_in.temp = 28.9f;
+    run(120);
+    CHECK(active(r));
+    run(1);
+    CHECK(!active(r) && s_seen_n == 2 && !s_seen[1].raised);
+
+    // temp_baja por abajo: on 22, off 23
+    int b = rule("temp_baja");
+    CHECK(s_comp[b].on == 22.0f && s_comp[b].off == 23.0f);
+    s_in.temp = 21.9f;
+    run(301);
+    CHECK(active(b));
+    s_in.temp = 22.9f;
+    run(1000);
+    CHECK(active(b));
+    s_in.temp = 23.1f;
+    run(121);
+    CHECK(!active(b) && s_seen_n == 4);
+
+    alarm_stats_t st;
+    alarms_get_stats(&st);
+    CHECK(st.raised == 2 && st.notified == 4 && st.suppressed == 0);
+    printf("alarms: umbrales, histéresis y tiempos: ok\n");
+}
+
+// Nuevo disparo a gap segundos de la vuelta a normal avisada: ¿se avisa?
+static bool raise_after_clear(int gap) {
+    reset();
+    int r = rule("temp_alta");
+    s_in.temp = 31.0f;
+    run(301);
+    s_in.temp = 26.0f;
+    run(121);
+    CHECK(s_seen_n == 2);
+    int64_t cleared = s_seen[1].t_us;
+    run((int)((cleared + S(gap - 301) - s_now) / 1000000));
+    s_in.temp = 31.0f;
+    run(301);
+    CHECK(active(r) && s_now == cleared + S(gap));
+    return s_seen_n == 3;
+}
+
+// Entrada oscilando alrededor del umbral
+static void test_flapping(void) {
+    reset();
+    int r = rule("temp_alta");
+    const alarm_rule_t *rr = &s_rules[r];
+
+    // Más rápido que on_s: nunca llega a disparar
+    for (int i = 0; i < 720; i++) {
+        s_in.temp = (i & 1) ? 31.0f : 26.0f;
+        run(30);
+    }
+    CHECK(!active(r) && s_seen_n == 0);
+
+    // Lo justo para disparar y rearmar en cada ciclo
+    int raised = 0;
+    for (int i = 0; i < 100; i++) {
+        s_in.temp = 31.0f;
+        run(rr->on_s + 1);
+        CHECK(active(r));
+        raised++;
+        s_in.temp = 26.0f;
+        run(rr->off_s + 1);
+        CHECK(!active(r));
+    }
+
+    alarm_stats_t st;
+    alarms_get_stats(&st);
+    CHECK(st.raised == (uint32_t)raised);
+    int notified_raises = 0;
+    int64_t last = 0;
+    for (int i = 0; i < s_seen_n; i++) {
+        CHECK(s_seen[i].rule == r);
+        if (s_seen[i].raised) {
+            CHECK(!last || s_seen[i].t_us - last >= S(rr->min_gap_s));
+            notified_raises++;
+            // Cada disparo avisado tiene su vuelta a normal avisada, y nada entre medias
+            CHECK(i + 1 < s_seen_n && !s_seen[i + 1].raised);
+        } else {
+            CHECK(i > 0 && s_seen[i - 1].raised);
+        }
+        last = s_seen[i].t_us;
+    }
+    // Ciclo de 422 s y 1800 s desde la última vuelta avisada: uno de cada cinco
+    CHECK(notified_raises == 20);
+    CHECK(st.suppressed == (uint32_t)(raised - notified_raises));
+    CHECK(st.notified == (uint32_t)s_seen_n);
+    CHECK(!raise_after_clear(rr->min_gap_s - 1));
+    CHECK(raise_after_clear(rr->min_gap_s));
+    printf("alarms: %d disparos oscilando, %d avisados, %lu silenciados: ok\n",
+           raised, notified_raises, (unsigned long)st.suppressed);
+}
+
+// Se fuerza el apagado; al volver a encenderlo durante 1800 s vuelve a disparar
+static void test_humid_rearm(void) {
+    reset();
+    int r = rule("humid_continuo");
+    s_in.humid = true;
+    run(1801);
+    CHECK(!active(r));
+    run(1);
+    CHECK(active(r) && (alarms_overrides() & ALARM_ACT_HUMID_OFF) && s_seen_n == 1);
+
+    // Apagado más corto que off_s: sigue activa
+    s_in.humid = false;
+    run(300);
+    s_in.humid = true;
+    run(60);
+    CHECK(active(r) && (alarms_overrides() & ALARM_ACT_HUMID_OFF));
+
+    s_in.humid = false;
+    run(600);
+    CHECK(active(r));
+    run(1);
+    CHECK(!active(r) && !(alarms_overrides() & ALARM_ACT_HUMID_OFF) && s_seen_n == 2);
+
+    // Rearmada: vuelve a forzar aunque el aviso quede silenciado por el intervalo
+    s_in.humid = true;
+    run(1802);
+    CHECK(active(r) && (alarms_overrides() & ALARM_ACT_HUMID_OFF) && s_seen_n == 2);
+    alarm_stats_t st;
+    alarms_get_stats(&st);
+    CHECK(st.raised == 2 && st.suppressed == 1);
+    s_in.humid = false;
+    run(601);
+    CHECK(!active(r) && s_seen_n == 2);
+    printf("alarms: humid_continuo rearmada: ok\n");
+}
+
+static void test_sensor_age(void) {
+    reset();
+    int r = rule("sensor"), t = rule("temp_alta");
+
+    // Sin ninguna lectura cuenta el uptime y las reglas de T/H no se evalúan
+    s_now = 0;
+    s_fresh = false;
+    s_in.sample_us = 0;
+    s_in.temp = 40.0f;
+    run(60);
+    CHECK(!active(r));
+    run(1);
+    CHECK(active(r) && s_seen_n == 1 && s_seen[0].rule == r);
+    run(1000);
+    CHECK(!active(t) && s_seen_n == 1);
+
+    // Primera lectura: normaliza al momento
+    s_in.temp = 26.0f;
+    s_fresh = true;
+    run(1);
+    CHECK(!active(r) && s_seen_n == 2 && !s_seen[1].raised);
+
+    // temp_alta activa y el sensor se calla: la regla conserva su estado
+    s_in.temp = 31.0f;
+    run(301);
+    CHECK(active(t));
+    s_fresh = false;
+    s_in.temp = 20.0f;                  // Dato viejo: no cuenta
+    run(60);
+    CHECK(!active(r) && active(t));
+    run(1);
+    CHECK(active(r) && active(t));
+    run(3600);
+    CHECK(active(t));
+    printf("alarms: edad del sensor: ok\n");
+}
+
+// Los umbrales relativos siguen a la fase, también si cambia en el sitio (receta)
+static void test_phase(void) {
+    reset();
+    int r = rule("temp_alta"), h = rule("hum_baja");
+    FaseCultivo receta = fase_germinacion;
+    fase_actual = &receta;
+    run(1);
+    CHECK(s_comp[r].on == 30.0f && s_comp[h].on == 50.0f && s_comp[h].off == 53.0f);
+
+    receta.temp_max = 23.0f;
+    receta.hum_min = 90.0f;
+    run(1);
+    CHECK(s_comp[r].on == 25.0f && s_comp[h].on == 80.0f);
+    run(300);
+    CHECK(active(r) && !active(h));
+    run(300);
+    CHECK(active(h));
+
+    fase_actual = &fase_germinacion;
+    run(121);
+    CHECK(!active(r) && !active(h));
+    printf("alarms: cambio de fase: ok\n");
+}
+
+static void test_overrides(void) {
+    reset();
+    int q = rule("iaq_alto"), u = rule("humid_continuo");
+    CHECK(alarms_overrides() == 0);
+    s_in.iaq = 260;
+    run(601);
+    CHECK(active(q) && alarms_overrides() == ALARM_ACT_FAN_ON);
+    // iaq_alto solo avisa por MQTT
+    CHECK(s_seen_n == 1 && s_seen[0].rule == q);
+    s_in.humid = true;
+    run(1802);
+    CHECK(alarms_overrides() == (ALARM_ACT_FAN_ON | ALARM_ACT_HUMID_OFF));
+
+    s_in.iaq = -1;                      // Sin dato: se mantiene
+    run(1000);
+    CHECK(active(q));
+    s_in.iaq = 180;
+    s_in.humid = false;
+    run(301);
+    CHECK(!active(q) && active(u) && alarms_overrides() == ALARM_ACT_HUMID_OFF);
+    run(300);
+    CHECK(alarms_overrides() == 0);
+
+    char buf[2048];
+    alarm_event_t ev = { .rule = q, .raised = true, .value = 260.0f };
+    CHECK(alarms_format_json(&ev, buf, sizeof(buf)) > 0);
+    CHECK(strcmp(buf, "{\"alarm\":\"iaq_alto\",\"alarm_active\":1,\"alarm_value\":260.00}") == 0);
+    int len = alarms_format_rules_json(buf, sizeof(buf));
+    CHECK(len > 0 && len == (int)strlen(buf));
+    CHECK(alarms_format_rules_json(buf, len) == -1);
+    printf("alarms: forzadas: ok\n");
+}
+
+int main(void) {
+    fake_rtos_reset();
+    test_thresholds();
+    test_flapping();
+    test_humid_rearm();
+    test_sensor_age();
+    test_phase();
+    test_overrides();
+    return 0;
+}
@@ -0,0 +1,93 @@
+/*
+ * chart_sparkline sobre el histórico real y un panel simulado que solo anota
+ * los tramos verticales: paneles de 128x64, 128x32 y 96x64. Cada columna cae
+ * dentro del ancho del panel, la más reciente en la última, y las páginas que
+ * el panel no tiene se recortan en lugar de dibujarse fuera.
+ */
+#include <stdio.h>
+#include "fake_rtos.h"
+#include "history.c"
+#include "chart.c"
+
+#define SAMPLES     500     // Más que HISTORY_CAPACITY: el anillo ya ha dado la vuelta
+
+static int s_spans, s_col_min, s_col_max;
+static int s_y_min, s_y_max;
+static bool s_cols[SSD1306_MAX_WIDTH * 2];
+
+int ssd1306_get_width(SSD1306_t *dev) { return dev->_width; }
+int ssd1306_get_pages(SSD1306_t *dev) { return dev->_pages; }
+
+void ssd1306_buffer_vspan(SSD1306_t *dev, int seg, int y0, int y1, bool invert) {
+    CHECK(seg >= -SSD1306_MAX_WIDTH && seg < SSD1306_MAX_WIDTH);
+    CHECK(y0 <= y1 && !invert);
+    CHECK(!s_cols[seg + SSD1306_MAX_WIDTH]);    // Una sola pasada por columna
+    s_cols[seg + SSD1306_MAX_WIDTH] = true;
+    if (!s_spans || seg < s_col_min) s_col_min = seg;
+    if (!s_spans || seg > s_col_max) s_col_max = seg;
+    if (!s_spans || y0 < s_y_min) s_y_min = y0;
+    if (!s_spans || y1 > s_y_max) s_y_max = y1;
+    s_spans++;
+}
+
+static SSD1306_t panel(int width, int height) {
+    return (SSD1306_t){ ._width = width, ._height = height, ._pages = height / 8 };
+}
+
+static chart_result_t draw(SSD1306_t *dev, int page, int pages) {
+    s_spans = 0;
+    memset(s_cols, 0, sizeof(s_cols));
+    chart_result_t r;
+    chart_sparkline(dev, HISTORY_HUM, page, pages, 500, &r);
+    return r;
+}
+
+// Todas las columnas dentro del panel, sin huecos y la última a la derecha
+static void check_columns(SSD1306_t *dev, const chart_result_t *r) {
+    int width = ssd1306_get_width(dev);
+    int per_col = (HISTORY_CAPACITY + width - 1) / width;
+    CHECK(s_spans > 0 && s_col_min >= 0 && s_col_max == width - 1);
+    CHECK(s_spans == s_col_max - s_col_min + 1);
+    CHECK(r->n <= width * per_col && r->n >= (s_spans - 2) * per_col + 2);     // Primera y última a medias
+    if (s_spans < width) CHECK(r->n == HISTORY_CAPACITY);      // Cabe todo el histórico
+}
+
+int main(void) {
+    fake_rtos_reset();
+    SSD1306_t p64 = panel(128, 64), p32 = panel(128, 32), p96 = panel(96, 64);
+
+    // Sin histórico no se dibuja nada
+    chart_result_t r = draw(&p64, 5, 3);
+    CHECK(r.n == 0 && s_spans == 0);
+
+    for (int i = 0; i < SAMPLES; i++) {
+        history_sample_t s = { .t_us = fake_now_us, .temperature = 20.0f, .humidity = 50.0f + (i % 60) * 0.5f };
+        history_push(&s);
+        fake_now_us += 5000000;
+    }
+
+    // 128x64: H en las páginas 5-7, como en la vista de gráficas
+    r = draw(&p64, 5, 3);
+    check_columns(&p64, &r);
+    CHECK(s_y_min >= 40 && s_y_max <= 63 && s_y_min < s_y_max);
+    CHECK(r.last == (int16_t)((50.0f + ((SAMPLES - 1) % 60) * 0.5f) * 100));
+
+    // 128x32: las páginas 5-7 no existen y 3-5 se quedan en la 3
+    r = draw(&p32, 5, 3);
+    CHECK(r.n == 0 && s_spans == 0);
+    r = draw(&p32, 3, 3);
+    check_columns(&p32, &r);
+    CHECK(s_y_min >= 24 && s_y_max <= 31);
+    r = draw(&p32, 1, 1);
+    check_columns(&p32, &r);
+    CHECK(s_y_min >= 8 && s_y_max <= 15);
+
+    // 96 de ancho: más muestras por columna y la última en la 95
+    r = draw(&p96, 1, 3);
+    check_columns(&p96, &r);
+    CHECK(s_y_min >= 8 && s_y_max <= 31);
+    int spans96 = s_spans;
+
+    printf("chart: 128x64, 128x32 recortada y 96x64 (%d columnas): ok\n", spans96);
+    return 0;
+}
@@ -0,0 +1,153 @@
+/*
+ * Cadena de filtrado: rechazo de picos por la mediana, respuesta a escalón,
+ * detector de valor atascado y límite de pendiente. Al final mide el coste
+ * por muestra en el host (ns y ciclos de TSC en x86).
+ */
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "fake_rtos.h"
+#include "filter.c"
+
+#define PERIOD_US   5000000     // Una lectura cada 5 s, como el bucle principal
+
+// Igual que filtro_cfg_temp de main.c
+static const filter_config_t cfg_temp = {
+    .min = -20.0f, .max = 70.0f, .median_n = 3, .ema_alpha = 0.5f,
+    .max_rate = 0.1f, .stuck_eps = 0.001f, .stuck_count = 60,
+};
+
+static void test_spike(void) {
+    // Un pico aislado en cualquier posición no llega a la salida
+    for (int at = 1; at < 10; at++) {
+        filter_t f;
+        filter_init(&f, &cfg_temp);
+        for (int i = 0; i < 10; i++) {
+            float raw = (i == at) ? 60.0f : 20.0f;
+            CHECK(filter_update(&f, raw, (int64_t)i * PERIOD_US, NULL) == 20.0f);
+        }
+    }
+    // Fuera de rango o NaN: se descarta y se mantiene la salida
+    filter_t f;
+    filter_status_t st;
+    filter_init(&f, &cfg_temp);
+    filter_update(&f, 20.0f, 0, &st);
+    CHECK(filter_update(&f, 85.0f, PERIOD_US, &st) == 20.0f && st == FILTER_REJECTED);
+    CHECK(filter_update(&f, NAN, 2 * PERIOD_US, &st) == 20.0f && st == FILTER_REJECTED);
+    CHECK(f.rejected == 2);
+}
+
+static void test_step(void) {
+    // Cadena de main.c: 20 -> 25 C llega a 24.9 en 13 lecturas (1 de retardo de la
+    // mediana, 8 a 0.5 C/lectura por max_rate y la cola de la EMA), sin sobrepasar
+    filter_t f;
+    filter_init(&f, &cfg_temp);
+    filter_update(&f, 20.0f, 0, NULL);
+    int reads = 0;
+    float prev = 20.0f, out = 20.0f;
+    while (out < 24.9f && reads < 100) {
+        reads++;
+        out = filter_update(&f, 25.0f, (int64_t)reads * PERIOD_US, NULL);
+        CHECK(out >= prev && out <= 25.0f);
+        prev = out;
+    }
+    CHECK(reads == 13);
+
+    // Solo EMA (sin mediana ni límite): out_k = 25 - 5 (1 - a)^k
+    const filter_config_t ema = { .min = -20.0f, .max = 70.0f, .median_n = 1, .ema_alpha = 0.3f };
+    filter_init(&f, &ema);
+    filter_update(&f, 20.0f, 0, NULL);
+    for (int k = 1; k <= 20; k++) {
+        out = filter_update(&f, 25.0f, (int64_t)k * PERIOD_US, NULL);
+        CHECK(fabsf(out - (25.0f - 5.0f * powf(1.0f - ema.ema_alpha, k))) < 1e-4f);
+    }
+}
+
+static void test_rate_clamp(void) {
+    // Sin suavizado, la pendiente es exactamente max_rate * dt, también con dt irregular
+    const filter_config_t c = { .min = 0.0f, .max = 100.0f, .median_n = 1, .ema_alpha = 1.0f, .max_rate = 0.2f };
+    filter_t f;
+    filter_init(&f, &c);
+    filter_update(&f, 10.0f, 0, NULL);
+    const int64_t dts[] = { 5000000, 1000000, 12000000, 5000000, 2500000 };
+    int64_t t = 0;
+    float out = 10.0f;
+    for (size_t i = 0; i < sizeof(dts) / sizeof(dts[0]); i++) {
+        t += dts[i];
+        float next = filter_update(&f, 90.0f, t, NULL);
+        CHECK(fabsf(next - out - c.max_rate * dts[i] / 1e6f) < 1e-4f);
+        out = next;
+    }
+    // Bajando igual, y un salto dentro del límite pasa entero
+    t += 5000000;
+    CHECK(fabsf(filter_update(&f, 0.0f, t, NULL) - (out - 1.0f)) < 1e-4f);
+    out -= 1.0f;
+    t += 5000000;
+    CHECK(fabsf(filter_update(&f, out + 0.5f, t, NULL) - (out + 0.5f)) < 1e-4f);
+}
+
+static void test_stuck(void) {
+    filter_t f;
+    filter_status_t st;
+    filter_init(&f, &cfg_temp);
+    // La primera lectura es la referencia; salta al repetirse stuck_count veces más
+    int first_stuck = -1;
+    for (int i = 0; i <= cfg_temp.stuck_count + 5; i++) {
+        filter_update(&f, 21.37f, (int64_t)i * PERIOD_US, &st);
+        if (st == FILTER_STUCK && first_stuck < 0) first_stuck = i;
+        if (first_stuck >= 0) CHECK(st == FILTER_STUCK);
+    }
+    CHECK(first_stuck == cfg_temp.stuck_count);
+    // Cualquier cambio mayor que stuck_eps lo rearma
+    filter_update(&f, 21.40f, 100 * (int64_t)PERIOD_US, &st);
+    CHECK(st == FILTER_OK && f.same_count == 0);
+    // Los topes del rango no cuentan (100 %RH saturado es legítimo)
+    const filter_config_t hum = {
+        .min = 0.0f, .max = 100.0f, .median_n = 3, .ema_alpha = 0.5f, .stuck_eps = 0.001f, .stuck_count = 60,
+    };
+    filter_init(&f, &hum);
+    for (int i = 0; i < 500; i++) {
+        filter_update(&f, 100.0f, (int64_t)i * PERIOD_US, &st);
+        CHECK(st == FILTER_OK);
+    }
+}
+
+static void bench(void) {
+    enum { N = 2000000 };
+    filter_t f;
+    filter_init(&f, &cfg_temp);
+    volatile float sink = 0;
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+#if defined(__x86_64__) || defined(__i386__)
+    uint64_t c0 = __rdtsc();
+#endif
+    for (int i = 0; i < N; i++) {
+        sink += filter_update(&f, 20.0f + (float)(i % 7) * 0.01f, (int64_t)i * PERIOD_US, NULL);
+    }
+#if defined(__x86_64__) || defined(__i386__)
+    uint64_t cycles = __rdtsc() - c0;
+#endif
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double ns = ((t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec)) / N;
+#if defined(__x86_64__) || defined(__i386__)
+    printf("filter: %.1f ns/muestra, %.0f ciclos TSC/muestra (host)\n", ns, (double)cycles / N);
+#else
+    printf("filter: %.1f ns/muestra (host)\n", ns);
+#endif
+    (void)sink;
+}
+
+int main(void) {
+    fake_rtos_reset();
+    test_spike();
+    test_step();
+    test_rate_clamp();
+    test_stuck();
+    bench();
+    printf("filter: ok\n");
+    return 0;
+}
@@ -0,0 +1,315 @@
+/*
+ * Gestor del bus I2C con un bus simulado: orden por prioridad, fusión de las
+ * escrituras del OLED (comandos seguidos y comandos + datos en forma Co),
+ * cuándo no se funde, un callback por petición, estadísticas y las reglas de
+ * i2c_merge_writes. La tarea del bus corre dentro de las esperas de quien
+ * pide (fake_pump), una petición por vuelta.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "fake_rtos.h"
+#include "i2c_bus.c"
+#undef TAG
+#include "ssd1306_i2c.c"
+
+#define TASK_BUS    1
+#define ADDR_OLED   0x3C
+#define ADDR_BME    0x76
+#define US_PER_BYTE 90      // 100 kHz
+
+typedef struct {
+    uint16_t addr;
+    bool read;
+    size_t len;
+    uint8_t b[I2C_BUS_MERGE_MAX];
+} xfer_t;
+
+static xfer_t s_log[64];
+static int s_nlog;
+static int s_cb_ok, s_cb_err;
+
+// --- Bus simulado: siempre con las líneas arriba y todos contestan ---
+esp_err_t i2c_new_master_bus(const i2c_master_bus_config_t *c, i2c_master_bus_handle_t *b) {
+    *b = (i2c_master_bus_handle_t)1;
+    return ESP_OK;
+}
+esp_err_t i2c_del_master_bus(i2c_master_bus_handle_t b) { return ESP_OK; }
+esp_err_t i2c_master_bus_add_device(i2c_master_bus_handle_t b, const i2c_device_config_t *c, i2c_master_dev_handle_t *d) {
+    *d = (i2c_master_dev_handle_t)(uintptr_t)c->device_address;
+    return ESP_OK;
+}
+esp_err_t i2c_master_bus_rm_device(i2c_master_dev_handle_t d) { return ESP_OK; }
+esp_err_t i2c_master_bus_reset(i2c_master_bus_handle_t b) { return ESP_OK; }
+esp_err_t i2c_master_probe(i2c_master_bus_handle_t b, uint16_t a, int t) {
+    return (a == ADDR_OLED || a == ADDR_BME) ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
+
+static xfer_t *log_xfer(i2c_master_dev_handle_t d, bool read, const uint8_t *b, size_t n, size_t rn) {
+    CHECK(fake_task == TASK_BUS);
+    CHECK(s_nlog < 64 && n <= I2C_BUS_MERGE_MAX);
+    xfer_t *x = &s_log[s_nlog++];
+    x->addr = (uint16_t)(uintptr_t)d;
+    x->read = read;
+    x->len = n;
+    memcpy(x->b, b, n);
+    fake_now_us += (int64_t)(n + rn) * US_PER_BYTE;
+    return x;
+}
+
+esp_err_t i2c_master_transmit(i2c_master_dev_handle_t d, const uint8_t *b, size_t n, int t) {
+    log_xfer(d, false, b, n, 0);
+    return ESP_OK;
+}
+esp_err_t i2c_master_transmit_receive(i2c_master_dev_handle_t d, const uint8_t *w, size_t wn, uint8_t *r, size_t rn, int t) {
+    log_xfer(d, true, w, wn, rn);
+    memset(r, 0x5A, rn);
+    return ESP_OK;
+}
+esp_err_t i2c_master_receive(i2c_master_dev_handle_t d, uint8_t *r, size_t rn, int t) {
+    log_xfer(d, true, NULL, 0, rn);
+    memset(r, 0x5A, rn);
+    return ESP_OK;
+}
+
+esp_err_t gpio_reset_pin(gpio_num_t p) { return ESP_OK; }
+esp_err_t gpio_set_direction(gpio_num_t p, gpio_mode_t m) { return ESP_OK; }
+esp_err_t gpio_set_level(gpio_num_t p, uint32_t l) { return ESP_OK; }
+int gpio_get_level(gpio_num_t p) { return 1; }
+void ets_delay_us(uint32_t us) { fake_now_us += us; }
+
+// Lo que ssd1306_i2c.c usa de ssd1306.c; aquí solo interesa i2c_merge_writes
+void ssd1306_set_controller(SSD1306_t *dev, ssd1306_controller_t controller) {}
+bool ssd1306_set_geometry(SSD1306_t *dev, int width, int height) { return true; }
+int ssd1306_init_commands(SSD1306_t *dev, bool horizontal, uint8_t *cmds) { cmds[0] = 0xAF; return 1; }
+int ssd1306_page_commands(SSD1306_t *dev, int page, int seg, uint8_t *cmds) { memset(cmds, 0, 3); return 3; }
+void ssd1306_hardware_scroll(SSD1306_t *dev, ssd1306_scroll_type_t scroll) {}
+
+// --- La tarea del bus, una vuelta cada vez que alguien esperaría ---
+static bool s_in_bus;
+
+static bool pump_bus(void) {
+    if (s_in_bus || uxSemaphoreGetCount(s_pending) == 0) return false;
+    int prev = fake_task;
+    fake_task = TASK_BUS;
+    s_in_bus = true;
+    bus_poll();
+    s_in_bus = false;
+    fake_task = prev;
+    return true;
+}
+
+static void drain(void) {
+    while (pump_bus()) {
+    }
+}
+
+static void cb(esp_err_t err, void *arg) {
+    CHECK(fake_task == TASK_BUS);
+    if (err == ESP_OK) s_cb_ok++;
+    else s_cb_err++;
+}
+
+static bool logged(int i, uint16_t addr, const uint8_t *b, size_t n) {
+    return i < s_nlog && s_log[i].addr == addr && s_log[i].len == n && memcmp(s_log[i].b, b, n) == 0;
+}
+
+static void reset_log(void) {
+    s_nlog = 0;
+    s_cb_ok = s_cb_err = 0;
+}
+
+static const uint8_t c_on[] = { 0x00, 0xAF };
+static const uint8_t c_contrast[] = { 0x00, 0x81, 0x7F };
+static uint8_t c_page[] = { 0x00, 0x00, 0x10, 0xB0 };
+static uint8_t d_row[129] = { 0x40 };
+
+// Un cuadro de dos páginas y dos comandos sueltos; la medida llega después y sale antes
+static void test_frame(i2c_bus_dev_t *oled, i2c_bus_dev_t *bme) {
+    reset_log();
+    for (int i = 1; i < 129; i++) d_row[i] = i;
+    c_page[3] = 0xB0;
+    CHECK(i2c_bus_submit(oled, I2C_BUS_PRIO_LOW, c_page, sizeof(c_page), NULL, 0, cb, NULL) == ESP_OK);
+    CHECK(i2c_bus_submit(oled, I2C_BUS_PRIO_LOW, d_row, sizeof(d_row), NULL, 0, cb, NULL) == ESP_OK);
+    c_page[3] = 0xB1;   // Se copia al pedir: cambiarlo ya no afecta a la anterior
+    CHECK(i2c_bus_submit(oled, I2C_BUS_PRIO_LOW, c_page, sizeof(c_page), NULL, 0, cb, NULL) == ESP_OK);
+    CHECK(i2c_bus_submit(oled, I2C_BUS_PRIO_LOW, d_row, sizeof(d_row), NULL, 0, cb, NULL) == ESP_OK);
+    CHECK(i2c_bus_submit(oled, I2C_BUS_PRIO_LOW, c_contrast, sizeof(c_contrast), NULL, 0, cb, NULL) == ESP_OK);
+    CHECK(i2c_bus_submit(oled, I2C_BUS_PRIO_LOW, c_on, sizeof(c_on), NULL, 0, cb, NULL) == ESP_OK);
+    CHECK(s_nlog == 0 && uxSemaphoreGetCount(s_pending) == 6);
+
+    uint8_t reg = 0x1D, out[3] = { 0 };
+    CHECK(i2c_bus_transfer(bme, I2C_BUS_PRIO_HIGH, &reg, 1, out, sizeof(out), 100) == ESP_OK);
+    CHECK(out[0] == 0x5A && out[2] == 0x5A);
+    CHECK(s_nlog == 1 && s_log[0].addr == ADDR_BME && s_log[0].read && s_log[0].b[0] == 0x1D);
+    drain();
+
+    // Página 0: los comandos pasan a forma Co (0x80 delante de cada uno) y siguen los datos
+    uint8_t co[6 + 129] = { 0x80, 0x00, 0x80, 0x10, 0x80, 0xB0 };
+    memcpy(co + 6, d_row, sizeof(d_row));
+    CHECK(logged(1, ADDR_OLED, co, sizeof(co)));
+    co[5] = 0xB1;
+    CHECK(logged(2, ADDR_OLED, co, sizeof(co)));
+    // Comandos seguidos: un solo stream
+    const uint8_t cmds[] = { 0x00, 0x81, 0x7F, 0xAF };
+    CHECK(logged(3, ADDR_OLED, cmds, sizeof(cmds)));
+    CHECK(s_nlog == 4);
+    CHECK(s_cb_ok == 6 && s_cb_err == 0);
+
+    i2c_bus_stats_t st;
+    i2c_bus_get_stats(oled, &st);
+    CHECK(st.xfers == 3 && st.merged == 3 && st.errors == 0);
+    CHECK(st.bytes == 2 * sizeof(co) + sizeof(cmds));
+    // Todo se pidió en t = 0: la última acaba cuando se ha transmitido todo
+    int64_t total = (int64_t)(4 + 2 * sizeof(co) + sizeof(cmds)) * US_PER_BYTE;
+    CHECK(st.lat_max_us == total);
+    CHECK(st.lat_avg_us > 0 && st.lat_avg_us < st.lat_max_us);
+    i2c_bus_get_stats(bme, &st);
+    CHECK(st.xfers == 1 && st.merged == 0 && st.bytes == 4);
+}
+
+// Solo se funden escrituras asíncronas seguidas del mismo dispositivo y cola
+static void test_no_merge(i2c_bus_dev_t *oled, i2c_bus_dev_t *bme) {
+    reset_log();
+    uint8_t bme_w[] = { 0x74, 0x25 };
+    // Otro dispositivo en medio
+    i2c_bus_submit(oled, I2C_BUS_PRIO_LOW, c_on, sizeof(c_on), NULL, 0, cb, NULL);
+    i2c_bus_submit(bme, I2C_BUS_PRIO_LOW, bme_w, sizeof(bme_w), NULL, 0, cb, NULL);
+    i2c_bus_submit(oled, I2C_BUS_PRIO_LOW, c_on, sizeof(c_on), NULL, 0, cb, NULL);
+    // Otra cola
+    i2c_bus_submit(oled, I2C_BUS_PRIO_NORMAL, c_contrast, sizeof(c_contrast), NULL, 0, cb, NULL);
+    // Una lectura detrás de la escritura de después del sensor
+    uint8_t rd[2];
+    i2c_bus_submit(oled, I2C_BUS_PRIO_LOW, c_on, sizeof(c_on), rd, sizeof(rd), cb, NULL);
+    drain();
+    CHECK(s_nlog == 5 && s_cb_ok == 5);
+    CHECK(logged(0, ADDR_OLED, c_contrast, sizeof(c_contrast)));    // NORMAL antes que LOW
+    CHECK(logged(1, ADDR_OLED, c_on, sizeof(c_on)));
+    CHECK(logged(2, ADDR_BME, bme_w, sizeof(bme_w)));
+    CHECK(logged(3, ADDR_OLED, c_on, sizeof(c_on)) && !s_log[3].read);
+    CHECK(s_log[4].read && rd[0] == 0x5A);
+
+    // Una llamada que espera no se funde con la asíncrona de delante
+    reset_log();
+    i2c_bus_submit(oled, I2C_BUS_PRIO_LOW, c_on, sizeof(c_on), NULL, 0, cb, NULL);
+    CHECK(i2c_bus_transfer(oled, I2C_BUS_PRIO_LOW, c_on, sizeof(c_on), NULL, 0, 100) == ESP_OK);
+    CHECK(s_nlog == 2 && s_log[0].len == 2 && s_log[1].len == 2);
+
+    // Como mucho I2C_BUS_MERGE_REQS peticiones por transacción
+    reset_log();
+    for (int i = 0; i < I2C_BUS_MERGE_REQS + 2; i++) {
+        i2c_bus_submit(oled, I2C_BUS_PRIO_LOW, c_on, sizeof(c_on), NULL, 0, cb, NULL);
+    }
+    drain();
+    CHECK(s_nlog == 2 && s_cb_ok == I2C_BUS_MERGE_REQS + 2);
+    CHECK(s_log[0].len == 1 + I2C_BUS_MERGE_REQS && s_log[1].len == 3);
+}
+
+// Algo urgente que llega mientras se funde corta la fusión
+static i2c_bus_dev_t *s_bme;
+static int s_merge_calls;
+
+static bool merge_then_urgent(uint8_t *buf, size_t *len, size_t cap, const uint8_t *next, size_t next_len) {
+    if (s_merge_calls++ == 0) {
+        int prev = fake_task;
+        fake_task = FAKE_TASK_MAIN;     // Otra tarea pide mientras tanto
+        static const uint8_t reg[] = { 0x74, 0x01 };
+        CHECK(i2c_bus_submit(s_bme, I2C_BUS_PRIO_HIGH, reg, sizeof(reg), NULL, 0, cb, NULL) == ESP_OK);
+        fake_task = prev;
+    }
+    return i2c_merge_writes(buf, len, cap, next, next_len);
+}
+
+static void test_urgent_cuts_merge(i2c_bus_dev_t *bme) {
+    reset_log();
+    s_bme = bme;
+    i2c_bus_dev_t *oled2 = i2c_bus_add_device("oled2", ADDR_OLED, 400000, merge_then_urgent);
+    CHECK(oled2);
+    for (int i = 0; i < 4; i++) i2c_bus_submit(oled2, I2C_BUS_PRIO_LOW, c_on, sizeof(c_on), NULL, 0, cb, NULL);
+    drain();
+    // La primera fusión ya estaba hecha; la segunda no se intenta con el sensor esperando
+    CHECK(s_merge_calls == 2);
+    CHECK(s_nlog == 3 && s_cb_ok == 5);
+    const uint8_t two[] = { 0x00, 0xAF, 0xAF };
+    CHECK(logged(0, ADDR_OLED, two, sizeof(two)));
+    CHECK(s_log[1].addr == ADDR_BME);
+    CHECK(logged(2, ADDR_OLED, two, sizeof(two)));
+    i2c_bus_rm_device(oled2);
+}
+
+static void test_json(void) {
+    char js[512];
+    int n = i2c_bus_format_json(js, sizeof(js));
+    CHECK(n > 0 && n == (int)strlen(js));
+    CHECK(strncmp(js, "{\"bus\":{\"recoveries\":0,", 23) == 0);
+    CHECK(strstr(js, ",\"oled\":{\"xfers\":") && strstr(js, ",\"bme680\":{\"xfers\":") && js[n - 1] == '}');
+    CHECK(i2c_bus_format_json(js, 40) == -1);
+    CHECK(i2c_bus_format_json(js, n + 1) == n);
+    CHECK(i2c_bus_format_json(js, n) == -1);
+}
+
+static void test_merge_rules(void) {
+    uint8_t buf[300];
+    size_t len;
+    const uint8_t cmd2[] = { 0x00, 0x81, 0x7F };
+    const uint8_t data3[] = { 0x40, 1, 2, 3 };
+
+    // Comandos + comandos: se concatena sin repetir el byte de control
+    memcpy(buf, c_on, 2);
+    len = 2;
+    CHECK(i2c_merge_writes(buf, &len, sizeof(buf), cmd2, sizeof(cmd2)) && len == 4);
+    CHECK(memcmp(buf, (const uint8_t[]){ 0x00, 0xAF, 0x81, 0x7F }, 4) == 0);
+    // Comandos + datos: forma Co y los datos detrás
+    CHECK(i2c_merge_writes(buf, &len, sizeof(buf), data3, sizeof(data3)) && len == 6 + 4);
+    CHECK(memcmp(buf, (const uint8_t[]){ 0x80, 0xAF, 0x80, 0x81, 0x80, 0x7F, 0x40, 1, 2, 3 }, 10) == 0);
+    // Tras datos ya no cabe nada (un stream de datos llega hasta el STOP)
+    uint8_t copy[300];
+    memcpy(copy, buf, len);
+    size_t l0 = len;
+    CHECK(!i2c_merge_writes(buf, &len, sizeof(buf), cmd2, sizeof(cmd2)) && len == l0);
+    CHECK(!i2c_merge_writes(buf, &len, sizeof(buf), data3, sizeof(data3)) && len == l0);
+    CHECK(memcmp(buf, copy, l0) == 0);
+    // Un buffer que empieza por datos no admite nada
+    memcpy(buf, data3, 4);
+    len = 4;
+    CHECK(!i2c_merge_writes(buf, &len, sizeof(buf), cmd2, sizeof(cmd2)) && len == 4);
+    // Sin sitio: ni se toca
+    memcpy(buf, cmd2, 3);
+    len = 3;
+    CHECK(!i2c_merge_writes(buf, &len, 5, data3, sizeof(data3)) && len == 3);   // Co necesita 2*2 + 4
+    CHECK(!i2c_merge_writes(buf, &len, 4, cmd2, sizeof(cmd2)) && len == 3);
+    CHECK(memcmp(buf, cmd2, 3) == 0);
+    CHECK(i2c_merge_writes(buf, &len, 5, cmd2, sizeof(cmd2)) && len == 5);      // Justo cabe
+    // Escrituras sin contenido o con otro byte de control
+    len = 1;
+    CHECK(!i2c_merge_writes(buf, &len, sizeof(buf), cmd2, sizeof(cmd2)));
+    len = 3;
+    CHECK(!i2c_merge_writes(buf, &len, sizeof(buf), (const uint8_t[]){ 0x00 }, 1));
+    CHECK(!i2c_merge_writes(buf, &len, sizeof(buf), (const uint8_t[]){ 0xC0, 0x55 }, 2));
+}
+
+int main(void) {
+    fake_rtos_reset();
+    CHECK(i2c_bus_init(0, 21, 22));
+    CHECK(fake_task_fn("i2c_bus") != NULL);
+    fake_pump = pump_bus;
+    i2c_bus_dev_t *oled = i2c_bus_add_device("oled", ADDR_OLED, 400000, i2c_merge_writes);
+    i2c_bus_dev_t *bme = i2c_bus_add_device("bme680", ADDR_BME, 100000, NULL);
+    CHECK(oled && bme);
+
+    test_frame(oled, bme);
+    test_no_merge(oled, bme);
+    test_urgent_cuts_merge(bme);
+    test_json();
+    test_merge_rules();
+
+    CHECK(i2c_bus_probe(ADDR_OLED, 50) == ESP_OK && i2c_bus_probe(0x77, 50) == ESP_ERR_NOT_FOUND);
+    i2c_bus_health_t h;
+    i2c_bus_get_health(&h);
+    CHECK(h.recoveries == 0 && h.timeouts == 0);
+
+    i2c_bus_stats_t st;
+    i2c_bus_get_stats(oled, &st);
+    printf("i2c_bus: oled %lu transacciones, %lu fusionadas, lat media %lu us: ok\n",
+           (unsigned long)st.xfers, (unsigned long)st.merged, (unsigned long)st.lat_avg_us);
+    return 0;
+}
@@ -0,0 +1,348 @@
+/*
+ * Recuperación del bus I2C con las líneas simuladas: un esclavo que retiene
+ * SDA hasta recibir unos pulsos, SCL pegada abajo, timeouts y NACK del
+ * periférico. Comprueba la parada de los pulsos en cuanto se suelta SDA, el
+ * STOP, el límite de una recuperación automática por segundo, que un NACK con
+ * las líneas arriba no recupera, el bus rehecho (forzado y como último
+ * recurso), el vigilante de SDA con el bus ocioso, el reenganche de los
+ * dispositivos y que una llamada que ya se rindió no toque el buffer de nadie.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "fake_rtos.h"
+#include "i2c_bus.c"
+
+#define TASK_BUS    1
+#define PIN_SDA     21
+#define PIN_SCL     22
+#define ADDR_OLED   0x3C
+#define ADDR_BME    0x76
+
+// --- Líneas: open-drain, arriba salvo que alguien tire de ellas ---
+static bool s_gpio_mode[2];         // Pin en GPIO (si no, del periférico, en reposo)
+static int s_out[2] = { 1, 1 };
+static int s_slave_hold;            // Pulsos de SCL que faltan para que el esclavo suelte SDA; -1 = nunca
+static bool s_scl_stuck;
+static int s_pulses, s_stops;
+
+static int pin_idx(gpio_num_t p) {
+    CHECK(p == PIN_SDA || p == PIN_SCL);
+    return p == PIN_SCL;
+}
+
+int gpio_get_level(gpio_num_t p) {
+    int i = pin_idx(p);
+    if (i == 0 && s_slave_hold) return 0;
+    if (i == 1 && s_scl_stuck) return 0;
+    return s_gpio_mode[i] ? s_out[i] : 1;
+}
+
+esp_err_t gpio_set_direction(gpio_num_t p, gpio_mode_t m) {
+    CHECK(m == GPIO_MODE_INPUT_OUTPUT_OD);
+    s_gpio_mode[pin_idx(p)] = true;
+    return ESP_OK;
+}
+
+esp_err_t gpio_set_level(gpio_num_t p, uint32_t l) {
+    int i = pin_idx(p);
+    CHECK(s_gpio_mode[i]);
+    bool scl_high = gpio_get_level(PIN_SCL);
+    if (i == 1 && l && !s_out[1]) {
+        // Flanco de subida de SCL con SDA libre por el maestro: un pulso de reloj
+        if (s_out[0]) {
+            s_pulses++;
+            if (s_slave_hold > 0) s_slave_hold--;
+        }
+    }
+    if (i == 0 && l && !s_out[0] && scl_high && !s_slave_hold) s_stops++;
+    s_out[i] = l;
+    return ESP_OK;
+}
+
+esp_err_t gpio_reset_pin(gpio_num_t p) { return ESP_OK; }
+void ets_delay_us(uint32_t us) { fake_now_us += us; }
+
+static void lines_to_peripheral(void) {
+    s_gpio_mode[0] = s_gpio_mode[1] = false;
+    s_out[0] = s_out[1] = 1;
+}
+
+// --- Bus simulado ---
+static int s_bus_news, s_bus_dels, s_dev_adds, s_dev_rms, s_resets, s_probes;
+static bool s_new_bus_fails, s_reset_fails;
+static esp_err_t s_next_err;        // Resultado de la próxima transacción
+static int s_recover_cbs;
+
+esp_err_t i2c_new_master_bus(const i2c_master_bus_config_t *c, i2c_master_bus_handle_t *b) {
+    CHECK(c->sda_io_num == PIN_SDA && c->scl_io_num == PIN_SCL);
+    s_bus_news++;
+    if (s_new_bus_fails) return ESP_FAIL;
+    lines_to_peripheral();
+    *b = (i2c_master_bus_handle_t)(uintptr_t)s_bus_news;
+    return ESP_OK;
+}
+
+esp_err_t i2c_del_master_bus(i2c_master_bus_handle_t b) {
+    s_bus_dels++;
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_bus_add_device(i2c_master_bus_handle_t b, const i2c_device_config_t *c, i2c_master_dev_handle_t *d) {
+    s_dev_adds++;
+    *d = (i2c_master_dev_handle_t)(uintptr_t)c->device_address;
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_bus_rm_device(i2c_master_dev_handle_t d) {
+    s_dev_rms++;
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_bus_reset(i2c_master_bus_handle_t b) {
+    s_resets++;
+    lines_to_peripheral();
+    return s_reset_fails ? ESP_FAIL : ESP_OK;
+}
+
+esp_err_t i2c_master_probe(i2c_master_bus_handle_t b, uint16_t a, int t) {
+    CHECK(fake_task == TASK_BUS && t > 0);
+    s_probes++;
+    return (a == ADDR_OLED || a == ADDR_BME) ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
+
+static esp_err_t xfer_result(int t) {
+    CHECK(fake_task == TASK_BUS && t > 0);       // Nunca una espera sin límite
+    esp_err_t e = s_next_err;
+    s_next_err = ESP_OK;
+    fake_now_us += (e == ESP_ERR_TIMEOUT) ? (int64_t)t * 1000 : 500;
+    return e;
+}
+
+esp_err_t i2c_master_transmit(i2c_master_dev_handle_t d, const uint8_t *b, size_t n, int t) {
+    return xfer_result(t);
+}
+
+esp_err_t i2c_master_transmit_receive(i2c_master_dev_handle_t d, const uint8_t *w, size_t wn, uint8_t *r, size_t rn, int t) {
+    esp_err_t e = xfer_result(t);
+    memset(r, w[0], rn);    // Lo leído lleva la marca de quién lo pidió
+    return e;
+}
+
+esp_err_t i2c_master_receive(i2c_master_dev_handle_t d, uint8_t *r, size_t rn, int t) {
+    return xfer_result(t);
+}
+
+// --- Tarea del bus ---
+static bool s_in_bus;
+
+static bool pump_bus(void) {
+    if (s_in_bus || uxSemaphoreGetCount(s_pending) == 0) return false;
+    int prev = fake_task;
+    fake_task = TASK_BUS;
+    s_in_bus = true;
+    bus_poll();
+    s_in_bus = false;
+    fake_task = prev;
+    return true;
+}
+
+// Una vuelta sin peticiones: vence la espera del vigilante
+static void idle_poll(void) {
+    CHECK(uxSemaphoreGetCount(s_pending) == 0);
+    int64_t t0 = fake_now_us;
+    fake_task = TASK_BUS;
+    s_in_bus = true;
+    bus_poll();
+    s_in_bus = false;
+    fake_task = FAKE_TASK_MAIN;
+    CHECK(fake_now_us - t0 >= (int64_t)I2C_BUS_WATCHDOG_MS * 1000);
+}
+
+static void on_recover(void *arg) {
+    CHECK(fake_task == TASK_BUS && arg == &s_recover_cbs);
+    s_recover_cbs++;
+}
+
+static i2c_bus_health_t health(void) {
+    i2c_bus_health_t h;
+    i2c_bus_get_health(&h);
+    return h;
+}
+
+static void wait_rate_limit(void) {
+    fake_now_us += (int64_t)I2C_BUS_RECOVER_MIN_MS * 1000;
+}
+
+static i2c_bus_dev_t *s_oled, *s_bme;
+
+static esp_err_t read_bme(uint8_t reg, uint8_t *r, size_t n) {
+    return i2c_bus_transfer(s_bme, I2C_BUS_PRIO_HIGH, &reg, 1, r, n, 100);
+}
+
+// Timeout con un esclavo que retiene SDA: 3 pulsos bastan, STOP, reinicio y reenganche
+static void test_timeout_recovers(void) {
+    uint8_t r[4];
+    s_slave_hold = 3;
+    s_next_err = ESP_ERR_TIMEOUT;
+    CHECK(read_bme(0x11, r, sizeof(r)) == ESP_ERR_TIMEOUT);
+    i2c_bus_health_t h = health();
+    CHECK(h.recoveries == 1 && h.timeouts == 1 && h.rebuilds == 0 && h.failed == 0);
+    CHECK(s_pulses == 3 && s_stops == 1 && s_resets == 1 && s_slave_hold == 0);
+    CHECK(!s_gpio_mode[0] && !s_gpio_mode[1]);      // Las líneas vuelven al periférico
+    CHECK(s_recover_cbs == 1);
+    i2c_bus_stats_t st;
+    i2c_bus_get_stats(s_oled, &st);
+    CHECK(st.reattached == 1);
+    i2c_bus_get_stats(s_bme, &st);
+    CHECK(st.reattached == 1 && st.errors == 1 && st.last_err == ESP_ERR_TIMEOUT);
+
+    // Otro timeout enseguida: no se recupera otra vez antes de I2C_BUS_RECOVER_MIN_MS
+    s_next_err = ESP_ERR_TIMEOUT;
+    CHECK(read_bme(0x11, r, sizeof(r)) == ESP_ERR_TIMEOUT);
+    h = health();
+    CHECK(h.recoveries == 1 && h.timeouts == 2 && s_resets == 1);
+    wait_rate_limit();
+    s_next_err = ESP_ERR_TIMEOUT;
+    CHECK(read_bme(0x11, r, sizeof(r)) == ESP_ERR_TIMEOUT);
+    h = health();
+    CHECK(h.recoveries == 2 && h.timeouts == 3);
+    // Con SDA libre desde el principio no hace falta ningún pulso
+    CHECK(s_pulses == 3 && s_stops == 2);
+}
+
+// Un NACK con las líneas arriba es un dispositivo ausente; con SDA abajo, no
+static void test_nack(void) {
+    uint8_t r[4];
+    wait_rate_limit();
+    s_next_err = ESP_FAIL;
+    CHECK(read_bme(0x11, r, sizeof(r)) == ESP_FAIL);
+    CHECK(health().recoveries == 2);
+    CHECK(i2c_bus_probe(0x50, 20) == ESP_ERR_NOT_FOUND);
+    CHECK(health().recoveries == 2);
+
+    s_slave_hold = 9;
+    s_next_err = ESP_FAIL;
+    CHECK(read_bme(0x11, r, sizeof(r)) == ESP_FAIL);
+    i2c_bus_health_t h = health();
+    CHECK(h.recoveries == 3 && h.failed == 0 && h.rebuilds == 0 && h.timeouts == 3);
+    CHECK(s_pulses == 3 + 9 && s_slave_hold == 0);
+}
+
+// Bus rehecho: si el reinicio falla, si las líneas no suben o si falla crearlo
+static void test_rebuild(void) {
+    int adds = s_dev_adds, rms = s_dev_rms, news = s_bus_news, cbs = s_recover_cbs;
+
+    // El reinicio del periférico falla con las líneas arriba: bus nuevo y todo bien
+    s_reset_fails = true;
+    CHECK(i2c_bus_recover() == ESP_OK);     // Forzada: sin límite de frecuencia
+    s_reset_fails = false;
+    i2c_bus_health_t h = health();
+    CHECK(h.recoveries == 4 && h.rebuilds == 1 && h.failed == 0);
+    CHECK(s_bus_news == news + 1 && s_bus_dels == 1);
+    CHECK(s_dev_rms == rms + 2 && s_dev_adds == adds + 2);    // Los mismos dispositivos otra vez
+    CHECK(s_recover_cbs == cbs + 1);
+    uint8_t r[2];
+    CHECK(read_bme(0x42, r, sizeof(r)) == ESP_OK && r[0] == 0x42);
+
+    // SCL pegada abajo: ni pulsos ni bus nuevo la sueltan. Falla y nadie se reengancha
+    s_scl_stuck = true;
+    CHECK(i2c_bus_recover() == ESP_FAIL);
+    h = health();
+    CHECK(h.recoveries == 5 && h.rebuilds == 2 && h.failed == 1);
+    CHECK(s_recover_cbs == cbs + 1);
+    s_scl_stuck = false;
+
+    // No se puede crear el bus: las peticiones fallan sin tocarlo hasta la próxima recuperación
+    s_new_bus_fails = true;
+    s_reset_fails = true;
+    CHECK(i2c_bus_recover() == ESP_FAIL);
+    s_reset_fails = false;
+    CHECK(s_bus == NULL && health().failed == 2);
+    CHECK(read_bme(0x42, r, sizeof(r)) == ESP_ERR_INVALID_STATE);
+    CHECK(i2c_bus_probe(ADDR_OLED, 20) == ESP_ERR_INVALID_STATE);
+    s_new_bus_fails = false;
+    CHECK(i2c_bus_recover() == ESP_OK);
+    CHECK(s_bus != NULL && read_bme(0x42, r, sizeof(r)) == ESP_OK);
+    h = health();
+    CHECK(h.recoveries == 7 && h.rebuilds == 4 && h.failed == 2);
+}
+
+// Vigilante: SDA retenida con el bus ocioso
+static void test_watchdog(void) {
+    wait_rate_limit();
+    idle_poll();
+    CHECK(health().stuck_sda == 0 && health().recoveries == 7);
+    s_slave_hold = 5;
+    idle_poll();
+    i2c_bus_health_t h = health();
+    CHECK(h.stuck_sda == 1 && h.recoveries == 8 && s_slave_hold == 0);
+    // Un esclavo que no suelta nunca: 9 pulsos como mucho, bus rehecho y fallida.
+    // El vigilante vence cada I2C_BUS_WATCHDOG_MS, no más a menudo que el límite
+    s_slave_hold = -1;
+    int pulses = s_pulses;
+    idle_poll();
+    h = health();
+    CHECK(h.stuck_sda == 2 && h.recoveries == 9 && h.rebuilds == 5 && h.failed == 3);
+    CHECK(s_pulses == pulses + I2C_BUS_CLEAR_PULSES);
+    s_slave_hold = 0;
+}
+
+// Una llamada que se rinde: su petición atrasada no escribe en su buffer ni
+// despierta a la siguiente, que recibe lo suyo
+static void test_stale_sync(void) {
+    uint8_t r[4] = { 0 };
+    fake_pump = NULL;       // La tarea del bus no llega a tiempo
+    int64_t t0 = fake_now_us;
+    CHECK(read_bme(0x22, r, sizeof(r)) == ESP_ERR_TIMEOUT);
+    CHECK(fake_now_us - t0 == (int64_t)(100 + I2C_BUS_SYNC_SLACK_MS) * 1000);
+    CHECK(r[0] == 0 && uxSemaphoreGetCount(s_pending) == 1);
+    CHECK(s_sync_waiting == 0 && fake_mutex_holder(s_sync_lock) == -1);
+
+    // La siguiente llamada encuentra la atrasada delante en la cola
+    fake_pump = pump_bus;
+    CHECK(read_bme(0x33, r, sizeof(r)) == ESP_OK);
+    CHECK(r[0] == 0x33 && r[3] == 0x33);
+    CHECK(s_scratch[0] == 0x22);            // La atrasada leyó en el buffer del gestor
+    CHECK(uxSemaphoreGetCount(s_sync_done) == 0);
+
+    // Atrasada que acaba sola, sin nadie esperando: tampoco deja un aviso pendiente
+    fake_pump = NULL;
+    memset(r, 0, sizeof(r));
+    CHECK(read_bme(0x44, r, sizeof(r)) == ESP_ERR_TIMEOUT);
+    fake_pump = pump_bus;
+    CHECK(pump_bus());
+    CHECK(r[0] == 0 && uxSemaphoreGetCount(s_sync_done) == 0);
+    CHECK(read_bme(0x55, r, sizeof(r)) == ESP_OK && r[0] == 0x55);
+
+    CHECK(read_bme(0x55, r, I2C_BUS_MAX_READ + 1) == ESP_ERR_INVALID_SIZE);
+}
+
+int main(void) {
+    fake_rtos_reset();
+    CHECK(i2c_bus_init(0, PIN_SDA, PIN_SCL));
+    fake_pump = pump_bus;
+    s_oled = i2c_bus_add_device("oled", ADDR_OLED, 400000, NULL);
+    s_bme = i2c_bus_add_device("bme680", ADDR_BME, 100000, NULL);
+    CHECK(s_oled && s_bme);
+    i2c_bus_on_recover(s_oled, on_recover, &s_recover_cbs);
+    fake_now_us = 5000000;
+
+    test_timeout_recovers();
+    test_nack();
+    test_rebuild();
+    test_watchdog();
+    test_stale_sync();
+
+    char js[512];
+    int n = i2c_bus_format_json(js, sizeof(js));
+    CHECK(n == (int)strlen(js));
+    i2c_bus_health_t h = health();
+    char bus[160];
+    snprintf(bus, sizeof(bus), "{\"bus\":{\"recoveries\":%lu,\"rebuilds\":%lu,\"failed\":%lu,\"stuck_sda\":%lu,\"timeouts\":%lu}",
+             (unsigned long)h.recoveries, (unsigned long)h.rebuilds, (unsigned long)h.failed,
+             (unsigned long)h.stuck_sda, (unsigned long)h.timeouts);
+    CHECK(strncmp(js, bus, strlen(bus)) == 0);
+    printf("i2c_bus_recover: %lu recuperaciones, %lu rehechos, %lu fallidas, %d pulsos: ok\n",
+           (unsigned long)h.recoveries, (unsigned long)h.rebuilds, (unsigned long)h.failed, s_pulses);
+    return 0;
+}
@@ -0,0 +1,172 @@
+/*
+ * iaq_update reproduciendo traces/iaq_dia.csv (24 h, una fila por minuto):
+ * calentamiento, aprendizaje y paso a estable, seguimiento de la línea base,
+ * su decaimiento durante un episodio de COV y tras una deriva del sensor, la
+ * compensación de humedad durante un riego y el arranque con la base de NVS.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fake_rtos.h"
+#include "iaq.c"
+
+#define TRACE_PATH  "traces/iaq_dia.csv"
+#define MAX_ROWS    2000
+#define CLEAN_OHM   150000.0f   // Aire limpio compensado del trazo, antes de la deriva
+
+typedef struct {
+    int64_t t_s;
+    float gas;
+    float hum;
+} row_t;
+
+static row_t s_rows[MAX_ROWS];
+static int s_nrows;
+
+// NVS simulado: una sola clave u32
+static uint32_t s_nvs_value;
+static bool s_nvs_has;
+static int s_nvs_saves;
+static int64_t s_save_t[64];
+
+esp_err_t nvs_open(const char *ns, nvs_open_mode_t mode, nvs_handle_t *out) {
+    (void)ns; (void)mode;
+    *out = 1;
+    return ESP_OK;
+}
+
+esp_err_t nvs_get_u32(nvs_handle_t h, const char *key, uint32_t *out) {
+    (void)h;
+    if (!s_nvs_has || strcmp(key, IAQ_NVS_KEY) != 0) return ESP_ERR_NVS_NOT_FOUND;
+    *out = s_nvs_value;
+    return ESP_OK;
+}
+
+esp_err_t nvs_set_u32(nvs_handle_t h, const char *key, uint32_t value) {
+    (void)h;
+    CHECK(strcmp(key, IAQ_NVS_KEY) == 0);
+    s_nvs_value = value;
+    s_nvs_has = true;
+    if (s_nvs_saves < 64) s_save_t[s_nvs_saves] = s_last_us / 1000000;
+    s_nvs_saves++;
+    return ESP_OK;
+}
+
+esp_err_t nvs_commit(nvs_handle_t h) { (void)h; return ESP_OK; }
+void nvs_close(nvs_handle_t h) { (void)h; }
+
+static void load_trace(void) {
+    FILE *f = fopen(TRACE_PATH, "r");
+    CHECK(f != NULL);
+    char line[128];
+    CHECK(fgets(line, sizeof(line), f) != NULL);     // Cabecera
+    long long t;
+    float gas, hum;
+    while (s_nrows < MAX_ROWS && fscanf(f, "%lld,%f,%f", &t, &gas, &hum) == 3) {
+        s_rows[s_nrows++] = (row_t){ t, gas, hum };
+    }
+    fclose(f);
+    CHECK(s_nrows > 24 * 60);
+}
+
+// Estado de un arranque en frío del módulo (las static de iaq.c)
+static void reboot(void) {
+    s_baseline = s_saved_baseline = 0.0f;
+    s_from_nvs = false;
+    s_first_us = -1;
+    s_last_us = s_saved_us = 0;
+    s_valid = false;
+    iaq_init();
+}
+
+static float base_at(int64_t t_s, const iaq_result_t *res, const bool *ok) {
+    int i = (int)(t_s / 60);
+    CHECK(ok[i]);
+    return res[i].baseline;
+}
+
+static void first_boot(void) {
+    static iaq_result_t res[MAX_ROWS];
+    static bool ok[MAX_ROWS];
+    reboot();
+    CHECK(!s_from_nvs);
+    CHECK(!iaq_update(0.0f, 45.0f, 0, NULL));       // Gas sin medida: ni arranca el reloj
+    CHECK(s_first_us < 0);
+
+    float max_raw_idx = 0.0f, max_hum_iaq = 0.0f;
+    for (int i = 0; i < s_nrows; i++) {
+        const row_t *r = &s_rows[i];
+        ok[i] = iaq_update(r->gas, r->hum, r->t_s * 1000000, &res[i]);
+
+        // Calentamiento: nada antes de IAQ_WARMUP_S
+        CHECK(ok[i] == (r->t_s >= IAQ_WARMUP_S));
+        if (!ok[i]) continue;
+        // Aprendizaje hasta completar IAQ_LEARN_S tras el calentamiento
+        CHECK(res[i].accuracy == (r->t_s >= IAQ_WARMUP_S + IAQ_LEARN_S ? IAQ_ACC_STABLE : IAQ_ACC_LEARNING));
+        CHECK(res[i].iaq >= 0.0f && res[i].iaq <= 500.0f);
+
+        // Riego: el índice sin compensar se dispararía, el compensado no se mueve
+        if (r->t_s >= 90 * 60 && r->t_s <= 150 * 60) {
+            float raw_idx = (1.0f - r->gas / res[i].baseline) * 500.0f;
+            if (raw_idx > max_raw_idx) max_raw_idx = raw_idx;
+            if (res[i].iaq > max_hum_iaq) max_hum_iaq = res[i].iaq;
+            CHECK(fabsf(res[i].comp_gas / CLEAN_OHM - 1.0f) < 0.02f);
+        }
+    }
+
+    // La base arranca con la lectura a los 5 min y sube hasta el aire limpio en minutos
+    CHECK(base_at(IAQ_WARMUP_S, res, ok) < 0.99f * CLEAN_OHM);
+    CHECK(fabsf(base_at(20 * 60, res, ok) / CLEAN_OHM - 1.0f) < 0.02f);
+    CHECK(res[60].iaq < 15.0f);
+
+    CHECK(max_raw_idx > 300.0f);
+    CHECK(max_hum_iaq < 15.0f);
+
+    // COV de 3.0 a 3.5 h: el índice refleja la caída al 55 % (225) y la base
+    // solo decae, un IAQ_BASE_DECAY_H por hora
+    float in_event = res[195].iaq;
+    CHECK(in_event > 200.0f && in_event < 250.0f);
+    float b0 = base_at(181 * 60, res, ok), b1 = base_at(209 * 60, res, ok);
+    float expect = b0 * powf(1.0f - IAQ_BASE_DECAY_H / 60.0f, 28);
+    CHECK(fabsf(b1 / expect - 1.0f) < 1e-4f);
+    CHECK(res[215].iaq < 15.0f);                        // 5 min después, limpio otra vez
+
+    // Deriva a las 6 h: el aire limpio lee un 10 % menos. Al principio parece
+    // contaminación (~50) y la base baja hasta alcanzarlo en unas 5 h
+    CHECK(res[361].iaq > 40.0f);
+    CHECK(res[14 * 60].iaq < 15.0f);
+    CHECK(fabsf(base_at(14 * 60 * 60, res, ok) / (0.9f * CLEAN_OHM) - 1.0f) < 0.02f);
+
+    // NVS: la primera escritura al ser estable, luego como mucho una por hora
+    CHECK(s_nvs_saves >= 2 && s_nvs_saves <= 1 + 24);
+    CHECK(s_save_t[0] == IAQ_WARMUP_S + IAQ_LEARN_S);
+    for (int k = 1; k < s_nvs_saves && k < 64; k++) CHECK(s_save_t[k] - s_save_t[k - 1] >= IAQ_SAVE_PERIOD_S);
+    CHECK(fabsf((float)s_nvs_value / s_baseline - 1.0f) < 0.02f);
+
+    printf("iaq: COV %.0f, riego %.0f (sin compensar %.0f), %d escrituras NVS\n",
+           in_event, max_hum_iaq, max_raw_idx, s_nvs_saves);
+}
+
+static void boot_from_nvs(void) {
+    uint32_t saved = s_nvs_value;
+    reboot();
+    CHECK(s_from_nvs && s_baseline == (float)saved);
+
+    // Base recuperada: estable desde el primer valor y sin reaprender desde el calentamiento
+    iaq_result_t r;
+    int i = 0;
+    while (!iaq_update(s_rows[i].gas, s_rows[i].hum, s_rows[i].t_s * 1000000, &r)) i++;
+    CHECK(s_rows[i].t_s == IAQ_WARMUP_S);
+    CHECK(r.accuracy == IAQ_ACC_STABLE);
+    CHECK(r.baseline >= 0.99f * (float)saved);
+    CHECK(iaq_latest(&r) && r.accuracy == IAQ_ACC_STABLE);
+}
+
+int main(void) {
+    fake_rtos_reset();
+    load_trace();
+    first_boot();
+    boot_from_nvs();
+    printf("iaq: ok\n");
+    return 0;
+}
@@ -0,0 +1,209 @@
+/*
+ * live_stream con LIVE_MAX_CLIENTS clientes contra el anillo: uno se atasca
+ * (su socket se llena y el envío falla tras el timeout de httpd), otro se
+ * desconecta y otro entra en su hueco. Se comprueba que nada crece (cola de
+ * trabajo de httpd, clientes, cursores dentro del anillo) y que los saltos que
+ * ve cada cliente suman exactamente stats.dropped.
+ *
+ * Al final, la cola de trabajo de httpd llena: ningún aviso de vaciado se queda
+ * marcado como pendiente sin estar en la cola.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "fake_rtos.h"
+#include "live_stream.c"
+
+#define TASK_HTTPD      1
+#define PEERS           8
+#define FD_BASE         100
+#define STALL_SEND_US   5000000     // send_wait_timeout de httpd
+#define STALL_PUBLISHES 5           // Muestras que llegan mientras httpd está atascado
+
+typedef struct {
+    httpd_ws_client_info_t info;
+    int room;               // Frames que caben antes de atascarse (-1 = sin límite)
+    bool closed;
+    uint32_t expected;      // Siguiente seq que debería llegar
+    uint32_t received;
+    uint32_t gaps;          // Mensajes saltados
+    uint32_t sends_after_gone;
+} peer_t;
+
+static peer_t s_peers[PEERS];
+static httpd_work_fn_t s_work[4];
+static int s_work_n, s_work_max;
+static bool s_queue_full;
+static uint32_t s_published;
+
+esp_err_t httpd_register_uri_handler(httpd_handle_t h, const httpd_uri_t *uri) { return ESP_OK; }
+int httpd_req_to_sockfd(httpd_req_t *r) { return r->fd; }
+esp_err_t httpd_ws_recv_frame(httpd_req_t *req, httpd_ws_frame_t *pkt, size_t max_len) { return ESP_OK; }
+
+esp_err_t httpd_queue_work(httpd_handle_t h, httpd_work_fn_t work, void *arg) {
+    if (s_queue_full) return ESP_FAIL;
+    CHECK(s_work_n < (int)(sizeof(s_work) / sizeof(s_work[0])));
+    s_work[s_work_n++] = work;
+    if (s_work_n > s_work_max) s_work_max = s_work_n;
+    return ESP_OK;
+}
+
+esp_err_t httpd_sess_trigger_close(httpd_handle_t h, int fd) {
+    s_peers[fd - FD_BASE].closed = true;
+    s_peers[fd - FD_BASE].info = HTTPD_WS_CLIENT_INVALID;
+    return ESP_OK;
+}
+
+httpd_ws_client_info_t httpd_ws_get_fd_info(httpd_handle_t h, int fd) {
+    return s_peers[fd - FD_BASE].info;
+}
+
+static void publish(void) {
+    char json[32];
+    snprintf(json, sizeof(json), "{\"seq\":%lu}", (unsigned long)s_published++);
+    int task = fake_task;
+    fake_task = FAKE_TASK_MAIN;
+    live_stream_publish(json);
+    fake_task = task;
+}
+
+esp_err_t httpd_ws_send_frame_async(httpd_handle_t h, int fd, httpd_ws_frame_t *frame) {
+    peer_t *p = &s_peers[fd - FD_BASE];
+    CHECK(fake_task == TASK_HTTPD);
+    CHECK(fake_mutex_holder(s_lock) == -1);     // Nunca se envía con el anillo tomado
+    if (p->info != HTTPD_WS_CLIENT_WEBSOCKET) p->sends_after_gone++;
+    unsigned long seq;
+    CHECK(sscanf((const char *)frame->payload, "{\"seq\":%lu}", &seq) == 1 && frame->len == strlen((char *)frame->payload));
+    CHECK(seq >= p->expected);
+    p->gaps += seq - p->expected;
+    p->expected = seq + 1;
+    if (p->room == 0) {
+        // Socket lleno: httpd se queda en send() hasta el timeout y mientras tanto siguen llegando muestras
+        for (int i = 0; i < STALL_PUBLISHES; i++) publish();
+        fake_now_us += STALL_SEND_US;
+        return ESP_FAIL;
+    }
+    if (p->room > 0) p->room--;
+    p->received++;
+    return ESP_OK;
+}
+
+static void run_work(void) {
+    int guard = 1000;
+    fake_task = TASK_HTTPD;
+    while (s_work_n && guard--) {
+        httpd_work_fn_t fn = s_work[0];
+        memmove(s_work, s_work + 1, --s_work_n * sizeof(s_work[0]));
+        fn(NULL);
+    }
+    CHECK(guard > 0);
+    fake_task = FAKE_TASK_MAIN;
+}
+
+static esp_err_t connect(int peer, int room) {
+    s_peers[peer] = (peer_t){ .info = HTTPD_WS_CLIENT_WEBSOCKET, .room = room };
+    s_peers[peer].expected = s_next_seq ? s_next_seq - 1 : 0;   // Empieza por la última muestra
+    httpd_req_t req = { .method = HTTP_GET, .fd = FD_BASE + peer };
+    return ws_handler(&req);
+}
+
+static int active_clients(void) {
+    int n = 0;
+    for (int i = 0; i < LIVE_MAX_CLIENTS; i++) {
+        if (s_clients[i].fd >= 0) n++;
+    }
+    return n;
+}
+
+static void check_bounded(void) {
+    CHECK(s_work_n <= 1);
+    CHECK(active_clients() == s_stats.clients && s_stats.clients <= LIVE_MAX_CLIENTS);
+    uint32_t oldest = s_next_seq > LIVE_RING_LEN ? s_next_seq - LIVE_RING_LEN : 0;
+    for (int i = 0; i < LIVE_MAX_CLIENTS; i++) {
+        if (s_clients[i].fd < 0) continue;
+        // Tras un envío el cursor queda dentro del anillo; antes puede ir atrasado, nunca adelantado
+        CHECK(s_clients[i].cursor <= s_next_seq);
+        if (!s_work_n) CHECK(s_clients[i].cursor >= oldest && s_clients[i].cursor == s_next_seq);
+    }
+}
+
+static void caught_up(void) {
+    CHECK(!s_work_n);
+    for (int i = 0; i < LIVE_MAX_CLIENTS; i++) {
+        if (s_clients[i].fd >= 0) CHECK(s_peers[s_clients[i].fd - FD_BASE].expected == s_next_seq);
+    }
+}
+
+static void test_queue_full(void) {
+    CHECK(s_stats.clients < LIVE_MAX_CLIENTS && !s_work_n && !s_flush_pending);
+
+    // Alta y publicación sin sitio en la cola
+    s_queue_full = true;
+    CHECK(connect(6, -1) == ESP_OK);
+    CHECK(!s_work_n && !s_flush_pending);
+    publish();
+    CHECK(!s_work_n && !s_flush_pending);
+    s_queue_full = false;
+    publish();
+    CHECK(s_work_n == 1);
+    run_work();
+    caught_up();
+
+    // Reprogramación tras agotar LIVE_SEND_BUDGET sin sitio en la cola
+    for (int i = 0; i < 2 * LIVE_SEND_BUDGET; i++) publish();
+    CHECK(s_work_n == 1);
+    s_queue_full = true;
+    run_work();
+    CHECK(!s_work_n && !s_flush_pending);
+    s_queue_full = false;
+    publish();
+    run_work();
+    caught_up();
+    printf("live_stream: cola de httpd llena: ok\n");
+}
+
+int main(void) {
+    fake_rtos_reset();
+    srand(1);
+    CHECK(live_stream_register((httpd_handle_t)1) == ESP_OK);
+
+    for (int i = 0; i < LIVE_MAX_CLIENTS; i++) CHECK(connect(i, i == 3 ? 40 : -1) == ESP_OK);
+    CHECK(connect(LIVE_MAX_CLIENTS, -1) == ESP_FAIL);       // Sin hueco
+    CHECK(s_stats.clients == LIVE_MAX_CLIENTS);
+    run_work();
+
+    for (int step = 0; step < 2000; step++) {
+        publish();
+        if (step == 600) s_peers[2].info = HTTPD_WS_CLIENT_INVALID;     // Se va sin avisar
+        if (step == 1200) CHECK(connect(5, -1) == ESP_OK);             // Ocupa un hueco liberado
+        // httpd a veces va al día y a veces se retrasa más que el anillo
+        if (rand() % (step < 1000 ? 3 : 40) == 0) run_work();
+        check_bounded();
+    }
+    run_work();
+    check_bounded();
+
+    uint32_t gaps = 0, received = 0;
+    for (int i = 0; i < PEERS; i++) {
+        gaps += s_peers[i].gaps;
+        received += s_peers[i].received;
+        CHECK(s_peers[i].sends_after_gone == 0);
+    }
+    // El atascado se cerró, el desconectado se retiró sin intentar enviarle
+    CHECK(s_peers[3].closed && s_peers[3].received == 40);
+    CHECK(!s_peers[2].closed);
+    for (int i = 0; i < LIVE_MAX_CLIENTS; i++) CHECK(s_clients[i].fd != FD_BASE + 2 && s_clients[i].fd != FD_BASE + 3);
+    CHECK(s_stats.clients == 3);
+    // Los que siguen conectados lo han visto todo: recibido + saltado
+    for (int i = 0; i < PEERS; i++) {
+        if (i == 2 || i == 3 || i == LIVE_MAX_CLIENTS || !s_peers[i].info) continue;
+        CHECK(s_peers[i].expected == s_next_seq);
+    }
+    CHECK(s_stats.published == s_published && s_stats.sent == received);
+    CHECK(s_stats.dropped == gaps && gaps > 0);
+    CHECK(s_work_max <= 1);
+    printf("live_stream: %lu publicados, %lu enviados, %lu saltados, %d clientes: ok\n",
+           (unsigned long)s_stats.published, (unsigned long)s_stats.sent,
+           (unsigned long)s_stats.dropped, s_stats.clients);
+    test_queue_full();
+    return 0;
+}
@@ -0,0 +1,254 @@
+/*
+ * mqtt_outbox contra un esp-mqtt y un broker simulados, con el broker caído a
+ * mitad de envío, un PUBACK perdido y un reinicio con mensajes pendientes.
+ *
+ * El cliente simulado reproduce el orden de bloqueos de esp-mqtt: su tarea
+ * entrega los eventos con el bloqueo del cliente tomado y esp_mqtt_client_enqueue
+ * lo toma. Si alguien publicara desde otra tarea con s_lock tomado, justo
+ * entonces la tarea MQTT entrega un PUBACK y el FreeRTOS simulado detecta el
+ * interbloqueo.
+ *
+ * Al final, un equipo actualizado por OTA sin la partición: publicación directa.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "fake_rtos.h"
+#include "mqtt_outbox.c"
+
+#define TASK_MQTT       2
+#define PART_SIZE       (16 * OUTBOX_SECTOR)
+#define MESSAGES        600
+#define CLIENT_OUTBOX   64
+
+typedef struct {
+    int msg_id;
+    int n;
+    bool delivered;         // Llegó al broker, falta el PUBACK
+} out_msg_t;
+
+static uint8_t s_flash[PART_SIZE];
+static const esp_partition_t s_fake_part = {
+    .type = ESP_PARTITION_TYPE_DATA, .subtype = OUTBOX_PART_SUBTYPE, .size = PART_SIZE, .label = "outbox",
+};
+
+static SemaphoreHandle_t s_client_lock;
+static out_msg_t s_cli_out[CLIENT_OUTBOX];
+static int s_cli_n, s_next_msg_id = 1;
+static bool s_user_event, s_connected, s_broker_up = true;
+static int s_user_overflows;
+static uint32_t s_enqueued;         // Desde el último arranque, como s_stats
+
+static int s_seen[MESSAGES];        // Veces que llegó cada mensaje al broker
+static int s_first[MESSAGES], s_first_n;
+static bool s_no_part;              // Tabla de particiones anterior a la bandeja
+
+const esp_partition_t *esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t sub, const char *label) {
+    return s_no_part ? NULL : &s_fake_part;
+}
+
+esp_err_t esp_partition_read(const esp_partition_t *p, size_t off, void *dst, size_t len) {
+    CHECK(off + len <= PART_SIZE);
+    memcpy(dst, s_flash + off, len);
+    return ESP_OK;
+}
+
+// NOR: escribir solo baja bits
+esp_err_t esp_partition_write(const esp_partition_t *p, size_t off, const void *src, size_t len) {
+    CHECK(off + len <= PART_SIZE);
+    for (size_t i = 0; i < len; i++) s_flash[off + i] &= ((const uint8_t *)src)[i];
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_erase_range(const esp_partition_t *p, size_t off, size_t len) {
+    CHECK(off % OUTBOX_SECTOR == 0 && len % OUTBOX_SECTOR == 0 && off + len <= PART_SIZE);
+    memset(s_flash + off, 0xFF, len);
+    return ESP_OK;
+}
+
+uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t *buf, uint32_t len) {
+    crc = ~crc;
+    while (len--) {
+        crc ^= *buf++;
+        for (int k = 0; k < 8; k++) crc = (crc >> 1) ^ (0xEDB88320u & -(crc & 1));
+    }
+    return ~crc;
+}
+
+// La tarea MQTT entrega un evento con el bloqueo del cliente tomado
+static void dispatch(esp_mqtt_event_id_t id, int msg_id) {
+    int task = fake_task;
+    fake_task = TASK_MQTT;
+    CHECK(xSemaphoreTake(s_client_lock, portMAX_DELAY));
+    esp_mqtt_event_t ev = { .event_id = id, .msg_id = msg_id };
+    mqtt_outbox_on_event(&ev);
+    xSemaphoreGive(s_client_lock);
+    fake_task = task;
+}
+
+static bool ack_one(void) {
+    for (int i = 0; i < s_cli_n; i++) {
+        if (!s_cli_out[i].delivered) continue;
+        int msg_id = s_cli_out[i].msg_id;
+        memmove(&s_cli_out[i], &s_cli_out[i + 1], (--s_cli_n - i) * sizeof(s_cli_out[0]));
+        dispatch(MQTT_EVENT_PUBLISHED, msg_id);
+        return true;
+    }
+    return false;
+}
+
+int esp_mqtt_client_enqueue(esp_mqtt_client_handle_t client, const char *topic, const char *data, int len,
+                            int qos, int retain, bool store) {
+    CHECK(qos == 1 && store);
+    if (fake_task != TASK_MQTT) {
+        // Otra tarea: justo ahora la tarea MQTT está entregando un PUBACK
+        ack_one();
+        CHECK(xSemaphoreTake(s_client_lock, portMAX_DELAY));
+        xSemaphoreGive(s_client_lock);
+    }
+    if (s_cli_n == CLIENT_OUTBOX) return -1;
+    int n;
+    CHECK(sscanf(data, "{\"n\":%d}", &n) == 1 && n >= 0 && n < MESSAGES);
+    s_cli_out[s_cli_n++] = (out_msg_t){ .msg_id = s_next_msg_id, .n = n };
+    s_enqueued++;
+    return s_next_msg_id++;
+}
+
+esp_err_t esp_mqtt_dispatch_custom_event(esp_mqtt_client_handle_t client, esp_mqtt_event_t *event) {
+    CHECK(event->event_id == MQTT_USER_EVENT);
+    CHECK(fake_mutex_holder(s_lock) != fake_task);
+    // CONFIG_MQTT_EVENT_QUEUE_SIZE = 1 y sin esperar
+    if (s_user_event) {
+        s_user_overflows++;
+        return ESP_ERR_TIMEOUT;
+    }
+    s_user_event = true;
+    return ESP_OK;
+}
+
+// Una vuelta de la tarea MQTT
+static void mqtt_step(void) {
+    if (s_user_event) {
+        s_user_event = false;
+        dispatch(MQTT_USER_EVENT, 0);
+    }
+    if (!s_connected) {
+        if (!s_broker_up) return;
+        s_connected = true;
+        dispatch(MQTT_EVENT_CONNECTED, 0);
+        return;
+    }
+    if (!s_broker_up) {
+        // Lo que esperaba PUBACK se pierde con la conexión
+        s_connected = false;
+        s_cli_n = 0;
+        dispatch(MQTT_EVENT_DISCONNECTED, 0);
+        return;
+    }
+    while (ack_one()) {
+    }
+    for (int i = 0; i < s_cli_n; i++) {
+        out_msg_t *m = &s_cli_out[i];
+        if (m->delivered) continue;
+        m->delivered = true;
+        if (!s_seen[m->n]++) s_first[s_first_n++] = m->n;
+    }
+}
+
+static void push(int n) {
+    char json[24];
+    int len = snprintf(json, sizeof(json), "{\"n\":%d}", n);
+    fake_task = FAKE_TASK_MAIN;
+    CHECK(mqtt_outbox_push(OUTBOX_TELEMETRY, json, len) == ESP_OK);
+}
+
+static void reboot(void) {
+    s_online = false;
+    s_pump_requested = false;
+    memset(s_inflight, 0, sizeof(s_inflight));
+    vSemaphoreDelete(s_lock);
+    CHECK(mqtt_outbox_init() == ESP_OK);
+    s_connected = false;
+    s_user_event = false;
+    s_cli_n = 0;
+    s_enqueued = 0;
+}
+
+// Sin partición: push publica directo, desde otra tarea y sin s_lock tomado
+static void test_no_partition(void) {
+    enum { DIRECT = 40 };
+    s_no_part = true;
+    vSemaphoreDelete(s_lock);
+    CHECK(mqtt_outbox_init() == ESP_ERR_NOT_FOUND);
+    CHECK(s_part == NULL && s_lock != NULL);
+    memset(&s_stats, 0, sizeof(s_stats));
+    memset(s_seen, 0, sizeof(s_seen));
+    s_first_n = 0;
+    s_enqueued = 0;
+
+    esp_mqtt_client_handle_t client = s_client;
+    s_client = NULL;
+    CHECK(mqtt_outbox_push(OUTBOX_TELEMETRY, "{\"n\":0}", 7) == ESP_ERR_INVALID_STATE);
+    s_client = client;
+
+    for (int n = 0; n < DIRECT; n++) {
+        push(n);
+        CHECK(!s_user_event);
+        if (n % 4 == 3) mqtt_step();
+    }
+    for (int guard = 0; guard < 100 && s_cli_n; guard++) mqtt_step();
+    for (int n = 0; n < DIRECT; n++) CHECK(s_seen[n] == 1);
+    CHECK(s_stats.sent == DIRECT && s_stats.acked == DIRECT && s_stats.pending == 0);
+
+    // Cola del cliente llena: el error llega a quien publica
+    s_broker_up = false;
+    mqtt_step();
+    for (int n = 0; n < CLIENT_OUTBOX; n++) push(n);
+    CHECK(mqtt_outbox_push(OUTBOX_TELEMETRY, "{\"n\":0}", 7) == ESP_FAIL);
+    s_broker_up = true;
+    s_no_part = false;
+    printf("mqtt_outbox: sin partición, %d publicaciones directas: ok\n", DIRECT);
+}
+
+int main(void) {
+    fake_rtos_reset();
+    srand(7);
+    memset(s_flash, 0xFF, sizeof(s_flash));
+    s_client_lock = xSemaphoreCreateMutex();
+    CHECK(mqtt_outbox_init() == ESP_OK);
+    mqtt_outbox_attach((esp_mqtt_client_handle_t)1);
+
+    for (int n = 0; n < MESSAGES; n++) {
+        if (n == 150) s_broker_up = false;                     // Broker caído un rato
+        if (n == 220) reboot();                                // Reinicio con pendientes en flash
+        if (n == 260) s_broker_up = true;
+        push(n);
+        if (n != 400) {
+            for (int k = rand() % 3; k > 0; k--) mqtt_step();
+        } else {
+            // Caída justo después de entregar y antes de los PUBACK
+            mqtt_step();
+            CHECK(s_cli_n > 0 && s_cli_out[0].delivered);
+            s_broker_up = false;
+            mqtt_step();
+            s_broker_up = true;
+        }
+    }
+    for (int guard = 0; guard < 1000 && (s_stats.pending || s_cli_n || s_user_event); guard++) mqtt_step();
+
+    int dupes = 0;
+    for (int n = 0; n < MESSAGES; n++) {
+        CHECK(s_seen[n] >= 1);
+        dupes += s_seen[n] - 1;
+    }
+    // Primera llegada en orden: el reenvío empieza siempre por el más antiguo
+    for (int i = 1; i < s_first_n; i++) CHECK(s_first[i] > s_first[i - 1]);
+    CHECK(s_first_n == MESSAGES);
+    CHECK(s_stats.pending == 0 && s_stats.evicted == 0);
+    CHECK(s_stats.sent == s_enqueued);
+    CHECK(dupes > 0);
+    CHECK(s_user_overflows == 0);
+    printf("mqtt_outbox: %d mensajes, %d duplicados (al menos una vez), %lu publicaciones: ok\n",
+           MESSAGES, dupes, (unsigned long)s_stats.sent);
+    test_no_partition();
+    return 0;
+}
@@ -0,0 +1,82 @@
+/*
+ * psychro contra las fórmulas de Magnus en doble precisión con exp/log:
+ * barrido de -10 a 50 C y de 5 a 100 %HR con tolerancias fijas para el punto
+ * de rocío, el VPD y la humedad absoluta.
+ */
+#include <stdio.h>
+#include <math.h>
+#include "fake_rtos.h"
+#include "psychro.c"
+
+// Interpolar es(T) entre grados enteros da ~0,06 % de error relativo
+#define TOL_DEW     0.02    // C
+#define TOL_VPD     0.005   // kPa
+#define TOL_ABS     0.03    // g/m3
+
+typedef struct {
+    double dew;
+    double vpd;
+    double abs;
+} ref_t;
+
+static double ref_svp(double t) {
+    return MAGNUS_E0 * exp(MAGNUS_A * t / (MAGNUS_B + t));
+}
+
+static ref_t reference(double t, double rh) {
+    double e = ref_svp(t) * rh / 100.0;
+    double g = log(rh / 100.0) + MAGNUS_A * t / (MAGNUS_B + t);
+    return (ref_t){
+        .dew = MAGNUS_B * g / (MAGNUS_A - g),
+        .vpd = (ref_svp(t) - e) / 10.0,
+        .abs = 216.7 * e / (t + 273.15),
+    };
+}
+
+int main(void) {
+    fake_rtos_reset();
+
+    // La tabla es la fórmula en cada grado
+    for (int t = PSYCHRO_T_MIN; t <= PSYCHRO_T_MAX; t++) {
+        CHECK(fabs(psychro_svp(t) - ref_svp(t)) <= ref_svp(t) * 1e-4 + 1e-4);
+    }
+
+    double err_dew = 0, err_vpd = 0, err_abs = 0;
+    int n = 0;
+    for (int t10 = -100; t10 <= 500; t10++) {
+        float prev_dew = -100.0f;
+        for (int rh2 = 10; rh2 <= 200; rh2++) {
+            float t = t10 / 10.0f, rh = rh2 / 2.0f;
+            psychro_t p;
+            psychro_compute(t, rh, &p);
+            ref_t r = reference(t, rh);
+            err_dew = fmax(err_dew, fabs(p.dew_point - r.dew));
+            err_vpd = fmax(err_vpd, fabs(p.vpd - r.vpd));
+            err_abs = fmax(err_abs, fabs(p.abs_hum - r.abs));
+            // Con más humedad el rocío sube y nunca pasa de la temperatura
+            CHECK(p.dew_point > prev_dew && p.dew_point <= t + TOL_DEW);
+            prev_dew = p.dew_point;
+            n++;
+        }
+    }
+    if (err_dew > TOL_DEW || err_vpd > TOL_VPD || err_abs > TOL_ABS) {
+        fake_fail("error máximo: rocío %.4f C, vpd %.4f kPa, abs %.4f g/m3", err_dew, err_vpd, err_abs);
+    }
+
+    // Fuera de rango: HR recortada y tabla saturada en los extremos
+    psychro_t a, b;
+    psychro_compute(25.0f, 120.0f, &a);
+    psychro_compute(25.0f, 100.0f, &b);
+    CHECK(a.dew_point == b.dew_point && a.vpd == b.vpd && fabsf(a.vpd) < 1e-4f);
+    psychro_compute(25.0f, -5.0f, &a);
+    CHECK(a.dew_point == PSYCHRO_T_MIN && a.abs_hum == 0.0f);
+    CHECK(psychro_svp(PSYCHRO_T_MAX + 10) == psychro_svp(PSYCHRO_T_MAX));
+
+    psychro_bench_t bench;
+    psychro_benchmark(&bench);
+    CHECK(bench.max_err_dew <= TOL_DEW && bench.max_err_vpd <= TOL_VPD && bench.max_err_abs <= TOL_ABS);
+    printf("psychro: %d puntos, error máximo rocío %.4f C, vpd %.4f kPa, abs %.4f g/m3; "
+           "ns/llamada %lu frente a %lu: ok\n", n, err_dew, err_vpd, err_abs,
+           (unsigned long)bench.fast_cycles, (unsigned long)bench.ref_cycles);
+    return 0;
+}
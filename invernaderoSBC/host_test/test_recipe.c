@@ -0,0 +1,291 @@
+/*
+ * Recetas: rangos de la importación, avance de fases por uptime (también varias
+ * de golpe tras un apagado largo), rampa lineal entre fases, horario día/noche
+ * con y sin cruce de medianoche y reanudación tras reiniciar con hora real.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "fake_rtos.h"
+#include "recipe.c"
+
+#define H(x)        ((x) * 3600)
+#define MIDNIGHT    1750032000      // 2025-06-16 00:00 UTC
+
+FaseCultivo fase_germinacion = {"Germinacion", 24.0, 28.0, 60.0, 70.0, 150.0};
+FaseCultivo *fase_actual = &fase_germinacion;
+bool modo_automatico = false;
+
+static int s_nvs_saves;
+static time_t s_epoch;              // 0 = sin hora real
+
+void guardar_estado_nvs(void) {
+}
+
+time_t time(time_t *t) {
+    time_t v = s_epoch ? s_epoch : 1000;
+    if (t) *t = v;
+    return v;
+}
+
+// ------------------------------------------------------------------ NVS
+
+static struct {
+    char key[16];
+    uint8_t data[sizeof(recipe_blob_t)];
+    size_t len;
+} s_nvs[2];
+
+esp_err_t nvs_open(const char *ns, nvs_open_mode_t mode, nvs_handle_t *out) {
+    *out = 1;
+    return ESP_OK;
+}
+
+esp_err_t nvs_get_blob(nvs_handle_t h, const char *key, void *out, size_t *len) {
+    for (int i = 0; i < 2; i++) {
+        if (strcmp(s_nvs[i].key, key) != 0) continue;
+        CHECK(*len >= s_nvs[i].len);
+        memcpy(out, s_nvs[i].data, s_nvs[i].len);
+        *len = s_nvs[i].len;
+        return ESP_OK;
+    }
+    return ESP_ERR_NVS_NOT_FOUND;
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t h, const char *key, const void *value, size_t len) {
+    for (int i = 0; i < 2; i++) {
+        if (s_nvs[i].key[0] && strcmp(s_nvs[i].key, key) != 0) continue;
+        CHECK(len <= sizeof(s_nvs[i].data));
+        strlcpy(s_nvs[i].key, key, sizeof(s_nvs[i].key));
+        memcpy(s_nvs[i].data, value, len);
+        s_nvs[i].len = len;
+        s_nvs_saves++;
+        return ESP_OK;
+    }
+    fake_fail("nvs lleno: %s", key);
+}
+
+esp_err_t nvs_commit(nvs_handle_t h) {
+    return ESP_OK;
+}
+
+void nvs_close(nvs_handle_t h) {
+}
+
+uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t *buf, uint32_t len) {
+    crc = ~crc;
+    while (len--) {
+        crc ^= *buf++;
+        for (int k = 0; k < 8; k++) crc = (crc >> 1) ^ (0xEDB88320u & -(crc & 1));
+    }
+    return ~crc;
+}
+
+// ------------------------------------------------------------------ Ayudas
+
+static void advance(int64_t s) {
+    fake_now_us += s * 1000000;
+    if (s_epoch) s_epoch += s;
+}
+
+static esp_err_t apply(const char *json, char *err, size_t err_len) {
+    cJSON *root = cJSON_Parse(json);
+    CHECK(root);
+    err[0] = 0;
+    esp_err_t ret = recipe_apply_json(root, err, err_len);
+    cJSON_Delete(root);
+    return ret;
+}
+
+static void apply_ok(const char *json) {
+    char err[96];
+    esp_err_t ret = apply(json, err, sizeof(err));
+    if (ret != ESP_OK) fake_fail("receta rechazada: %s", err);
+}
+
+static recipe_status_t status(void) {
+    recipe_status_t st;
+    recipe_get_status(&st);
+    return st;
+}
+
+static bool near(float a, float b) {
+    return a > b - 1e-3f && a < b + 1e-3f;
+}
+
+// ------------------------------------------------------------------ Pruebas
+
+// Valores que no caben en los campos enteros se rechazan con motivo, sin tocar la receta
+static void test_import_ranges(void) {
+    static const struct {
+        const char *field;
+        const char *key;
+    } bad[] = {
+        { "\"ramp_h\":1093", "ramp_h" },
+        { "\"ramp_h\":-1", "ramp_h" },
+        { "\"hours\":1e12", "hours" },
+        { "\"hours\":-5", "hours" },
+        { "\"hours\":\"12\"", "hours" },
+        { "\"night_temp\":400", "night_temp" },
+        { "\"night_temp\":-20.5", "night_temp" },
+        { "\"night_hum\":3277", "night_hum" },
+        { "\"night_hum\":-51", "night_hum" },
+    };
+    char json[256], err[96];
+    for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); i++) {
+        snprintf(json, sizeof(json), "{\"phases\":[{\"name\":\"A\",\"temp\":[20,24],\"hum\":[80,90],%s}]}",
+                 bad[i].field);
+        CHECK(apply(json, err, sizeof(err)) == ESP_ERR_INVALID_ARG);
+        if (!strstr(err, bad[i].key) || strncmp(err, "A: ", 3) != 0) fake_fail("%s: \"%s\"", bad[i].field, err);
+        CHECK(s_recipe.count == 0 && !recipe_running());
+    }
+
+    // Los extremos sí caben
+    apply_ok("{\"phases\":[{\"name\":\"A\",\"temp\":[20,24],\"hum\":[80,90],\"hours\":8760,\"ramp_h\":1092,"
+             "\"night_temp\":-20,\"night_hum\":50},{\"temp\":[20,24],\"hum\":[80,90],\"night_temp\":20,\"night_hum\":-50}]}");
+    CHECK(s_recipe.count == 2);
+    const recipe_phase_t *p = &s_recipe.phases[0];
+    CHECK(p->duration_min == 525600 && p->ramp_min == 65520);
+    CHECK(p->night_dtemp_c10 == -200 && p->night_dhum_c10 == 500);
+    CHECK(s_recipe.phases[1].night_dtemp_c10 == 200 && s_recipe.phases[1].night_dhum_c10 == -500);
+    CHECK(s_recipe.phases[1].duration_min == 0 && s_recipe.phases[1].ramp_min == 0);
+    recipe_stop();
+    printf("recipe: rangos de importación: ok\n");
+}
+
+// Sin hora real: avance por uptime, rampa de media hora y fase final indefinida
+static void test_schedule(void) {
+    s_epoch = 0;
+    apply_ok("{\"phases\":["
+             "{\"name\":\"Incubacion\",\"hours\":1,\"temp\":[24,28],\"hum\":[60,70]},"
+             "{\"name\":\"Fruto\",\"hours\":2,\"ramp_h\":0.5,\"temp\":[18,22],\"hum\":[90,96],\"iaq_max\":120},"
+             "{\"name\":\"Final\",\"temp\":[16,20],\"hum\":[85,90]}]}");
+    CHECK(recipe_running() && fase_actual == &fase_receta && modo_automatico);
+    CHECK(status().phase == 0 && status().remaining_s == H(1));
+
+    advance(H(1) - 1);
+    recipe_tick();
+    CHECK(status().phase == 0 && status().remaining_s == 1 && near(fase_receta.temp_min, 24.0f));
+    CHECK(fase_receta.iaq_max == RECIPE_IAQ_DEFAULT);
+
+    // La rampa arranca en las consignas de la fase anterior y llega a las nuevas en 30 min
+    advance(1);
+    recipe_tick();
+    CHECK(status().phase == 1 && status().elapsed_s == 0 && strcmp(fase_receta.nombre, "Fruto") == 0);
+    CHECK(fase_receta.iaq_max == 120);
+    for (int t = 0; t <= 1800; t += 60) {
+        float f = t / 1800.0f;
+        CHECK(near(fase_receta.temp_min, 24.0f + f * (18.0f - 24.0f)));
+        CHECK(near(fase_receta.temp_max, 28.0f + f * (22.0f - 28.0f)));
+        CHECK(near(fase_receta.hum_min, 60.0f + f * (90.0f - 60.0f)));
+        CHECK(near(fase_receta.hum_max, 70.0f + f * (96.0f - 70.0f)));
+        advance(60);
+        recipe_tick();
+    }
+    CHECK(near(fase_receta.temp_min, 18.0f) && near(fase_receta.hum_max, 96.0f));
+
+    // Última fase sin duración: sin rampa ni fin
+    advance(H(2) - 1860);
+    recipe_tick();
+    CHECK(status().phase == 2 && status().remaining_s == 0 && near(fase_receta.temp_min, 16.0f));
+    advance(H(1000));
+    recipe_tick();
+    CHECK(status().phase == 2 && status().elapsed_s == H(1000));
+
+    // Tras un apagado largo avanza una fase por llamada y conserva el sobrante
+    apply_ok("{\"phases\":[{\"hours\":1,\"temp\":[20,24],\"hum\":[80,90]},{\"hours\":1,\"temp\":[20,24],\"hum\":[80,90]},"
+             "{\"hours\":1,\"temp\":[20,24],\"hum\":[80,90]}]}");
+    advance(H(2) + 1800);
+    recipe_tick();
+    CHECK(status().phase == 1 && status().elapsed_s == H(1) + 1800);
+    recipe_tick();
+    CHECK(status().phase == 2 && status().elapsed_s == 1800);
+    recipe_tick();
+    CHECK(status().phase == 2 && status().remaining_s == 1800);
+    recipe_stop();
+    printf("recipe: fases y rampa: ok\n");
+}
+
+static void check_day(int start, int end) {
+    char json[200];
+    snprintf(json, sizeof(json),
+             "{\"phases\":[{\"temp\":[20,24],\"hum\":[80,90],\"day\":[%d,%d],\"night_temp\":-2.5,\"night_hum\":5}]}",
+             start, end);
+    s_epoch = MIDNIGHT;
+    apply_ok(json);
+    for (int m = 0; m < 24 * 60; m += 15) {
+        s_epoch = MIDNIGHT + m * 60;
+        recipe_tick();
+        int h = m / 60;
+        bool day = (start == end) || (start < end ? (h >= start && h < end) : (h >= start || h < end));
+        if (status().night == day) fake_fail("día [%d,%d] a las %02d:%02d", start, end, h, m % 60);
+        CHECK(near(fase_receta.temp_min, day ? 20.0f : 17.5f) && near(fase_receta.hum_max, day ? 90.0f : 95.0f));
+    }
+    recipe_stop();
+}
+
+static void test_day_window(void) {
+    setenv("TZ", "UTC0", 1);
+    tzset();
+    check_day(8, 20);
+    check_day(20, 8);       // El día cruza la medianoche
+    check_day(22, 2);
+    check_day(6, 6);        // Sin noche
+
+    // Sin hora real no hay noche
+    s_epoch = 0;
+    apply_ok("{\"phases\":[{\"temp\":[20,24],\"hum\":[80,90],\"day\":[23,0],\"night_temp\":-2}]}");
+    recipe_tick();
+    CHECK(!status().night && near(fase_receta.temp_min, 20.0f));
+    recipe_stop();
+    printf("recipe: horario día/noche: ok\n");
+}
+
+// Con hora real el tiempo apagado cuenta; sin ella se sigue desde el último guardado
+static void test_resume(void) {
+    s_epoch = 0;
+    apply_ok("{\"phases\":[{\"hours\":3,\"temp\":[20,24],\"hum\":[80,90]},{\"hours\":3,\"temp\":[18,22],\"hum\":[85,95]}]}");
+    advance(1800);
+    recipe_tick();
+    // Llega la hora: el inicio real de la fase se deduce del progreso
+    s_epoch = MIDNIGHT;
+    recipe_tick();
+    CHECK(s_state.start_epoch == MIDNIGHT - 1800 && status().clock_synced);
+    advance(1800);
+    recipe_tick();
+    CHECK(status().elapsed_s == H(1));
+
+    // Reinicio con una hora apagado
+    memset(&s_recipe, 0, sizeof(s_recipe));
+    memset(&s_state, 0, sizeof(s_state));
+    fase_actual = &fase_germinacion;
+    fake_now_us = 0;
+    s_saved_us = 0;
+    s_epoch += H(1);
+    recipe_init();
+    CHECK(recipe_running() && fase_actual == &fase_receta && s_recipe.count == 2);
+    CHECK(status().phase == 0 && status().elapsed_s == H(2));
+    advance(H(1));
+    recipe_tick();
+    CHECK(status().phase == 1 && status().elapsed_s == 0);
+
+    // Parada y reanudación: el tiempo parado no cuenta
+    advance(600);
+    recipe_tick();
+    recipe_stop();
+    advance(H(5));
+    apply_ok("{\"running\":true}");
+    CHECK(status().phase == 1 && status().elapsed_s == 600);
+    recipe_stop();
+    printf("recipe: reanudación: ok\n");
+}
+
+int main(void) {
+    fake_rtos_reset();
+    s_lock = xSemaphoreCreateMutex();
+    test_import_ranges();
+    test_schedule();
+    test_day_window();
+    test_resume();
+    CHECK(s_nvs_saves > 0);
+    return 0;
+}
@@ -0,0 +1,49 @@
+/*
+ * Envío por excepción: bandas muertas, latido y gas sin medida (0).
+ */
+#include <stdio.h>
+#include "fake_rtos.h"
+#include "report.c"
+
+#define S(x) ((int64_t)(x) * 1000000)
+
+static telemetry_sample_t sample(float temp, float gas) {
+    return (telemetry_sample_t){
+        .temperature = temp, .humidity = 50.0f, .pressure = 1013.0f, .gas = gas,
+        .iaq = -1, .auto_mode = 1, .phase_id = 0,
+    };
+}
+
+int main(void) {
+    fake_rtos_reset();
+    telemetry_sample_t s = sample(20.0f, 0.0f);
+
+    // Sin gas (calentador sin estabilizar): no dispara nada por sí solo
+    CHECK(report_should_send(&s, S(1)));
+    for (int i = 2; i < 100; i++) CHECK(!report_should_send(&s, S(i)));
+    s.temperature += REPORT_DB_TEMP;
+    CHECK(report_should_send(&s, S(100)));
+
+    // Primera medida de gas: cambio de estado
+    s.gas = 50000.0f;
+    CHECK(report_should_send(&s, S(101)));
+    s.gas = 50000.0f * (1.0f + 0.9f * REPORT_DB_GAS_PCT / 100.0f);
+    CHECK(!report_should_send(&s, S(102)));
+    s.gas = 50000.0f * (1.0f + 1.1f * REPORT_DB_GAS_PCT / 100.0f);
+    CHECK(report_should_send(&s, S(103)));
+    // Y su pérdida también
+    s.gas = 0.0f;
+    CHECK(report_should_send(&s, S(104)));
+
+    // Latido aunque nada cambie
+    CHECK(!report_should_send(&s, S(104 + REPORT_HEARTBEAT_S - 1)));
+    CHECK(report_should_send(&s, S(104 + REPORT_HEARTBEAT_S)));
+
+    report_stats_t st;
+    report_get_stats(&st);
+    CHECK(st.heartbeats == 1 && st.sent == 6 && st.evaluated == st.sent + st.suppressed);
+    CHECK(report_suppression_pct(&st) > 90.0f);
+    printf("report: %lu evaluadas, %lu enviadas, %.1f%% suprimidas: ok\n",
+           (unsigned long)st.evaluated, (unsigned long)st.sent, report_suppression_pct(&st));
+    return 0;
+}
@@ -0,0 +1,322 @@
+/*
+ * Codificadores de telemetría contra un decodificador mínimo de CBOR y JSON.
+ *
+ * Cada muestra se codifica con todas las combinaciones de campos opcionales
+ * (ts, t, derivados, iaq, auto, phase_id) y valores que pasan por todos los
+ * anchos de cabecera CBOR (inmediato, 1, 2, 4 y 8 bytes). El decodificador
+ * exige el número exacto de pares del mapa, la forma más corta de cada
+ * cabecera y los float32 (0xFA) bit a bit. Al final, bytes y tiempo por
+ * muestra frente al snprintf("%.2f") anterior.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "fake_rtos.h"
+#include "telemetry_codec.c"
+
+enum { K_TS, K_T, K_TC, K_RH, K_P, K_G, K_DP, K_VPD, K_AH, K_Q, K_A, K_F, K_U, K_PH, K_COUNT };
+
+static const char *const s_cbor_keys[K_COUNT] = {
+    "ts", "t", "tc", "rh", "p", "g", "dp", "vpd", "ah", "q", "a", "f", "u", "ph",
+};
+static const char *const s_json_keys[K_COUNT] = {
+    "ts", "t", "temperature", "humidity", "pressure", "gas", "dew_point", "vpd", "abs_hum",
+    "iaq", "auto", "fan", "humid", "phase_id",
+};
+
+typedef struct {
+    bool has[K_COUNT];
+    double v[K_COUNT];
+    float f[K_COUNT];       // CBOR: el float32 tal cual
+    bool is_float[K_COUNT];
+    int decimals[K_COUNT];  // JSON
+    bool wrapped;           // JSON: {"ts":..,"values":{..}}
+} decoded_t;
+
+static uint32_t s_widths[5];    // Cabeceras CBOR vistas: inmediata, 1, 2, 4 y 8 bytes
+
+// ------------------------------------------------------------------ CBOR
+
+typedef struct {
+    const uint8_t *p;
+    const uint8_t *end;
+} rbuf_t;
+
+static uint8_t rd(rbuf_t *r) {
+    CHECK(r->p < r->end);
+    return *r->p++;
+}
+
+// Devuelve el tipo mayor; exige la forma más corta (RFC 8949, 4.2.1)
+static int cbor_read_head(rbuf_t *r, uint64_t *v) {
+    uint8_t b = rd(r);
+    int info = b & 31;
+    if (info < 24) {
+        *v = info;
+        s_widths[0]++;
+        return b >> 5;
+    }
+    CHECK(info <= 27);
+    uint64_t x = 0;
+    for (int i = 0; i < (1 << (info - 24)); i++) x = (x << 8) | rd(r);
+    CHECK(x >= (info == 24 ? 24 : 1ull << (8 << (info - 25))));
+    s_widths[info - 23]++;
+    *v = x;
+    return b >> 5;
+}
+
+static void cbor_decode_map(rbuf_t *r, decoded_t *d) {
+    uint64_t pairs;
+    CHECK(cbor_read_head(r, &pairs) == 5);
+    for (uint64_t i = 0; i < pairs; i++) {
+        uint64_t n;
+        CHECK(cbor_read_head(r, &n) == 3);
+        CHECK(n < 8 && (size_t)(r->end - r->p) >= n);
+        int k = 0;
+        while (k < K_COUNT && !(strlen(s_cbor_keys[k]) == n && memcmp(s_cbor_keys[k], r->p, n) == 0)) k++;
+        CHECK(k < K_COUNT && !d->has[k]);
+        r->p += n;
+        d->has[k] = true;
+
+        uint8_t b = *r->p;
+        if (b == 0xFA) {
+            r->p++;
+            uint32_t bits = 0;
+            for (int j = 0; j < 4; j++) bits = (bits << 8) | rd(r);
+            memcpy(&d->f[k], &bits, sizeof(bits));
+            d->v[k] = d->f[k];
+            d->is_float[k] = true;
+        } else if (b == 0xF4 || b == 0xF5) {
+            r->p++;
+            d->v[k] = (b == 0xF5);
+        } else {
+            uint64_t x;
+            CHECK(cbor_read_head(r, &x) == 0);
+            d->v[k] = (double)x;
+        }
+    }
+}
+
+static void cbor_decode(const uint8_t *buf, int len, decoded_t *d) {
+    memset(d, 0, sizeof(*d));
+    rbuf_t r = { buf, buf + len };
+    cbor_decode_map(&r, d);
+    CHECK(r.p == r.end);
+}
+
+// ------------------------------------------------------------------ JSON
+
+// Sin espacios: el codificador no los escribe
+static const char *json_object(const char *p, decoded_t *d, bool top) {
+    CHECK(*p++ == '{');
+    for (;;) {
+        CHECK(*p++ == '"');
+        const char *q = strchr(p, '"');
+        CHECK(q);
+        size_t n = q - p;
+        if (top && n == 6 && memcmp(p, "values", 6) == 0) {
+            CHECK(q[1] == ':' && d->has[K_TS] && !d->wrapped);
+            d->wrapped = true;
+            p = json_object(q + 2, d, false);
+        } else {
+            int k = 0;
+            while (k < K_COUNT && !(strlen(s_json_keys[k]) == n && memcmp(s_json_keys[k], p, n) == 0)) k++;
+            CHECK(k < K_COUNT && !d->has[k]);
+            // ts solo fuera; con ts, el resto solo dentro de values
+            CHECK(k == K_TS ? top : !(top && d->has[K_TS]));
+            CHECK(q[1] == ':');
+            p = q + 2;
+            char *end;
+            d->v[k] = strtod(p, &end);
+            CHECK(end > p && (*p == '-' || (*p >= '0' && *p <= '9')));
+            const char *dot = memchr(p, '.', end - p);
+            d->decimals[k] = dot ? (int)(end - dot - 1) : 0;
+            CHECK(!strpbrk(p, "eE") || strpbrk(p, "eE") >= end);
+            d->has[k] = true;
+            p = end;
+        }
+        if (*p == '}') return p + 1;
+        CHECK(*p++ == ',');
+    }
+}
+
+static void json_decode(const uint8_t *buf, int len, decoded_t *d) {
+    char text[TELEMETRY_MAX_LEN + 1];
+    CHECK(len <= TELEMETRY_MAX_LEN);
+    memcpy(text, buf, len);
+    text[len] = 0;
+    memset(d, 0, sizeof(*d));
+    const char *end = json_object(text, d, true);
+    CHECK(end == text + len);
+    CHECK(d->wrapped == d->has[K_TS]);
+}
+
+// ------------------------------------------------------------------ Comparación
+
+static void expect_present(const decoded_t *d, int k, bool present) {
+    if (d->has[k] != present) fake_fail("clave %s: %s", s_json_keys[k], present ? "falta" : "sobra");
+}
+
+static void check_decoded(const telemetry_sample_t *s, const decoded_t *d, bool cbor) {
+    expect_present(d, K_TS, s->ts_ms > 0);
+    expect_present(d, K_T, s->uptime_s != 0);
+    expect_present(d, K_DP, s->derived);
+    expect_present(d, K_VPD, s->derived);
+    expect_present(d, K_AH, s->derived);
+    expect_present(d, K_Q, s->iaq >= 0);
+    expect_present(d, K_A, s->auto_mode >= 0);
+    expect_present(d, K_PH, s->phase_id >= 0);
+    for (int k = K_TC; k <= K_G; k++) expect_present(d, k, true);
+    expect_present(d, K_F, true);
+    expect_present(d, K_U, true);
+
+    const float floats[K_COUNT] = {
+        [K_TC] = s->temperature, [K_RH] = s->humidity, [K_P] = s->pressure,
+        [K_DP] = s->dew_point, [K_VPD] = s->vpd, [K_AH] = s->abs_hum,
+    };
+    const bool is_float[K_COUNT] = { [K_TC] = 1, [K_RH] = 1, [K_P] = 1, [K_DP] = 1, [K_VPD] = 1, [K_AH] = 1 };
+    const double ints[K_COUNT] = {
+        [K_TS] = (double)s->ts_ms, [K_T] = s->uptime_s, [K_Q] = s->iaq, [K_A] = s->auto_mode,
+        [K_F] = s->fan, [K_U] = s->humid, [K_PH] = s->phase_id,
+    };
+    for (int k = 0; k < K_COUNT; k++) {
+        if (!d->has[k]) continue;
+        if (is_float[k]) {
+            if (cbor) {
+                CHECK(d->is_float[k] && memcmp(&d->f[k], &floats[k], sizeof(float)) == 0);
+            } else {
+                CHECK(d->decimals[k] == 2);
+                CHECK(fabs(d->v[k] - floats[k]) <= 0.005 + fabs(floats[k]) * 1e-6);
+            }
+        } else if (k == K_G) {
+            CHECK(!d->is_float[k] && d->decimals[k] == 0);
+            if (cbor) CHECK(d->v[k] == (s->gas > 0 ? (uint32_t)(s->gas + 0.5f) : 0));
+            else CHECK(fabs(d->v[k] - s->gas) <= 0.5);
+        } else {
+            CHECK(!d->is_float[k] && d->decimals[k] == 0);
+            CHECK(d->v[k] == ints[k]);
+        }
+    }
+}
+
+// Todos los anchos de cabecera entre ts, t, gas e iaq
+static const telemetry_sample_t s_base[] = {
+    { .ts_ms = 1760000000123LL, .uptime_s = 3600, .temperature = 22.5f, .humidity = 85.3f, .pressure = 1013.25f,
+      .gas = 52000.0f, .dew_point = 19.83f, .vpd = 0.40f, .abs_hum = 17.07f, .iaq = 45, .fan = 1, .humid = 0,
+      .auto_mode = 1, .phase_id = 2 },
+    { .ts_ms = 5, .uptime_s = 23, .temperature = -12.34f, .humidity = 100.0f, .pressure = 870.0f,
+      .gas = 0.0f, .dew_point = -12.34f, .vpd = 0.0f, .abs_hum = 2.05f, .iaq = 0, .fan = 0, .humid = 1,
+      .auto_mode = 0, .phase_id = 0 },
+    { .ts_ms = 65535, .uptime_s = 255, .temperature = 35.99f, .humidity = 5.01f, .pressure = 1100.0f,
+      .gas = 200.4f, .dew_point = -7.5f, .vpd = 5.61f, .abs_hum = 2.0f, .iaq = 500, .fan = 1, .humid = 1,
+      .auto_mode = 1, .phase_id = 1 },
+    { .ts_ms = 1LL << 40, .uptime_s = 70000, .temperature = 0.0f, .humidity = 50.0f, .pressure = 999.99f,
+      .gas = 300000.0f, .dew_point = -9.19f, .vpd = 0.31f, .abs_hum = 2.42f, .iaq = 24, .fan = 0, .humid = 0,
+      .auto_mode = 0, .phase_id = 3 },
+};
+
+static telemetry_sample_t with_fields(const telemetry_sample_t *b, unsigned mask) {
+    telemetry_sample_t s = *b;
+    if (!(mask & 1)) s.ts_ms = 0;
+    if (!(mask & 2)) s.uptime_s = 0;
+    s.derived = mask & 4;
+    if (!(mask & 8)) s.iaq = -1;
+    if (!(mask & 16)) s.auto_mode = -1;
+    if (!(mask & 32)) s.phase_id = -1;
+    return s;
+}
+
+static void round_trip(const telemetry_encoder_t *enc, const telemetry_sample_t *s) {
+    uint8_t buf[TELEMETRY_MAX_LEN];
+    int len = enc->encode(s, buf, sizeof(buf));
+    CHECK(len > 0);
+    decoded_t d;
+    bool cbor = (enc == &telemetry_cbor);
+    if (cbor) cbor_decode(buf, len, &d);
+    else json_decode(buf, len, &d);
+    check_decoded(s, &d, cbor);
+    // Sin sitio: -1 y nunca una muestra cortada
+    for (int cap = 0; cap < len; cap++) CHECK(enc->encode(s, buf, cap) == -1);
+    CHECK(enc->encode(s, buf, len) == len);
+}
+
+// Varias muestras con los delimitadores de streaming de cada formato
+static void stream(void) {
+    uint8_t buf[4 * TELEMETRY_MAX_LEN];
+    const telemetry_encoder_t *encs[] = { &telemetry_json, &telemetry_cbor };
+    for (int e = 0; e < 2; e++) {
+        const telemetry_encoder_t *enc = encs[e];
+        size_t off = 0;
+        memcpy(buf, enc->array_open, strlen(enc->array_open));
+        off += strlen(enc->array_open);
+        for (int i = 0; i < 3; i++) {
+            if (i) {
+                memcpy(buf + off, enc->array_sep, strlen(enc->array_sep));
+                off += strlen(enc->array_sep);
+            }
+            telemetry_sample_t s = with_fields(&s_base[i], 63);
+            int len = enc->encode(&s, buf + off, sizeof(buf) - off);
+            CHECK(len > 0);
+            off += len;
+        }
+        memcpy(buf + off, enc->array_close, strlen(enc->array_close));
+        off += strlen(enc->array_close);
+
+        decoded_t d;
+        if (enc == &telemetry_cbor) {
+            rbuf_t r = { buf, buf + off };
+            CHECK(rd(&r) == 0x9F);
+            for (int i = 0; i < 3; i++) {
+                memset(&d, 0, sizeof(d));
+                cbor_decode_map(&r, &d);
+                telemetry_sample_t s = with_fields(&s_base[i], 63);
+                check_decoded(&s, &d, true);
+            }
+            CHECK(rd(&r) == 0xFF && r.p == r.end);
+        } else {
+            buf[off] = 0;
+            const char *p = (const char *)buf;
+            CHECK(*p++ == '[');
+            for (int i = 0; i < 3; i++) {
+                if (i) CHECK(*p++ == ',');
+                memset(&d, 0, sizeof(d));
+                p = json_object(p, &d, true);
+                telemetry_sample_t s = with_fields(&s_base[i], 63);
+                check_decoded(&s, &d, false);
+            }
+            CHECK(*p++ == ']' && p == (const char *)buf + off);
+        }
+    }
+}
+
+int main(void) {
+    fake_rtos_reset();
+    CHECK(telemetry_encoder_find(NULL) == &telemetry_json);
+    CHECK(telemetry_encoder_find("json") == &telemetry_json);
+    CHECK(telemetry_encoder_find("cbor") == &telemetry_cbor);
+    CHECK(telemetry_encoder_find("xml") == NULL);
+
+    int combos = 0;
+    for (size_t b = 0; b < sizeof(s_base) / sizeof(s_base[0]); b++) {
+        for (unsigned mask = 0; mask < 64; mask++) {
+            telemetry_sample_t s = with_fields(&s_base[b], mask);
+            round_trip(&telemetry_json, &s);
+            round_trip(&telemetry_cbor, &s);
+            combos++;
+        }
+    }
+    for (int w = 0; w < 5; w++) CHECK(s_widths[w] > 0);
+    stream();
+
+    // Los mismos campos que enviaba el snprintf
+    telemetry_sample_t s = with_fields(&s_base[0], 16 | 32);
+    telemetry_bench_t bench;
+    telemetry_codec_benchmark(&s, 20000, &bench);
+    CHECK(bench.cbor_bytes < bench.json_bytes && bench.json_bytes <= bench.printf_bytes);
+    CHECK(bench.json_cycles < bench.printf_cycles);
+    printf("telemetry_codec: %d combinaciones; bytes/muestra printf %u, json %u, cbor %u; "
+           "ns/muestra printf %lu, json %lu, cbor %lu: ok\n",
+           combos, bench.printf_bytes, bench.json_bytes, bench.cbor_bytes,
+           (unsigned long)bench.printf_cycles, (unsigned long)bench.json_cycles, (unsigned long)bench.cbor_cycles);
+    return 0;
+}
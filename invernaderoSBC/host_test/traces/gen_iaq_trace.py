@@ -0,0 +1,43 @@
+#!/usr/bin/env python3
+"""Genera iaq_dia.csv: 24 h de gas/RH de un BME680, una fila por minuto.
+
+Escenario (horas desde el arranque):
+  0.0-0.1   calentador estabilizándose, la resistencia sube hacia su valor
+  1.5-2.5   riego: la humedad sube de 45 a 85 %RH y vuelve, aire limpio
+  3.0-3.5   episodio de COV: la resistencia compensada cae al 55 %
+  6.0-      deriva del sensor: el aire limpio lee un 10 % menos
+
+La resistencia en bruto sigue el mismo modelo que iaq.c (ln R baja 0.03 por
+%RH sobre 40 %RH) con un ruido de +-1 %. Sustituible por una captura real con
+las mismas columnas: t_s,gas_ohm,hum.
+
+    python3 gen_iaq_trace.py > iaq_dia.csv
+"""
+import math
+
+CLEAN = 150000.0
+HUM_COEF = 0.03
+HUM_REF = 40.0
+
+seed = 12345
+
+
+def noise():
+    global seed
+    seed = (seed * 1103515245 + 12345) & 0x7FFFFFFF
+    return (seed / 0x7FFFFFFF - 0.5) * 0.02
+
+
+print("t_s,gas_ohm,hum")
+for m in range(24 * 60 + 1):
+    h = m / 60.0
+    hum = 45.0
+    if 1.5 <= h <= 2.5:
+        hum = 45.0 + 40.0 * math.sin(math.pi * (h - 1.5))
+    comp = CLEAN * (0.9 if h >= 6.0 else 1.0)
+    if 3.0 <= h < 3.5:
+        comp *= 0.55
+    if h < 0.1:
+        comp *= 1.0 - 0.8 * math.exp(-h / 0.02)
+    raw = comp * math.exp(-HUM_COEF * (hum - HUM_REF)) * (1.0 + noise())
+    print(f"{m * 60},{raw:.0f},{hum:.1f}")
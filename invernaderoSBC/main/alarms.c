@@ -0,0 +1,228 @@
+#include <stdio.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_log.h"
+
+#include "alarms.h"
+#include "time_sync.h"
+
+#define TAG "ALARMS"
+
+#define ALARM_STALE_S   30  // Lecturas más viejas no cuentan para las reglas de T/H/IAQ
+
+static const alarm_rule_t s_rules[] = {
+    // name              text                         src                   op         ref                 actions                                  thr     hyst    on_s  off_s gap_s
+    { "temp_alta",       "Temperatura alta",          ALARM_SRC_TEMP,       ALARM_GT,  ALARM_REF_FASE_MAX, ALARM_ACT_NOTIFY,                        2.0f,   1.0f,   300,  120,  1800 },
+    { "temp_baja",       "Temperatura baja",          ALARM_SRC_TEMP,       ALARM_LT,  ALARM_REF_FASE_MIN, ALARM_ACT_NOTIFY,                        -2.0f,  1.0f,   300,  120,  1800 },
+    { "hum_baja",        "Humedad baja",              ALARM_SRC_HUM,        ALARM_LT,  ALARM_REF_FASE_MIN, ALARM_ACT_NOTIFY,                        -10.0f, 3.0f,   600,  120,  3600 },
+    { "iaq_alto",        "Aire viciado (IAQ)",        ALARM_SRC_IAQ,        ALARM_GT,  ALARM_REF_FASE_MAX, ALARM_ACT_MQTT | ALARM_ACT_FAN_ON,      100.0f, 60.0f,  600,  300,  3600 },
+    { "sensor",          "Sensor BME680 sin lecturas", ALARM_SRC_SENSOR_AGE, ALARM_GT,  ALARM_REF_ABS,      ALARM_ACT_NOTIFY,                        60.0f,  50.0f,  0,    0,    3600 },
+    { "humid_continuo",  "Humidificador sin parar",   ALARM_SRC_HUMID_ON,   ALARM_GT,  ALARM_REF_ABS,      ALARM_ACT_NOTIFY | ALARM_ACT_HUMID_OFF,  1800.0f, 1790.0f, 0,  600,  3600 },
+};
+
+#define RULE_COUNT ((int)(sizeof(s_rules) / sizeof(s_rules[0])))
+_Static_assert(RULE_COUNT <= 32, "alarm_stats_t.active es una máscara de 32 bits");
+_Static_assert(RULE_COUNT <= ALARM_MAX_EVENTS, "una transición por regla y evaluación");
+
+// Umbrales resueltos contra la fase
+typedef struct {
+    float on;
+    float off;
+} alarm_compiled_t;
+
+typedef struct {
+    int64_t since_us;       // Inicio de la transición pendiente, 0 = ninguna
+    int64_t last_notify_us; // 0 = nunca
+    bool active;
+    bool notified;          // Se avisó el disparo: también se avisa la vuelta a normal
+} alarm_state_t;
+
+static alarm_compiled_t s_comp[RULE_COUNT];
+static FaseCultivo s_comp_fase;
+static bool s_compiled = false;
+static alarm_state_t s_state[RULE_COUNT];
+static int64_t s_fan_since = 0;
+static int64_t s_humid_since = 0;
+
+static uint8_t s_overrides = 0;
+static alarm_stats_t s_stats;
+static portMUX_TYPE s_alarm_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static float band_value(const FaseCultivo *f, const alarm_rule_t *r) {
+    bool max = (r->ref == ALARM_REF_FASE_MAX);
+    switch (r->src) {
+    case ALARM_SRC_TEMP: return max ? f->temp_max : f->temp_min;
+    case ALARM_SRC_HUM:  return max ? f->hum_max : f->hum_min;
+    case ALARM_SRC_IAQ:  return max ? f->iaq_max : 0.0f;
+    default:             return 0.0f;
+    }
+}
+
+static void compile(const FaseCultivo *f) {
+    for (int i = 0; i < RULE_COUNT; i++) {
+        const alarm_rule_t *r = &s_rules[i];
+        float on = r->threshold + (r->ref == ALARM_REF_ABS ? 0.0f : band_value(f, r));
+        s_comp[i].on = on;
+        s_comp[i].off = (r->op == ALARM_GT) ? on - r->hysteresis : on + r->hysteresis;
+    }
+    s_comp_fase = *f;
+    s_compiled = true;
+}
+
+// false si la magnitud no tiene dato fiable ahora: la regla conserva su estado
+static bool source_value(const alarm_inputs_t *in, int64_t now_us, uint8_t src, float *v) {
+    bool fresh = in->sample_us && (now_us - in->sample_us) < (int64_t)ALARM_STALE_S * 1000000;
+    switch (src) {
+    case ALARM_SRC_TEMP:       *v = in->temp; return fresh;
+    case ALARM_SRC_HUM:        *v = in->hum; return fresh;
+    case ALARM_SRC_IAQ:        *v = in->iaq; return fresh && in->iaq >= 0;
+    case ALARM_SRC_DEW_MARGIN: *v = in->dew_margin; return fresh;
+    // Sin ninguna lectura desde el arranque cuenta el uptime
+    case ALARM_SRC_SENSOR_AGE: *v = (now_us - in->sample_us) / 1e6f; return true;
+    case ALARM_SRC_HUMID_ON:   *v = s_humid_since ? (now_us - s_humid_since) / 1e6f : 0.0f; return true;
+    case ALARM_SRC_FAN_ON:     *v = s_fan_since ? (now_us - s_fan_since) / 1e6f : 0.0f; return true;
+    default:                   return false;
+    }
+}
+
+int alarms_evaluate(const alarm_inputs_t *in, int64_t now_us, alarm_event_t *ev, int max_ev) {
+    if (!s_compiled || memcmp(&s_comp_fase, fase_actual, sizeof(FaseCultivo)) != 0) compile(fase_actual);
+
+    if (!in->humid) s_humid_since = 0;
+    else if (!s_humid_since) s_humid_since = now_us;
+    if (!in->fan) s_fan_since = 0;
+    else if (!s_fan_since) s_fan_since = now_us;
+
+    int n = 0;
+    uint32_t active = 0, raised = 0, notified = 0, suppressed = 0;
+    uint8_t overrides = 0;
+
+    for (int i = 0; i < RULE_COUNT; i++) {
+        const alarm_rule_t *r = &s_rules[i];
+        alarm_state_t *st = &s_state[i];
+        float v;
+
+        if (!source_value(in, now_us, r->src, &v)) {
+            st->since_us = 0;
+        } else {
+            float limit = st->active ? s_comp[i].off : s_comp[i].on;
+            bool cross = (r->op == ALARM_GT) ? (st->active ? v < limit : v > limit)
+                                             : (st->active ? v > limit : v < limit);
+            if (!cross) {
+                st->since_us = 0;
+            } else {
+                if (!st->since_us) st->since_us = now_us;
+                uint16_t hold_s = st->active ? r->off_s : r->on_s;
+                if (now_us - st->since_us >= (int64_t)hold_s * 1000000) {
+                    st->active = !st->active;
+                    st->since_us = 0;
+
+                    bool notify;
+                    if (st->active) {
+                        raised++;
+                        notify = !st->last_notify_us ||
+                                 (now_us - st->last_notify_us) >= (int64_t)r->min_gap_s * 1000000;
+                        if (!notify) suppressed++;
+                        st->notified = notify;
+                        ESP_LOGW(TAG, "Alarma %s: %.1f (límite %.1f)%s", r->name, v, s_comp[i].on,
+                                 notify ? "" : " [silenciada]");
+                    } else {
+                        notify = st->notified;
+                        st->notified = false;
+                        ESP_LOGI(TAG, "Alarma %s normalizada: %.1f", r->name, v);
+                    }
+
+                    if (notify && (r->actions & ALARM_ACT_NOTIFY)) {
+                        st->last_notify_us = now_us;
+                        notified++;
+                        if (n < max_ev) {
+                            ev[n++] = (alarm_event_t){
+                                .t_us = now_us, .value = v, .limit = s_comp[i].on,
+                                .rule = i, .raised = st->active, .actions = r->actions & ALARM_ACT_NOTIFY,
+                            };
+                        }
+                    }
+                }
+            }
+        }
+
+        if (st->active) {
+            active |= 1u << i;
+            overrides |= r->actions & (ALARM_ACT_FAN_ON | ALARM_ACT_HUMID_OFF);
+        }
+    }
+
+    portENTER_CRITICAL(&s_alarm_lock);
+    s_stats.active = active;
+    s_stats.raised += raised;
+    s_stats.notified += notified;
+    s_stats.suppressed += suppressed;
+    s_overrides = overrides;
+    portEXIT_CRITICAL(&s_alarm_lock);
+    return n;
+}
+
+uint8_t alarms_overrides(void) {
+    portENTER_CRITICAL(&s_alarm_lock);
+    uint8_t o = s_overrides;
+    portEXIT_CRITICAL(&s_alarm_lock);
+    return o;
+}
+
+int alarms_rule_count(void) {
+    return RULE_COUNT;
+}
+
+const alarm_rule_t *alarms_rule(int idx) {
+    return (idx >= 0 && idx < RULE_COUNT) ? &s_rules[idx] : NULL;
+}
+
+void alarms_get_stats(alarm_stats_t *out) {
+    portENTER_CRITICAL(&s_alarm_lock);
+    *out = s_stats;
+    portEXIT_CRITICAL(&s_alarm_lock);
+}
+
+int alarms_format_text(const alarm_event_t *ev, char *buf, size_t cap) {
+    const alarm_rule_t *r = alarms_rule(ev->rule);
+    if (!r) return -1;
+    if (ev->raised) return snprintf(buf, cap, "🚨 %s: %.1f (límite %.1f)", r->text, ev->value, ev->limit);
+    return snprintf(buf, cap, "✅ %s: normal (%.1f)", r->text, ev->value);
+}
+
+int alarms_format_json(const alarm_event_t *ev, char *buf, size_t cap) {
+    const alarm_rule_t *r = alarms_rule(ev->rule);
+    if (!r) return -1;
+    int64_t ts = time_epoch_ms(ev->t_us);
+    if (ts) {
+        return snprintf(buf, cap, "{\"ts\":%lld,\"values\":{\"alarm\":\"%s\",\"alarm_active\":%d,\"alarm_value\":%.2f}}",
+                        (long long)ts, r->name, ev->raised, ev->value);
+    }
+    return snprintf(buf, cap, "{\"alarm\":\"%s\",\"alarm_active\":%d,\"alarm_value\":%.2f}",
+                    r->name, ev->raised, ev->value);
+}
+
+int alarms_format_rules_json(char *buf, size_t cap) {
+    alarm_stats_t st;
+    alarms_get_stats(&st);
+
+    size_t off = 0;
+    int n = snprintf(buf, cap, "{\"raised\":%lu,\"notified\":%lu,\"suppressed\":%lu,\"rules\":[",
+                     (unsigned long)st.raised, (unsigned long)st.notified, (unsigned long)st.suppressed);
+    if (n < 0 || (size_t)n >= cap) return -1;
+    off = n;
+
+    for (int i = 0; i < RULE_COUNT; i++) {
+        const alarm_rule_t *r = &s_rules[i];
+        n = snprintf(buf + off, cap - off,
+            "%s{\"name\":\"%s\",\"active\":%s,\"on\":%.1f,\"off\":%.1f,\"on_s\":%u,\"off_s\":%u,\"min_gap_s\":%u,\"actions\":%u}",
+            i ? "," : "", r->name, (st.active & (1u << i)) ? "true" : "false",
+            s_comp[i].on, s_comp[i].off, r->on_s, r->off_s, r->min_gap_s, r->actions);
+        if (n < 0 || (size_t)n >= cap - off) return -1;
+        off += n;
+    }
+
+    n = snprintf(buf + off, cap - off, "]}");
+    if (n < 0 || (size_t)n >= cap - off) return -1;
+    return (int)(off + n);
+}
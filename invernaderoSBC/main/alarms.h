@@ -0,0 +1,112 @@
+#ifndef MAIN_ALARMS_H_
+#define MAIN_ALARMS_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "app_state.h"
+
+/*
+ * Motor de alarmas.
+ *
+ * Cada regla es una fila de una tabla fija: magnitud, comparación, umbral
+ * (absoluto o relativo a la banda de la fase), histéresis, tiempo que debe
+ * mantenerse la condición para disparar y para rearmar, acciones y un intervalo
+ * mínimo entre avisos. Los umbrales relativos se resuelven contra fase_actual
+ * solo cuando la banda cambia; la evaluación es un recorrido lineal sin
+ * reservas de memoria.
+ *
+ * Solo avisan las transiciones (disparo y vuelta a normal), nunca cada muestra.
+ * Un disparo dentro del intervalo mínimo de su regla se cuenta pero no se
+ * notifica, y su vuelta a normal tampoco. Las forzadas de actuadores se
+ * mantienen mientras la alarma está activa, también en modo manual.
+ */
+
+typedef enum {
+    ALARM_SRC_TEMP = 0,
+    ALARM_SRC_HUM,
+    ALARM_SRC_IAQ,
+    ALARM_SRC_DEW_MARGIN,   // T - punto de rocío
+    ALARM_SRC_SENSOR_AGE,   // Segundos sin lectura válida
+    ALARM_SRC_HUMID_ON,     // Segundos seguidos con el humidificador encendido
+    ALARM_SRC_FAN_ON,
+    ALARM_SRC_COUNT
+} alarm_src_t;
+
+typedef enum {
+    ALARM_REF_ABS = 0,      // threshold es el umbral
+    ALARM_REF_FASE_MIN,     // threshold se suma al mínimo de la fase (temp/hum)
+    ALARM_REF_FASE_MAX,
+} alarm_ref_t;
+
+typedef enum {
+    ALARM_GT = 0,
+    ALARM_LT,
+} alarm_op_t;
+
+// Acciones
+#define ALARM_ACT_TELEGRAM  0x01
+#define ALARM_ACT_MQTT      0x02
+#define ALARM_ACT_FAN_ON    0x04    // Forzar ventilador mientras esté activa
+#define ALARM_ACT_HUMID_OFF 0x08    // Forzar humidificador apagado
+#define ALARM_ACT_NOTIFY    (ALARM_ACT_TELEGRAM | ALARM_ACT_MQTT)
+
+typedef struct {
+    const char *name;       // Clave corta para MQTT/API
+    const char *text;       // Descripción para Telegram
+    uint8_t src;            // alarm_src_t
+    uint8_t op;             // alarm_op_t
+    uint8_t ref;            // alarm_ref_t
+    uint8_t actions;
+    float threshold;
+    float hysteresis;       // La vuelta a normal exige cruzar el umbral más esto
+    uint16_t on_s;          // Condición mantenida antes de disparar
+    uint16_t off_s;         // Normalidad mantenida antes de rearmar
+    uint16_t min_gap_s;     // Mínimo entre avisos de la misma regla
+} alarm_rule_t;
+
+#define ALARM_MAX_EVENTS 8  // Transiciones por evaluación como mucho (una por regla)
+
+typedef struct {
+    int64_t sample_us;      // Instante de la última lectura válida, 0 = nunca
+    float temp;
+    float hum;
+    float dew_margin;
+    int iaq;                // -1 = sin dato
+    bool fan;
+    bool humid;
+} alarm_inputs_t;
+
+typedef struct {
+    int64_t t_us;
+    float value;
+    float limit;
+    uint8_t rule;
+    bool raised;            // true disparo, false vuelta a normal
+    uint8_t actions;        // Acciones de notificación a ejecutar
+} alarm_event_t;
+
+typedef struct {
+    uint32_t active;        // Bit por regla
+    uint32_t raised;
+    uint32_t notified;
+    uint32_t suppressed;    // Disparos silenciados por el intervalo mínimo
+} alarm_stats_t;
+
+// Evalúa todas las reglas en now_us. Devuelve cuántos eventos a notificar deja en ev
+int alarms_evaluate(const alarm_inputs_t *in, int64_t now_us, alarm_event_t *ev, int max_ev);
+// Acciones de forzado (ALARM_ACT_FAN_ON/HUMID_OFF) de las alarmas activas
+uint8_t alarms_overrides(void);
+
+int alarms_rule_count(void);
+const alarm_rule_t *alarms_rule(int idx);
+void alarms_get_stats(alarm_stats_t *out);
+
+// Texto para Telegram y JSON para ThingsBoard (con ts si hay hora real)
+int alarms_format_text(const alarm_event_t *ev, char *buf, size_t cap);
+int alarms_format_json(const alarm_event_t *ev, char *buf, size_t cap);
+// Reglas con su estado; -1 si no cabe
+int alarms_format_rules_json(char *buf, size_t cap);
+
+#endif /* MAIN_ALARMS_H_ */
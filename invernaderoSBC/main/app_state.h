@@ -0,0 +1,31 @@
+#ifndef MAIN_APP_STATE_H_
+#define MAIN_APP_STATE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Estado compartido entre main.c y los módulos de red (web, MQTT, Telegram).
+
+#define PIN_VENTILADOR     26   
+#define PIN_HUMIDIFICADOR  27
+
+typedef struct {
+    char nombre[16];
+    float temp_min;
+    float temp_max;
+    float hum_min;
+    float hum_max;
+    float iaq_max;      // IAQ a partir del cual se renueva aire
+} FaseCultivo;
+
+extern FaseCultivo fase_germinacion;
+extern FaseCultivo fase_fructificacion;
+extern FaseCultivo *fase_actual;
+extern bool modo_automatico;
+extern bool mqtt_connected;
+
+void guardar_estado_nvs(void);
+// 0 germinación, 1 fructificación, 2 + n fase n de la receta en marcha
+int fase_id_actual(void);
+
+#endif /* MAIN_APP_STATE_H_ */
@@ -0,0 +1,73 @@
+#include "chart.h"
+
+static int16_t s_series[HISTORY_CAPACITY];     // Solo la usa la tarea de pantalla
+
+static inline int to_y(int32_t v, int32_t lo, int32_t span, int top, int h) {
+    return top + (h - 1) - (int)(((v - lo) * (h - 1) + span / 2) / span);
+}
+
+void chart_sparkline(SSD1306_t *dev, history_field_t field, int page, int pages,
+                     int16_t min_span, chart_result_t *res) {
+    chart_result_t r = { 0 };
+    // Geometría real del panel: en uno de 4 páginas lo que no cabe se recorta
+    int width = ssd1306_get_width(dev);
+    if (pages > ssd1306_get_pages(dev) - page) pages = ssd1306_get_pages(dev) - page;
+    if (page < 0 || pages <= 0 || width <= 0) {
+        if (res) *res = r;
+        return;
+    }
+    uint32_t seq;
+    int n = history_series(field, s_series, HISTORY_CAPACITY, &seq);
+    if (n == 0) {
+        if (res) *res = r;
+        return;
+    }
+
+    // Grupo absoluto de cada muestra; el más reciente ocupa la última columna
+    uint32_t per_col = (HISTORY_CAPACITY + width - 1) / width;
+    uint32_t first = seq - n;
+    uint32_t g_last = (seq - 1) / per_col;
+    int i0 = 0;
+    while ((first + i0) / per_col + width <= g_last) i0++;
+
+    int16_t lo = s_series[i0], hi = s_series[i0];
+    for (int i = i0 + 1; i < n; i++) {
+        if (s_series[i] < lo) lo = s_series[i];
+        if (s_series[i] > hi) hi = s_series[i];
+    }
+    if (hi - lo < min_span) {
+        int32_t mid = ((int32_t)lo + hi) / 2;
+        lo = (int16_t)(mid - min_span / 2);
+        hi = (int16_t)(lo + min_span);
+    }
+    int32_t span = (int32_t)hi - lo;
+    if (span <= 0) span = 1;
+
+    int top = page * 8, h = pages * 8;
+    int prev_y = -1;
+    int i = i0;
+    while (i < n) {
+        uint32_t g = (first + i) / per_col;
+        int col = width - 1 - (int)(g_last - g);
+        int16_t cmin = s_series[i], cmax = s_series[i];
+        for (i++; i < n && (first + i) / per_col == g; i++) {
+            if (s_series[i] < cmin) cmin = s_series[i];
+            if (s_series[i] > cmax) cmax = s_series[i];
+        }
+        int y0 = to_y(cmax, lo, span, top, h);
+        int y1 = to_y(cmin, lo, span, top, h);
+        // Unida a la columna anterior para que un salto no deje huecos
+        if (prev_y >= 0) {
+            if (prev_y < y0) y0 = prev_y;
+            if (prev_y > y1) y1 = prev_y;
+        }
+        ssd1306_buffer_vspan(dev, col, y0, y1, false);
+        prev_y = to_y(s_series[i - 1], lo, span, top, h);
+    }
+
+    r.lo = lo;
+    r.hi = hi;
+    r.last = s_series[n - 1];
+    r.n = n - i0;
+    if (res) *res = r;
+}
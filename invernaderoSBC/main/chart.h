@@ -0,0 +1,36 @@
+#ifndef MAIN_CHART_H_
+#define MAIN_CHART_H_
+
+#include <stdint.h>
+#include "ssd1306.h"
+#include "history.h"
+
+/*
+ * Gráficas de tendencia para la pantalla.
+ *
+ * Se dibuja directamente en el buffer del driver (_page[]._segs) columna a
+ * columna: cada columna es un tramo vertical entre el mínimo y el máximo de
+ * las muestras que agrupa, unido a la columna anterior, y se rellena con una
+ * máscara por página (ssd1306_buffer_vspan) en lugar de píxel a píxel.
+ *
+ * La serie sale del histórico en RAM. Las columnas se alinean al número de
+ * muestra absoluto: al llegar muestras nuevas la gráfica se desplaza columnas
+ * enteras hacia la izquierda en vez de reagrupar (y temblar) en cada muestra.
+ * Hay una columna por segmento del panel (ssd1306_get_width): cada una agrupa
+ * HISTORY_CAPACITY / ancho muestras, redondeando hacia arriba.
+ */
+
+typedef struct {
+    int16_t lo;     // Escala usada, en las unidades de la serie
+    int16_t hi;
+    int16_t last;   // Muestra más reciente
+    int n;          // Muestras dibujadas (0 = histórico vacío o fuera del panel)
+} chart_result_t;
+
+// Dibuja la serie en las páginas [page, page + pages), recortadas a las del
+// panel (res->n = 0 si no queda ninguna). min_span evita amplificar
+// el ruido cuando la magnitud apenas se mueve. No borra: el área debe estar limpia
+void chart_sparkline(SSD1306_t *dev, history_field_t field, int page, int pages,
+                     int16_t min_span, chart_result_t *res);
+
+#endif /* MAIN_CHART_H_ */
@@ -0,0 +1,217 @@
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "esp_log.h"
+
+#include "display.h"
+#include "trace.h"
+#include "chart.h"
+
+#define TAG "DISPLAY"
+
+#define DISPLAY_TASK_STACK  3072
+#define DISPLAY_TASK_PRIO   3   // Por debajo del bucle de control y de la red
+#define MARQUEE_INTERVAL    5   // Frames por paso de la marquesina (~20 px/s)
+
+static SSD1306_t *s_dev;
+static QueueHandle_t s_queue;
+static uint8_t s_front[SSD1306_MAX_PAGES * SSD1306_MAX_WIDTH];    // Lo que muestra el panel
+static bool s_scrolling = false;
+static uint8_t s_scroll_page, s_scroll_pages;
+static volatile bool s_resync = false;
+
+static const ssd1306_font_t *const s_fonts[] = {
+    [DISPLAY_FONT_SMALL] = &ssd1306_font_small,
+    [DISPLAY_FONT_MEDIUM] = &ssd1306_font_medium,
+    [DISPLAY_FONT_LARGE] = &ssd1306_font_large,
+};
+
+static void compose(const display_model_t *m) {
+    ssd1306_clear_buffer(s_dev, false);
+    for (int page = 0; page < DISPLAY_LINES; page++) {
+        size_t len = strnlen(m->line[page], DISPLAY_LINE_CHARS);
+        if (!len) continue;
+        if (m->font[page] == DISPLAY_FONT_FIXED || m->font[page] > DISPLAY_FONT_LARGE) {
+            ssd1306_buffer_text(s_dev, page, 0, m->line[page], len, false);
+        } else {
+            ssd1306_buffer_string_aligned(s_dev, s_fonts[m->font[page]], page,
+                                          (ssd1306_align_t)m->align[page], m->line[page], false);
+        }
+    }
+    for (int i = 0; i < DISPLAY_CHARTS; i++) {
+        const display_chart_t *c = &m->chart[i];
+        if (!c->pages) continue;
+        chart_result_t r;
+        chart_sparkline(s_dev, (history_field_t)c->field, c->page, c->pages, c->min_span, &r);
+        if (!r.n || c->page == 0) continue;
+        // Escala alineada a la derecha del panel, sea cual sea su ancho
+        int chars = ssd1306_get_width(s_dev) / 8;
+        char scale[DISPLAY_LINE_CHARS + 1];
+        int len = snprintf(scale, sizeof(scale), "%.*f/%.*f", c->decimals, (float)r.lo / c->scale,
+                           c->decimals, (float)r.hi / c->scale);
+        if (len > 0 && len <= chars && len <= DISPLAY_LINE_CHARS) {
+            ssd1306_buffer_text(s_dev, c->page - 1, (chars - len) * 8, scale, len, false);
+        }
+    }
+}
+
+static bool frame_changed(void) {
+    int width = ssd1306_get_width(s_dev);
+    for (int page = 0; page < ssd1306_get_pages(s_dev); page++) {
+        if (memcmp(&s_front[page * width], s_dev->_page[page]._segs, width) != 0) return true;
+    }
+    return false;
+}
+
+// front distinto del buffer en [page, page + pages): el próximo flush las reescribe enteras
+static void invalidate(int page, int pages) {
+    int width = ssd1306_get_width(s_dev);
+    for (; pages > 0; page++, pages--) {
+        for (int seg = 0; seg < width; seg++) s_front[page * width + seg] = ~s_dev->_page[page]._segs[seg];
+    }
+}
+
+static void scroll_stop(void) {
+    if (!s_scrolling) return;
+    ssd1306_scroll_cfg_t cfg = { .dir = SCROLL_STOP };
+    ssd1306_hardware_scroll_config(s_dev, &cfg);
+    // La banda quedó desplazada en la GDDRAM
+    invalidate(s_scroll_page, s_scroll_pages);
+    s_scrolling = false;
+}
+
+// El panel pudo reiniciarse con el bus: configuración de nuevo y GDDRAM desconocida
+static void resync(void) {
+    s_resync = false;
+    ssd1306_init(s_dev, s_dev->_width, s_dev->_height);
+    s_scrolling = false;
+    invalidate(0, ssd1306_get_pages(s_dev));
+    ESP_LOGW(TAG, "Panel reconfigurado");
+}
+
+static void scroll_start(uint8_t page, uint8_t pages) {
+    ssd1306_scroll_cfg_t cfg = {
+        .dir = SCROLL_LEFT, .start_page = page, .end_page = page + pages - 1, .interval = MARQUEE_INTERVAL,
+    };
+    // Sin motor de scroll (SH1106) la banda se queda quieta
+    s_scrolling = ssd1306_hardware_scroll_config(s_dev, &cfg);
+    s_scroll_page = page;
+    s_scroll_pages = pages;
+}
+
+static void display_task(void *arg) {
+    display_model_t m;
+    bool on = true;
+    while (1) {
+        if (xQueueReceive(s_queue, &m, portMAX_DELAY) != pdTRUE) continue;
+        if (s_resync) {
+            resync();
+            on = true;      // ssd1306_init deja el panel encendido
+        }
+
+        if (!m.on) {
+            // El panel conserva la GDDRAM apagado: front sigue siendo válido
+            scroll_stop();
+            if (on) ssd1306_display_power(s_dev, false);
+            on = false;
+            continue;
+        }
+
+        int64_t t_oled = trace_begin();
+        compose(&m);
+        bool marquee = m.marquee_pages > 0;
+        // Con el scroll activo no se puede tocar la GDDRAM
+        if (marquee && m.marquee_page + m.marquee_pages > ssd1306_get_pages(s_dev)) marquee = false;
+        if (s_scrolling && (!marquee || m.marquee_page != s_scroll_page ||
+                            m.marquee_pages != s_scroll_pages || frame_changed())) {
+            scroll_stop();
+        }
+        if (!s_scrolling) {
+            ssd1306_flush_diff(s_dev, s_front);
+            if (marquee) scroll_start(m.marquee_page, m.marquee_pages);
+        }
+        // Se enciende con el cuadro nuevo ya en el panel, sin mostrar el anterior
+        if (!on) ssd1306_display_power(s_dev, true);
+        on = true;
+        trace_end(TRACE_OLED, t_oled);
+    }
+}
+
+bool display_start(SSD1306_t *dev) {
+    if (s_queue) return true;
+    s_dev = dev;
+    // Estado real del panel tras ssd1306_init: el buffer interno tal cual
+    ssd1306_get_buffer(dev, s_front);
+    s_queue = xQueueCreate(1, sizeof(display_model_t));
+    if (!s_queue) return false;
+    if (xTaskCreate(display_task, "display_task", DISPLAY_TASK_STACK, NULL, DISPLAY_TASK_PRIO, NULL) != pdPASS) {
+        vQueueDelete(s_queue);
+        s_queue = NULL;
+        ESP_LOGE(TAG, "No se pudo crear la tarea de pantalla");
+        return false;
+    }
+    return true;
+}
+
+int display_pages(void) {
+    return s_dev ? ssd1306_get_pages(s_dev) : DISPLAY_LINES;
+}
+
+void display_resync(void) {
+    s_resync = true;
+}
+
+void display_submit(const display_model_t *m) {
+    if (s_queue) xQueueOverwrite(s_queue, m);
+}
+
+void display_model_init(display_model_t *m) {
+    memset(m, 0, sizeof(*m));
+    m->on = true;
+}
+
+void display_model_line(display_model_t *m, int page, const char *fmt, ...) {
+    if (page < 0 || page >= DISPLAY_LINES) return;
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(m->line[page], sizeof(m->line[page]), fmt, ap);
+    va_end(ap);
+}
+
+void display_model_style(display_model_t *m, int page, display_font_t font, ssd1306_align_t align) {
+    if (page < 0 || page >= DISPLAY_LINES) return;
+    m->font[page] = font;
+    m->align[page] = align;
+}
+
+void display_model_marquee(display_model_t *m, int page, int pages) {
+    if (page < 0 || pages <= 0 || page + pages > display_pages()) return;
+    m->marquee_page = page;
+    m->marquee_pages = pages;
+}
+
+void display_model_chart(display_model_t *m, int idx, history_field_t field, int page, int pages,
+                         int16_t min_span, int16_t scale, int decimals) {
+    if (idx < 0 || idx >= DISPLAY_CHARTS || page < 0 || pages <= 0 || page + pages > display_pages()) return;
+    m->chart[idx] = (display_chart_t){
+        .pages = pages, .page = page, .field = field, .decimals = decimals,
+        .min_span = min_span, .scale = scale > 0 ? scale : 1,
+    };
+}
+
+void display_message(const char *l0, const char *l2, const char *l4) {
+    display_model_t m;
+    display_model_init(&m);
+    if (l0) display_model_line(&m, 0, "%s", l0);
+    if (l2) display_model_line(&m, 2, "%s", l2);
+    if (l4) display_model_line(&m, 4, "%s", l4);
+    display_submit(&m);
+}
+
+void display_off(void) {
+    display_model_t m = { .on = false };
+    display_submit(&m);
+}
@@ -0,0 +1,88 @@
+#ifndef MAIN_DISPLAY_H_
+#define MAIN_DISPLAY_H_
+
+#include <stdbool.h>
+#include "ssd1306.h"
+#include "history.h"
+
+/*
+ * Servicio de pantalla.
+ *
+ * Una tarea propia es la única que habla con el SSD1306. Los demás le mandan
+ * un modelo de lo que hay que mostrar (texto por página) a una cola de un
+ * solo hueco que se sobrescribe: quien publica nunca espera y la tarea dibuja
+ * siempre el último estado. El modelo se compone en el buffer interno del
+ * driver (back) y solo se envían las columnas que difieren de lo que ya
+ * muestra el panel (front), sin borrar antes: no hay parpadeo.
+ *
+ * Las gráficas de tendencia (chart.h) las dibuja la propia tarea leyendo el
+ * histórico: el modelo solo dice qué magnitud y en qué páginas. La escala
+ * usada se escribe a la derecha de la página anterior a la gráfica.
+ *
+ * Marquesina: una banda de páginas la desplaza el propio controlador del panel
+ * (scroll continuo por hardware), sin CPU ni I2C mientras el cuadro no cambie.
+ * El SSD1306 no admite escribir la GDDRAM con el scroll activo: si cambia
+ * algo se para, se reescribe y se vuelve a arrancar. Pensada para pantallas
+ * estáticas (avisos, alarmas).
+ */
+
+#define DISPLAY_LINES       8
+#define DISPLAY_LINE_CHARS  16
+
+#define DISPLAY_CHARTS      2
+
+// Tipo de letra por línea. Las de atlas son proporcionales, admiten tildes y
+// ° (texto UTF-8) y ocupan 1, 2 o 3 páginas a partir de la de la línea
+typedef enum {
+    DISPLAY_FONT_FIXED = 0,     // 8x8 de siempre, 16 caracteres
+    DISPLAY_FONT_SMALL,
+    DISPLAY_FONT_MEDIUM,
+    DISPLAY_FONT_LARGE,
+} display_font_t;
+
+typedef struct {
+    uint8_t pages;      // 0 = sin gráfica
+    uint8_t page;       // Primera página
+    uint8_t field;      // history_field_t
+    uint8_t decimals;   // De la escala
+    int16_t min_span;   // Rango mínimo, en unidades de la serie
+    int16_t scale;      // Unidades de la serie por unidad mostrada (100 = centésimas)
+} display_chart_t;
+
+typedef struct {
+    bool on;
+    display_chart_t chart[DISPLAY_CHARTS];
+    uint8_t font[DISPLAY_LINES];    // display_font_t
+    uint8_t align[DISPLAY_LINES];   // ssd1306_align_t
+    uint8_t marquee_page;
+    uint8_t marquee_pages;          // 0 = sin marquesina
+    char line[DISPLAY_LINES][DISPLAY_LINE_CHARS + 1];
+} display_model_t;
+
+// Arranca la tarea; dev ya inicializado. A partir de aquí no se usa dev desde fuera
+bool display_start(SSD1306_t *dev);
+// Sin bloquear; se ignora si la pantalla no se ha arrancado
+void display_submit(const display_model_t *m);
+// Sin bloquear y desde cualquier tarea: con el próximo modelo se reconfigura el
+// panel y se reescribe entero (tras una recuperación del bus)
+void display_resync(void);
+// Páginas del panel arrancado (DISPLAY_LINES antes de display_start); los
+// modelos se maquetan con esto, no con DISPLAY_LINES
+int display_pages(void);
+
+// Modelo vacío y encendido
+void display_model_init(display_model_t *m);
+void display_model_line(display_model_t *m, int page, const char *fmt, ...) __attribute__((format(printf, 3, 4)));
+void display_model_style(display_model_t *m, int page, display_font_t font, ssd1306_align_t align);
+// Banda [page, page + pages) desplazada a la izquierda por el panel; se ignora
+// si no cabe en display_pages()
+void display_model_marquee(display_model_t *m, int page, int pages);
+// Gráfica de la magnitud en [page, page + pages); idx < DISPLAY_CHARTS. Se
+// ignora si no cabe en display_pages()
+void display_model_chart(display_model_t *m, int idx, history_field_t field, int page, int pages,
+                         int16_t min_span, int16_t scale, int decimals);
+// Atajos
+void display_message(const char *l0, const char *l2, const char *l4);
+void display_off(void);
+
+#endif /* MAIN_DISPLAY_H_ */
@@ -0,0 +1,78 @@
+#include <string.h>
+#include <math.h>
+
+#include "filter.h"
+
+void filter_init(filter_t *f, const filter_config_t *cfg) {
+    memset(f, 0, sizeof(*f));
+    f->cfg = cfg;
+}
+
+// Mediana por inserción sobre una copia: N <= 5, más barato que cualquier selección
+static float median(const float *w, uint8_t n) {
+    float s[FILTER_MEDIAN_MAX];
+    for (uint8_t i = 0; i < n; i++) {
+        float v = w[i];
+        int j = i - 1;
+        while (j >= 0 && s[j] > v) {
+            s[j + 1] = s[j];
+            j--;
+        }
+        s[j + 1] = v;
+    }
+    return s[n / 2];
+}
+
+float filter_update(filter_t *f, float raw, int64_t now_us, filter_status_t *status) {
+    const filter_config_t *c = f->cfg;
+    filter_status_t st = FILTER_OK;
+
+    if (!(raw >= c->min && raw <= c->max)) { // También descarta NaN
+        f->rejected++;
+        if (status) *status = FILTER_REJECTED;
+        return f->primed ? f->out : raw;
+    }
+
+    if (c->stuck_count) {
+        // En los topes del rango (p. ej. 100 %RH) un valor fijo es legítimo
+        bool at_limit = (raw <= c->min || raw >= c->max);
+        if (f->primed && !at_limit && fabsf(raw - f->last_raw) < c->stuck_eps) {
+            if (f->same_count < UINT16_MAX) f->same_count++;
+        } else {
+            f->same_count = 0;
+        }
+        if (f->same_count >= c->stuck_count) st = FILTER_STUCK;
+    }
+    f->last_raw = raw;
+
+    float v = raw;
+    uint8_t n = (c->median_n > FILTER_MEDIAN_MAX) ? FILTER_MEDIAN_MAX : c->median_n;
+    if (n > 1) {
+        // La primera lectura llena la ventana: con 2 muestras la mediana sería el máximo
+        if (f->win_len == 0) {
+            for (uint8_t i = 0; i < n; i++) f->window[i] = raw;
+            f->win_len = n;
+        }
+        f->window[f->win_pos] = raw;
+        f->win_pos = (f->win_pos + 1) % n;
+        v = median(f->window, f->win_len);
+    }
+
+    if (!f->primed) {
+        f->out = v;
+        f->last_us = now_us;
+        f->primed = true;
+    } else {
+        float next = f->out + c->ema_alpha * (v - f->out);
+        if (c->max_rate > 0.0f) {
+            float max_step = c->max_rate * (float)(now_us - f->last_us) / 1e6f;
+            if (next > f->out + max_step) next = f->out + max_step;
+            else if (next < f->out - max_step) next = f->out - max_step;
+        }
+        f->out = next;
+        f->last_us = now_us;
+    }
+
+    if (status) *status = st;
+    return f->out;
+}
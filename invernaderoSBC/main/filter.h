@@ -0,0 +1,50 @@
+#ifndef MAIN_FILTER_H_
+#define MAIN_FILTER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Cadena de filtrado por canal entre la lectura del BME680 y el control.
+ *
+ * Orden: rango válido -> detección de valor atascado -> mediana de N ->
+ * EMA -> límite de pendiente. Sin memoria dinámica; todo el estado vive en
+ * filter_t y la configuración (constante) se comparte por puntero.
+ */
+
+#define FILTER_MEDIAN_MAX 5
+
+typedef struct {
+    float min;              // Rango físico aceptado; fuera de él la lectura se descarta
+    float max;
+    uint8_t median_n;       // Ventana de mediana (impar, 1 = desactivada)
+    float ema_alpha;        // Peso de la muestra nueva (1 = sin suavizado)
+    float max_rate;         // Variación máxima por segundo (0 = sin límite)
+    float stuck_eps;        // Dos lecturas más cercanas que esto cuentan como iguales
+    uint16_t stuck_count;   // Lecturas iguales seguidas para declarar el sensor atascado (0 = off)
+} filter_config_t;
+
+typedef enum {
+    FILTER_OK = 0,
+    FILTER_REJECTED,        // Lectura fuera de rango: se devuelve la última salida
+    FILTER_STUCK,           // Valor congelado durante stuck_count lecturas
+} filter_status_t;
+
+typedef struct {
+    const filter_config_t *cfg;
+    float window[FILTER_MEDIAN_MAX];
+    float out;
+    float last_raw;
+    int64_t last_us;
+    uint16_t same_count;
+    uint16_t rejected;      // Lecturas descartadas desde el arranque
+    uint8_t win_len;
+    uint8_t win_pos;
+    bool primed;
+} filter_t;
+
+void filter_init(filter_t *f, const filter_config_t *cfg);
+// Procesa una lectura cruda tomada en now_us y devuelve el valor filtrado
+float filter_update(filter_t *f, float raw, int64_t now_us, filter_status_t *status);
+
+#endif /* MAIN_FILTER_H_ */
@@ -0,0 +1,96 @@
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_timer.h"
+
+#include "history.h"
+
+// Formato empaquetado en punto fijo: 16 bytes por muestra en lugar de 28
+typedef struct {
+    uint32_t t_ms;      // Adquisición, ms monotónicos módulo 2^32 (~49 días)
+    uint32_t gas;       // Ohm
+    int16_t temp_c100;  // 0.01 C
+    uint16_t hum_c100;  // 0.01 %
+    uint16_t press_d10; // 0.1 hPa
+    uint8_t flags;      // bit0 ventilador, bit1 humidificador
+    uint8_t _pad;
+} packed_sample_t;
+
+static packed_sample_t s_ring[HISTORY_CAPACITY];
+static int s_head = 0;   // siguiente posición a escribir
+static int s_count = 0;
+static uint32_t s_seq = 0;  // muestras añadidas desde el arranque
+static portMUX_TYPE s_hist_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static inline int32_t clamp_i32(float v, int32_t lo, int32_t hi) {
+    if (v < lo) return lo;
+    if (v > hi) return hi;
+    return (int32_t)(v + (v >= 0 ? 0.5f : -0.5f));
+}
+
+void history_push(const history_sample_t *sample) {
+    packed_sample_t p = {
+        .t_ms = (uint32_t)(sample->t_us / 1000),
+        .gas = (uint32_t)clamp_i32(sample->gas, 0, INT32_MAX),
+        .temp_c100 = (int16_t)clamp_i32(sample->temperature * 100.0f, INT16_MIN, INT16_MAX),
+        .hum_c100 = (uint16_t)clamp_i32(sample->humidity * 100.0f, 0, UINT16_MAX),
+        .press_d10 = (uint16_t)clamp_i32(sample->pressure * 10.0f, 0, UINT16_MAX),
+        .flags = (sample->fan ? 0x01 : 0) | (sample->humid ? 0x02 : 0),
+    };
+
+    portENTER_CRITICAL(&s_hist_lock);
+    s_ring[s_head] = p;
+    s_head = (s_head + 1) % HISTORY_CAPACITY;
+    if (s_count < HISTORY_CAPACITY) s_count++;
+    s_seq++;
+    portEXIT_CRITICAL(&s_hist_lock);
+}
+
+int history_count(void) {
+    return s_count;
+}
+
+bool history_get(int idx, history_sample_t *out) {
+    packed_sample_t p;
+    portENTER_CRITICAL(&s_hist_lock);
+    if (idx < 0 || idx >= s_count) {
+        portEXIT_CRITICAL(&s_hist_lock);
+        return false;
+    }
+    int pos = (s_head - s_count + idx + HISTORY_CAPACITY) % HISTORY_CAPACITY;
+    p = s_ring[pos];
+    portEXIT_CRITICAL(&s_hist_lock);
+
+    // El anillo cubre mucho menos que una vuelta del contador: la edad es inequívoca
+    int64_t now_ms = esp_timer_get_time() / 1000;
+    uint32_t age_ms = (uint32_t)now_ms - p.t_ms;
+    out->t_us = (now_ms - age_ms) * 1000;
+    out->gas = (float)p.gas;
+    out->temperature = p.temp_c100 / 100.0f;
+    out->humidity = p.hum_c100 / 100.0f;
+    out->pressure = p.press_d10 / 10.0f;
+    out->fan = p.flags & 0x01;
+    out->humid = (p.flags & 0x02) != 0;
+    return true;
+}
+
+bool history_latest(history_sample_t *out) {
+    return history_get(s_count - 1, out);
+}
+
+int history_series(history_field_t field, int16_t *out, int max, uint32_t *seq) {
+    portENTER_CRITICAL(&s_hist_lock);
+    int n = (max < s_count) ? max : s_count;
+    int pos = (s_head - n + HISTORY_CAPACITY) % HISTORY_CAPACITY;
+    for (int i = 0; i < n; i++) {
+        const packed_sample_t *p = &s_ring[pos];
+        switch (field) {
+        case HISTORY_TEMP:  out[i] = p->temp_c100; break;
+        case HISTORY_HUM:   out[i] = (int16_t)p->hum_c100; break;
+        default:            out[i] = (int16_t)p->press_d10; break;
+        }
+        if (++pos == HISTORY_CAPACITY) pos = 0;
+    }
+    if (seq) *seq = s_seq;
+    portEXIT_CRITICAL(&s_hist_lock);
+    return n;
+}
@@ -0,0 +1,37 @@
+#ifndef MAIN_HISTORY_H_
+#define MAIN_HISTORY_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Histórico circular en RAM de las últimas muestras (una por ciclo de telemetría).
+#define HISTORY_CAPACITY 360 // ~30 min a 5 s por muestra
+
+typedef struct {
+    int64_t t_us;       // Instante de adquisición (monotónico, ver time_sync.h)
+    float temperature;
+    float humidity;
+    float pressure;     // hPa
+    float gas;          // Ohm
+    bool fan;
+    bool humid;
+} history_sample_t;
+
+// Magnitudes que se pueden extraer como serie en punto fijo
+typedef enum {
+    HISTORY_TEMP,       // 0.01 C
+    HISTORY_HUM,        // 0.01 %
+    HISTORY_PRESS,      // 0.1 hPa
+} history_field_t;
+
+void history_push(const history_sample_t *sample);
+int history_count(void);
+// idx 0 es la muestra más antigua disponible
+bool history_get(int idx, history_sample_t *out);
+bool history_latest(history_sample_t *out);
+// Copia las últimas max muestras de una magnitud, de la más antigua a la más
+// reciente, sin pasar por float. seq (opcional) recibe el total de muestras
+// añadidas desde el arranque, para alinear agrupaciones entre llamadas.
+int history_series(history_field_t field, int16_t *out, int max, uint32_t *seq);
+
+#endif /* MAIN_HISTORY_H_ */
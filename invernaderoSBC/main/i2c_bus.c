@@ -0,0 +1,490 @@
+#include <stdio.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "driver/gpio.h"
+#include "rom/ets_sys.h"
+
+#include "i2c_bus.h"
+
+#define TAG "I2C_BUS"
+
+#define I2C_BUS_TASK_STACK      3072
+#define I2C_BUS_TASK_PRIO       6       // Por encima de quien pide: el bus no espera a la CPU
+#define I2C_BUS_QUEUE_LEN       16      // Un cuadro entero del OLED
+#define I2C_BUS_QUEUE_WAIT_MS   1000    // Cola llena tanto tiempo: el bus está colgado
+#define I2C_BUS_MERGE_MAX       (2 * I2C_BUS_MAX_WRITE)
+#define I2C_BUS_MERGE_REQS      8
+#define I2C_BUS_PROBE_MS        20      // Sondeo de cada dispositivo tras recuperar
+#define I2C_BUS_CLEAR_PULSES    9
+#define I2C_BUS_HALF_PERIOD_US  5       // 100 kHz
+
+typedef enum {
+    OP_XFER = 0,
+    OP_PROBE,
+    OP_RECOVER,
+} bus_op_t;
+
+struct i2c_bus_dev {
+    bool used;
+    const char *name;
+    uint16_t addr;
+    uint32_t scl_hz;
+    i2c_master_dev_handle_t handle;
+    i2c_bus_merge_t merge;
+    i2c_bus_recover_cb_t on_recover;
+    void *recover_arg;
+    i2c_bus_stats_t st;
+    uint64_t lat_sum_us;
+};
+
+typedef struct {
+    uint8_t op;             // bus_op_t
+    uint8_t wlen;
+    uint16_t rlen;
+    uint16_t addr;          // OP_PROBE
+    int timeout_ms;
+    uint32_t sync;          // Número de la llamada que espera; 0 = asíncrona
+    i2c_bus_dev_t *dev;
+    uint8_t *rbuf;
+    i2c_bus_done_cb_t cb;
+    void *arg;
+    int64_t t_req;
+    uint8_t wbuf[I2C_BUS_MAX_WRITE];
+} bus_req_t;
+
+// Lo que queda por avisar de cada petición fundida en una transacción
+typedef struct {
+    i2c_bus_done_cb_t cb;
+    void *arg;
+    int64_t t_req;
+} bus_done_t;
+
+static i2c_master_bus_config_t s_conf;
+static i2c_master_bus_handle_t s_bus;
+static QueueHandle_t s_queue[I2C_BUS_PRIO_COUNT];
+static SemaphoreHandle_t s_pending;     // Una cuenta por petición en cualquier cola
+static SemaphoreHandle_t s_sync_lock;   // Las llamadas que esperan van de una en una
+static SemaphoreHandle_t s_sync_done;
+static i2c_bus_dev_t s_devs[I2C_BUS_MAX_DEVICES];
+static i2c_bus_health_t s_health;
+static portMUX_TYPE s_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// Llamada síncrona en espera y su resultado. Una petición que llega tarde
+// (quien la pidió ya se rindió) lee en s_scratch y no avisa
+static uint32_t s_sync_seq;
+static uint32_t s_sync_waiting;
+static uint32_t s_sync_done_seq;
+static esp_err_t s_sync_err;
+static uint8_t s_sync_rbuf[I2C_BUS_MAX_READ];
+static uint8_t s_scratch[I2C_BUS_MAX_READ];
+
+// Solo los usa la tarea del bus
+static bus_req_t s_req, s_next;
+static uint8_t s_merge[I2C_BUS_MERGE_MAX];
+static int64_t s_last_recover_us;
+
+static bool urgent_waiting(int prio) {
+    for (int p = 0; p < prio; p++) {
+        if (uxQueueMessagesWaiting(s_queue[p])) return true;
+    }
+    return false;
+}
+
+static bool lines_high(void) {
+    return gpio_get_level(s_conf.sda_io_num) && gpio_get_level(s_conf.scl_io_num);
+}
+
+// Un esclavo cortado a mitad de byte retiene SDA hasta que recibe los
+// pulsos que le faltan: hasta 9, parando en cuanto la suelta, y un STOP.
+// Las líneas pasan a GPIO open-drain; i2c_master_bus_reset o el bus nuevo
+// las devuelven al periférico
+static void clear_bus(void) {
+    int sda = s_conf.sda_io_num, scl = s_conf.scl_io_num;
+    gpio_set_direction(scl, GPIO_MODE_INPUT_OUTPUT_OD);
+    gpio_set_direction(sda, GPIO_MODE_INPUT_OUTPUT_OD);
+    gpio_set_level(scl, 0);
+    gpio_set_level(sda, 1);
+    ets_delay_us(I2C_BUS_HALF_PERIOD_US);
+    for (int i = 0; i < I2C_BUS_CLEAR_PULSES && !gpio_get_level(sda); i++) {
+        gpio_set_level(scl, 1);
+        ets_delay_us(I2C_BUS_HALF_PERIOD_US);
+        gpio_set_level(scl, 0);
+        ets_delay_us(I2C_BUS_HALF_PERIOD_US);
+    }
+    // STOP: SDA sube con SCL arriba
+    gpio_set_level(sda, 0);
+    ets_delay_us(I2C_BUS_HALF_PERIOD_US);
+    gpio_set_level(scl, 1);
+    ets_delay_us(I2C_BUS_HALF_PERIOD_US);
+    gpio_set_level(sda, 1);
+    ets_delay_us(I2C_BUS_HALF_PERIOD_US);
+}
+
+static esp_err_t add_handle(i2c_bus_dev_t *dev) {
+    i2c_device_config_t cfg = {
+        .dev_addr_length = I2C_ADDR_BIT_LEN_7, .device_address = dev->addr, .scl_speed_hz = dev->scl_hz,
+    };
+    esp_err_t err = i2c_master_bus_add_device(s_bus, &cfg, &dev->handle);
+    if (err != ESP_OK) dev->handle = NULL;
+    return err;
+}
+
+// Último recurso: bus nuevo con la misma configuración y los mismos dispositivos
+static esp_err_t rebuild(void) {
+    for (int i = 0; i < I2C_BUS_MAX_DEVICES; i++) {
+        if (s_devs[i].used && s_devs[i].handle) i2c_master_bus_rm_device(s_devs[i].handle);
+        s_devs[i].handle = NULL;
+    }
+    if (s_bus) i2c_del_master_bus(s_bus);
+    s_bus = NULL;
+    esp_err_t err = i2c_new_master_bus(&s_conf, &s_bus);
+    if (err != ESP_OK) {
+        s_bus = NULL;
+        return err;
+    }
+    for (int i = 0; i < I2C_BUS_MAX_DEVICES; i++) {
+        if (s_devs[i].used && add_handle(&s_devs[i]) != ESP_OK) err = ESP_FAIL;
+    }
+    return err;
+}
+
+static esp_err_t recover(void) {
+    s_last_recover_us = esp_timer_get_time();
+    clear_bus();
+    esp_err_t err = s_bus ? i2c_master_bus_reset(s_bus) : ESP_ERR_INVALID_STATE;
+    bool rebuilt = false;
+    if (err != ESP_OK || !lines_high()) {
+        err = rebuild();
+        rebuilt = true;
+    }
+    bool ok = err == ESP_OK && lines_high();
+
+    portENTER_CRITICAL(&s_stats_lock);
+    s_health.recoveries++;
+    if (rebuilt) s_health.rebuilds++;
+    if (!ok) s_health.failed++;
+    portEXIT_CRITICAL(&s_stats_lock);
+
+    // Quien haya perdido la configuración (reinicio por el glitch) la repone
+    for (int i = 0; ok && i < I2C_BUS_MAX_DEVICES; i++) {
+        i2c_bus_dev_t *dev = &s_devs[i];
+        if (!dev->used || i2c_master_probe(s_bus, dev->addr, I2C_BUS_PROBE_MS) != ESP_OK) continue;
+        portENTER_CRITICAL(&s_stats_lock);
+        dev->st.reattached++;
+        portEXIT_CRITICAL(&s_stats_lock);
+        if (dev->on_recover) dev->on_recover(dev->recover_arg);
+    }
+    ESP_LOGW(TAG, "Bus recuperado%s: %s", rebuilt ? " (rehecho)" : "", ok ? "ok" : "líneas abajo");
+    return ok ? ESP_OK : ESP_FAIL;
+}
+
+static void auto_recover(void) {
+    if (esp_timer_get_time() - s_last_recover_us < (int64_t)I2C_BUS_RECOVER_MIN_MS * 1000) return;
+    recover();
+}
+
+// Funde en s_merge las escrituras siguientes al mismo dispositivo de la misma
+// cola, mientras no llegue nada más urgente. Devuelve la longitud total
+static size_t merge_writes(const bus_req_t *r, int prio, bus_done_t *done, int *n) {
+    i2c_bus_dev_t *dev = r->dev;
+    size_t len = r->wlen;
+    memcpy(s_merge, r->wbuf, len);
+    while (*n < I2C_BUS_MERGE_REQS && !urgent_waiting(prio) &&
+           xQueuePeek(s_queue[prio], &s_next, 0) == pdTRUE &&
+           s_next.op == OP_XFER && s_next.dev == dev && !s_next.rlen && !s_next.sync &&
+           dev->merge(s_merge, &len, sizeof(s_merge), s_next.wbuf, s_next.wlen)) {
+        xQueueReceive(s_queue[prio], &s_next, 0);
+        xSemaphoreTake(s_pending, 0);
+        done[(*n)++] = (bus_done_t){ s_next.cb, s_next.arg, s_next.t_req };
+    }
+    return len;
+}
+
+static void finish_sync(uint32_t seq, esp_err_t err) {
+    bool mine;
+    portENTER_CRITICAL(&s_stats_lock);
+    mine = (seq == s_sync_waiting);
+    if (mine) {
+        s_sync_err = err;
+        s_sync_done_seq = seq;
+    }
+    portEXIT_CRITICAL(&s_stats_lock);
+    if (mine) xSemaphoreGive(s_sync_done);
+}
+
+static void run(const bus_req_t *r, int prio) {
+    bus_done_t done[I2C_BUS_MERGE_REQS];
+    int n = 0;
+    done[n++] = (bus_done_t){ r->cb, r->arg, r->t_req };
+
+    esp_err_t err;
+    i2c_bus_dev_t *dev = r->dev;
+    size_t wlen = r->wlen;
+    uint8_t *rbuf = r->rbuf;
+    if (r->sync) rbuf = (r->sync == s_sync_waiting) ? s_sync_rbuf : s_scratch;
+
+    if (r->op == OP_RECOVER) {
+        err = recover();
+    } else if (!s_bus) {
+        err = ESP_ERR_INVALID_STATE;    // Falló el último intento de rehacerlo
+    } else if (r->op == OP_PROBE) {
+        err = i2c_master_probe(s_bus, r->addr, r->timeout_ms);
+    } else if (!dev->handle) {
+        err = ESP_ERR_INVALID_STATE;    // Quedó sin handle en un bus rehecho a medias
+    } else if (r->rlen) {
+        err = wlen ? i2c_master_transmit_receive(dev->handle, r->wbuf, wlen, rbuf, r->rlen, r->timeout_ms)
+                   : i2c_master_receive(dev->handle, rbuf, r->rlen, r->timeout_ms);
+    } else if (dev->merge) {
+        wlen = merge_writes(r, prio, done, &n);
+        err = i2c_master_transmit(dev->handle, s_merge, wlen, r->timeout_ms);
+    } else {
+        err = i2c_master_transmit(dev->handle, r->wbuf, wlen, r->timeout_ms);
+    }
+
+    int64_t now = esp_timer_get_time();
+    if (r->op == OP_XFER) {
+        portENTER_CRITICAL(&s_stats_lock);
+        i2c_bus_stats_t *st = &dev->st;
+        st->xfers++;
+        st->merged += n - 1;
+        st->bytes += wlen + r->rlen;
+        if (err != ESP_OK) {
+            st->errors++;
+            st->last_err = err;
+        }
+        if (err == ESP_ERR_TIMEOUT) s_health.timeouts++;
+        for (int i = 0; i < n; i++) {
+            uint32_t lat = (uint32_t)(now - done[i].t_req);
+            dev->lat_sum_us += lat;
+            if (lat > st->lat_max_us) st->lat_max_us = lat;
+        }
+        portEXIT_CRITICAL(&s_stats_lock);
+    }
+    if (r->sync) finish_sync(r->sync, err);
+    for (int i = 0; i < n; i++) {
+        if (done[i].cb) done[i].cb(err, done[i].arg);
+    }
+    // Un NACK con las líneas arriba es un dispositivo ausente, no un bus colgado
+    if (r->op != OP_RECOVER && (err == ESP_ERR_TIMEOUT || (err != ESP_OK && !lines_high()))) auto_recover();
+}
+
+// Una vuelta de la tarea: la petición más urgente o, si no llega ninguna, la vigilancia
+static void bus_poll(void) {
+    if (xSemaphoreTake(s_pending, pdMS_TO_TICKS(I2C_BUS_WATCHDOG_MS)) != pdTRUE) {
+        // Ocioso: nadie debería tener SDA abajo
+        if (!gpio_get_level(s_conf.sda_io_num)) {
+            portENTER_CRITICAL(&s_stats_lock);
+            s_health.stuck_sda++;
+            portEXIT_CRITICAL(&s_stats_lock);
+            ESP_LOGW(TAG, "SDA retenida con el bus ocioso");
+            auto_recover();
+        }
+        return;
+    }
+    for (int p = 0; p < I2C_BUS_PRIO_COUNT; p++) {
+        if (xQueueReceive(s_queue[p], &s_req, 0) == pdTRUE) {
+            run(&s_req, p);
+            return;
+        }
+    }
+}
+
+static void bus_task(void *arg) {
+    while (1) bus_poll();
+}
+
+bool i2c_bus_init(i2c_port_num_t port, int sda, int scl) {
+    if (s_bus) return true;
+    s_conf = (i2c_master_bus_config_t){
+        .clk_source = I2C_CLK_SRC_DEFAULT, .i2c_port = port,
+        .scl_io_num = scl, .sda_io_num = sda,
+        .glitch_ignore_cnt = 7, .flags.enable_internal_pullup = true,
+    };
+    if (i2c_new_master_bus(&s_conf, &s_bus) != ESP_OK) {
+        ESP_LOGE(TAG, "No se pudo crear el bus I2C");
+        s_bus = NULL;
+        return false;
+    }
+    for (int p = 0; p < I2C_BUS_PRIO_COUNT; p++) {
+        s_queue[p] = xQueueCreate(I2C_BUS_QUEUE_LEN, sizeof(bus_req_t));
+        if (!s_queue[p]) return false;
+    }
+    s_pending = xSemaphoreCreateCounting(I2C_BUS_PRIO_COUNT * I2C_BUS_QUEUE_LEN, 0);
+    s_sync_lock = xSemaphoreCreateMutex();
+    s_sync_done = xSemaphoreCreateBinary();
+    if (!s_pending || !s_sync_lock || !s_sync_done) return false;
+    if (xTaskCreate(bus_task, "i2c_bus", I2C_BUS_TASK_STACK, NULL, I2C_BUS_TASK_PRIO, NULL) != pdPASS) {
+        ESP_LOGE(TAG, "No se pudo crear la tarea del bus");
+        return false;
+    }
+    return true;
+}
+
+i2c_bus_dev_t *i2c_bus_add_device(const char *name, uint16_t addr, uint32_t scl_hz, i2c_bus_merge_t merge) {
+    for (int i = 0; i < I2C_BUS_MAX_DEVICES; i++) {
+        i2c_bus_dev_t *dev = &s_devs[i];
+        if (dev->used) continue;
+        dev->addr = addr;
+        dev->scl_hz = scl_hz;
+        if (!s_bus || add_handle(dev) != ESP_OK) return NULL;
+        portENTER_CRITICAL(&s_stats_lock);
+        memset(&dev->st, 0, sizeof(dev->st));
+        dev->lat_sum_us = 0;
+        portEXIT_CRITICAL(&s_stats_lock);
+        dev->name = name;
+        dev->merge = merge;
+        dev->on_recover = NULL;
+        dev->recover_arg = NULL;
+        dev->used = true;
+        return dev;
+    }
+    ESP_LOGE(TAG, "Sin hueco para 0x%02x", addr);
+    return NULL;
+}
+
+void i2c_bus_rm_device(i2c_bus_dev_t *dev) {
+    if (!dev || !dev->used) return;
+    if (dev->handle) i2c_master_bus_rm_device(dev->handle);
+    dev->handle = NULL;
+    dev->used = false;
+}
+
+void i2c_bus_on_recover(i2c_bus_dev_t *dev, i2c_bus_recover_cb_t cb, void *arg) {
+    if (!dev) return;
+    dev->recover_arg = arg;
+    dev->on_recover = cb;
+}
+
+static esp_err_t enqueue(const bus_req_t *r, i2c_bus_prio_t prio) {
+    if (!s_pending || prio >= I2C_BUS_PRIO_COUNT) return ESP_ERR_INVALID_STATE;
+    if (xQueueSend(s_queue[prio], r, pdMS_TO_TICKS(I2C_BUS_QUEUE_WAIT_MS)) != pdTRUE) return ESP_ERR_TIMEOUT;
+    xSemaphoreGive(s_pending);
+    return ESP_OK;
+}
+
+// Espera acotada. Si vence, la petición sigue en cola pero ya no puede
+// escribir en rbuf ni despertar a la siguiente llamada
+static esp_err_t run_sync(bus_req_t *r, i2c_bus_prio_t prio, uint8_t *rbuf) {
+    TickType_t wait = pdMS_TO_TICKS(r->timeout_ms + I2C_BUS_SYNC_SLACK_MS);
+    if (!s_sync_lock || xSemaphoreTake(s_sync_lock, wait) != pdTRUE) return ESP_ERR_TIMEOUT;
+
+    portENTER_CRITICAL(&s_stats_lock);
+    if (++s_sync_seq == 0) s_sync_seq = 1;
+    r->sync = s_sync_seq;
+    s_sync_waiting = s_sync_seq;
+    portEXIT_CRITICAL(&s_stats_lock);
+
+    esp_err_t err = enqueue(r, prio);
+    if (err == ESP_OK) {
+        TickType_t start = xTaskGetTickCount(), elapsed = 0;
+        err = ESP_ERR_TIMEOUT;
+        // Un aviso atrasado de una llamada anterior no cuenta
+        while (elapsed <= wait && xSemaphoreTake(s_sync_done, wait - elapsed) == pdTRUE) {
+            if (s_sync_done_seq == r->sync) {
+                err = s_sync_err;
+                break;
+            }
+            elapsed = xTaskGetTickCount() - start;
+        }
+    }
+    portENTER_CRITICAL(&s_stats_lock);
+    s_sync_waiting = 0;
+    portEXIT_CRITICAL(&s_stats_lock);
+    if (err == ESP_OK && r->rlen) memcpy(rbuf, s_sync_rbuf, r->rlen);
+    xSemaphoreGive(s_sync_lock);
+    return err;
+}
+
+static esp_err_t fill(bus_req_t *r, i2c_bus_dev_t *dev, const uint8_t *wbuf, size_t wlen,
+                      uint8_t *rbuf, size_t rlen, int timeout_ms) {
+    if (!dev || !dev->used || wlen > I2C_BUS_MAX_WRITE || rlen > UINT16_MAX || (!wlen && !rlen)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    r->op = OP_XFER;
+    r->dev = dev;
+    r->wlen = wlen;
+    r->rlen = rlen;
+    r->rbuf = rbuf;
+    r->timeout_ms = timeout_ms;
+    r->sync = 0;
+    r->cb = NULL;
+    r->arg = NULL;
+    r->t_req = esp_timer_get_time();
+    if (wlen) memcpy(r->wbuf, wbuf, wlen);
+    return ESP_OK;
+}
+
+esp_err_t i2c_bus_submit(i2c_bus_dev_t *dev, i2c_bus_prio_t prio, const uint8_t *wbuf, size_t wlen,
+                         uint8_t *rbuf, size_t rlen, i2c_bus_done_cb_t cb, void *arg) {
+    bus_req_t r;
+    esp_err_t err = fill(&r, dev, wbuf, wlen, rbuf, rlen, I2C_BUS_TIMEOUT_MS);
+    if (err != ESP_OK) return err;
+    r.cb = cb;
+    r.arg = arg;
+    return enqueue(&r, prio);
+}
+
+esp_err_t i2c_bus_transfer(i2c_bus_dev_t *dev, i2c_bus_prio_t prio, const uint8_t *wbuf, size_t wlen,
+                           uint8_t *rbuf, size_t rlen, int timeout_ms) {
+    if (rlen > I2C_BUS_MAX_READ) return ESP_ERR_INVALID_SIZE;
+    bus_req_t r;
+    esp_err_t err = fill(&r, dev, wbuf, wlen, NULL, rlen, timeout_ms);
+    if (err != ESP_OK) return err;
+    return run_sync(&r, prio, rbuf);
+}
+
+esp_err_t i2c_bus_probe(uint16_t addr, int timeout_ms) {
+    bus_req_t r = { .op = OP_PROBE, .addr = addr, .timeout_ms = timeout_ms, .t_req = esp_timer_get_time() };
+    return run_sync(&r, I2C_BUS_PRIO_HIGH, NULL);
+}
+
+esp_err_t i2c_bus_recover(void) {
+    // Rehacer el bus sondea todos los dispositivos: cabe en el margen
+    bus_req_t r = { .op = OP_RECOVER, .timeout_ms = I2C_BUS_TIMEOUT_MS, .t_req = esp_timer_get_time() };
+    return run_sync(&r, I2C_BUS_PRIO_HIGH, NULL);
+}
+
+void i2c_bus_get_stats(const i2c_bus_dev_t *dev, i2c_bus_stats_t *out) {
+    portENTER_CRITICAL(&s_stats_lock);
+    *out = dev->st;
+    uint32_t reqs = dev->st.xfers + dev->st.merged;
+    out->lat_avg_us = reqs ? (uint32_t)(dev->lat_sum_us / reqs) : 0;
+    portEXIT_CRITICAL(&s_stats_lock);
+}
+
+void i2c_bus_get_health(i2c_bus_health_t *out) {
+    portENTER_CRITICAL(&s_stats_lock);
+    *out = s_health;
+    portEXIT_CRITICAL(&s_stats_lock);
+}
+
+int i2c_bus_format_json(char *buf, size_t cap) {
+    i2c_bus_health_t h;
+    i2c_bus_get_health(&h);
+    int len = snprintf(buf, cap, "{\"bus\":{\"recoveries\":%lu,\"rebuilds\":%lu,\"failed\":%lu,\"stuck_sda\":%lu,\"timeouts\":%lu}",
+                       (unsigned long)h.recoveries, (unsigned long)h.rebuilds, (unsigned long)h.failed,
+                       (unsigned long)h.stuck_sda, (unsigned long)h.timeouts);
+    if (len < 0 || len >= (int)cap) return -1;
+    for (int i = 0; i < I2C_BUS_MAX_DEVICES; i++) {
+        if (!s_devs[i].used) continue;
+        i2c_bus_stats_t st;
+        i2c_bus_get_stats(&s_devs[i], &st);
+        int n = snprintf(buf + len, cap - len,
+                         ",\"%s\":{\"xfers\":%lu,\"merged\":%lu,\"errors\":%lu,\"reattached\":%lu,"
+                         "\"lat_avg_us\":%lu,\"lat_max_us\":%lu}",
+                         s_devs[i].name, (unsigned long)st.xfers, (unsigned long)st.merged,
+                         (unsigned long)st.errors, (unsigned long)st.reattached,
+                         (unsigned long)st.lat_avg_us, (unsigned long)st.lat_max_us);
+        if (n < 0 || n >= (int)(cap - len)) return -1;
+        len += n;
+    }
+    if (len + 2 > (int)cap) return -1;
+    buf[len++] = '}';
+    buf[len] = '\0';
+    return len;
+}
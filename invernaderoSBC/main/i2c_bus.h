@@ -0,0 +1,108 @@
+#ifndef MAIN_I2C_BUS_H_
+#define MAIN_I2C_BUS_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "driver/i2c_master.h"
+
+/*
+ * Gestor del bus I2C compartido (BME680 y OLED).
+ *
+ * Es el dueño del i2c_master_bus_handle_t: una tarea propia ejecuta todas las
+ * transacciones, sondeos y reinicios del bus. Cada petición va a la cola de
+ * su prioridad y la tarea vacía siempre antes la más urgente, así una medida
+ * del sensor espera como mucho a que acabe la transferencia de pantalla en
+ * curso, no el cuadro entero.
+ *
+ * Lo que se escribe se copia en la petición (hasta I2C_BUS_MAX_WRITE bytes):
+ * al volver, quien pide puede reutilizar su buffer. i2c_bus_submit no espera
+ * y avisa con un callback desde la tarea del bus; i2c_bus_transfer espera el
+ * resultado. Escrituras seguidas al mismo dispositivo y con la misma
+ * prioridad se funden en una sola transacción si el dispositivo da una
+ * función de fusión (el OLED encadena comandos y datos con el bit Co).
+ *
+ * Por dispositivo se cuentan transacciones, errores, bytes, fusiones y la
+ * latencia desde la petición hasta el final de la transferencia.
+ *
+ * Todo está acotado en tiempo: cada transacción lleva su timeout y las
+ * llamadas que esperan se rinden pasado ese tiempo más I2C_BUS_SYNC_SLACK_MS
+ * (lo leído va a un buffer del gestor y se copia solo si llega a tiempo).
+ *
+ * Recuperación: un timeout, o un fallo con SDA o SCL abajo, o SDA retenida con
+ * el bus ocioso (el vigilante mira cada I2C_BUS_WATCHDOG_MS), disparan 9
+ * pulsos de SCL y un STOP para soltar al esclavo, y luego
+ * i2c_master_bus_reset. Si las líneas siguen abajo se rehace el bus con
+ * todos sus dispositivos. Al final se sondea cada dispositivo y al que
+ * contesta se le avisa (i2c_bus_on_recover) para que se reconfigure.
+ */
+
+#define I2C_BUS_MAX_DEVICES     4
+#define I2C_BUS_MAX_WRITE       132     // Byte de control + una fila de página del OLED
+#define I2C_BUS_TIMEOUT_MS      100     // Por transacción si no se indica otro
+#define I2C_BUS_MAX_READ        64      // Lecturas síncronas
+#define I2C_BUS_SYNC_SLACK_MS   500     // Cola por delante y una posible recuperación
+#define I2C_BUS_WATCHDOG_MS     1000
+#define I2C_BUS_RECOVER_MIN_MS  1000    // Entre recuperaciones automáticas
+
+typedef enum {
+    I2C_BUS_PRIO_HIGH = 0,      // Medidas del sensor
+    I2C_BUS_PRIO_NORMAL,
+    I2C_BUS_PRIO_LOW,           // Pantalla
+    I2C_BUS_PRIO_COUNT
+} i2c_bus_prio_t;
+
+typedef struct i2c_bus_dev i2c_bus_dev_t;
+
+// Desde la tarea del bus: corto y sin bloquear
+typedef void (*i2c_bus_done_cb_t)(esp_err_t err, void *arg);
+typedef void (*i2c_bus_recover_cb_t)(void *arg);
+// Añade next a la transacción de buf (len bytes, cap como mucho). Si no cabe o
+// no se puede, false sin tocar buf
+typedef bool (*i2c_bus_merge_t)(uint8_t *buf, size_t *len, size_t cap, const uint8_t *next, size_t next_len);
+
+typedef struct {
+    uint32_t xfers;         // Transacciones en el bus
+    uint32_t merged;        // Peticiones fundidas con la anterior
+    uint32_t errors;
+    uint32_t bytes;         // Escritos y leídos
+    uint32_t lat_avg_us;    // Petición → fin
+    uint32_t lat_max_us;
+    uint32_t reattached;    // Contestó tras una recuperación
+    esp_err_t last_err;
+} i2c_bus_stats_t;
+
+typedef struct {
+    uint32_t recoveries;    // Pulsos + STOP + reinicio del periférico
+    uint32_t rebuilds;      // Bus y dispositivos creados de nuevo
+    uint32_t failed;        // Líneas todavía abajo al terminar
+    uint32_t stuck_sda;     // SDA retenida con el bus ocioso
+    uint32_t timeouts;      // Transacciones que agotaron su tiempo
+} i2c_bus_health_t;
+
+// Crea el bus y la tarea
+bool i2c_bus_init(i2c_port_num_t port, int sda, int scl);
+// El dispositivo no debe tener peticiones pendientes al quitarlo
+i2c_bus_dev_t *i2c_bus_add_device(const char *name, uint16_t addr, uint32_t scl_hz, i2c_bus_merge_t merge);
+void i2c_bus_rm_device(i2c_bus_dev_t *dev);
+// cb desde la tarea del bus cuando el dispositivo contesta tras una recuperación
+void i2c_bus_on_recover(i2c_bus_dev_t *dev, i2c_bus_recover_cb_t cb, void *arg);
+
+// Sin esperar a la transferencia (sí a que haya hueco en la cola). rbuf debe
+// seguir vivo hasta el callback; cb puede ser NULL
+esp_err_t i2c_bus_submit(i2c_bus_dev_t *dev, i2c_bus_prio_t prio, const uint8_t *wbuf, size_t wlen,
+                         uint8_t *rbuf, size_t rlen, i2c_bus_done_cb_t cb, void *arg);
+// Escritura y/o lectura (rlen <= I2C_BUS_MAX_READ) esperando el resultado
+esp_err_t i2c_bus_transfer(i2c_bus_dev_t *dev, i2c_bus_prio_t prio, const uint8_t *wbuf, size_t wlen,
+                           uint8_t *rbuf, size_t rlen, int timeout_ms);
+esp_err_t i2c_bus_probe(uint16_t addr, int timeout_ms);
+// Recuperación completa ya, sin esperar al vigilante. ESP_OK si las líneas quedan arriba
+esp_err_t i2c_bus_recover(void);
+
+void i2c_bus_get_stats(const i2c_bus_dev_t *dev, i2c_bus_stats_t *out);
+void i2c_bus_get_health(i2c_bus_health_t *out);
+// {"bus":{...},"<nombre>":{...},...}. Longitud escrita o -1 si no cabe
+int i2c_bus_format_json(char *buf, size_t cap);
+
+#endif /* MAIN_I2C_BUS_H_ */
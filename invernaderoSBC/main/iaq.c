@@ -0,0 +1,100 @@
+#include <math.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_log.h"
+#include "nvs_flash.h"
+#include "nvs.h"
+
+#include "iaq.h"
+
+#define TAG "IAQ"
+
+#define IAQ_NVS_KEY         "iaq_base"
+#define IAQ_BASE_RISE       0.2f    // Rapidez con la que la línea base sigue a un aire más limpio
+
+static float s_baseline = 0.0f;
+static float s_saved_baseline = 0.0f;
+static bool s_from_nvs = false;
+static int64_t s_first_us = -1;
+static int64_t s_last_us = 0;
+static int64_t s_saved_us = 0;
+
+static iaq_result_t s_result;
+static bool s_valid = false;
+static portMUX_TYPE s_iaq_lock = portMUX_INITIALIZER_UNLOCKED;
+
+void iaq_init(void) {
+    nvs_handle_t h;
+    if (nvs_open("storage", NVS_READONLY, &h) != ESP_OK) return;
+    uint32_t base = 0;
+    if (nvs_get_u32(h, IAQ_NVS_KEY, &base) == ESP_OK && base > 0) {
+        s_baseline = s_saved_baseline = (float)base;
+        s_from_nvs = true;
+        ESP_LOGI(TAG, "Línea base IAQ recuperada: %lu Ohm", (unsigned long)base);
+    }
+    nvs_close(h);
+}
+
+static void save_baseline(int64_t now_us) {
+    nvs_handle_t h;
+    if (nvs_open("storage", NVS_READWRITE, &h) != ESP_OK) return;
+    nvs_set_u32(h, IAQ_NVS_KEY, (uint32_t)s_baseline);
+    nvs_commit(h);
+    nvs_close(h);
+    s_saved_baseline = s_baseline;
+    s_saved_us = now_us;
+    ESP_LOGI(TAG, "💾 Línea base IAQ guardada: %.0f Ohm", s_baseline);
+}
+
+bool iaq_update(float gas_ohm, float hum, int64_t now_us, iaq_result_t *out) {
+    if (!(gas_ohm > 0.0f)) return false;
+    if (s_first_us < 0) s_first_us = now_us;
+
+    // La resistencia del MOX baja con la humedad: se lleva a la humedad de referencia
+    float comp = gas_ohm * expf(IAQ_HUM_COEF * (hum - IAQ_HUM_REF));
+    float elapsed_s = (float)(now_us - s_first_us) / 1e6f;
+    if (elapsed_s < IAQ_WARMUP_S) {
+        s_last_us = now_us;
+        return false;
+    }
+
+    if (s_baseline <= 0.0f) {
+        s_baseline = comp;
+    } else {
+        float dt_h = (float)(now_us - s_last_us) / 3.6e9f;
+        s_baseline -= s_baseline * IAQ_BASE_DECAY_H * dt_h;
+        if (comp > s_baseline) s_baseline += IAQ_BASE_RISE * (comp - s_baseline);
+    }
+    s_last_us = now_us;
+
+    float ratio = comp / s_baseline;
+    if (ratio > 1.0f) ratio = 1.0f;
+
+    iaq_result_t r = {
+        .iaq = (1.0f - ratio) * 500.0f,
+        .comp_gas = comp,
+        .baseline = s_baseline,
+        .accuracy = (s_from_nvs || elapsed_s >= IAQ_WARMUP_S + IAQ_LEARN_S) ? IAQ_ACC_STABLE : IAQ_ACC_LEARNING,
+    };
+
+    // Solo se persiste una base ya aprendida y si ha cambiado más de un 1 %
+    if (r.accuracy == IAQ_ACC_STABLE && (now_us - s_saved_us) >= (int64_t)IAQ_SAVE_PERIOD_S * 1000000 &&
+        fabsf(s_baseline - s_saved_baseline) > 0.01f * s_saved_baseline) {
+        save_baseline(now_us);
+    }
+
+    portENTER_CRITICAL(&s_iaq_lock);
+    s_result = r;
+    s_valid = true;
+    portEXIT_CRITICAL(&s_iaq_lock);
+
+    if (out) *out = r;
+    return true;
+}
+
+bool iaq_latest(iaq_result_t *out) {
+    portENTER_CRITICAL(&s_iaq_lock);
+    bool valid = s_valid;
+    *out = s_result;
+    portEXIT_CRITICAL(&s_iaq_lock);
+    return valid;
+}
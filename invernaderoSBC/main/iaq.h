@@ -0,0 +1,44 @@
+#ifndef MAIN_IAQ_H_
+#define MAIN_IAQ_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Índice de calidad del aire (IAQ 0-500) a partir de la resistencia de gas.
+ *
+ * Implementación abierta y sencilla, no equivalente a BSEC: la resistencia se
+ * compensa en humedad (modelo log-lineal), se compara con una línea base de
+ * "aire limpio" que sigue los máximos y decae lentamente, y la caída relativa
+ * se escala a 0-500 (0 = aire limpio). La línea base se guarda en NVS para no
+ * reaprender en cada arranque. Coste por muestra: una expf y unas pocas
+ * operaciones; la escritura en NVS es como mucho una por hora.
+ */
+
+#define IAQ_WARMUP_S        300     // Estabilización del calentador tras arrancar
+#define IAQ_LEARN_S         3600    // Aprendizaje de línea base sin valor guardado
+#define IAQ_HUM_REF         40.0f   // %RH de referencia de la compensación
+#define IAQ_HUM_COEF        0.03f   // ln(R) por %RH (empírico, ajustar por sensor)
+#define IAQ_BASE_DECAY_H    0.02f   // Fracción por hora que baja la línea base
+#define IAQ_SAVE_PERIOD_S   3600
+
+typedef enum {
+    IAQ_ACC_WARMUP = 0,     // Sin valor todavía
+    IAQ_ACC_LEARNING,       // Línea base de esta sesión, aún poco fiable
+    IAQ_ACC_STABLE,
+} iaq_accuracy_t;
+
+typedef struct {
+    float iaq;              // 0 (limpio) - 500
+    float comp_gas;         // Resistencia compensada, Ohm
+    float baseline;         // Ohm
+    iaq_accuracy_t accuracy;
+} iaq_result_t;
+
+// Carga la línea base guardada (NVS ya inicializado)
+void iaq_init(void);
+// Procesa una lectura con gas válido; devuelve true si out tiene un IAQ utilizable
+bool iaq_update(float gas_ohm, float hum, int64_t now_us, iaq_result_t *out);
+bool iaq_latest(iaq_result_t *out);
+
+#endif /* MAIN_IAQ_H_ */
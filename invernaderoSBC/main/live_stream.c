@@ -0,0 +1,182 @@
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include <esp_http_server.h>
+
+#include "live_stream.h"
+
+#define TAG "LIVE_STREAM"
+
+#define LIVE_SEND_BUDGET 4 // Mensajes máximos por cliente y por pasada de envío
+
+typedef struct {
+    uint32_t seq;
+    uint16_t len;
+    char data[LIVE_MSG_MAX];
+} live_msg_t;
+
+typedef struct {
+    int fd;             // -1 = libre
+    uint32_t cursor;    // siguiente seq a enviar
+} live_client_t;
+
+static httpd_handle_t s_server = NULL;
+static SemaphoreHandle_t s_lock = NULL;
+static live_msg_t s_ring[LIVE_RING_LEN];
+static uint32_t s_next_seq = 0;
+static live_client_t s_clients[LIVE_MAX_CLIENTS];
+static volatile bool s_flush_pending = false;
+static live_stream_stats_t s_stats;
+
+static void flush_work(void *arg);
+
+// Una sola tarea de vaciado en la cola de httpd. Si no entra se deja sin marcar
+// para que la siguiente muestra lo reintente
+static void request_flush(void) {
+    if (s_flush_pending) return;
+    s_flush_pending = true;
+    if (httpd_queue_work(s_server, flush_work, NULL) != ESP_OK) s_flush_pending = false;
+}
+
+static void client_remove_locked(int slot) {
+    s_clients[slot].fd = -1;
+    if (s_stats.clients) s_stats.clients--;
+}
+
+static esp_err_t ws_handler(httpd_req_t *req) {
+    if (req->method == HTTP_GET) {
+        // Handshake completado: alta del cliente, empezando por la última muestra
+        int fd = httpd_req_to_sockfd(req);
+        xSemaphoreTake(s_lock, portMAX_DELAY);
+        int slot = -1;
+        for (int i = 0; i < LIVE_MAX_CLIENTS; i++) {
+            if (s_clients[i].fd == fd) { slot = i; break; }
+            if (slot < 0 && s_clients[i].fd < 0) slot = i;
+        }
+        if (slot >= 0 && s_clients[slot].fd != fd) {
+            s_clients[slot].fd = fd;
+            s_clients[slot].cursor = s_next_seq ? s_next_seq - 1 : 0;
+            s_stats.clients++;
+        }
+        xSemaphoreGive(s_lock);
+
+        if (slot < 0) {
+            ESP_LOGW(TAG, "Sin hueco para cliente WS fd=%d", fd);
+            return ESP_FAIL;
+        }
+        ESP_LOGI(TAG, "Cliente WS conectado fd=%d", fd);
+        request_flush();
+        return ESP_OK;
+    }
+
+    // Los clientes no envían nada útil: se leen y descartan los frames entrantes
+    httpd_ws_frame_t frame = { .type = HTTPD_WS_TYPE_TEXT };
+    esp_err_t ret = httpd_ws_recv_frame(req, &frame, 0);
+    if (ret != ESP_OK) return ret;
+    if (frame.len > 0 && frame.len <= 64) {
+        uint8_t scratch[64];
+        frame.payload = scratch;
+        ret = httpd_ws_recv_frame(req, &frame, frame.len);
+    }
+    return ret;
+}
+
+// Se ejecuta en la tarea de httpd: envía lo pendiente a cada cliente
+static void flush_work(void *arg) {
+    static live_msg_t out; // Solo se usa desde la tarea de httpd
+    s_flush_pending = false;
+
+    for (int slot = 0; slot < LIVE_MAX_CLIENTS; slot++) {
+        for (int budget = 0; budget < LIVE_SEND_BUDGET; budget++) {
+            xSemaphoreTake(s_lock, portMAX_DELAY);
+            int fd = s_clients[slot].fd;
+            if (fd < 0 || s_clients[slot].cursor >= s_next_seq) {
+                xSemaphoreGive(s_lock);
+                break;
+            }
+            if (httpd_ws_get_fd_info(s_server, fd) != HTTPD_WS_CLIENT_WEBSOCKET) {
+                client_remove_locked(slot);
+                xSemaphoreGive(s_lock);
+                break;
+            }
+            // Cliente lento: descartar los más antiguos que ya no están en el anillo
+            uint32_t oldest = (s_next_seq > LIVE_RING_LEN) ? s_next_seq - LIVE_RING_LEN : 0;
+            if (s_clients[slot].cursor < oldest) {
+                s_stats.dropped += oldest - s_clients[slot].cursor;
+                s_clients[slot].cursor = oldest;
+            }
+            out = s_ring[s_clients[slot].cursor % LIVE_RING_LEN];
+            s_clients[slot].cursor++;
+            xSemaphoreGive(s_lock);
+
+            httpd_ws_frame_t frame = {
+                .final = true,
+                .type = HTTPD_WS_TYPE_TEXT,
+                .payload = (uint8_t *)out.data,
+                .len = out.len,
+            };
+            if (httpd_ws_send_frame_async(s_server, fd, &frame) != ESP_OK) {
+                ESP_LOGW(TAG, "Fallo de envío, cerrando fd=%d", fd);
+                xSemaphoreTake(s_lock, portMAX_DELAY);
+                if (s_clients[slot].fd == fd) client_remove_locked(slot);
+                xSemaphoreGive(s_lock);
+                httpd_sess_trigger_close(s_server, fd);
+                break;
+            }
+            s_stats.sent++;
+        }
+    }
+
+    // Si algún cliente sigue con atraso, se reprograma en lugar de monopolizar httpd
+    bool pending = false;
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    for (int slot = 0; slot < LIVE_MAX_CLIENTS; slot++) {
+        if (s_clients[slot].fd >= 0 && s_clients[slot].cursor < s_next_seq) pending = true;
+    }
+    xSemaphoreGive(s_lock);
+    if (pending) request_flush();
+}
+
+esp_err_t live_stream_register(httpd_handle_t server) {
+    if (!server) return ESP_ERR_INVALID_ARG;
+    if (!s_lock) s_lock = xSemaphoreCreateMutex();
+    if (!s_lock) return ESP_ERR_NO_MEM;
+    for (int i = 0; i < LIVE_MAX_CLIENTS; i++) s_clients[i].fd = -1;
+    s_server = server;
+
+    httpd_uri_t uri_ws = {
+        .uri = "/ws", .method = HTTP_GET, .handler = ws_handler, .is_websocket = true,
+    };
+    return httpd_register_uri_handler(server, &uri_ws);
+}
+
+void live_stream_publish(const char *json) {
+    if (!s_server || !s_lock) return;
+    size_t len = strlen(json);
+    if (len >= LIVE_MSG_MAX) {
+        ESP_LOGW(TAG, "Mensaje demasiado largo (%u)", (unsigned)len);
+        return;
+    }
+
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    live_msg_t *m = &s_ring[s_next_seq % LIVE_RING_LEN];
+    m->seq = s_next_seq++;
+    m->len = len;
+    memcpy(m->data, json, len + 1);
+    s_stats.published++;
+    bool any = s_stats.clients > 0;
+    xSemaphoreGive(s_lock);
+
+    if (any) request_flush();
+}
+
+void live_stream_get_stats(live_stream_stats_t *out) {
+    if (!s_lock) {
+        memset(out, 0, sizeof(*out));
+        return;
+    }
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    *out = s_stats;
+    xSemaphoreGive(s_lock);
+}
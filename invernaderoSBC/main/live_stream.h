@@ -0,0 +1,31 @@
+#ifndef MAIN_LIVE_STREAM_H_
+#define MAIN_LIVE_STREAM_H_
+
+#include <stdint.h>
+#include <esp_http_server.h>
+
+/*
+ * Canal push por WebSocket (/ws) para clientes de la LAN.
+ *
+ * Los mensajes se guardan una sola vez en un anillo global numerado; cada
+ * cliente solo guarda su cursor. Si un cliente lento se queda más de
+ * LIVE_RING_LEN mensajes atrás, su cursor salta al más antiguo disponible
+ * (se descartan los viejos), así que la memoria no depende del nº de clientes.
+ */
+
+#define LIVE_MAX_CLIENTS 4
+#define LIVE_RING_LEN    16
+#define LIVE_MSG_MAX     224
+
+typedef struct {
+    uint8_t clients;
+    uint32_t published;
+    uint32_t sent;
+    uint32_t dropped;   // mensajes saltados por clientes lentos
+} live_stream_stats_t;
+
+esp_err_t live_stream_register(httpd_handle_t server);
+void live_stream_publish(const char *json);
+void live_stream_get_stats(live_stream_stats_t *out);
+
+#endif /* MAIN_LIVE_STREAM_H_ */
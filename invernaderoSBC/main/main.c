@@ -5,6 +5,7 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/event_groups.h"
+#include "freertos/queue.h"
 #include "esp_system.h"
 #include "esp_wifi.h"
 #include "esp_event.h"
@@ -20,7 +21,6 @@
 #include "driver/gpio.h"
 #include "driver/i2c_master.h"
 #include "cJSON.h" 
-#include "rom/ets_sys.h"
 
 #include "bme68x.h"
 #include "ssd1306.h"
@@ -28,6 +28,26 @@
 #include "esp_https_ota.h"
 #include "esp_ota_ops.h"
 
+#include "alarms.h"
+#include "app_state.h"
+#include "display.h"
+#include "filter.h"
+#include "history.h"
+#include "i2c_bus.h"
+#include "iaq.h"
+#include "live_stream.h"
+#include "mqtt_outbox.h"
+#include "provisioning.h"
+#include "recipe.h"
+#include "psychro.h"
+#include "report.h"
+#include "sensor.h"
+#include "telemetry_codec.h"
+#include "time_sync.h"
+#include "trace.h"
+#include "web_server.h"
+#include "wifi_manager.h"
+
 
 
 
@@ -35,16 +55,28 @@
 
 #define BOTON_PULSADO_ES 1 
 
-#define PIN_VENTILADOR     26   
-#define PIN_HUMIDIFICADOR  27
-
 #define TB_BROKER_URI      "mqtt://demo.thingsboard.io"
 #define TB_ACCESS_TOKEN    "a08e1dncysa8fky6xive" 
+#define TB_ATTRIBUTES_TOPIC "v1/devices/me/attributes"
+#define TELEMETRY_MQTT_ENCODER telemetry_json // ThingsBoard solo acepta JSON en este topic; telemetry_cbor para brokers propios
 #define TELEGRAM_TOKEN     "8531142504:AAHamh-FsSlT65B9_0uMU9LtF4492xxAj3s" 
 #define TELEGRAM_CHAT_ID   "476420106"        
 
 #define OTA_URL "http://192.168.1.129:9000/invernaderoSBC.bin"
 
+#define IAQ_FAN_HISTERESIS  50  // El ventilador por IAQ para por debajo de iaq_max - esto
+#define ZONA_HORARIA        "CET-1CEST,M3.5.0,M10.5.0/3" // Horario día/noche de las recetas
+#define SNTP_SERVER         "pool.ntp.org"
+
+#define CONDENSACION_MARGEN_C 0.5 // Distancia mínima T - punto de rocío para humidificar
+
+#define TRACE_PUBLISH_EVERY 12 // Ciclos de telemetría (~60 s) entre envíos de histogramas
+#define MAIN_STACK_WARN     768 // Bytes libres mínimos de la pila de app_main antes de avisar
+#define ALARMAS_COLA        8  // Avisos de Telegram en espera; si se llena se descartan
+
+// Vistas de la pantalla, en el orden en que las recorre el botón
+enum { VISTA_ESTADO = 0, VISTA_GRAFICAS, VISTA_ALARMAS, VISTA_N };
+
 
 
 #define APP_VERSION "v4.0.5" // pa test
@@ -56,58 +88,64 @@
 #define PIN_BOTON           4
 
 #define I2C_FREQ_HZ         100000
-#define BME_ADDR_LOW        0x76
-#define BME_ADDR_HIGH       0x77
 #define OLED_ADDR           0x3C
+#define OLED_CONTROLLER     SSD1306_CTRL_SSD1306    // SSD1306_CTRL_SH1106 para el panel de 1,3"
+#define OLED_WIDTH          128
+#define OLED_HEIGHT         64
 
 
-char current_ssid[32] = {0};
-char current_pass[64] = {0};
-
-void start_ap_mode(void);
-esp_err_t load_wifi_credentials(void);
-
-
-typedef struct {
-    char nombre[16];
-    float temp_min;
-    float temp_max;
-    float hum_min;
-    float hum_max;
-} FaseCultivo;
 
-FaseCultivo fase_germinacion = {"Germinacion", 24.0, 28.0, 60.0, 70.0};
-FaseCultivo fase_fructificacion = {"Fructificacion", 18.0, 23.0, 90.0, 95.0};
+FaseCultivo fase_germinacion = {"Germinacion", 24.0, 28.0, 60.0, 70.0, 150.0};
+FaseCultivo fase_fructificacion = {"Fructificacion", 18.0, 23.0, 90.0, 95.0, 150.0};
 
 FaseCultivo *fase_actual = &fase_germinacion; 
 bool modo_automatico = true; 
 
+// Filtrado por magnitud entre la lectura y el control (ver filter.h)
+static const filter_config_t filtro_cfg_temp = {
+    .min = -20.0f, .max = 70.0f, .median_n = 3, .ema_alpha = 0.5f,
+    .max_rate = 0.1f, .stuck_eps = 0.001f, .stuck_count = 60,
+};
+static const filter_config_t filtro_cfg_hum = {
+    .min = 0.0f, .max = 100.0f, .median_n = 3, .ema_alpha = 0.5f,
+    .max_rate = 1.0f, .stuck_eps = 0.001f, .stuck_count = 60,
+};
+static const filter_config_t filtro_cfg_press = {
+    .min = 300.0f, .max = 1100.0f, .median_n = 3, .ema_alpha = 0.3f,
+};
+static const filter_config_t filtro_cfg_gas = {
+    .min = 50.0f, .max = 50000000.0f, .median_n = 3, .ema_alpha = 0.3f,
+};
+static filter_t filtro_temp, filtro_hum, filtro_press, filtro_gas;
+
 int8_t guardado_fan_state = 0; 
 int8_t guardado_hum_state = 0; 
 
-i2c_master_bus_handle_t bus_handle;
-i2c_master_dev_handle_t bme_dev_handle;
-i2c_master_dev_handle_t oled_dev_handle = NULL;
-struct bme68x_dev bme;
 SSD1306_t oled;
 bool oled_detectada = false;
 
 static EventGroupHandle_t s_wifi_event_group;
+static QueueHandle_t s_cola_alarmas;    // alarm_event_t pendientes de Telegram
 #define WIFI_CONNECTED_BIT BIT0
 esp_mqtt_client_handle_t mqtt_client = NULL;
 bool mqtt_connected = false;
 static int last_update_id = 0; 
 
-int8_t bme_i2c_read(uint8_t reg_addr, uint8_t *reg_data, uint32_t len, void *intf_ptr);
-int8_t bme_i2c_write(uint8_t reg_addr, const uint8_t *reg_data, uint32_t len, void *intf_ptr);
-void bme_delay_us(uint32_t period, void *intf_ptr);
 void telegram_send_message_to(const char *chat_id, const char *text);
 
+int fase_id_actual(void) {
+    if (fase_actual == &fase_germinacion) return 0;
+    if (fase_actual == &fase_fructificacion) return 1;
+    recipe_status_t st;
+    recipe_get_status(&st);
+    return 2 + st.phase;
+}
+
 void guardar_estado_nvs() {
     nvs_handle_t my_handle;
     esp_err_t err = nvs_open("storage", NVS_READWRITE, &my_handle);
     if (err == ESP_OK) {
-        int8_t id_fase = (fase_actual == &fase_germinacion) ? 0 : 1;
+        int8_t id_fase = fase_id_actual();
         int8_t id_modo = modo_automatico ? 1 : 0;
         int8_t st_fan = gpio_get_level(PIN_VENTILADOR);
         int8_t st_hum = gpio_get_level(PIN_HUMIDIFICADOR);
@@ -152,49 +190,37 @@ void cargar_estado_nvs() {
     }
 }
 
-void oled_set_power(bool on) {
-    if (!oled_detectada || oled_dev_handle == NULL) return;
-    uint8_t cmd = on ? 0xAF : 0xAE;
-    uint8_t data[] = {0x00, cmd}; 
-    i2c_master_transmit(oled_dev_handle, data, sizeof(data), -1);
+static void init_i2c_bus(void) {
+    // El gestor es el dueño del bus: sensor y pantalla le piden las transacciones
+    if (!i2c_bus_init(I2C_PORT, PIN_SDA, PIN_SCL)) ESP_ERROR_CHECK(ESP_FAIL);
+}
+
+// Tráfico de la pantalla: sin esperar y detrás de las medidas del sensor
+static esp_err_t oled_write(void *ctx, const uint8_t *buf, size_t len) {
+    return i2c_bus_submit((i2c_bus_dev_t *)ctx, I2C_BUS_PRIO_LOW, buf, len, NULL, 0, NULL, NULL);
 }
 
-static void init_i2c_bus(void) {
-    i2c_master_bus_config_t i2c_bus_conf = {
-        .clk_source = I2C_CLK_SRC_DEFAULT, .i2c_port = I2C_PORT,
-        .scl_io_num = PIN_SCL, .sda_io_num = PIN_SDA,
-        .glitch_ignore_cnt = 7, .flags.enable_internal_pullup = true,
-    };
-    ESP_ERROR_CHECK(i2c_new_master_bus(&i2c_bus_conf, &bus_handle));
+static void oled_recovered(void *arg) {
+    display_resync();
 }
 
 static void init_oled_device(void) {
-    if (i2c_master_probe(bus_handle, OLED_ADDR, 50) != ESP_OK) {
+    if (i2c_bus_probe(OLED_ADDR, 50) != ESP_OK) {
         oled_detectada = false; return;
     }
-    i2c_device_config_t oled_conf = {
-        .dev_addr_length = I2C_ADDR_BIT_LEN_7, .device_address = OLED_ADDR, .scl_speed_hz = I2C_FREQ_HZ,
-    };
-    ESP_ERROR_CHECK(i2c_master_bus_add_device(bus_handle, &oled_conf, &oled_dev_handle));
-    oled._i2c_dev_handle = oled_dev_handle;
-    oled._address = OLED_ADDR; oled._flip = false;
-    ssd1306_init(&oled, 128, 64);
-    oled_set_power(true); 
+    i2c_bus_dev_t *bus_oled = i2c_bus_add_device("oled", OLED_ADDR, I2C_FREQ_HZ, i2c_merge_writes);
+    if (!bus_oled) {
+        oled_detectada = false; return;
+    }
+    i2c_device_attach(&oled, OLED_ADDR, oled_write, bus_oled);
+    // Un glitch que cuelga el bus puede reiniciar también el panel
+    i2c_bus_on_recover(bus_oled, oled_recovered, NULL);
+    ssd1306_set_controller(&oled, OLED_CONTROLLER);
+    ssd1306_init(&oled, OLED_WIDTH, OLED_HEIGHT);
     ssd1306_clear_screen(&oled, false);
     ssd1306_display_text(&oled, 0, "Iniciando...", 12, false);
-    oled_detectada = true;
-}
-
-static bool init_bme_device(void) {
-    uint8_t addr_found = 0;
-    if (i2c_master_probe(bus_handle, BME_ADDR_LOW, 50) == ESP_OK) addr_found = BME_ADDR_LOW;
-    else if (i2c_master_probe(bus_handle, BME_ADDR_HIGH, 50) == ESP_OK) addr_found = BME_ADDR_HIGH;
-    if (addr_found == 0) return false;
-    i2c_device_config_t bme_dev_conf = {
-        .dev_addr_length = I2C_ADDR_BIT_LEN_7, .device_address = addr_found, .scl_speed_hz = I2C_FREQ_HZ,
-    };
-    ESP_ERROR_CHECK(i2c_master_bus_add_device(bus_handle, &bme_dev_conf, &bme_dev_handle));
-    return true;
+    // Desde aquí solo la tarea de pantalla habla con el OLED
+    oled_detectada = display_start(&oled);
 }
 
 static void init_gpio(void) {
@@ -216,144 +242,52 @@ static void init_gpio(void) {
     gpio_config(&btn_conf);
 }
 
-static void wifi_event_handler(void* arg, esp_event_base_t event_base, int32_t event_id, void* event_data) {
-    if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_STA_START) esp_wifi_connect();
-    else if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_STA_DISCONNECTED) {
-        esp_wifi_connect(); xEventGroupClearBits(s_wifi_event_group, WIFI_CONNECTED_BIT);
-    } else if (event_base == IP_EVENT && event_id == IP_EVENT_STA_GOT_IP) xEventGroupSetBits(s_wifi_event_group, WIFI_CONNECTED_BIT);
-}
-
-esp_err_t save_wifi_credentials(const char *ssid, const char *pass) {
-    nvs_handle_t my_handle;
-    esp_err_t err = nvs_open("storage", NVS_READWRITE, &my_handle);
-    if (err == ESP_OK) {
-        nvs_set_str(my_handle, "w_ssid", ssid);
-        nvs_set_str(my_handle, "w_pass", pass);
-        nvs_commit(my_handle);
-        nvs_close(my_handle);
-        return ESP_OK;
-    }
-    return err;
-}
-
-esp_err_t load_wifi_credentials(void) {
-    nvs_handle_t my_handle;
-    size_t ssid_len = sizeof(current_ssid);
-    size_t pass_len = sizeof(current_pass);
-    esp_err_t err = nvs_open("storage", NVS_READONLY, &my_handle);
-    if (err == ESP_OK) {
-        if(nvs_get_str(my_handle, "w_ssid", current_ssid, &ssid_len) == ESP_OK &&
-           nvs_get_str(my_handle, "w_pass", current_pass, &pass_len) == ESP_OK) {
-            nvs_close(my_handle);
-            return ESP_OK;
-        }
-        nvs_close(my_handle);
+// Atributo compartido "recipe" de ThingsBoard: objeto JSON o texto con el JSON
+static void mqtt_handle_attributes(esp_mqtt_event_handle_t event) {
+    if (event->current_data_offset != 0 || event->data_len != event->total_data_len) return; // Fragmentado
+    if (event->topic_len != strlen(TB_ATTRIBUTES_TOPIC) ||
+        strncmp(event->topic, TB_ATTRIBUTES_TOPIC, event->topic_len) != 0) return;
+
+    cJSON *root = cJSON_ParseWithLength(event->data, event->data_len);
+    if (!root) return;
+    cJSON *receta = cJSON_GetObjectItem(root, "recipe");
+    cJSON *parsed = cJSON_IsString(receta) ? cJSON_Parse(receta->valuestring) : NULL;
+    if (parsed) receta = parsed;
+    if (cJSON_IsObject(receta)) {
+        char err[64] = "";
+        if (recipe_apply_json(receta, err, sizeof(err)) == ESP_OK) ESP_LOGI(TAG, "Receta recibida por MQTT");
+        else ESP_LOGW(TAG, "Receta MQTT rechazada: %s", err);
     }
-    return ESP_FAIL;
-}
-
-static esp_err_t save_post_handler(httpd_req_t *req) {
-    char buf[150];
-    int ret = httpd_req_recv(req, buf, req->content_len);
-    if (ret <= 0) return ESP_FAIL;
-    buf[ret] = '\0';
-
-    char ssid[32] = {0}, pass[64] = {0};
-    if (httpd_query_key_value(buf, "ssid", ssid, sizeof(ssid)) == ESP_OK &&
-        httpd_query_key_value(buf, "pwd", pass, sizeof(pass)) == ESP_OK) {
-        
-        save_wifi_credentials(ssid, pass);
-        httpd_resp_send(req, "<h1>Guardado! Reiniciando...</h1>", -1);
-        vTaskDelay(pdMS_TO_TICKS(2000));
-        esp_restart(); 
-    }
-    return ESP_OK;
-}
-
-static esp_err_t config_get_handler(httpd_req_t *req) {
-    char html[1024] = "<html><body><h1>Configurar WiFi SBC</h1>"
-                      "<form action='/save' method='post'>"
-                      "SSID: <input type='text' name='ssid'><br>"
-                      "Pass: <input type='password' name='pwd'><br>"
-                      "<input type='submit' value='Guardar'></form></body></html>";
-    httpd_resp_send(req, html, -1);
-    return ESP_OK;
-}
-
-void start_ap_mode(void) {
-    ESP_LOGI(TAG, "Iniciando Modo Punto de Acceso (AP)");
-    
-    if(oled_detectada) {
-        ssd1306_clear_screen(&oled, false);
-        ssd1306_display_text(&oled, 0, "MODO CONFIG", 11, false);
-        ssd1306_display_text(&oled, 2, "WIFI: ESP32-SBC", 15, false);
-        ssd1306_display_text(&oled, 4, "IP: 192.168.4.1", 15, false);
-    }
-
-    wifi_init_config_t cfg = WIFI_INIT_CONFIG_DEFAULT();
-    esp_wifi_init(&cfg); 
-
-    esp_netif_create_default_wifi_ap();
-    
-    wifi_config_t wifi_config = {
-        .ap = { .ssid = "ESP32-SBC-Config", .password = "", .max_connection = 4, .authmode = WIFI_AUTH_OPEN }
-    };
-    
-    ESP_ERROR_CHECK(esp_wifi_set_mode(WIFI_MODE_AP));
-    ESP_ERROR_CHECK(esp_wifi_set_config(WIFI_IF_AP, &wifi_config));
-    ESP_ERROR_CHECK(esp_wifi_start());
-
-    httpd_handle_t server = NULL;
-    httpd_config_t config = HTTPD_DEFAULT_CONFIG();
-    if (httpd_start(&server, &config) == ESP_OK) {
-        httpd_uri_t uri_get = { .uri = "/", .method = HTTP_GET, .handler = config_get_handler };
-        httpd_register_uri_handler(server, &uri_get);
-        httpd_uri_t uri_post = { .uri = "/save", .method = HTTP_POST, .handler = save_post_handler };
-        httpd_register_uri_handler(server, &uri_post);
-    }
-    
-    while(1) { vTaskDelay(pdMS_TO_TICKS(1000)); }
-}
-
-void wifi_init_sta(void) {
-    s_wifi_event_group = xEventGroupCreate();
-
-    esp_netif_create_default_wifi_sta();
-    
-    wifi_init_config_t cfg = WIFI_INIT_CONFIG_DEFAULT();
-    ESP_ERROR_CHECK(esp_wifi_init(&cfg));
-
-    esp_event_handler_instance_t instance_any_id;
-    esp_event_handler_instance_t instance_got_ip;
-    ESP_ERROR_CHECK(esp_event_handler_instance_register(WIFI_EVENT, ESP_EVENT_ANY_ID, &wifi_event_handler, NULL, &instance_any_id));
-    ESP_ERROR_CHECK(esp_event_handler_instance_register(IP_EVENT, IP_EVENT_STA_GOT_IP, &wifi_event_handler, NULL, &instance_got_ip));
-
-    wifi_config_t wifi_config = { .sta = { .threshold.authmode = WIFI_AUTH_WPA2_PSK } };
-    
-    strlcpy((char *)wifi_config.sta.ssid, current_ssid, sizeof(wifi_config.sta.ssid));
-    strlcpy((char *)wifi_config.sta.password, current_pass, sizeof(wifi_config.sta.password));
-
-    ESP_ERROR_CHECK(esp_wifi_set_mode(WIFI_MODE_STA));
-    ESP_ERROR_CHECK(esp_wifi_set_config(WIFI_IF_STA, &wifi_config));
-    ESP_ERROR_CHECK(esp_wifi_start());
+    cJSON_Delete(parsed);
+    cJSON_Delete(root);
 }
 
 static void mqtt_event_handler(void *handler_args, esp_event_base_t base, int32_t event_id, void *event_data) {
     esp_mqtt_event_handle_t event = event_data;
-    if (event->event_id == MQTT_EVENT_CONNECTED) mqtt_connected = true;
+    if (event->event_id == MQTT_EVENT_CONNECTED) {
+        mqtt_connected = true;
+        esp_mqtt_client_subscribe(mqtt_client, TB_ATTRIBUTES_TOPIC, 1);
+    }
     else if (event->event_id == MQTT_EVENT_DISCONNECTED) mqtt_connected = false;
+    else if (event->event_id == MQTT_EVENT_DATA) mqtt_handle_attributes(event);
+    mqtt_outbox_on_event(event);
 }
 
 static void mqtt_app_start(void) {
     esp_mqtt_client_config_t mqtt_cfg = { .broker.address.uri = TB_BROKER_URI, .credentials.username = TB_ACCESS_TOKEN };
     mqtt_client = esp_mqtt_client_init(&mqtt_cfg);
     esp_mqtt_client_register_event(mqtt_client, ESP_EVENT_ANY_ID, mqtt_event_handler, NULL);
+    mqtt_outbox_attach(mqtt_client);
     esp_mqtt_client_start(mqtt_client);
 }
 
-void send_telemetry_thingsboard(float temp, float hum, float press, float gas) {
-    if (!mqtt_connected) return;
-    int fase_id = (fase_actual == &fase_germinacion) ? 0 : 1; 
+// Solo publica si algo cambia más que su banda muerta (o vence el latido).
+// Pasa por el outbox: sin conexión se guarda en flash y se reenvía al reconectar.
+// t_us es el instante de adquisición; con hora real viaja como "ts"
+void send_telemetry_thingsboard(int64_t t_us, float temp, float hum, float press, float gas, int iaq) {
+    psychro_t psy;
+    psychro_compute(temp, hum, &psy);
+    int fase_id = fase_id_actual(); 
 	
 	// MODO PRUEBA: FORZAR VALORES PERFECTOS o MALOOOOS
     // Si estás en Germinación (24-28), enviamos 26.
@@ -366,11 +300,45 @@ void send_telemetry_thingsboard(float temp, float hum, float press, float gas) {
 	
     // ---------------------------------------------
 	
-    char telemetry_json[256]; 
-    snprintf(telemetry_json, sizeof(telemetry_json), //cambiar si quieres temp y hum a temp_fake o hum_fake para simular thingsboard
-        "{\"temperature\":%.2f,\"humidity\":%.2f,\"pressure\":%.2f,\"gas\":%.0f,\"auto\":%d,\"fan\":%d,\"humid\":%d,\"phase_id\":%d}", 
-        temp, hum, press, gas, modo_automatico, gpio_get_level(PIN_VENTILADOR), gpio_get_level(PIN_HUMIDIFICADOR), fase_id);
-    esp_mqtt_client_publish(mqtt_client, "v1/devices/me/telemetry", telemetry_json, 0, 1, 0);
+    telemetry_sample_t muestra = { //cambiar si quieres temp y hum a temp_fake o hum_fake para simular thingsboard
+        .ts_ms = time_epoch_ms(t_us),
+        .temperature = temp, .humidity = hum, .pressure = press, .gas = gas, .iaq = iaq,
+        .derived = true, .dew_point = psy.dew_point, .vpd = psy.vpd, .abs_hum = psy.abs_hum,
+        .auto_mode = modo_automatico, .fan = gpio_get_level(PIN_VENTILADOR),
+        .humid = gpio_get_level(PIN_HUMIDIFICADOR), .phase_id = fase_id,
+    };
+    if (!report_should_send(&muestra, t_us)) return;
+
+    uint8_t payload[TELEMETRY_MAX_LEN];
+    int len = TELEMETRY_MQTT_ENCODER.encode(&muestra, payload, sizeof(payload));
+    if (len > 0) mqtt_outbox_push(OUTBOX_TELEMETRY, (const char *)payload, len);
+    trace_end(TRACE_SAMPLE_AGE, t_us);
+}
+
+void send_trace_thingsboard(void) {
+    if (!mqtt_connected) return;
+    static char trace_json[1024];   // Fuera de la pila de la tarea principal
+    int len = snprintf(trace_json, sizeof(trace_json), "{\"trace\":");
+    int n = trace_format_json(trace_json + len, sizeof(trace_json) - len - 1);
+    if (n < 0) return;
+    len += n;
+    // Métrica del envío por excepción junto al resto de diagnósticos
+    report_stats_t rep;
+    report_get_stats(&rep);
+    // Se llama desde app_main: el mínimo histórico de pila libre de la tarea principal
+    UBaseType_t stack_free = uxTaskGetStackHighWaterMark(NULL);
+    if (stack_free < MAIN_STACK_WARN) ESP_LOGW(TAG, "Pila de app_main casi agotada: %u bytes libres", (unsigned)stack_free);
+    n = snprintf(trace_json + len, sizeof(trace_json) - len,
+                 ",\"report_suppressed_pct\":%.1f,\"main_stack_free\":%u,\"i2c\":",
+                 report_suppression_pct(&rep), (unsigned)stack_free);
+    if (n >= (int)(sizeof(trace_json) - len)) return;
+    len += n;
+    // Transacciones, fusiones, errores y latencia por dispositivo del bus
+    n = i2c_bus_format_json(trace_json + len, sizeof(trace_json) - len - 1);
+    if (n < 0) return;
+    len += n;
+    trace_json[len++] = '}';
+    esp_mqtt_client_publish(mqtt_client, "v1/devices/me/telemetry", trace_json, len, 0, 0);
 }
 
 void telegram_send_message_to(const char *chat_id, const char *text) {
@@ -392,10 +360,7 @@ void telegram_send_message_to(const char *chat_id, const char *text) {
 void ota_task(void *pvParameter) {
     ESP_LOGI(TAG, "Iniciando OTA desde: %s", OTA_URL);
     
-    if (oled_detectada) {
-        ssd1306_clear_screen(&oled, false);
-        ssd1306_display_text(&oled, 0, "ACTUALIZANDO...", 13, false);
-    }
+    display_message("ACTUALIZANDO...", NULL, NULL);
 
     esp_http_client_config_t config = {
         .url = OTA_URL,
@@ -415,13 +380,23 @@ void ota_task(void *pvParameter) {
         esp_restart();
     } else {
         ESP_LOGE(TAG, "Fallo OTA");
-        if (oled_detectada) {
-            ssd1306_display_text(&oled, 2, "Error OTA", 9, false);
-        }
+        display_message("ACTUALIZANDO...", "Error OTA", NULL);
     }
     vTaskDelete(NULL);
 }
 
+// Las forzadas de seguridad mandan sobre el control automático y sobre las órdenes
+// manuales. Se aplican antes de escribir: cada pin cambia una sola vez por vuelta
+static void set_ventilador(int nivel) {
+    if (alarms_overrides() & ALARM_ACT_FAN_ON) nivel = 1;
+    gpio_set_level(PIN_VENTILADOR, nivel);
+}
+
+static void set_humidificador(int nivel) {
+    if (alarms_overrides() & ALARM_ACT_HUMID_OFF) nivel = 0;
+    gpio_set_level(PIN_HUMIDIFICADOR, nivel);
+}
+
 static void telegram_check_updates(void) {
     EventBits_t bits = xEventGroupGetBits(s_wifi_event_group);
     if (!(bits & WIFI_CONNECTED_BIT)) return;
@@ -476,12 +451,14 @@ static void telegram_check_updates(void) {
                                             telegram_send_message_to(chat_id_str, resp);
                                         }
                                         else if (strcmp(text->valuestring, "/germinacion") == 0) {
+                                            recipe_stop();
                                             fase_actual = &fase_germinacion;
                                             modo_automatico = true;
                                             guardar_cambios = true; 
                                             telegram_send_message_to(chat_id_str, "✅ Fase: GERMINACION (Auto).");
                                         }
                                         else if (strcmp(text->valuestring, "/fructificacion") == 0) {
+                                            recipe_stop();
                                             fase_actual = &fase_fructificacion;
                                             modo_automatico = true;
                                             guardar_cambios = true; 
@@ -499,25 +476,25 @@ static void telegram_check_updates(void) {
                                         }
                                         else if (strcmp(text->valuestring, "/encender_ventilador") == 0) {
                                             modo_automatico = false;
-                                            gpio_set_level(PIN_VENTILADOR, 1);
+                                            set_ventilador(1);
                                             guardar_cambios = true; 
                                             telegram_send_message_to(chat_id_str, "Ventilador ON (Manual).");
                                         } 
                                         else if (strcmp(text->valuestring, "/apagar_ventilador") == 0) {
                                             modo_automatico = false;
-                                            gpio_set_level(PIN_VENTILADOR, 0);
+                                            set_ventilador(0);
                                             guardar_cambios = true; 
                                             telegram_send_message_to(chat_id_str, "Ventilador OFF (Manual).");
                                         }
                                         else if (strcmp(text->valuestring, "/encender_humidificador") == 0) {
                                             modo_automatico = false;
-                                            gpio_set_level(PIN_HUMIDIFICADOR, 1);
+                                            set_humidificador(1);
                                             guardar_cambios = true; 
                                             telegram_send_message_to(chat_id_str, "Humidificador ON (Manual).");
                                         } 
                                         else if (strcmp(text->valuestring, "/apagar_humidificador") == 0) {
                                             modo_automatico = false;
-                                            gpio_set_level(PIN_HUMIDIFICADOR, 0);
+                                            set_humidificador(0);
                                             guardar_cambios = true; 
                                             telegram_send_message_to(chat_id_str, "Humidificador OFF (Manual).");
                                         }
@@ -544,28 +521,66 @@ static void telegram_check_updates(void) {
     esp_http_client_cleanup(client);
 }
 
+// Los avisos salen de aquí y no del bucle de control: el POST HTTPS bloquea segundos
+static void telegram_send_alarms(void) {
+    alarm_event_t ev;
+    char msg[128];
+    while (xQueueReceive(s_cola_alarmas, &ev, 0) == pdTRUE) {
+        if (alarms_format_text(&ev, msg, sizeof(msg)) > 0) telegram_send_message_to(TELEGRAM_CHAT_ID, msg);
+    }
+}
+
 static void telegram_task(void *pvParameters) {
     while (1) {
         telegram_check_updates();
+        telegram_send_alarms();
         vTaskDelay(pdMS_TO_TICKS(4000)); 
     }
 }
 
-void check_auto_control(float temp, float hum) {
+// Arranca MQTT, Telegram y el servidor local la primera vez que hay IP
+static void start_online_services(void) {
+    static bool started = false;
+    if (started) return;
+    started = true;
+
+    ESP_LOGI(TAG, "✅ WiFi Conectado.");
+    time_sync_start(SNTP_SERVER);
+    mqtt_app_start();
+    if (!provisioning_active()) web_server_start();
+    
+    char msg_inicio[128];
+	snprintf(msg_inicio, 128, "Sistema Online %s.\n%s | %s", 
+		 APP_VERSION, fase_actual->nombre, modo_automatico ? "AUTO" : "MANUAL");
+    telegram_send_message_to(TELEGRAM_CHAT_ID, msg_inicio);
+    
+    xTaskCreate(telegram_task, "telegram_task", 8192, NULL, 5, NULL);
+}
+
+// iaq puede ser NULL si todavía no hay un índice fiable
+void check_auto_control(float temp, float hum, const psychro_t *psy, const iaq_result_t *iaq) {
     if (!modo_automatico) return; 
 
-    if (temp > fase_actual->temp_max) {
-        gpio_set_level(PIN_VENTILADOR, 1);
+    // El ventilador se enciende por calor o por aire viciado y solo se apaga
+    // cuando ambas condiciones han vuelto por debajo de su histéresis
+    bool aire_viciado = iaq && iaq->iaq > fase_actual->iaq_max;
+    bool aire_limpio = !iaq || iaq->iaq < (fase_actual->iaq_max - IAQ_FAN_HISTERESIS);
+
+    if (temp > fase_actual->temp_max || aire_viciado) {
+        set_ventilador(1);
     }
-    else if (temp < (fase_actual->temp_max - 0.5)) {
-        gpio_set_level(PIN_VENTILADOR, 0);
+    else if (temp < (fase_actual->temp_max - 0.5) && aire_limpio) {
+        set_ventilador(0);
     }
 
-    if (hum < fase_actual->hum_min) {
-        gpio_set_level(PIN_HUMIDIFICADOR, 1);
+    // Cerca del punto de rocío se condensaría agua sobre el sustrato y las paredes
+    bool riesgo_condensacion = (temp - psy->dew_point) < CONDENSACION_MARGEN_C;
+
+    if (hum < fase_actual->hum_min && !riesgo_condensacion) {
+        set_humidificador(1);
     }
-    else if (hum > (fase_actual->hum_min + 3.0)) {
-        gpio_set_level(PIN_HUMIDIFICADOR, 0);
+    else if (hum > (fase_actual->hum_min + 3.0) || riesgo_condensacion) {
+        set_humidificador(0);
     }
 }
 
@@ -578,6 +593,9 @@ void app_main(void) {
         err = nvs_flash_init();
     }
     ESP_ERROR_CHECK(err);
+    if (mqtt_outbox_init() != ESP_OK) {
+        ESP_LOGW(TAG, "Bandeja MQTT sin persistencia: lo pendiente se pierde al reiniciar");
+    }
     ESP_ERROR_CHECK(esp_netif_init());
     ESP_ERROR_CHECK(esp_event_loop_create_default());
 	
@@ -586,79 +604,107 @@ void app_main(void) {
     init_oled_device();  
 
     bool boton_pulsado = (gpio_get_level(PIN_BOTON) == BOTON_PULSADO_ES);
-    bool wifi_guardado = (load_wifi_credentials() == ESP_OK);
-
-    if (boton_pulsado || !wifi_guardado) {
-        ESP_LOGW(TAG, "Entrando en MODO CONFIGURACION (AP)");
-        start_ap_mode(); 
-    }
+    s_wifi_event_group = xEventGroupCreate();
+    s_cola_alarmas = xQueueCreate(ALARMAS_COLA, sizeof(alarm_event_t));
+    wifi_manager_init(s_wifi_event_group, WIFI_CONNECTED_BIT);
+    bool modo_config = boton_pulsado || !wifi_manager_has_credentials();
 
     esp_ota_mark_app_valid_cancel_rollback(); 
     cargar_estado_nvs(); 
+    time_sync_init(ZONA_HORARIA);
+    recipe_init();
+    iaq_init();
 
-    if (!init_bme_device()) {
-        if(oled_detectada) ssd1306_display_text(&oled, 0, "Error Sensor", 12, false);
-        ESP_LOGE(TAG, "Error BME680 no encontrado");
-    }
-    
-    bme.intf = BME68X_I2C_INTF; bme.read = bme_i2c_read; bme.write = bme_i2c_write;
-    bme.delay_us = bme_delay_us; bme.intf_ptr = &bme_dev_handle; bme.amb_temp = 25;
-    bme68x_init(&bme);
-    struct bme68x_conf conf = { .filter = BME68X_FILTER_OFF, .odr = BME68X_ODR_NONE, .os_hum = BME68X_OS_16X, .os_pres = BME68X_OS_1X, .os_temp = BME68X_OS_2X };
-    bme68x_set_conf(&conf, &bme);
-    struct bme68x_heatr_conf heatr_conf = { .enable = BME68X_ENABLE, .heatr_temp = 300, .heatr_dur = 100 };
-    bme68x_set_heatr_conf(BME68X_FORCED_MODE, &heatr_conf, &bme);
-
-    if (oled_detectada) {
-        ssd1306_clear_screen(&oled, false);
-        ssd1306_display_text(&oled, 0, "Conectando...", 13, false);
+    // Sin sensor se sigue arrancando: el supervisor lo busca en segundo plano
+    if (!sensor_init()) {
+        display_message("Error Sensor", NULL, NULL);
     }
-    
-    wifi_init_sta(); 
 
-    EventBits_t bits = xEventGroupWaitBits(s_wifi_event_group, WIFI_CONNECTED_BIT, pdFALSE, pdFALSE, pdMS_TO_TICKS(15000));
-    
-    if (bits & WIFI_CONNECTED_BIT) {
-        ESP_LOGI(TAG, "✅ WiFi Conectado.");
-        mqtt_app_start();
+    if (modo_config) {
+        // El portal corre en segundo plano: sensado y control siguen activos
+        ESP_LOGW(TAG, "Entrando en MODO CONFIGURACION (AP)");
+        display_message("MODO CONFIG", "WIFI: ESP32-SBC", "IP: 192.168.4.1");
+        provisioning_start(s_wifi_event_group, WIFI_CONNECTED_BIT);
+    } else {
+        display_message("Conectando...", NULL, NULL);
         
-        char msg_inicio[128];
-		snprintf(msg_inicio, 128, "Sistema Online %s.\n%s | %s", 
-			 APP_VERSION, fase_actual->nombre, modo_automatico ? "AUTO" : "MANUAL");
-        telegram_send_message_to(TELEGRAM_CHAT_ID, msg_inicio);
+        wifi_manager_start(); 
+
+        EventBits_t bits = xEventGroupWaitBits(s_wifi_event_group, WIFI_CONNECTED_BIT, pdFALSE, pdFALSE, pdMS_TO_TICKS(15000));
         
-        xTaskCreate(telegram_task, "telegram_task", 8192, NULL, 5, NULL);
-    } else {
-        ESP_LOGW(TAG, "⚠️ Offline (Timeout).");
-        if (oled_detectada) ssd1306_display_text(&oled, 0, "Modo Offline", 12, false);
-        vTaskDelay(pdMS_TO_TICKS(2000));
+        if (bits & WIFI_CONNECTED_BIT) {
+            start_online_services();
+        } else {
+            ESP_LOGW(TAG, "⚠️ Offline (Timeout).");
+            display_message("Modo Offline", NULL, NULL);
+            vTaskDelay(pdMS_TO_TICKS(2000));
+        }
     }
 
     struct bme68x_data data;
-    uint32_t del_period;
-    uint8_t n_fields;
+    bool lectura_ok = false;
+    bool prev_sensor_perdido = (sensor_state() == SENSOR_LOST);
     
     int tick_counter = 0;       
-    int timer_pantalla = 0;     
+    int trace_counter = 0;
+    int timer_pantalla = modo_config ? 600 : 0; // En configuración la pantalla muestra las instrucciones
     bool pantalla_fisica_encendida = true; 
+    int vista = VISTA_ESTADO;
+    bool boton_previo = false;
+    int64_t last_t_us = 0;      // Instante de adquisición de la última lectura
     float last_temp = 0.0;
     float last_hum = 0.0;
-
-    if (oled_detectada) {
-        ssd1306_clear_screen(&oled, false);
-        oled_set_power(false);
+    float last_press = 0.0;
+    float last_gas = 0.0;
+    int last_iaq = -1;
+    psychro_t last_psy = {0};
+    bool aviso_atascado = false;
+
+    filter_init(&filtro_temp, &filtro_cfg_temp);
+    filter_init(&filtro_hum, &filtro_cfg_hum);
+    filter_init(&filtro_press, &filtro_cfg_press);
+    filter_init(&filtro_gas, &filtro_cfg_gas);
+    int prev_fan = -1;
+    int prev_humid = -1;
+    int prev_auto = -1;
+    int prev_fase = -1;
+    static char live_json[LIVE_MSG_MAX];    // Buffers del bucle fuera de la pila de la tarea principal
+
+    if (oled_detectada && !modo_config) {
+        display_off();
         pantalla_fisica_encendida = false;
     }
 
     while (1) {
+        int64_t t_loop = trace_begin();
         bool despertar_y_leer = false;
         bool refresco_segundo = false;
         bool enviar_nube = false;
+        bool muestra_nueva = false;
 
-        if (gpio_get_level(PIN_BOTON) == BOTON_PULSADO_ES) {
+        bool redibujar = false;
+
+        // La primera pulsación enciende la pantalla; con ella encendida, pasa a la vista siguiente
+        // (estado, gráficas y alarmas si hay alguna activa)
+        bool boton = (gpio_get_level(PIN_BOTON) == BOTON_PULSADO_ES);
+        if (boton) {
             if (timer_pantalla == 0) despertar_y_leer = true;
+            else if (!boton_previo) {
+                vista = (vista + 1) % VISTA_N;
+                alarm_stats_t st_alarmas;
+                alarms_get_stats(&st_alarmas);
+                if (vista == VISTA_ALARMAS && !st_alarmas.active) vista = VISTA_ESTADO;
+                redibujar = true;
+            }
             timer_pantalla = 100; 
         }
+        boton_previo = boton;
+
+        // Conexión tardía (portal de configuración o timeout inicial)
+        if (xEventGroupGetBits(s_wifi_event_group) & WIFI_CONNECTED_BIT) {
+            start_online_services();
+            if (!provisioning_active()) web_server_start();
+        }
 
         tick_counter++;
         if (tick_counter >= 50) { 
@@ -671,17 +717,50 @@ void app_main(void) {
         }
 
         if (despertar_y_leer || refresco_segundo || (enviar_nube && timer_pantalla > 0)) {
-            bme68x_set_op_mode(BME68X_FORCED_MODE, &bme);
-            del_period = bme68x_get_meas_dur(BME68X_FORCED_MODE, &conf, &bme) + (heatr_conf.heatr_dur * 1000);
-            bme.delay_us(del_period, bme.intf_ptr);
-            bme68x_get_data(BME68X_FORCED_MODE, &data, &n_fields, &bme);
+            int64_t t_sensor = trace_begin();
+            lectura_ok = sensor_read(&data, t_sensor);
+            trace_end(TRACE_SENSOR, t_sensor);
             
-            if (n_fields) {
-                last_temp = data.temperature;
-                last_hum = data.humidity;
-                
-                check_auto_control(last_temp, last_hum);
+            if (lectura_ok) {
+                muestra_nueva = true;
+                last_t_us = time_now_us();
+                int64_t t_control = trace_begin();
+                recipe_tick();
+                filter_status_t st_temp, st_hum;
+                last_temp = filter_update(&filtro_temp, data.temperature, last_t_us, &st_temp);
+                last_hum = filter_update(&filtro_hum, data.humidity, last_t_us, &st_hum);
+                last_press = filter_update(&filtro_press, data.pressure / 100.0f, last_t_us, NULL);
+                // El gas solo vale con el calentador estable
+                bool gas_ok = (data.status & BME68X_GASM_VALID_MSK) && (data.status & BME68X_HEAT_STAB_MSK);
+                iaq_result_t iaq;
+                bool iaq_ok = false;
+                if (gas_ok) {
+                    last_gas = filter_update(&filtro_gas, data.gas_resistance, last_t_us, NULL);
+                    iaq_ok = iaq_update(last_gas, last_hum, last_t_us, &iaq);
+                }
+                if (iaq_ok) last_iaq = (int)(iaq.iaq + 0.5f);
+                psychro_compute(last_temp, last_hum, &last_psy);
+
+                // Con el sensor congelado no se mueven los relés a partir de un valor viejo
+                bool atascado = (st_temp == FILTER_STUCK || st_hum == FILTER_STUCK);
+                if (atascado != aviso_atascado) {
+                    if (atascado) {
+                        ESP_LOGW(TAG, "Lecturas T/H congeladas, control automático en pausa");
+                        sensor_force_recovery(last_t_us);
+                    }
+                    aviso_atascado = atascado;
+                }
+                if (!atascado) check_auto_control(last_temp, last_hum, &last_psy,
+                                                  (iaq_ok && iaq.accuracy == IAQ_ACC_STABLE) ? &iaq : NULL);
+                trace_end(TRACE_CONTROL, t_control);
                 
+                snprintf(live_json, sizeof(live_json),
+                    "{\"type\":\"sample\",\"ts\":%lld,\"temperature\":%.2f,\"humidity\":%.2f,\"pressure\":%.1f,\"gas\":%.0f,\"iaq\":%d,"
+                    "\"dew_point\":%.2f,\"vpd\":%.2f,\"abs_hum\":%.2f}",
+                    (long long)time_epoch_ms(last_t_us), last_temp, last_hum, last_press, last_gas, last_iaq,
+                    last_psy.dew_point, last_psy.vpd, last_psy.abs_hum);
+                live_stream_publish(live_json);
+
                 ESP_LOGI(TAG, "T: %.2f | H: %.2f | Mode: %s | F: %d | H: %d", 
                          last_temp, last_hum, 
                          modo_automatico ? "A" : "M", 
@@ -690,58 +769,152 @@ void app_main(void) {
             }
         }
 
+        // Recuperación del sensor en segundo plano y modo degradado sin él
+        int64_t t_ahora = time_now_us();
+        sensor_service(t_ahora);
+        if (modo_automatico && sensor_fallback_active(t_ahora)) {
+            bool fan_fb, humid_fb;
+            sensor_fallback_outputs(t_ahora, &fan_fb, &humid_fb);
+            set_ventilador(fan_fb);
+            set_humidificador(humid_fb);
+        }
+        // Solo se publica al perderlo o recuperarlo: un fallo suelto no genera tráfico
+        bool sensor_perdido = (sensor_state() == SENSOR_LOST);
+        if (sensor_perdido != prev_sensor_perdido) {
+            int len = sensor_format_health_json(live_json, sizeof(live_json), t_ahora);
+            if (len > 0 && len < (int)sizeof(live_json)) mqtt_outbox_push(OUTBOX_TELEMETRY, live_json, len);
+            prev_sensor_perdido = sensor_perdido;
+        }
+
+        // Alarmas con cada muestra y al menos una vez por segundo, para notar que faltan
+        if (muestra_nueva || tick_counter % 10 == 0) {
+            alarm_inputs_t entradas = {
+                .sample_us = last_t_us, .temp = last_temp, .hum = last_hum,
+                .dew_margin = last_temp - last_psy.dew_point, .iaq = last_iaq,
+                .fan = gpio_get_level(PIN_VENTILADOR), .humid = gpio_get_level(PIN_HUMIDIFICADOR),
+            };
+            static alarm_event_t eventos[ALARM_MAX_EVENTS];
+            int n_eventos = alarms_evaluate(&entradas, t_ahora, eventos, ALARM_MAX_EVENTS);
+            for (int i = 0; i < n_eventos; i++) {
+                if (eventos[i].actions & ALARM_ACT_MQTT) {
+                    int len = alarms_format_json(&eventos[i], live_json, sizeof(live_json));
+                    if (len > 0 && len < (int)sizeof(live_json)) mqtt_outbox_push(OUTBOX_TELEMETRY, live_json, len);
+                }
+                if (eventos[i].actions & ALARM_ACT_TELEGRAM) xQueueSend(s_cola_alarmas, &eventos[i], 0);
+            }
+        }
+        // Alarma recién disparada en esta vuelta: solo se toca el pin si cambia
+        uint8_t forzado = alarms_overrides();
+        if ((forzado & ALARM_ACT_HUMID_OFF) && gpio_get_level(PIN_HUMIDIFICADOR)) gpio_set_level(PIN_HUMIDIFICADOR, 0);
+        if ((forzado & ALARM_ACT_FAN_ON) && !gpio_get_level(PIN_VENTILADOR)) gpio_set_level(PIN_VENTILADOR, 1);
+
+        // Cualquier cambio de actuadores (auto, Telegram o web) se empuja al momento
+        int fan_now = gpio_get_level(PIN_VENTILADOR);
+        int humid_now = gpio_get_level(PIN_HUMIDIFICADOR);
+        int64_t t_evento = time_now_us();
+        if (fan_now != prev_fan || humid_now != prev_humid) {
+            snprintf(live_json, sizeof(live_json),
+                "{\"type\":\"actuators\",\"ts\":%lld,\"fan\":%d,\"humid\":%d,\"auto\":%s}",
+                (long long)time_epoch_ms(t_evento), fan_now, humid_now, modo_automatico ? "true" : "false");
+            live_stream_publish(live_json);
+        }
+        // Los cambios de estado también van a ThingsBoard, aunque no haya conexión
+        int fase_now = fase_id_actual();
+        if (fan_now != prev_fan || humid_now != prev_humid ||
+            modo_automatico != prev_auto || fase_now != prev_fase) {
+            int64_t ts = time_epoch_ms(t_evento);
+            int len = ts ? snprintf(live_json, sizeof(live_json),
+                               "{\"ts\":%lld,\"values\":{\"fan\":%d,\"humid\":%d,\"auto\":%d,\"phase_id\":%d}}",
+                               (long long)ts, fan_now, humid_now, modo_automatico, fase_now)
+                         : snprintf(live_json, sizeof(live_json),
+                               "{\"fan\":%d,\"humid\":%d,\"auto\":%d,\"phase_id\":%d}",
+                               fan_now, humid_now, modo_automatico, fase_now);
+            if (prev_fan != -1) mqtt_outbox_push(OUTBOX_TELEMETRY, live_json, len);
+            prev_fan = fan_now;
+            prev_humid = humid_now;
+            prev_auto = modo_automatico;
+            prev_fase = fase_now;
+        }
+
         if (timer_pantalla > 0) {
             timer_pantalla--;
             if (!pantalla_fisica_encendida) {
-                oled_set_power(true); 
-                vTaskDelay(pdMS_TO_TICKS(10)); 
                 pantalla_fisica_encendida = true;
                 despertar_y_leer = true; 
             }
 
-            if (oled_detectada && (despertar_y_leer || refresco_segundo)) {
-                char linea[20];
-                ssd1306_clear_screen(&oled, false);
-                sprintf(linea, "%s %s", modo_automatico ? "AUTO" : "MAN", mqtt_connected ? "*" : ".");
-                ssd1306_display_text(&oled, 0, linea, strlen(linea), false);
-                sprintf(linea, "T: %.1fC H: %.0f%%", last_temp, last_hum);
-                ssd1306_display_text(&oled, 2, linea, strlen(linea), false);
-                ssd1306_display_text(&oled, 4, fase_actual->nombre, strlen(fase_actual->nombre), false);
-                sprintf(linea, "V:%d H:%d", gpio_get_level(PIN_VENTILADOR), gpio_get_level(PIN_HUMIDIFICADOR));
-                ssd1306_display_text(&oled, 6, linea, strlen(linea), false);
+            // Solo se publica el modelo; la tarea de pantalla dibuja y hace el I2C
+            if (oled_detectada && (despertar_y_leer || refresco_segundo || redibujar)) {
+                static display_model_t pantalla;
+                display_model_init(&pantalla);
+                alarm_stats_t st_alarmas;
+                alarms_get_stats(&st_alarmas);
+                if (vista == VISTA_ALARMAS && st_alarmas.active) {
+                    // Lista estática: la desplaza el propio panel, sin tráfico mientras no cambie
+                    int n = 0;
+                    for (int i = 0; i < alarms_rule_count(); i++) {
+                        if (!(st_alarmas.active & (1u << i))) continue;
+                        if (n < 5) {
+                            display_model_line(&pantalla, 2 + n, "%s", alarms_rule(i)->text);
+                            display_model_style(&pantalla, 2 + n, DISPLAY_FONT_SMALL, SSD1306_ALIGN_LEFT);
+                        }
+                        n++;
+                    }
+                    display_model_line(&pantalla, 0, "ALARMAS: %d", n);
+                    display_model_marquee(&pantalla, 2, n < 5 ? n : 5);
+                } else if (vista == VISTA_GRAFICAS) {
+                    // Tendencia del histórico (~30 min), media pantalla cada una: en el
+                    // panel de 64 T en páginas 1-3 y H en 5-7, en el de 32 en 1 y 3
+                    int mitad = display_pages() / 2;
+                    display_model_line(&pantalla, 0, "T %.1fC", last_temp);
+                    display_model_chart(&pantalla, 0, HISTORY_TEMP, 1, mitad - 1, 100, 100, 1);
+                    display_model_line(&pantalla, mitad, "H %.0f%%", last_hum);
+                    display_model_chart(&pantalla, 1, HISTORY_HUM, mitad + 1, mitad - 1, 500, 100, 0);
+                } else {
+                    display_model_line(&pantalla, 0, "%s %s", modo_automatico ? "AUTO" : "MAN",
+                                       provisioning_active() ? "CFG" : (mqtt_connected ? "*" : "."));
+                    // Temperatura en grande (páginas 1-3), el resto proporcional y centrado
+                    display_model_line(&pantalla, 1, "%.1f°", last_temp);
+                    display_model_style(&pantalla, 1, DISPLAY_FONT_LARGE, SSD1306_ALIGN_CENTER);
+                    display_model_line(&pantalla, 4, "HR %.0f%% VPD %.2f", last_hum, last_psy.vpd);
+                    display_model_line(&pantalla, 5, "Rocío %.1f°C", last_psy.dew_point);
+                    display_model_line(&pantalla, 6, "%s", fase_actual->nombre);
+                    display_model_line(&pantalla, 7, "Vent %d  Humid %d", gpio_get_level(PIN_VENTILADOR), gpio_get_level(PIN_HUMIDIFICADOR));
+                    for (int p = 4; p < DISPLAY_LINES; p++) display_model_style(&pantalla, p, DISPLAY_FONT_SMALL, SSD1306_ALIGN_CENTER);
+                }
+                display_submit(&pantalla);
             }
         } 
         else {
             if (pantalla_fisica_encendida) {
-                if (oled_detectada) ssd1306_clear_screen(&oled, false);
-                oled_set_power(false);
+                display_off();
                 pantalla_fisica_encendida = false;
+                vista = VISTA_ESTADO;
             }
         }
 
-        if (enviar_nube && mqtt_connected && n_fields) {
-            send_telemetry_thingsboard(last_temp, last_hum, data.pressure/100.0, data.gas_resistance);
+        if (enviar_nube && lectura_ok) {
+            history_sample_t muestra = {
+                .t_us = last_t_us,
+                .temperature = last_temp, .humidity = last_hum,
+                .pressure = last_press, .gas = last_gas,
+                .fan = gpio_get_level(PIN_VENTILADOR), .humid = gpio_get_level(PIN_HUMIDIFICADOR),
+            };
+            history_push(&muestra);
+        }
+
+        if (enviar_nube && lectura_ok) {
+            int64_t t_telemetry = trace_begin();
+            send_telemetry_thingsboard(last_t_us, last_temp, last_hum, last_press, last_gas, last_iaq);
+            trace_end(TRACE_TELEMETRY, t_telemetry);
+
+            if (++trace_counter >= TRACE_PUBLISH_EVERY) {
+                send_trace_thingsboard();
+                trace_counter = 0;
+            }
         }
 
+        trace_end(TRACE_LOOP, t_loop);
         vTaskDelay(pdMS_TO_TICKS(100)); 
     }
 }
-
-int8_t bme_i2c_read(uint8_t reg_addr, uint8_t *reg_data, uint32_t len, void *intf_ptr) {
-    i2c_master_dev_handle_t handle = *(i2c_master_dev_handle_t*)intf_ptr;
-    esp_err_t err = i2c_master_transmit_receive(handle, &reg_addr, 1, reg_data, len, -1);
-    return (err == ESP_OK) ? BME68X_OK : BME68X_E_COM_FAIL;
-}
-int8_t bme_i2c_write(uint8_t reg_addr, const uint8_t *reg_data, uint32_t len, void *intf_ptr) {
-    i2c_master_dev_handle_t handle = *(i2c_master_dev_handle_t*)intf_ptr;
-    uint8_t *buffer = malloc(len + 1);
-    if (!buffer) return BME68X_E_NULL_PTR;
-    buffer[0] = reg_addr; memcpy(buffer + 1, reg_data, len);
-    esp_err_t err = i2c_master_transmit(handle, buffer, len + 1, -1);
-    free(buffer);
-    return (err == ESP_OK) ? BME68X_OK : BME68X_E_COM_FAIL;
-}
-void bme_delay_us(uint32_t period, void *intf_ptr) {
-    if (period >= 10000) vTaskDelay(pdMS_TO_TICKS(period / 1000));
-    else ets_delay_us(period); 
-}
\ No newline at end of file
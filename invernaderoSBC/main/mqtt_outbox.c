@@ -0,0 +1,361 @@
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "esp_partition.h"
+#include "esp_rom_crc.h"
+#include "mqtt_client.h"
+
+#include "mqtt_outbox.h"
+
+#define TAG "MQTT_OUTBOX"
+
+#define OUTBOX_PART_LABEL   "outbox"
+#define OUTBOX_PART_SUBTYPE 0x40
+#define OUTBOX_SECTOR       4096
+#define OUTBOX_INFLIGHT     4       // Publicaciones QoS 1 sin PUBACK a la vez
+
+// Estados del registro: solo se pasan bits de 1 a 0, sin borrar el sector
+#define REC_ERASED          0xFF
+#define REC_VALID           0xFE
+#define REC_ACKED           0xFC
+
+typedef struct {
+    uint8_t state;
+    uint8_t topic;
+    uint16_t len;
+    uint32_t seq;
+    uint32_t crc;           // CRC32 de topic/len/seq + payload
+} rec_hdr_t;
+
+typedef struct {
+    int msg_id;             // 0 = libre
+    uint32_t off;
+    uint32_t seq;
+} inflight_t;
+
+static const char *s_topics[OUTBOX_TOPIC_COUNT] = {
+    [OUTBOX_TELEMETRY] = "v1/devices/me/telemetry",
+    [OUTBOX_ATTRIBUTES] = "v1/devices/me/attributes",
+};
+
+static const esp_partition_t *s_part = NULL;
+static SemaphoreHandle_t s_lock = NULL;
+static esp_mqtt_client_handle_t s_client = NULL;
+static bool s_online = false;
+static bool s_pump_requested = false;   // Evento de usuario en camino a la tarea MQTT
+
+static uint32_t s_sectors = 0;
+static uint32_t s_head = 0;         // Siguiente escritura
+static bool s_head_needs_erase = false;
+static uint32_t s_tail = 0;         // Registro pendiente más antiguo (== s_head si no hay)
+static uint32_t s_send = 0;         // Siguiente registro a publicar en esta conexión
+static uint32_t s_seq = 0;
+static inflight_t s_inflight[OUTBOX_INFLIGHT];
+static mqtt_outbox_stats_t s_stats;
+
+static uint8_t s_buf[(sizeof(rec_hdr_t) + OUTBOX_MAX_PAYLOAD + 3) & ~3];
+
+static inline uint32_t rec_size(uint16_t len) {
+    return (sizeof(rec_hdr_t) + len + 3) & ~3u;
+}
+
+static inline uint32_t sector_start(uint32_t off) {
+    return off - (off % OUTBOX_SECTOR);
+}
+
+static inline uint32_t next_sector(uint32_t off) {
+    uint32_t s = off / OUTBOX_SECTOR + 1;
+    return (s >= s_sectors) ? 0 : s * OUTBOX_SECTOR;
+}
+
+static uint32_t rec_crc(const rec_hdr_t *h, const uint8_t *payload) {
+    uint32_t crc = esp_rom_crc32_le(0, (const uint8_t *)h + 1, 7);
+    return esp_rom_crc32_le(crc, payload, h->len);
+}
+
+// Lee y valida el registro en off. Devuelve false si está borrado, corrupto o no cabe.
+static bool rec_read(uint32_t off, rec_hdr_t *h, bool with_payload) {
+    uint32_t end = sector_start(off) + OUTBOX_SECTOR;
+    if (off + sizeof(rec_hdr_t) > end) return false;
+    if (esp_partition_read(s_part, off, h, sizeof(*h)) != ESP_OK) return false;
+    if (h->state == REC_ERASED || h->len > OUTBOX_MAX_PAYLOAD || off + rec_size(h->len) > end) return false;
+    if (!with_payload) return true;
+    if (esp_partition_read(s_part, off + sizeof(*h), s_buf, h->len) != ESP_OK) return false;
+    return rec_crc(h, s_buf) == h->crc;
+}
+
+// Primer registro pendiente a partir de off (o s_head si no hay ninguno)
+static uint32_t find_next_valid(uint32_t off) {
+    uint32_t guard = s_sectors * (OUTBOX_SECTOR / sizeof(rec_hdr_t)) + s_sectors;
+    while (off != s_head && guard--) {
+        rec_hdr_t h;
+        if (!rec_read(off, &h, false)) {
+            off = next_sector(off);
+            continue;
+        }
+        if (h.state == REC_VALID) return off;
+        off += rec_size(h.len);
+        if (off % OUTBOX_SECTOR == 0 && off / OUTBOX_SECTOR >= s_sectors) off = 0;
+    }
+    return s_head;
+}
+
+// Borra el sector donde va a escribir la cabeza, descartando lo pendiente que quede en él
+static void erase_head_sector(void) {
+    uint32_t start = sector_start(s_head);
+    uint32_t evicted = 0;
+    for (uint32_t off = start; off < start + OUTBOX_SECTOR;) {
+        rec_hdr_t h;
+        if (!rec_read(off, &h, false)) break;
+        if (h.state == REC_VALID) evicted++;
+        off += rec_size(h.len);
+    }
+    esp_partition_erase_range(s_part, start, OUTBOX_SECTOR);
+    s_head_needs_erase = false;
+
+    if (evicted) {
+        s_stats.evicted += evicted;
+        s_stats.pending -= (evicted > s_stats.pending) ? s_stats.pending : evicted;
+        ESP_LOGW(TAG, "Outbox lleno: %lu mensajes antiguos descartados", (unsigned long)evicted);
+    }
+    // Si la cola o el cursor de envío estaban en el sector borrado, saltan al siguiente
+    uint32_t after = next_sector(start);
+    if (sector_start(s_tail) == start && s_tail != s_head) s_tail = find_next_valid(after);
+    if (sector_start(s_send) == start && s_send != s_head) s_send = find_next_valid(after);
+}
+
+static void recover(void) {
+    bool any = false;
+    bool head_sector_dirty = false;
+    uint32_t min_valid_seq = UINT32_MAX;
+    s_tail = UINT32_MAX;
+    memset(&s_stats, 0, sizeof(s_stats));
+
+    for (uint32_t sec = 0; sec < s_sectors; sec++) {
+        uint32_t off = sec * OUTBOX_SECTOR;
+        bool dirty = false;
+        while (off < (sec + 1) * OUTBOX_SECTOR) {
+            rec_hdr_t h;
+            if (!rec_read(off, &h, true)) {
+                // Escritura interrumpida: el resto del sector no es utilizable
+                uint8_t st = REC_ERASED;
+                esp_partition_read(s_part, off, &st, 1);
+                dirty = (st != REC_ERASED);
+                break;
+            }
+            if (h.state == REC_VALID) {
+                s_stats.pending++;
+                if (h.seq < min_valid_seq) {
+                    min_valid_seq = h.seq;
+                    s_tail = off;
+                }
+            }
+            if (!any || h.seq >= s_seq) {
+                s_seq = h.seq;
+                s_head = off + rec_size(h.len);
+                head_sector_dirty = false;
+                any = true;
+            }
+            off += rec_size(h.len);
+        }
+        if (dirty && any && sector_start(s_head) == sec * OUTBOX_SECTOR) head_sector_dirty = true;
+    }
+
+    if (!any) {
+        s_head = 0;
+        s_head_needs_erase = true;
+    } else if (head_sector_dirty || s_head % OUTBOX_SECTOR == 0) {
+        s_head = next_sector(s_head - (s_head % OUTBOX_SECTOR == 0 ? 1 : 0));
+        s_head_needs_erase = true;
+    }
+    if (s_tail == UINT32_MAX) s_tail = s_head;
+    s_send = s_tail;
+}
+
+esp_err_t mqtt_outbox_init(void) {
+    s_part = NULL;
+    s_lock = xSemaphoreCreateMutex();
+    if (!s_lock) return ESP_ERR_NO_MEM;
+    const esp_partition_t *part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, OUTBOX_PART_SUBTYPE, OUTBOX_PART_LABEL);
+    if (!part) {
+        // Una OTA no cambia la tabla de particiones: equipos actualizados sin reflashear por serie
+        ESP_LOGE(TAG, "Partición '%s' no encontrada (tabla de particiones antigua): publicación directa "
+                      "SIN persistencia; hace falta flashear la tabla por serie", OUTBOX_PART_LABEL);
+        return ESP_ERR_NOT_FOUND;
+    }
+    s_part = part;
+    s_sectors = s_part->size / OUTBOX_SECTOR;
+    recover();
+    ESP_LOGI(TAG, "Outbox: %lu pendientes, %lu sectores", (unsigned long)s_stats.pending, (unsigned long)s_sectors);
+    return ESP_OK;
+}
+
+void mqtt_outbox_attach(esp_mqtt_client_handle_t client) {
+    s_client = client;
+}
+
+// Solo desde la tarea MQTT: enqueue toma el bloqueo del cliente, que esa tarea
+// ya tiene mientras entrega eventos a mqtt_outbox_on_event (que toma s_lock)
+static void pump_locked(void) {
+    if (!s_online || !s_client) return;
+    for (int slot = 0; slot < OUTBOX_INFLIGHT; slot++) {
+        if (s_inflight[slot].msg_id != 0) continue;
+
+        s_send = find_next_valid(s_send);
+        if (s_send == s_head) return;
+
+        rec_hdr_t h;
+        if (!rec_read(s_send, &h, true)) {
+            s_send = next_sector(s_send);
+            continue;
+        }
+        const char *topic = s_topics[h.topic < OUTBOX_TOPIC_COUNT ? h.topic : OUTBOX_TELEMETRY];
+        // enqueue: lo envía la tarea MQTT, sin bloquear al llamante en el socket
+        int msg_id = esp_mqtt_client_enqueue(s_client, topic, (const char *)s_buf, h.len, 1, 0, true);
+        if (msg_id <= 0) return; // Cliente ocupado o caído: se reintenta en el próximo evento
+
+        s_inflight[slot] = (inflight_t){ .msg_id = msg_id, .off = s_send, .seq = h.seq };
+        s_stats.sent++;
+        s_send += rec_size(h.len);
+        if (s_send / OUTBOX_SECTOR >= s_sectors) s_send = 0;
+    }
+}
+
+// Sin partición: como antes de la bandeja, a la cola en RAM del cliente (QoS 1,
+// guardada también sin conexión). Sin s_lock tomado, así que vale desde cualquier tarea
+static esp_err_t push_direct(outbox_topic_t topic, const char *payload, size_t len) {
+    if (!s_client) return ESP_ERR_INVALID_STATE;
+    int msg_id = esp_mqtt_client_enqueue(s_client, s_topics[topic], payload, len, 1, 0, true);
+    if (msg_id < 0) return ESP_FAIL;
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    s_stats.sent++;
+    xSemaphoreGive(s_lock);
+    return ESP_OK;
+}
+
+esp_err_t mqtt_outbox_push(outbox_topic_t topic, const char *payload, size_t len) {
+    if (len > OUTBOX_MAX_PAYLOAD) return ESP_ERR_INVALID_SIZE;
+    if (topic >= OUTBOX_TOPIC_COUNT) return ESP_ERR_INVALID_ARG;
+    if (!s_lock) return ESP_ERR_INVALID_STATE;
+    if (!s_part) return push_direct(topic, payload, len);
+
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    uint32_t size = rec_size(len);
+    bool was_empty = (s_tail == s_head);
+    bool send_at_head = (s_send == s_head);
+    if (!s_head_needs_erase && (s_head % OUTBOX_SECTOR) + size > OUTBOX_SECTOR) {
+        s_head = next_sector(s_head);
+        s_head_needs_erase = true;
+    }
+    if (was_empty) s_tail = s_head;
+    if (send_at_head) s_send = s_head;
+    if (s_head_needs_erase) erase_head_sector();
+
+    rec_hdr_t *h = (rec_hdr_t *)s_buf;
+    *h = (rec_hdr_t){ .state = REC_VALID, .topic = topic, .len = len, .seq = ++s_seq };
+    memcpy(s_buf + sizeof(rec_hdr_t), payload, len);
+    h->crc = rec_crc(h, s_buf + sizeof(rec_hdr_t));
+    memset(s_buf + sizeof(rec_hdr_t) + len, 0xFF, size - sizeof(rec_hdr_t) - len);
+
+    esp_err_t err = esp_partition_write(s_part, s_head, s_buf, size);
+    if (err == ESP_OK) {
+        s_head += size;
+        if (s_head % OUTBOX_SECTOR == 0) {
+            s_head = next_sector(s_head - 1);
+            s_head_needs_erase = true;
+        }
+        s_stats.pending++;
+        s_stats.stored++;
+    } else {
+        ESP_LOGE(TAG, "Error escribiendo outbox: %s", esp_err_to_name(err));
+    }
+    // El envío lo hace la tarea MQTT: se le pide con un evento de usuario, uno a la vez
+    bool request = (err == ESP_OK && s_online && s_client && !s_pump_requested);
+    if (request) s_pump_requested = true;
+    xSemaphoreGive(s_lock);
+
+    if (request) {
+        esp_mqtt_event_t ev = { .event_id = MQTT_USER_EVENT };
+        if (esp_mqtt_dispatch_custom_event(s_client, &ev) != ESP_OK) {
+            // Cola de eventos llena: ya hay algo pendiente que bombeará
+            xSemaphoreTake(s_lock, portMAX_DELAY);
+            s_pump_requested = false;
+            xSemaphoreGive(s_lock);
+        }
+    }
+    return err;
+}
+
+static void ack_locked(int msg_id) {
+    for (int slot = 0; slot < OUTBOX_INFLIGHT; slot++) {
+        inflight_t *f = &s_inflight[slot];
+        if (f->msg_id != msg_id) continue;
+
+        // Se comprueba la seq por si el sector se reutilizó mientras esperaba el PUBACK
+        rec_hdr_t h;
+        if (rec_read(f->off, &h, false) && h.seq == f->seq && h.state == REC_VALID) {
+            uint8_t st = REC_ACKED;
+            esp_partition_write(s_part, f->off, &st, 1);
+            if (s_stats.pending) s_stats.pending--;
+            s_stats.acked++;
+            if (f->off == s_tail) s_tail = find_next_valid(s_tail);
+        }
+        f->msg_id = 0;
+        return;
+    }
+}
+
+void mqtt_outbox_on_event(esp_mqtt_event_handle_t event) {
+    if (!s_lock) return;
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    if (!s_part) {
+        // Publicación directa: solo se cuentan las confirmaciones
+        if (event->event_id == MQTT_EVENT_PUBLISHED) s_stats.acked++;
+        xSemaphoreGive(s_lock);
+        return;
+    }
+    switch (event->event_id) {
+        case MQTT_EVENT_CONNECTED:
+            // Reenvío ordenado desde el pendiente más antiguo
+            s_online = true;
+            memset(s_inflight, 0, sizeof(s_inflight));
+            s_send = s_tail;
+            if (s_stats.pending) ESP_LOGI(TAG, "Reenviando %lu mensajes pendientes", (unsigned long)s_stats.pending);
+            pump_locked();
+            break;
+        case MQTT_EVENT_DISCONNECTED:
+            s_online = false;
+            memset(s_inflight, 0, sizeof(s_inflight));
+            break;
+        case MQTT_EVENT_PUBLISHED:
+            ack_locked(event->msg_id);
+            pump_locked();
+            break;
+        case MQTT_USER_EVENT:
+            // Petición de mqtt_outbox_push
+            s_pump_requested = false;
+            pump_locked();
+            break;
+        case MQTT_EVENT_DELETED:
+            // El cliente descartó un mensaje sin PUBACK: se repetirá desde la cola
+            for (int slot = 0; slot < OUTBOX_INFLIGHT; slot++) {
+                if (s_inflight[slot].msg_id == event->msg_id) s_inflight[slot].msg_id = 0;
+            }
+            s_send = s_tail;
+            break;
+        default:
+            break;
+    }
+    xSemaphoreGive(s_lock);
+}
+
+void mqtt_outbox_get_stats(mqtt_outbox_stats_t *out) {
+    if (!s_lock) {
+        memset(out, 0, sizeof(*out));
+        return;
+    }
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    *out = s_stats;
+    xSemaphoreGive(s_lock);
+}
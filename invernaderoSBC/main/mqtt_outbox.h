@@ -0,0 +1,49 @@
+#ifndef MAIN_MQTT_OUTBOX_H_
+#define MAIN_MQTT_OUTBOX_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "mqtt_client.h"
+
+/*
+ * Bandeja de salida MQTT persistente (partición "outbox").
+ *
+ * Cada mensaje se escribe primero como registro en un log circular en flash
+ * y solo se marca como entregado al llegar MQTT_EVENT_PUBLISHED (PUBACK QoS 1).
+ * Al reconectar se reenvía en orden desde el más antiguo pendiente. Si el log
+ * se llena se borra el sector más antiguo (se pierden los más viejos primero).
+ * La semántica es "al menos una vez": tras un corte puede haber duplicados.
+ *
+ * La partición solo llega con un flasheo por serie (una OTA no cambia la tabla).
+ * Sin ella mqtt_outbox_init devuelve ESP_ERR_NOT_FOUND y push publica directo
+ * con esp_mqtt_client_enqueue: lo pendiente vive en RAM y se pierde al reiniciar.
+ */
+
+#define OUTBOX_MAX_PAYLOAD 512
+
+typedef enum {
+    OUTBOX_TELEMETRY = 0,   // v1/devices/me/telemetry
+    OUTBOX_ATTRIBUTES,      // v1/devices/me/attributes
+    OUTBOX_TOPIC_COUNT
+} outbox_topic_t;
+
+typedef struct {
+    uint32_t pending;       // Registros en flash sin confirmar
+    uint32_t stored;        // Registros escritos desde el arranque
+    uint32_t sent;          // Publicaciones (incluye reenvíos)
+    uint32_t acked;
+    uint32_t evicted;       // Descartados por falta de espacio
+} mqtt_outbox_stats_t;
+
+esp_err_t mqtt_outbox_init(void);
+void mqtt_outbox_attach(esp_mqtt_client_handle_t client);
+// No publica: deja el registro en flash y avisa a la tarea MQTT (MQTT_USER_EVENT).
+// Sin partición, a la cola del cliente
+esp_err_t mqtt_outbox_push(outbox_topic_t topic, const char *payload, size_t len);
+// Debe llamarse desde el manejador de eventos MQTT con cada evento (incluidos los
+// de usuario): es el único sitio desde el que se publica
+void mqtt_outbox_on_event(esp_mqtt_event_handle_t event);
+void mqtt_outbox_get_stats(mqtt_outbox_stats_t *out);
+
+#endif /* MAIN_MQTT_OUTBOX_H_ */
@@ -0,0 +1,448 @@
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/event_groups.h"
+#include "esp_log.h"
+#include "esp_wifi.h"
+#include "esp_event.h"
+#include "esp_netif.h"
+#include "esp_timer.h"
+#include <esp_http_server.h>
+#include "lwip/sockets.h"
+
+#include "provisioning.h"
+#include "wifi_manager.h"
+
+#define TAG "PROVISIONING"
+
+#define PROV_MAX_BODY        512    // Cuerpo máximo aceptado en POST /save
+#define PROV_RECV_CHUNK      64     // El formulario se procesa en trozos de este tamaño
+#define PROV_SCAN_MAX        16
+#define PROV_SCAN_MAX_AGE_US (15 * 1000000LL)
+#define PROV_CONNECT_RETRIES 3
+#define PROV_GRACE_MS        10000  // Tiempo con el AP vivo tras conectar
+#define DNS_PORT             53
+#define DNS_MAX_PACKET       512
+
+static EventGroupHandle_t s_event_group;
+static EventBits_t s_connected_bit;
+static volatile prov_state_t s_state = PROV_STATE_IDLE;
+static httpd_handle_t s_portal = NULL;
+static volatile bool s_dns_run = false;
+static int s_retries = 0;
+static char s_sta_ip[16] = {0};
+static char s_try_ssid[33] = {0};
+
+// Caché del último escaneo (se refresca en segundo plano bajo demanda)
+static wifi_ap_record_t s_scan[PROV_SCAN_MAX];
+static uint16_t s_scan_n = 0;
+static int64_t s_scan_time = 0;
+static volatile bool s_scanning = false;
+static portMUX_TYPE s_scan_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static const char *PORTAL_HTML =
+    "<!DOCTYPE html><html><head><meta charset='utf-8'>"
+    "<meta name='viewport' content='width=device-width,initial-scale=1'>"
+    "<title>Configurar WiFi SBC</title></head><body>"
+    "<h1>Configurar WiFi SBC</h1>"
+    "<form action='/save' method='post'>"
+    "SSID: <input list='redes' name='ssid' maxlength='32'><datalist id='redes'></datalist><br>"
+    "Pass: <input type='password' name='pwd' maxlength='64'><br>"
+    "<input type='submit' value='Guardar'></form>"
+    "<ul id='l'></ul>"
+    "<script>fetch('/scan').then(r=>r.json()).then(a=>{"
+    "const d=document.getElementById('redes'),l=document.getElementById('l');"
+    "a.forEach(n=>{const o=document.createElement('option');o.value=n.ssid;d.appendChild(o);"
+    "const i=document.createElement('li');i.textContent=n.ssid+' ('+n.rssi+' dBm, canal '+n.ch+')';l.appendChild(i);});});"
+    "</script></body></html>";
+
+static const char *RESULT_HTML =
+    "<!DOCTYPE html><html><head><meta charset='utf-8'>"
+    "<meta name='viewport' content='width=device-width,initial-scale=1'></head><body>"
+    "<h1>Conectando...</h1><p id='s'>Probando credenciales</p>"
+    "<script>function p(){fetch('/status').then(r=>r.json()).then(j=>{"
+    "const s=document.getElementById('s');"
+    "if(j.state=='connected'){s.textContent='Conectado. IP: '+j.ip;}"
+    "else if(j.state=='failed'){s.innerHTML='No se pudo conectar. <a href=\"/\">Reintentar</a>';}"
+    "else setTimeout(p,1000);}).catch(()=>setTimeout(p,1000));}p();</script></body></html>";
+
+static const char *state_name(prov_state_t st) {
+    switch (st) {
+        case PROV_STATE_CONNECTING: return "connecting";
+        case PROV_STATE_CONNECTED:  return "connected";
+        case PROV_STATE_FAILED:     return "failed";
+        case PROV_STATE_DONE:       return "done";
+        default:                    return "idle";
+    }
+}
+
+/* ---------- Escaneo asíncrono ---------- */
+
+static void scan_request(void) {
+    if (s_scanning || s_state == PROV_STATE_CONNECTING) return;
+    wifi_scan_config_t scan_conf = { .show_hidden = false };
+    if (esp_wifi_scan_start(&scan_conf, false) == ESP_OK) s_scanning = true;
+}
+
+static void scan_collect(void) {
+    uint16_t n = PROV_SCAN_MAX;
+    static wifi_ap_record_t recs[PROV_SCAN_MAX];
+    if (esp_wifi_scan_get_ap_records(&n, recs) != ESP_OK) n = 0;
+    portENTER_CRITICAL(&s_scan_lock);
+    memcpy(s_scan, recs, n * sizeof(wifi_ap_record_t));
+    s_scan_n = n;
+    s_scan_time = esp_timer_get_time();
+    portEXIT_CRITICAL(&s_scan_lock);
+    s_scanning = false;
+    ESP_LOGI(TAG, "Escaneo terminado: %u redes", n);
+}
+
+/* ---------- Parser de formulario en streaming ---------- */
+
+// Decodifica application/x-www-form-urlencoded byte a byte sobre buffers fijos
+typedef struct {
+    char key[8];
+    uint8_t klen;
+    bool in_value;
+    char *dst;
+    size_t dst_cap;
+    size_t dst_len;
+    uint8_t pct;        // 0 = normal, 1-2 = dígitos hex pendientes de %XX
+    uint8_t pct_val;
+    bool overflow;
+    char *ssid;
+    char *pwd;
+} form_parser_t;
+
+static int hexval(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    c = tolower((unsigned char)c);
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+static void form_put(form_parser_t *p, char c) {
+    if (!p->dst) return; // Campo desconocido: se ignora
+    if (p->dst_len + 1 >= p->dst_cap) {
+        p->overflow = true;
+        return;
+    }
+    p->dst[p->dst_len++] = c;
+    p->dst[p->dst_len] = '\0';
+}
+
+static void form_feed(form_parser_t *p, const char *buf, int len) {
+    for (int i = 0; i < len; i++) {
+        char c = buf[i];
+        if (c == '&') {
+            p->in_value = false;
+            p->klen = 0;
+            p->dst = NULL;
+            p->pct = 0;
+            continue;
+        }
+        if (!p->in_value) {
+            if (c == '=') {
+                p->key[p->klen] = '\0';
+                p->in_value = true;
+                p->dst_len = 0;
+                if (strcmp(p->key, "ssid") == 0) { p->dst = p->ssid; p->dst_cap = 33; }
+                else if (strcmp(p->key, "pwd") == 0) { p->dst = p->pwd; p->dst_cap = 65; }
+                else p->dst = NULL;
+                if (p->dst) p->dst[0] = '\0';
+            } else if (p->klen < sizeof(p->key) - 1) {
+                p->key[p->klen++] = c;
+            }
+            continue;
+        }
+        if (p->pct) {
+            int v = hexval(c);
+            if (v < 0) { p->pct = 0; continue; }
+            p->pct_val = (p->pct_val << 4) | v;
+            if (++p->pct == 3) {
+                form_put(p, (char)p->pct_val);
+                p->pct = 0;
+            }
+        } else if (c == '%') {
+            p->pct = 1;
+            p->pct_val = 0;
+        } else {
+            form_put(p, c == '+' ? ' ' : c);
+        }
+    }
+}
+
+/* ---------- Conexión con las credenciales nuevas ---------- */
+
+static void try_credentials(const char *ssid, const char *pass) {
+    wifi_config_t sta_cfg = { .sta = { .threshold.authmode = WIFI_AUTH_WPA2_PSK } };
+    if (pass[0] == '\0') sta_cfg.sta.threshold.authmode = WIFI_AUTH_OPEN;
+    strlcpy((char *)sta_cfg.sta.ssid, ssid, sizeof(sta_cfg.sta.ssid));
+    strlcpy((char *)sta_cfg.sta.password, pass, sizeof(sta_cfg.sta.password));
+
+    // Si hay una red de la caché con ese SSID se fija el canal y se evita el barrido completo
+    portENTER_CRITICAL(&s_scan_lock);
+    for (int i = 0; i < s_scan_n; i++) {
+        if (strcmp((const char *)s_scan[i].ssid, ssid) == 0) {
+            sta_cfg.sta.channel = s_scan[i].primary;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_scan_lock);
+
+    strlcpy(s_try_ssid, ssid, sizeof(s_try_ssid));
+    s_retries = 0;
+    s_state = PROV_STATE_CONNECTING;
+    esp_wifi_disconnect();
+    esp_wifi_set_config(WIFI_IF_STA, &sta_cfg);
+    esp_wifi_connect();
+    ESP_LOGI(TAG, "Probando credenciales para '%s'", ssid);
+}
+
+/* ---------- Handlers HTTP del portal ---------- */
+
+static esp_err_t portal_get_handler(httpd_req_t *req) {
+    scan_request();
+    httpd_resp_set_type(req, "text/html");
+    return httpd_resp_send(req, PORTAL_HTML, HTTPD_RESP_USE_STRLEN);
+}
+
+static esp_err_t scan_get_handler(httpd_req_t *req) {
+    if (esp_timer_get_time() - s_scan_time > PROV_SCAN_MAX_AGE_US) scan_request();
+
+    httpd_resp_set_type(req, "application/json");
+    char item[96];
+    bool first = true;
+    httpd_resp_send_chunk(req, "[", 1);
+    for (int i = 0; i < PROV_SCAN_MAX; i++) {
+        wifi_ap_record_t rec;
+        portENTER_CRITICAL(&s_scan_lock);
+        bool valid = i < s_scan_n;
+        if (valid) rec = s_scan[i];
+        portEXIT_CRITICAL(&s_scan_lock);
+        if (!valid) break;
+
+        // Se omiten SSID con comillas o barras para no tener que escapar JSON
+        if (strpbrk((const char *)rec.ssid, "\"\\") != NULL || rec.ssid[0] == '\0') continue;
+        int n = snprintf(item, sizeof(item), "%s{\"ssid\":\"%s\",\"rssi\":%d,\"ch\":%d,\"open\":%s}",
+                         first ? "" : ",", (const char *)rec.ssid, rec.rssi, rec.primary,
+                         rec.authmode == WIFI_AUTH_OPEN ? "true" : "false");
+        httpd_resp_send_chunk(req, item, n);
+        first = false;
+    }
+    httpd_resp_send_chunk(req, "]", 1);
+    return httpd_resp_send_chunk(req, NULL, 0);
+}
+
+static esp_err_t status_get_handler(httpd_req_t *req) {
+    char json[96];
+    snprintf(json, sizeof(json), "{\"state\":\"%s\",\"ssid\":\"%s\",\"ip\":\"%s\"}",
+             state_name(s_state), s_try_ssid, s_sta_ip);
+    httpd_resp_set_type(req, "application/json");
+    return httpd_resp_send(req, json, HTTPD_RESP_USE_STRLEN);
+}
+
+static esp_err_t save_post_handler(httpd_req_t *req) {
+    if (req->content_len == 0 || req->content_len > PROV_MAX_BODY) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Formulario demasiado grande");
+        return ESP_FAIL;
+    }
+
+    char ssid[33] = {0}, pass[65] = {0};
+    form_parser_t parser = { .ssid = ssid, .pwd = pass };
+    char buf[PROV_RECV_CHUNK];
+    size_t remaining = req->content_len;
+    while (remaining > 0) {
+        int ret = httpd_req_recv(req, buf, remaining < sizeof(buf) ? remaining : sizeof(buf));
+        if (ret == HTTPD_SOCK_ERR_TIMEOUT) continue;
+        if (ret <= 0) return ESP_FAIL;
+        form_feed(&parser, buf, ret);
+        remaining -= ret;
+    }
+
+    if (parser.overflow || ssid[0] == '\0') {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "SSID o password no válidos");
+        return ESP_FAIL;
+    }
+
+    wifi_manager_add_credential(ssid, pass);
+    try_credentials(ssid, pass);
+
+    httpd_resp_set_type(req, "text/html");
+    return httpd_resp_send(req, RESULT_HTML, HTTPD_RESP_USE_STRLEN);
+}
+
+// Cualquier URL desconocida (detección de portal cautivo de Android/iOS/Windows) va al formulario
+static esp_err_t captive_redirect_handler(httpd_req_t *req, httpd_err_code_t err) {
+    httpd_resp_set_status(req, "302 Found");
+    httpd_resp_set_hdr(req, "Location", "http://" PROV_AP_IP "/");
+    return httpd_resp_send(req, NULL, 0);
+}
+
+/* ---------- DNS cautivo ---------- */
+
+// Responde a todas las consultas A con la IP del AP
+static void dns_task(void *pv) {
+    int sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (sock < 0) {
+        ESP_LOGE(TAG, "DNS: no se pudo crear el socket");
+        vTaskDelete(NULL);
+        return;
+    }
+    struct sockaddr_in addr = { .sin_family = AF_INET, .sin_port = htons(DNS_PORT), .sin_addr.s_addr = htonl(INADDR_ANY) };
+    if (bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        ESP_LOGE(TAG, "DNS: bind fallido");
+        close(sock);
+        vTaskDelete(NULL);
+        return;
+    }
+    struct timeval tv = { .tv_sec = 1, .tv_usec = 0 };
+    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    uint8_t pkt[DNS_MAX_PACKET];
+    uint32_t ap_ip = inet_addr(PROV_AP_IP);
+
+    while (s_dns_run) {
+        struct sockaddr_in client;
+        socklen_t clen = sizeof(client);
+        int len = recvfrom(sock, pkt, sizeof(pkt), 0, (struct sockaddr *)&client, &clen);
+        if (len < 12) continue;
+
+        // Solo consultas estándar (QR=0, OPCODE=0) con al menos una pregunta
+        if ((pkt[2] & 0xF8) != 0 || ((pkt[4] << 8) | pkt[5]) == 0) continue;
+
+        // Fin del nombre de la primera pregunta
+        int pos = 12;
+        while (pos < len && pkt[pos] != 0) {
+            if ((pkt[pos] & 0xC0) != 0) { pos = len; break; }
+            pos += pkt[pos] + 1;
+        }
+        if (pos + 5 > len) continue;
+        uint16_t qtype = (pkt[pos + 1] << 8) | pkt[pos + 2];
+        int qend = pos + 5;
+
+        pkt[2] = 0x84 | (pkt[2] & 0x01);     // QR=1, AA=1, conservando RD
+        pkt[3] = 0x80;                       // RA=1, RCODE=0
+        pkt[4] = 0; pkt[5] = 1;              // QDCOUNT = 1
+        pkt[8] = pkt[9] = pkt[10] = pkt[11] = 0;
+        int out = qend;
+        if (qtype == 1 && out + 16 <= (int)sizeof(pkt)) {
+            static const uint8_t answer_hdr[] = {
+                0xC0, 0x0C,             // Puntero al nombre de la pregunta
+                0x00, 0x01, 0x00, 0x01, // Tipo A, clase IN
+                0x00, 0x00, 0x00, 0x3C, // TTL 60 s
+                0x00, 0x04,
+            };
+            memcpy(pkt + out, answer_hdr, sizeof(answer_hdr));
+            out += sizeof(answer_hdr);
+            memcpy(pkt + out, &ap_ip, 4);
+            out += 4;
+            pkt[6] = 0; pkt[7] = 1;          // ANCOUNT = 1
+        } else {
+            pkt[6] = pkt[7] = 0;
+        }
+        sendto(sock, pkt, out, 0, (struct sockaddr *)&client, clen);
+    }
+
+    close(sock);
+    ESP_LOGI(TAG, "DNS cautivo detenido");
+    vTaskDelete(NULL);
+}
+
+/* ---------- Ciclo de vida ---------- */
+
+static void teardown_task(void *pv) {
+    vTaskDelay(pdMS_TO_TICKS(PROV_GRACE_MS));
+    s_dns_run = false;
+    if (s_portal) {
+        httpd_stop(s_portal);
+        s_portal = NULL;
+    }
+    esp_wifi_set_mode(WIFI_MODE_STA);
+    s_state = PROV_STATE_DONE;
+    ESP_LOGI(TAG, "Portal cerrado, modo STA");
+    vTaskDelete(NULL);
+}
+
+static void prov_event_handler(void *arg, esp_event_base_t base, int32_t id, void *data) {
+    if (base == WIFI_EVENT && id == WIFI_EVENT_SCAN_DONE) {
+        scan_collect();
+    } else if (base == WIFI_EVENT && id == WIFI_EVENT_STA_DISCONNECTED) {
+        xEventGroupClearBits(s_event_group, s_connected_bit);
+        if (s_state == PROV_STATE_CONNECTING) {
+            if (++s_retries < PROV_CONNECT_RETRIES) {
+                esp_wifi_connect();
+            } else {
+                ESP_LOGW(TAG, "No se pudo conectar a '%s'", s_try_ssid);
+                s_state = PROV_STATE_FAILED;
+            }
+        }
+        // Tras conectar, las reconexiones las gestiona wifi_manager
+    } else if (base == IP_EVENT && id == IP_EVENT_STA_GOT_IP) {
+        ip_event_got_ip_t *event = (ip_event_got_ip_t *)data;
+        snprintf(s_sta_ip, sizeof(s_sta_ip), IPSTR, IP2STR(&event->ip_info.ip));
+        xEventGroupSetBits(s_event_group, s_connected_bit);
+        if (s_state == PROV_STATE_CONNECTING) {
+            s_state = PROV_STATE_CONNECTED;
+            wifi_manager_adopt_connection();
+            ESP_LOGI(TAG, "Conectado a '%s' con IP %s", s_try_ssid, s_sta_ip);
+            xTaskCreate(teardown_task, "prov_teardown", 3072, NULL, 3, NULL);
+        }
+    }
+}
+
+esp_err_t provisioning_start(EventGroupHandle_t event_group, EventBits_t connected_bit) {
+    s_event_group = event_group;
+    s_connected_bit = connected_bit;
+    s_state = PROV_STATE_IDLE;
+
+    // La interfaz STA y el driver ya los ha creado wifi_manager_init()
+    esp_netif_create_default_wifi_ap();
+
+    esp_event_handler_instance_t inst_wifi, inst_ip;
+    ESP_ERROR_CHECK(esp_event_handler_instance_register(WIFI_EVENT, ESP_EVENT_ANY_ID, &prov_event_handler, NULL, &inst_wifi));
+    ESP_ERROR_CHECK(esp_event_handler_instance_register(IP_EVENT, IP_EVENT_STA_GOT_IP, &prov_event_handler, NULL, &inst_ip));
+
+    wifi_config_t ap_cfg = {
+        .ap = { .ssid = PROV_AP_SSID, .ssid_len = strlen(PROV_AP_SSID), .password = "",
+                .max_connection = 4, .authmode = WIFI_AUTH_OPEN }
+    };
+    // APSTA: el AP atiende el portal mientras la interfaz STA escanea y prueba credenciales
+    ESP_ERROR_CHECK(esp_wifi_set_mode(WIFI_MODE_APSTA));
+    ESP_ERROR_CHECK(esp_wifi_set_config(WIFI_IF_AP, &ap_cfg));
+    ESP_ERROR_CHECK(esp_wifi_start());
+    scan_request();
+
+    httpd_config_t config = HTTPD_DEFAULT_CONFIG();
+    config.lru_purge_enable = true;
+    if (httpd_start(&s_portal, &config) == ESP_OK) {
+        const httpd_uri_t uris[] = {
+            { .uri = "/",       .method = HTTP_GET,  .handler = portal_get_handler },
+            { .uri = "/scan",   .method = HTTP_GET,  .handler = scan_get_handler },
+            { .uri = "/status", .method = HTTP_GET,  .handler = status_get_handler },
+            { .uri = "/save",   .method = HTTP_POST, .handler = save_post_handler },
+        };
+        for (size_t i = 0; i < sizeof(uris) / sizeof(uris[0]); i++) {
+            httpd_register_uri_handler(s_portal, &uris[i]);
+        }
+        httpd_register_err_handler(s_portal, HTTPD_404_NOT_FOUND, captive_redirect_handler);
+    } else {
+        ESP_LOGE(TAG, "No se pudo iniciar el portal HTTP");
+    }
+
+    s_dns_run = true;
+    xTaskCreate(dns_task, "captive_dns", 3072, NULL, 4, NULL);
+
+    ESP_LOGI(TAG, "Portal de configuración activo en " PROV_AP_IP);
+    return ESP_OK;
+}
+
+bool provisioning_active(void) {
+    return s_portal != NULL || s_dns_run;
+}
+
+prov_state_t provisioning_get_state(void) {
+    return s_state;
+}
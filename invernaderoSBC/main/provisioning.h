@@ -0,0 +1,33 @@
+#ifndef MAIN_PROVISIONING_H_
+#define MAIN_PROVISIONING_H_
+
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
+
+/*
+ * Portal de configuración WiFi no bloqueante.
+ *
+ * Levanta el AP "ESP32-SBC-Config" en modo APSTA junto con un DNS cautivo y
+ * el formulario web. El bucle de sensores y control sigue funcionando. Al
+ * guardar, se prueban las credenciales sin reiniciar; con IP se activa
+ * connected_bit y, tras un margen para que el usuario vea la IP, se apaga
+ * el AP y el equipo queda en modo STA. Requiere wifi_manager_init() previo.
+ */
+
+#define PROV_AP_SSID "ESP32-SBC-Config"
+#define PROV_AP_IP   "192.168.4.1"
+
+typedef enum {
+    PROV_STATE_IDLE = 0,    // Esperando credenciales
+    PROV_STATE_CONNECTING,  // Probando las credenciales recibidas
+    PROV_STATE_CONNECTED,   // IP obtenida, AP pendiente de apagarse
+    PROV_STATE_FAILED,      // Credenciales rechazadas, se sigue en AP
+    PROV_STATE_DONE,        // Portal apagado, modo STA normal
+} prov_state_t;
+
+esp_err_t provisioning_start(EventGroupHandle_t event_group, EventBits_t connected_bit);
+bool provisioning_active(void);
+prov_state_t provisioning_get_state(void);
+
+#endif /* MAIN_PROVISIONING_H_ */
@@ -0,0 +1,104 @@
+#include <math.h>
+#include "esp_cpu.h"
+
+#include "psychro.h"
+
+#define MAGNUS_A 17.62f
+#define MAGNUS_B 243.12f
+#define MAGNUS_E0 6.112f
+
+// es(T) en hPa para T = PSYCHRO_T_MIN .. PSYCHRO_T_MAX (paso 1 C)
+static const float s_svp[PSYCHRO_T_MAX - PSYCHRO_T_MIN + 1] = {
+    0.0638f, 0.0715f, 0.0801f, 0.0896f, 0.1001f, 0.1117f,
+    0.1245f, 0.1387f, 0.1542f, 0.1714f, 0.1902f, 0.2109f,
+    0.2336f, 0.2586f, 0.2858f, 0.3157f, 0.3484f, 0.3840f,
+    0.4230f, 0.4654f, 0.5117f, 0.5620f, 0.6168f, 0.6764f,
+    0.7410f, 0.8112f, 0.8872f, 0.9696f, 1.0588f, 1.1553f,
+    1.2597f, 1.3723f, 1.4939f, 1.6251f, 1.7665f, 1.9187f,
+    2.0826f, 2.2589f, 2.4483f, 2.6518f, 2.8703f, 3.1047f,
+    3.3559f, 3.6251f, 3.9134f, 4.2218f, 4.5517f, 4.9043f,
+    5.2809f, 5.6830f, 6.1120f, 6.5695f, 7.0570f, 7.5763f,
+    8.1292f, 8.7174f, 9.3430f, 10.0079f, 10.7143f, 11.4643f,
+    12.2603f, 13.1046f, 13.9998f, 14.9483f, 15.9531f, 17.0167f,
+    18.1423f, 19.3327f, 20.5913f, 21.9212f, 23.3260f, 24.8090f,
+    26.3742f, 28.0251f, 29.7659f, 31.6006f, 33.5334f, 35.5689f,
+    37.7115f, 39.9660f, 42.3372f, 44.8303f, 47.4505f, 50.2031f,
+    53.0939f, 56.1284f, 59.3128f, 62.6531f, 66.1558f, 69.8274f,
+    73.6746f, 77.7044f, 81.9241f, 86.3409f, 90.9627f, 95.7971f,
+    100.8523f, 106.1367f, 111.6588f, 117.4274f, 123.4516f, 129.7407f,
+    136.3042f, 143.1521f, 150.2945f, 157.7416f, 165.5043f, 173.5933f,
+    182.0201f, 190.7960f, 199.9329f,
+};
+
+#define SVP_LEN ((int)(sizeof(s_svp) / sizeof(s_svp[0])))
+
+float psychro_svp(float temp_c) {
+    float x = temp_c - PSYCHRO_T_MIN;
+    if (x <= 0.0f) return s_svp[0];
+    if (x >= SVP_LEN - 1) return s_svp[SVP_LEN - 1];
+    int i = (int)x;
+    float f = x - i;
+    return s_svp[i] + f * (s_svp[i + 1] - s_svp[i]);
+}
+
+// Inversa de la tabla: temperatura a la que es(T) == e
+static float svp_inverse(float e) {
+    if (e <= s_svp[0]) return PSYCHRO_T_MIN;
+    if (e >= s_svp[SVP_LEN - 1]) return PSYCHRO_T_MAX;
+    int lo = 0, hi = SVP_LEN - 1;
+    while (hi - lo > 1) {
+        int mid = (lo + hi) / 2;
+        if (s_svp[mid] <= e) lo = mid;
+        else hi = mid;
+    }
+    return PSYCHRO_T_MIN + lo + (e - s_svp[lo]) / (s_svp[hi] - s_svp[lo]);
+}
+
+void psychro_compute(float temp_c, float rh, psychro_t *out) {
+    if (rh < 0.0f) rh = 0.0f;
+    if (rh > 100.0f) rh = 100.0f;
+    float es = psychro_svp(temp_c);
+    float e = es * rh * 0.01f;
+    out->vpd = (es - e) * 0.1f;
+    out->abs_hum = 216.7f * e / (temp_c + 273.15f);
+    out->dew_point = svp_inverse(e);
+}
+
+// ---------------------------------------------------------------- Benchmark
+
+static void psychro_reference(float temp_c, float rh, psychro_t *out) {
+    float es = MAGNUS_E0 * expf(MAGNUS_A * temp_c / (MAGNUS_B + temp_c));
+    float e = es * rh * 0.01f;
+    float g = logf(rh * 0.01f) + MAGNUS_A * temp_c / (MAGNUS_B + temp_c);
+    out->vpd = (es - e) * 0.1f;
+    out->abs_hum = 216.7f * e / (temp_c + 273.15f);
+    out->dew_point = MAGNUS_B * g / (MAGNUS_A - g);
+}
+
+void psychro_benchmark(psychro_bench_t *out) {
+    psychro_t fast, ref;
+    uint32_t n = 0, fast_cycles = 0, ref_cycles = 0;
+    out->max_err_dew = out->max_err_vpd = out->max_err_abs = 0.0f;
+
+    for (float t = -10.0f; t <= 50.0f; t += 0.37f) {
+        for (float rh = 10.0f; rh <= 100.0f; rh += 1.3f) {
+            uint32_t c0 = esp_cpu_get_cycle_count();
+            psychro_compute(t, rh, &fast);
+            uint32_t c1 = esp_cpu_get_cycle_count();
+            psychro_reference(t, rh, &ref);
+            uint32_t c2 = esp_cpu_get_cycle_count();
+            fast_cycles += c1 - c0;
+            ref_cycles += c2 - c1;
+            n++;
+
+            float d = fabsf(fast.dew_point - ref.dew_point);
+            if (d > out->max_err_dew) out->max_err_dew = d;
+            d = fabsf(fast.vpd - ref.vpd);
+            if (d > out->max_err_vpd) out->max_err_vpd = d;
+            d = fabsf(fast.abs_hum - ref.abs_hum);
+            if (d > out->max_err_abs) out->max_err_abs = d;
+        }
+    }
+    out->fast_cycles = fast_cycles / n;
+    out->ref_cycles = ref_cycles / n;
+}
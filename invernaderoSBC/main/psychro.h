@@ -0,0 +1,39 @@
+#ifndef MAIN_PSYCHRO_H_
+#define MAIN_PSYCHRO_H_
+
+#include <stdint.h>
+
+/*
+ * Magnitudes psicrométricas derivadas de T y HR.
+ *
+ * La presión de saturación (Magnus, coeficientes de Sonntag 17.62/243.12) se
+ * toma de una tabla de 1 C entre -50 y 60 C con interpolación lineal; el punto
+ * de rocío se obtiene invirtiendo la misma tabla por búsqueda binaria. No hay
+ * expf ni logf en el camino normal.
+ */
+
+#define PSYCHRO_T_MIN   -50
+#define PSYCHRO_T_MAX   60
+
+typedef struct {
+    float dew_point;    // C
+    float vpd;          // kPa (déficit de presión de vapor)
+    float abs_hum;      // g/m3
+} psychro_t;
+
+void psychro_compute(float temp_c, float rh, psychro_t *out);
+// Presión de vapor de saturación en hPa
+float psychro_svp(float temp_c);
+
+typedef struct {
+    float max_err_dew;      // C, frente a las fórmulas con expf/logf
+    float max_err_vpd;      // kPa
+    float max_err_abs;      // g/m3
+    uint32_t fast_cycles;   // Ciclos por llamada a psychro_compute
+    uint32_t ref_cycles;    // Ciclos por llamada a la versión de referencia
+} psychro_bench_t;
+
+// Recorre T en [-10, 50] y HR en [10, 100] comparando con la referencia
+void psychro_benchmark(psychro_bench_t *out);
+
+#endif /* MAIN_PSYCHRO_H_ */
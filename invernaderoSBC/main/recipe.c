@@ -0,0 +1,411 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_rom_crc.h"
+#include "nvs_flash.h"
+#include "nvs.h"
+
+#include "recipe.h"
+#include "time_sync.h"
+
+#define TAG "RECIPE"
+
+#define RECIPE_MAGIC        0x5243  // "RC"
+#define RECIPE_VERSION      1
+#define RECIPE_NVS_KEY      "recipe"
+#define RECIPE_STATE_KEY    "recipe_st"
+#define RECIPE_SAVE_S       600     // Cada cuánto se guarda el progreso
+#define RECIPE_IAQ_DEFAULT  150
+#define RECIPE_MAX_HOURS    8760            // Una fase dura como mucho un año
+#define RECIPE_MAX_RAMP_H   (UINT16_MAX / 60) // ramp_min es de 16 bits
+#define RECIPE_MAX_NIGHT_T  20              // Desplazamientos nocturnos, C y %
+#define RECIPE_MAX_NIGHT_H  50
+
+typedef struct {
+    uint16_t magic;
+    uint8_t version;
+    uint8_t count;
+    uint32_t crc;               // CRC32 de las fases
+    recipe_phase_t phases[RECIPE_MAX_PHASES];
+} recipe_blob_t;
+
+#define RECIPE_HDR_LEN offsetof(recipe_blob_t, phases)
+
+typedef struct {
+    uint8_t running;
+    uint8_t phase;
+    uint16_t _pad;
+    uint32_t start_epoch;       // Inicio de la fase en hora real (0 = desconocido)
+    uint32_t elapsed_s;         // Progreso por uptime cuando no hay hora real
+} recipe_state_t;
+
+FaseCultivo fase_receta = {"Receta", 24.0, 28.0, 60.0, 70.0, RECIPE_IAQ_DEFAULT};
+
+static recipe_blob_t s_recipe;
+static recipe_state_t s_state;
+static int64_t s_resume_us = 0;     // Uptime al que corresponde s_state.elapsed_s
+static int64_t s_saved_us = 0;
+static recipe_status_t s_status;
+static SemaphoreHandle_t s_lock = NULL;
+
+static uint32_t phases_crc(const recipe_blob_t *r) {
+    return esp_rom_crc32_le(0, (const uint8_t *)r->phases, r->count * sizeof(recipe_phase_t));
+}
+
+static void save_recipe(void) {
+    nvs_handle_t h;
+    if (nvs_open("storage", NVS_READWRITE, &h) != ESP_OK) return;
+    nvs_set_blob(h, RECIPE_NVS_KEY, &s_recipe, RECIPE_HDR_LEN + s_recipe.count * sizeof(recipe_phase_t));
+    nvs_commit(h);
+    nvs_close(h);
+}
+
+static void save_state(int64_t now_us) {
+    nvs_handle_t h;
+    if (nvs_open("storage", NVS_READWRITE, &h) != ESP_OK) return;
+    nvs_set_blob(h, RECIPE_STATE_KEY, &s_state, sizeof(s_state));
+    nvs_commit(h);
+    nvs_close(h);
+    s_saved_us = now_us;
+}
+
+static inline bool clock_valid(time_t now) {
+    return now >= TIME_EPOCH_VALID;
+}
+
+// Segundos en la fase actual: hora real si se conoce el inicio, si no uptime acumulado
+static uint32_t phase_elapsed(time_t now, int64_t now_us) {
+    if (clock_valid(now) && s_state.start_epoch) return (uint32_t)(now - s_state.start_epoch);
+    return s_state.elapsed_s + (uint32_t)((now_us - s_resume_us) / 1000000);
+}
+
+// Congela el progreso mientras la receta está parada
+static void freeze_locked(time_t now, int64_t now_us) {
+    s_state.elapsed_s = phase_elapsed(now, now_us);
+    s_state.start_epoch = 0;
+    s_resume_us = now_us;
+}
+
+static void resume_locked(time_t now, int64_t now_us) {
+    s_resume_us = now_us;
+    s_state.start_epoch = clock_valid(now) ? (uint32_t)(now - s_state.elapsed_s) : 0;
+}
+
+static void enter_phase(uint8_t phase, uint32_t carry_s, time_t now, int64_t now_us) {
+    s_state.phase = phase;
+    s_state.elapsed_s = carry_s;
+    s_state.start_epoch = clock_valid(now) ? (uint32_t)(now - carry_s) : 0;
+    s_resume_us = now_us;
+    save_state(now_us);
+    ESP_LOGI(TAG, "Fase %u/%u: %s", phase + 1, s_recipe.count, s_recipe.phases[phase].name);
+}
+
+static bool is_night(const recipe_phase_t *p, time_t now) {
+    if (p->day_start_h == p->day_end_h || !clock_valid(now)) return false;
+    struct tm t;
+    localtime_r(&now, &t);
+    int h = t.tm_hour;
+    if (p->day_start_h < p->day_end_h) return h < p->day_start_h || h >= p->day_end_h;
+    return h < p->day_start_h && h >= p->day_end_h; // Día que cruza la medianoche
+}
+
+static inline float lerp_c10(int16_t from, int16_t to, float f) {
+    return (from + f * (to - from)) / 10.0f;
+}
+
+void recipe_init(void) {
+    s_lock = xSemaphoreCreateMutex();
+
+    nvs_handle_t h;
+    if (nvs_open("storage", NVS_READONLY, &h) != ESP_OK) return;
+    size_t len = sizeof(s_recipe);
+    bool ok = nvs_get_blob(h, RECIPE_NVS_KEY, &s_recipe, &len) == ESP_OK &&
+              len >= RECIPE_HDR_LEN && s_recipe.magic == RECIPE_MAGIC &&
+              s_recipe.version == RECIPE_VERSION && s_recipe.count > 0 &&
+              s_recipe.count <= RECIPE_MAX_PHASES &&
+              len == RECIPE_HDR_LEN + s_recipe.count * sizeof(recipe_phase_t) &&
+              s_recipe.crc == phases_crc(&s_recipe);
+    len = sizeof(s_state);
+    if (ok && nvs_get_blob(h, RECIPE_STATE_KEY, &s_state, &len) != ESP_OK) memset(&s_state, 0, sizeof(s_state));
+    nvs_close(h);
+
+    if (!ok) {
+        memset(&s_recipe, 0, sizeof(s_recipe));
+        memset(&s_state, 0, sizeof(s_state));
+        return;
+    }
+    if (s_state.phase >= s_recipe.count) s_state.phase = 0;
+    ESP_LOGI(TAG, "Receta de %u fases cargada (%s, fase %u)", s_recipe.count,
+             s_state.running ? "en marcha" : "parada", s_state.phase + 1);
+    if (s_state.running) {
+        fase_actual = &fase_receta;
+        recipe_tick();
+    }
+}
+
+void recipe_tick(void) {
+    if (!s_state.running || s_recipe.count == 0) return;
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+
+    time_t now = time(NULL);
+    int64_t now_us = esp_timer_get_time();
+    // Primera hora válida: se fija el inicio real de la fase a partir del progreso
+    if (clock_valid(now) && s_state.start_epoch == 0) {
+        s_state.start_epoch = (uint32_t)(now - phase_elapsed(0, now_us));
+    }
+
+    uint32_t elapsed = phase_elapsed(now, now_us);
+    const recipe_phase_t *p = &s_recipe.phases[s_state.phase];
+    uint32_t duration_s = p->duration_min * 60;
+
+    // Como mucho una transición por llamada; tras un apagado largo se recupera en pocos ticks
+    if (duration_s && elapsed >= duration_s && s_state.phase + 1 < s_recipe.count) {
+        enter_phase(s_state.phase + 1, elapsed - duration_s, now, now_us);
+        elapsed = phase_elapsed(now, now_us);
+        p = &s_recipe.phases[s_state.phase];
+        duration_s = p->duration_min * 60;
+    } else if (now_us - s_saved_us >= (int64_t)RECIPE_SAVE_S * 1000000) {
+        s_state.elapsed_s = elapsed;
+        s_resume_us = now_us;
+        save_state(now_us);
+    }
+
+    // Rampa lineal desde las consignas de la fase anterior
+    const recipe_phase_t *prev = (s_state.phase > 0) ? &s_recipe.phases[s_state.phase - 1] : p;
+    float f = 1.0f;
+    if (prev != p && p->ramp_min && elapsed < p->ramp_min * 60u) f = (float)elapsed / (p->ramp_min * 60.0f);
+
+    bool night = is_night(p, now);
+    float dt = night ? p->night_dtemp_c10 / 10.0f : 0.0f;
+    float dh = night ? p->night_dhum_c10 / 10.0f : 0.0f;
+
+    strlcpy(fase_receta.nombre, p->name, sizeof(fase_receta.nombre));
+    fase_receta.temp_min = lerp_c10(prev->temp_min_c10, p->temp_min_c10, f) + dt;
+    fase_receta.temp_max = lerp_c10(prev->temp_max_c10, p->temp_max_c10, f) + dt;
+    fase_receta.hum_min = lerp_c10(prev->hum_min_c10, p->hum_min_c10, f) + dh;
+    fase_receta.hum_max = lerp_c10(prev->hum_max_c10, p->hum_max_c10, f) + dh;
+    fase_receta.iaq_max = p->iaq_max ? p->iaq_max : RECIPE_IAQ_DEFAULT;
+
+    s_status = (recipe_status_t){
+        .loaded = true, .running = true, .phase = s_state.phase, .count = s_recipe.count,
+        .elapsed_s = elapsed, .remaining_s = (duration_s > elapsed) ? duration_s - elapsed : 0,
+        .night = night, .clock_synced = clock_valid(now),
+    };
+    xSemaphoreGive(s_lock);
+}
+
+static bool json_pair(const cJSON *arr, float *lo, float *hi) {
+    if (!cJSON_IsArray(arr) || cJSON_GetArraySize(arr) != 2) return false;
+    const cJSON *a = cJSON_GetArrayItem(arr, 0);
+    const cJSON *b = cJSON_GetArrayItem(arr, 1);
+    if (!cJSON_IsNumber(a) || !cJSON_IsNumber(b)) return false;
+    *lo = a->valuedouble;
+    *hi = b->valuedouble;
+    return *lo <= *hi;
+}
+
+// Clave numérica opcional dentro de [lo, hi]; si falta, *out no cambia
+static bool json_range(const cJSON *o, const char *key, double lo, double hi, double *out) {
+    const cJSON *v = cJSON_GetObjectItem(o, key);
+    if (!v) return true;
+    if (!cJSON_IsNumber(v) || !(v->valuedouble >= lo && v->valuedouble <= hi)) return false;
+    *out = v->valuedouble;
+    return true;
+}
+
+static bool parse_phase(const cJSON *o, recipe_phase_t *p, char *err, size_t err_len) {
+    memset(p, 0, sizeof(*p));
+    const cJSON *name = cJSON_GetObjectItem(o, "name");
+    strlcpy(p->name, cJSON_IsString(name) ? name->valuestring : "Fase", sizeof(p->name));
+    for (char *c = p->name; *c; c++) {
+        if (*c == '"' || *c == '\\' || (unsigned char)*c < 0x20) *c = '_'; // Se reenvía dentro de JSON
+    }
+
+    float tmin, tmax, hmin, hmax;
+    if (!json_pair(cJSON_GetObjectItem(o, "temp"), &tmin, &tmax) || tmin < -10 || tmax > 50) {
+        snprintf(err, err_len, "%s: temp must be [min,max] within -10..50", p->name);
+        return false;
+    }
+    if (!json_pair(cJSON_GetObjectItem(o, "hum"), &hmin, &hmax) || hmin < 0 || hmax > 100) {
+        snprintf(err, err_len, "%s: hum must be [min,max] within 0..100", p->name);
+        return false;
+    }
+    p->temp_min_c10 = (int16_t)(tmin * 10);
+    p->temp_max_c10 = (int16_t)(tmax * 10);
+    p->hum_min_c10 = (int16_t)(hmin * 10);
+    p->hum_max_c10 = (int16_t)(hmax * 10);
+
+    // Se comprueba el rango antes de convertir a los campos enteros
+    double hours = 0, ramp_h = 0, night_t = 0, night_h = 0;
+    if (!json_range(o, "hours", 0, RECIPE_MAX_HOURS, &hours)) {
+        snprintf(err, err_len, "%s: hours must be within 0..%d", p->name, RECIPE_MAX_HOURS);
+        return false;
+    }
+    if (!json_range(o, "ramp_h", 0, RECIPE_MAX_RAMP_H, &ramp_h)) {
+        snprintf(err, err_len, "%s: ramp_h must be within 0..%d", p->name, RECIPE_MAX_RAMP_H);
+        return false;
+    }
+    if (!json_range(o, "night_temp", -RECIPE_MAX_NIGHT_T, RECIPE_MAX_NIGHT_T, &night_t)) {
+        snprintf(err, err_len, "%s: night_temp must be within -%d..%d", p->name, RECIPE_MAX_NIGHT_T, RECIPE_MAX_NIGHT_T);
+        return false;
+    }
+    if (!json_range(o, "night_hum", -RECIPE_MAX_NIGHT_H, RECIPE_MAX_NIGHT_H, &night_h)) {
+        snprintf(err, err_len, "%s: night_hum must be within -%d..%d", p->name, RECIPE_MAX_NIGHT_H, RECIPE_MAX_NIGHT_H);
+        return false;
+    }
+    p->duration_min = (uint32_t)(hours * 60);
+    p->ramp_min = (uint16_t)(ramp_h * 60);
+    p->night_dtemp_c10 = (int16_t)(night_t * 10);
+    p->night_dhum_c10 = (int16_t)(night_h * 10);
+
+    const cJSON *v;
+    if (cJSON_IsNumber(v = cJSON_GetObjectItem(o, "iaq_max")) && v->valueint > 0 && v->valueint <= 500) p->iaq_max = v->valueint;
+
+    // El día puede cruzar la medianoche, así que aquí start > end es válido
+    if ((v = cJSON_GetObjectItem(o, "day"))) {
+        const cJSON *ds = cJSON_GetArrayItem(v, 0);
+        const cJSON *de = cJSON_GetArrayItem(v, 1);
+        if (!cJSON_IsArray(v) || cJSON_GetArraySize(v) != 2 || !cJSON_IsNumber(ds) || !cJSON_IsNumber(de) ||
+            ds->valueint < 0 || ds->valueint > 23 || de->valueint < 0 || de->valueint > 23) {
+            snprintf(err, err_len, "%s: day must be [start_h,end_h] within 0..23", p->name);
+            return false;
+        }
+        p->day_start_h = ds->valueint;
+        p->day_end_h = de->valueint;
+    }
+    return true;
+}
+
+esp_err_t recipe_apply_json(const cJSON *root, char *err, size_t err_len) {
+    const cJSON *phases = cJSON_GetObjectItem(root, "phases");
+    const cJSON *running = cJSON_GetObjectItem(root, "running");
+    const cJSON *phase = cJSON_GetObjectItem(root, "phase");
+    bool new_recipe = cJSON_IsArray(phases);
+
+    recipe_blob_t *blob = NULL;
+    if (new_recipe) {
+        int n = cJSON_GetArraySize(phases);
+        if (n < 1 || n > RECIPE_MAX_PHASES) {
+            snprintf(err, err_len, "phases must have 1..%d entries", RECIPE_MAX_PHASES);
+            return ESP_ERR_INVALID_ARG;
+        }
+        blob = calloc(1, sizeof(*blob));
+        if (!blob) return ESP_ERR_NO_MEM;
+        blob->magic = RECIPE_MAGIC;
+        blob->version = RECIPE_VERSION;
+        blob->count = n;
+        for (int i = 0; i < n; i++) {
+            if (!parse_phase(cJSON_GetArrayItem(phases, i), &blob->phases[i], err, err_len)) {
+                free(blob);
+                return ESP_ERR_INVALID_ARG;
+            }
+        }
+        blob->crc = phases_crc(blob);
+    } else if (!s_recipe.count) {
+        snprintf(err, err_len, "no recipe loaded");
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    uint8_t count = new_recipe ? blob->count : s_recipe.count;
+    if (cJSON_IsNumber(phase) && (phase->valueint < 0 || phase->valueint >= count)) {
+        free(blob);
+        snprintf(err, err_len, "phase out of range");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    time_t now = time(NULL);
+    int64_t now_us = esp_timer_get_time();
+    if (new_recipe) {
+        s_recipe = *blob;
+        free(blob);
+        save_recipe();
+    }
+    // Una receta nueva arranca salvo "running":false explícito
+    bool run = cJSON_IsBool(running) ? cJSON_IsTrue(running) : (new_recipe || s_state.running);
+    if (new_recipe || cJSON_IsNumber(phase)) {
+        s_state.running = run;
+        enter_phase(cJSON_IsNumber(phase) ? phase->valueint : 0, 0, now, now_us);
+    } else if (run != s_state.running) {
+        if (run) resume_locked(now, now_us);
+        else freeze_locked(now, now_us);
+        s_state.running = run;
+        save_state(now_us);
+    }
+    if (!run) s_status.running = false;
+    xSemaphoreGive(s_lock);
+
+    if (run) {
+        fase_actual = &fase_receta;
+        modo_automatico = true;
+        recipe_tick();
+    } else if (fase_actual == &fase_receta) {
+        fase_actual = &fase_germinacion;
+    }
+    guardar_estado_nvs();
+    return ESP_OK;
+}
+
+void recipe_stop(void) {
+    if (!s_state.running) return;
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    int64_t now_us = esp_timer_get_time();
+    freeze_locked(time(NULL), now_us);
+    s_state.running = 0;
+    s_status.running = false;
+    save_state(now_us);
+    xSemaphoreGive(s_lock);
+    ESP_LOGI(TAG, "Receta detenida");
+}
+
+bool recipe_running(void) {
+    return s_state.running;
+}
+
+void recipe_get_status(recipe_status_t *out) {
+    if (!s_lock) {
+        memset(out, 0, sizeof(*out));
+        return;
+    }
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    *out = s_status;
+    out->loaded = s_recipe.count > 0;
+    out->count = s_recipe.count;
+    out->phase = s_state.phase;
+    out->running = s_state.running;
+    xSemaphoreGive(s_lock);
+}
+
+int recipe_format_json(char *buf, size_t cap) {
+    recipe_status_t st;
+    recipe_get_status(&st);
+
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    size_t off = 0;
+    int n = snprintf(buf, cap, "{\"running\":%s,\"phase\":%u,\"elapsed_s\":%lu,\"remaining_s\":%lu,"
+                     "\"night\":%s,\"clock\":%s,\"phases\":[",
+                     st.running ? "true" : "false", st.phase, (unsigned long)st.elapsed_s,
+                     (unsigned long)st.remaining_s, st.night ? "true" : "false",
+                     st.clock_synced ? "true" : "false");
+    for (int i = 0; n >= 0 && (size_t)n < cap - off && i < s_recipe.count; i++) {
+        off += n;
+        const recipe_phase_t *p = &s_recipe.phases[i];
+        n = snprintf(buf + off, cap - off,
+                     "%s{\"name\":\"%s\",\"hours\":%.2f,\"ramp_h\":%.2f,\"temp\":[%.1f,%.1f],\"hum\":[%.1f,%.1f],"
+                     "\"iaq_max\":%u,\"day\":[%u,%u],\"night_temp\":%.1f,\"night_hum\":%.1f}",
+                     i ? "," : "", p->name, p->duration_min / 60.0, p->ramp_min / 60.0,
+                     p->temp_min_c10 / 10.0, p->temp_max_c10 / 10.0, p->hum_min_c10 / 10.0, p->hum_max_c10 / 10.0,
+                     p->iaq_max, p->day_start_h, p->day_end_h, p->night_dtemp_c10 / 10.0, p->night_dhum_c10 / 10.0);
+    }
+    xSemaphoreGive(s_lock);
+    if (n < 0 || (size_t)n >= cap - off) return -1;
+    off += n;
+    n = snprintf(buf + off, cap - off, "]}");
+    if (n < 0 || (size_t)n >= cap - off) return -1;
+    return off + n;
+}
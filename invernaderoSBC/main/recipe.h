@@ -0,0 +1,72 @@
+#ifndef MAIN_RECIPE_H_
+#define MAIN_RECIPE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "cJSON.h"
+
+#include "app_state.h"
+
+/*
+ * Recetas de cultivo: lista de fases con consignas, duración, rampa desde la
+ * fase anterior y horario día/noche.
+ *
+ * La receta se guarda en NVS como blob versionado con CRC y se sube por HTTP
+ * (POST /api/recipe) o por MQTT (atributo compartido "recipe" de ThingsBoard).
+ * Mientras está en marcha, fase_actual apunta a fase_receta, cuyas consignas
+ * recalcula recipe_tick() en tiempo constante. El tiempo en fase sale del
+ * reloj SNTP si está en hora (cuenta también el tiempo apagado) y si no, del
+ * uptime acumulado en NVS.
+ *
+ * Formato JSON:
+ * {"phases":[{"name":"Incubacion","hours":336,"ramp_h":0,"temp":[24,28],
+ *   "hum":[60,70],"iaq_max":200,"day":[8,20],"night_temp":-2,"night_hum":0}],
+ *  "running":true,"phase":0}
+ * hours 0..8760 (0 = indefinida), ramp_h 0..1092, night_temp -20..20, night_hum -50..50.
+ */
+
+#define RECIPE_MAX_PHASES 12
+
+typedef struct {
+    char name[16];
+    uint32_t duration_min;      // 0 = indefinida
+    uint16_t ramp_min;          // Transición lineal desde la fase anterior
+    int16_t temp_min_c10;       // Décimas de grado
+    int16_t temp_max_c10;
+    int16_t hum_min_c10;        // Décimas de %
+    int16_t hum_max_c10;
+    int16_t night_dtemp_c10;    // Desplazamiento nocturno de las consignas
+    int16_t night_dhum_c10;
+    uint16_t iaq_max;           // 0 = valor por defecto
+    uint8_t day_start_h;        // Horas locales; iguales = sin noche
+    uint8_t day_end_h;
+} recipe_phase_t;
+
+typedef struct {
+    bool loaded;
+    bool running;
+    uint8_t phase;
+    uint8_t count;
+    uint32_t elapsed_s;         // En la fase actual
+    uint32_t remaining_s;       // 0 si la fase es indefinida
+    bool night;
+    bool clock_synced;
+} recipe_status_t;
+
+extern FaseCultivo fase_receta;
+
+// Carga receta y progreso desde NVS (NVS ya inicializado)
+void recipe_init(void);
+// Acepta el formato JSON de arriba; err recibe el motivo si se rechaza
+esp_err_t recipe_apply_json(const cJSON *root, char *err, size_t err_len);
+void recipe_stop(void);
+bool recipe_running(void);
+// Avanza de fase si toca y recalcula fase_receta. O(1).
+void recipe_tick(void);
+void recipe_get_status(recipe_status_t *out);
+// Receta + estado en JSON; devuelve la longitud o -1 si no cabe
+int recipe_format_json(char *buf, size_t cap);
+
+#endif /* MAIN_RECIPE_H_ */
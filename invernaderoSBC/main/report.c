@@ -0,0 +1,56 @@
+#include <math.h>
+#include <stdlib.h>
+#include "freertos/FreeRTOS.h"
+
+#include "report.h"
+
+static telemetry_sample_t s_last;
+static int64_t s_last_us = 0;
+static bool s_have_last = false;
+static report_stats_t s_stats;
+static portMUX_TYPE s_report_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static bool exceeds_deadband(const telemetry_sample_t *s) {
+    if (fabsf(s->temperature - s_last.temperature) >= REPORT_DB_TEMP) return true;
+    if (fabsf(s->humidity - s_last.humidity) >= REPORT_DB_HUM) return true;
+    if (fabsf(s->pressure - s_last.pressure) >= REPORT_DB_PRESS) return true;
+    // gas 0 = sin medida válida (calentador sin estabilizar): solo cuenta el cambio de estado
+    if ((s->gas > 0) != (s_last.gas > 0)) return true;
+    if (s_last.gas > 0 && fabsf(s->gas - s_last.gas) >= s_last.gas * (REPORT_DB_GAS_PCT / 100.0f)) return true;
+    if ((s->iaq < 0) != (s_last.iaq < 0) || abs(s->iaq - s_last.iaq) >= REPORT_DB_IAQ) return true;
+    return s->fan != s_last.fan || s->humid != s_last.humid ||
+           s->auto_mode != s_last.auto_mode || s->phase_id != s_last.phase_id;
+}
+
+bool report_should_send(const telemetry_sample_t *s, int64_t now_us) {
+    bool heartbeat = (now_us - s_last_us) >= (int64_t)REPORT_HEARTBEAT_S * 1000000;
+    bool changed = !s_have_last || exceeds_deadband(s);
+    bool send = changed || heartbeat;
+
+    portENTER_CRITICAL(&s_report_lock);
+    s_stats.evaluated++;
+    if (send) {
+        s_stats.sent++;
+        if (!changed) s_stats.heartbeats++;
+    } else {
+        s_stats.suppressed++;
+    }
+    portEXIT_CRITICAL(&s_report_lock);
+
+    if (send) {
+        s_last = *s;
+        s_last_us = now_us;
+        s_have_last = true;
+    }
+    return send;
+}
+
+void report_get_stats(report_stats_t *out) {
+    portENTER_CRITICAL(&s_report_lock);
+    *out = s_stats;
+    portEXIT_CRITICAL(&s_report_lock);
+}
+
+float report_suppression_pct(const report_stats_t *st) {
+    return st->evaluated ? (100.0f * st->suppressed) / st->evaluated : 0.0f;
+}
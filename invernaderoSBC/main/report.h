@@ -0,0 +1,36 @@
+#ifndef MAIN_REPORT_H_
+#define MAIN_REPORT_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "telemetry_codec.h"
+
+/*
+ * Envío por excepción de la telemetría periódica.
+ *
+ * Una muestra solo se publica si algún campo se aleja de la última enviada más
+ * que su banda muerta, si cambian actuadores/modo/fase, o si ha pasado el
+ * latido máximo sin publicar nada. El histórico local sigue guardando todo.
+ */
+
+#define REPORT_DB_TEMP      0.1f    // C
+#define REPORT_DB_HUM       0.5f    // %RH
+#define REPORT_DB_PRESS     1.0f    // hPa
+#define REPORT_DB_GAS_PCT   5.0f    // % relativo a la última resistencia enviada
+#define REPORT_DB_IAQ       10      // Puntos de índice IAQ
+#define REPORT_HEARTBEAT_S  300     // Máximo entre publicaciones aunque nada cambie
+
+typedef struct {
+    uint32_t evaluated;     // Muestras presentadas
+    uint32_t sent;          // Publicadas (incluye latidos)
+    uint32_t heartbeats;    // Publicadas solo por el latido
+    uint32_t suppressed;
+} report_stats_t;
+
+// Devuelve true si hay que publicar la muestra y la toma como nueva referencia
+bool report_should_send(const telemetry_sample_t *s, int64_t now_us);
+void report_get_stats(report_stats_t *out);
+// Porcentaje de muestras suprimidas (0-100)
+float report_suppression_pct(const report_stats_t *st);
+
+#endif /* MAIN_REPORT_H_ */
@@ -0,0 +1,238 @@
+#include <stdio.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "rom/ets_sys.h"
+
+#include "sensor.h"
+#include "i2c_bus.h"
+#include "time_sync.h"
+
+#define TAG "SENSOR"
+
+#define SENSOR_ADDR_LOW     0x76
+#define SENSOR_ADDR_HIGH    0x77
+#define SENSOR_I2C_FREQ_HZ  100000
+#define SENSOR_I2C_TIMEOUT_MS 100   // Un bus colgado no debe bloquear el bucle de control
+#define SENSOR_PROBE_MS     50
+
+static i2c_bus_dev_t *s_dev = NULL;
+static struct bme68x_dev s_bme;
+static struct bme68x_conf s_conf = {
+    .filter = BME68X_FILTER_OFF, .odr = BME68X_ODR_NONE,
+    .os_hum = BME68X_OS_16X, .os_pres = BME68X_OS_1X, .os_temp = BME68X_OS_2X,
+};
+static struct bme68x_heatr_conf s_heatr = { .enable = BME68X_ENABLE, .heatr_temp = 300, .heatr_dur = 100 };
+
+static sensor_health_t s_health;
+static uint32_t s_backoff_ms = SENSOR_RETRY_MIN_MS;
+static int64_t s_next_try_us = 0;
+static portMUX_TYPE s_sensor_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// Por el gestor del bus, con la prioridad más alta: la pantalla espera
+static int8_t bme_i2c_read(uint8_t reg_addr, uint8_t *reg_data, uint32_t len, void *intf_ptr) {
+    i2c_bus_dev_t *dev = *(i2c_bus_dev_t **)intf_ptr;
+    esp_err_t err = i2c_bus_transfer(dev, I2C_BUS_PRIO_HIGH, &reg_addr, 1, reg_data, len, SENSOR_I2C_TIMEOUT_MS);
+    return (err == ESP_OK) ? BME68X_OK : BME68X_E_COM_FAIL;
+}
+
+static int8_t bme_i2c_write(uint8_t reg_addr, const uint8_t *reg_data, uint32_t len, void *intf_ptr) {
+    i2c_bus_dev_t *dev = *(i2c_bus_dev_t **)intf_ptr;
+    uint8_t buffer[I2C_BUS_MAX_WRITE];
+    if (len + 1 > sizeof(buffer)) return BME68X_E_COM_FAIL;
+    buffer[0] = reg_addr; memcpy(buffer + 1, reg_data, len);
+    esp_err_t err = i2c_bus_transfer(dev, I2C_BUS_PRIO_HIGH, buffer, len + 1, NULL, 0, SENSOR_I2C_TIMEOUT_MS);
+    return (err == ESP_OK) ? BME68X_OK : BME68X_E_COM_FAIL;
+}
+
+static void bme_delay_us(uint32_t period, void *intf_ptr) {
+    if (period >= 10000) vTaskDelay(pdMS_TO_TICKS(period / 1000));
+    else ets_delay_us(period);
+}
+
+static void set_state(sensor_state_t st) {
+    portENTER_CRITICAL(&s_sensor_lock);
+    s_health.state = st;
+    portEXIT_CRITICAL(&s_sensor_lock);
+}
+
+// Añade el dispositivo en la dirección que conteste. No toca el bus si no hay nadie
+static bool attach(void) {
+    uint8_t addr = 0;
+    if (i2c_bus_probe(SENSOR_ADDR_LOW, SENSOR_PROBE_MS) == ESP_OK) addr = SENSOR_ADDR_LOW;
+    else if (i2c_bus_probe(SENSOR_ADDR_HIGH, SENSOR_PROBE_MS) == ESP_OK) addr = SENSOR_ADDR_HIGH;
+    if (addr == 0) return false;
+
+    if (s_dev && addr != s_health.addr) {
+        i2c_bus_rm_device(s_dev);
+        s_dev = NULL;
+    }
+    if (!s_dev) {
+        s_dev = i2c_bus_add_device("bme680", addr, SENSOR_I2C_FREQ_HZ, NULL);
+        if (!s_dev) return false;
+    }
+    s_health.addr = addr;
+    return true;
+}
+
+// Reinicio blando, lectura de identificador y calibración, configuración y calentador
+static bool configure(void) {
+    if (!s_dev) return false;
+    s_bme.intf = BME68X_I2C_INTF;
+    s_bme.read = bme_i2c_read;
+    s_bme.write = bme_i2c_write;
+    s_bme.delay_us = bme_delay_us;
+    s_bme.intf_ptr = &s_dev;
+    s_bme.amb_temp = 25;
+    return bme68x_init(&s_bme) == BME68X_OK &&
+           bme68x_set_conf(&s_conf, &s_bme) == BME68X_OK &&
+           bme68x_set_heatr_conf(BME68X_FORCED_MODE, &s_heatr, &s_bme) == BME68X_OK;
+}
+
+static void enter_lost(int64_t now_us) {
+    s_backoff_ms = SENSOR_RETRY_MIN_MS;
+    s_next_try_us = now_us + (int64_t)s_backoff_ms * 1000;
+    portENTER_CRITICAL(&s_sensor_lock);
+    if (!s_health.down_since_us) s_health.down_since_us = now_us;
+    s_health.state = SENSOR_LOST;
+    portEXIT_CRITICAL(&s_sensor_lock);
+}
+
+bool sensor_init(void) {
+    if (attach() && configure()) {
+        ESP_LOGI(TAG, "BME680 en 0x%02x", s_health.addr);
+        set_state(SENSOR_OK);
+        return true;
+    }
+    ESP_LOGE(TAG, "BME680 no encontrado, se reintentará en segundo plano");
+    enter_lost(time_now_us());
+    return false;
+}
+
+// Rango de medida del BME680: fuera de aquí es un fallo de lectura, no el ambiente
+static inline bool plausible(const struct bme68x_data *d) {
+    return d->temperature > -40.0f && d->temperature < 85.0f &&
+           d->humidity >= 0.0f && d->humidity <= 100.0f &&
+           d->pressure > 30000.0f && d->pressure < 110000.0f;
+}
+
+bool sensor_read(struct bme68x_data *out, int64_t now_us) {
+    if (s_health.state == SENSOR_LOST) return false;
+
+    uint8_t n_fields = 0;
+    int8_t rslt = bme68x_set_op_mode(BME68X_FORCED_MODE, &s_bme);
+    if (rslt == BME68X_OK) {
+        uint32_t del_period = bme68x_get_meas_dur(BME68X_FORCED_MODE, &s_conf, &s_bme) + (s_heatr.heatr_dur * 1000);
+        s_bme.delay_us(del_period, s_bme.intf_ptr);
+        rslt = bme68x_get_data(BME68X_FORCED_MODE, out, &n_fields, &s_bme);
+    }
+    bool ok = (rslt == BME68X_OK && n_fields > 0 && plausible(out));
+
+    portENTER_CRITICAL(&s_sensor_lock);
+    s_health.reads++;
+    if (ok) {
+        s_health.consecutive = 0;
+        s_health.down_since_us = 0;
+        s_health.state = SENSOR_OK;
+    } else {
+        s_health.failures++;
+        s_health.consecutive++;
+        if (!s_health.down_since_us) s_health.down_since_us = now_us;
+        s_health.state = SENSOR_DEGRADED;
+    }
+    uint32_t consecutive = s_health.consecutive;
+    portEXIT_CRITICAL(&s_sensor_lock);
+
+    if (!ok && consecutive >= SENSOR_FAILS_LOST) {
+        ESP_LOGW(TAG, "⚠️ %lu lecturas fallidas (rslt %d), recuperando sensor", (unsigned long)consecutive, rslt);
+        enter_lost(now_us);
+    }
+    return ok;
+}
+
+void sensor_force_recovery(int64_t now_us) {
+    if (s_health.state == SENSOR_LOST) return;
+    ESP_LOGW(TAG, "Lecturas congeladas, reinicializando sensor");
+    enter_lost(now_us);
+}
+
+void sensor_service(int64_t now_us) {
+    if (s_health.state != SENSOR_LOST || now_us < s_next_try_us) return;
+
+    bool ok = configure();
+    bool bus_reset = false;
+    if (!ok) {
+        // Un esclavo a medio byte deja SDA abajo: pulsos de SCL y nueva búsqueda
+        bus_reset = (i2c_bus_recover() == ESP_OK);
+        ok = attach() && configure();
+    }
+
+    portENTER_CRITICAL(&s_sensor_lock);
+    s_health.attempts++;
+    if (bus_reset) s_health.bus_resets++;
+    if (ok) {
+        s_health.recoveries++;
+        s_health.consecutive = 0;
+        s_health.down_since_us = 0;
+        s_health.state = SENSOR_OK;
+    }
+    portEXIT_CRITICAL(&s_sensor_lock);
+
+    if (ok) {
+        ESP_LOGI(TAG, "✅ BME680 recuperado en 0x%02x", s_health.addr);
+        s_backoff_ms = SENSOR_RETRY_MIN_MS;
+    } else {
+        s_backoff_ms = (s_backoff_ms * 2 > SENSOR_RETRY_MAX_MS) ? SENSOR_RETRY_MAX_MS : s_backoff_ms * 2;
+        s_next_try_us = now_us + (int64_t)s_backoff_ms * 1000;
+    }
+}
+
+sensor_state_t sensor_state(void) {
+    return s_health.state;
+}
+
+const char *sensor_state_name(sensor_state_t st) {
+    switch (st) {
+    case SENSOR_OK:       return "ok";
+    case SENSOR_DEGRADED: return "degraded";
+    default:              return "lost";
+    }
+}
+
+void sensor_get_health(sensor_health_t *out) {
+    portENTER_CRITICAL(&s_sensor_lock);
+    *out = s_health;
+    portEXIT_CRITICAL(&s_sensor_lock);
+}
+
+static int64_t down_since(void) {
+    portENTER_CRITICAL(&s_sensor_lock);
+    int64_t since = s_health.down_since_us;
+    portEXIT_CRITICAL(&s_sensor_lock);
+    return since;
+}
+
+bool sensor_fallback_active(int64_t now_us) {
+    int64_t since = down_since();
+    return since && (now_us - since) >= (int64_t)SENSOR_FALLBACK_S * 1000000;
+}
+
+void sensor_fallback_outputs(int64_t now_us, bool *fan, bool *humid) {
+    int64_t start = down_since() + (int64_t)SENSOR_FALLBACK_S * 1000000;
+    uint32_t pos = (uint32_t)(((now_us - start) / 1000000) % SENSOR_FB_PERIOD_S);
+    *fan = pos < SENSOR_FB_FAN_ON_S;
+    *humid = pos >= SENSOR_FB_HUMID_AT_S && pos < SENSOR_FB_HUMID_AT_S + SENSOR_FB_HUMID_ON_S;
+}
+
+int sensor_format_health_json(char *buf, size_t cap, int64_t now_us) {
+    sensor_health_t h;
+    sensor_get_health(&h);
+    int64_t ts = time_epoch_ms(now_us);
+    char vals[128];
+    snprintf(vals, sizeof(vals), "\"sensor\":\"%s\",\"sensor_failures\":%lu,\"sensor_recoveries\":%lu,\"i2c_bus_resets\":%lu",
+             sensor_state_name(h.state), (unsigned long)h.failures,
+             (unsigned long)h.recoveries, (unsigned long)h.bus_resets);
+    if (ts) return snprintf(buf, cap, "{\"ts\":%lld,\"values\":{%s}}", (long long)ts, vals);
+    return snprintf(buf, cap, "{%s}", vals);
+}
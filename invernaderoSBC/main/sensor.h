@@ -0,0 +1,72 @@
+#ifndef MAIN_SENSOR_H_
+#define MAIN_SENSOR_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "bme68x.h"
+
+/*
+ * Supervisor del BME680.
+ *
+ * sensor_read() hace la medida forzada y cuenta los fallos (error de I2C, sin
+ * datos nuevos o valores fuera de lo que el sensor puede dar). Tras
+ * SENSOR_FAILS_LOST fallos seguidos el sensor se da por perdido y
+ * sensor_service() lo recupera en segundo plano, con espera exponencial entre
+ * intentos: primero reinicio y recarga de calibración; si no contesta, reinicio
+ * del bus I2C (pulsos de SCL) y nueva búsqueda en 0x76/0x77. Cada intento está
+ * acotado en tiempo y se hace entre pasadas del bucle. Todo el tráfico va por
+ * el gestor del bus (i2c_bus.h) con prioridad alta, por delante de la pantalla.
+ *
+ * Con el sensor caído más de SENSOR_FALLBACK_S el modo automático pasa a ciclos
+ * fijos de ventilación y humidificación en lugar de dejar los relés congelados.
+ */
+
+#define SENSOR_FAILS_LOST       3       // Fallos seguidos para pasar a recuperación
+#define SENSOR_RETRY_MIN_MS     1000
+#define SENSOR_RETRY_MAX_MS     60000
+#define SENSOR_FALLBACK_S       60      // Caído más que esto: ciclos fijos
+#define SENSOR_FB_PERIOD_S      1800
+#define SENSOR_FB_FAN_ON_S      300     // Al inicio de cada periodo
+#define SENSOR_FB_HUMID_AT_S    900     // Humidificación a mitad de periodo, lejos del ventilador
+#define SENSOR_FB_HUMID_ON_S    180
+
+typedef enum {
+    SENSOR_OK = 0,
+    SENSOR_DEGRADED,    // Algún fallo reciente, se sigue leyendo
+    SENSOR_LOST,        // En recuperación, no se lee
+} sensor_state_t;
+
+typedef struct {
+    sensor_state_t state;
+    uint8_t addr;               // 0 = no encontrado
+    uint32_t reads;
+    uint32_t failures;
+    uint32_t consecutive;
+    uint32_t recoveries;        // Vueltas a OK desde recuperación
+    uint32_t attempts;          // Intentos de recuperación
+    uint32_t bus_resets;
+    int64_t down_since_us;      // 0 = funcionando
+} sensor_health_t;
+
+// Busca e inicializa el sensor; si no está queda en recuperación
+bool sensor_init(void);
+// Medida forzada (bloquea lo que dura la conversión). false sin lectura válida
+bool sensor_read(struct bme68x_data *out, int64_t now_us);
+// Paso de recuperación si toca; llamar en cada pasada del bucle
+void sensor_service(int64_t now_us);
+// Lecturas válidas pero congeladas: se fuerza una reinicialización
+void sensor_force_recovery(int64_t now_us);
+
+sensor_state_t sensor_state(void);
+const char *sensor_state_name(sensor_state_t st);
+void sensor_get_health(sensor_health_t *out);
+
+// Política de emergencia del modo automático
+bool sensor_fallback_active(int64_t now_us);
+void sensor_fallback_outputs(int64_t now_us, bool *fan, bool *humid);
+
+// Salud para ThingsBoard (con ts si hay hora real)
+int sensor_format_health_json(char *buf, size_t cap, int64_t now_us);
+
+#endif /* MAIN_SENSOR_H_ */
@@ -0,0 +1,268 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include "esp_cpu.h"
+
+#include "telemetry_codec.h"
+
+typedef struct {
+    uint8_t *p;
+    uint8_t *end;
+    bool overflow;
+} wbuf_t;
+
+static inline void put(wbuf_t *w, const void *src, size_t n) {
+    if (w->overflow || (size_t)(w->end - w->p) < n) {
+        w->overflow = true;
+        return;
+    }
+    memcpy(w->p, src, n);
+    w->p += n;
+}
+
+static inline void put_byte(wbuf_t *w, uint8_t b) {
+    put(w, &b, 1);
+}
+
+static inline void put_str(wbuf_t *w, const char *s) {
+    put(w, s, strlen(s));
+}
+
+static int finish(wbuf_t *w, uint8_t *buf) {
+    return w->overflow ? -1 : (int)(w->p - buf);
+}
+
+// ------------------------------------------------------------------ JSON
+
+// Punto fijo con 0 o 2 decimales, mismo resultado que "%.0f"/"%.2f" salvo empates de redondeo
+static void put_fixed(wbuf_t *w, float v, int decimals) {
+    char tmp[16];
+    int n = 0;
+    bool neg = v < 0;
+    if (neg) v = -v;
+    if (decimals && v > 40000000.0f) v = 40000000.0f;
+    uint32_t scaled = (uint32_t)(v * (decimals ? 100.0f : 1.0f) + 0.5f);
+
+    for (int d = 0; d < decimals; d++) {
+        tmp[n++] = '0' + scaled % 10;
+        scaled /= 10;
+    }
+    if (decimals) tmp[n++] = '.';
+    do {
+        tmp[n++] = '0' + scaled % 10;
+        scaled /= 10;
+    } while (scaled);
+    if (neg) tmp[n++] = '-';
+
+    char out[16];
+    for (int i = 0; i < n; i++) out[i] = tmp[n - 1 - i];
+    put(w, out, n);
+}
+
+static void put_uint_dec(wbuf_t *w, uint32_t v) {
+    char tmp[10], out[10];
+    int n = 0;
+    do {
+        tmp[n++] = '0' + v % 10;
+        v /= 10;
+    } while (v);
+    for (int i = 0; i < n; i++) out[i] = tmp[n - 1 - i];
+    put(w, out, n);
+}
+
+static void put_u64_dec(wbuf_t *w, uint64_t v) {
+    char tmp[20], out[20];
+    int n = 0;
+    do {
+        tmp[n++] = '0' + v % 10;
+        v /= 10;
+    } while (v);
+    for (int i = 0; i < n; i++) out[i] = tmp[n - 1 - i];
+    put(w, out, n);
+}
+
+static int json_encode(const telemetry_sample_t *s, uint8_t *buf, size_t cap) {
+    wbuf_t w = { .p = buf, .end = buf + cap };
+    if (s->ts_ms > 0) {
+        put_str(&w, "{\"ts\":");
+        put_u64_dec(&w, s->ts_ms);
+        put_str(&w, ",\"values\":");
+    }
+    put_byte(&w, '{');
+    if (s->uptime_s) {
+        put_str(&w, "\"t\":");
+        put_uint_dec(&w, s->uptime_s);
+        put_byte(&w, ',');
+    }
+    put_str(&w, "\"temperature\":");
+    put_fixed(&w, s->temperature, 2);
+    put_str(&w, ",\"humidity\":");
+    put_fixed(&w, s->humidity, 2);
+    put_str(&w, ",\"pressure\":");
+    put_fixed(&w, s->pressure, 2);
+    put_str(&w, ",\"gas\":");
+    put_fixed(&w, s->gas, 0);
+    if (s->derived) {
+        put_str(&w, ",\"dew_point\":");
+        put_fixed(&w, s->dew_point, 2);
+        put_str(&w, ",\"vpd\":");
+        put_fixed(&w, s->vpd, 2);
+        put_str(&w, ",\"abs_hum\":");
+        put_fixed(&w, s->abs_hum, 2);
+    }
+    if (s->iaq >= 0) {
+        put_str(&w, ",\"iaq\":");
+        put_uint_dec(&w, s->iaq);
+    }
+    if (s->auto_mode >= 0) {
+        put_str(&w, ",\"auto\":");
+        put_uint_dec(&w, s->auto_mode);
+    }
+    put_str(&w, ",\"fan\":");
+    put_uint_dec(&w, s->fan);
+    put_str(&w, ",\"humid\":");
+    put_uint_dec(&w, s->humid);
+    if (s->phase_id >= 0) {
+        put_str(&w, ",\"phase_id\":");
+        put_uint_dec(&w, s->phase_id);
+    }
+    put_byte(&w, '}');
+    if (s->ts_ms > 0) put_byte(&w, '}');
+    return finish(&w, buf);
+}
+
+// ------------------------------------------------------------------ CBOR
+
+static void cbor_head(wbuf_t *w, uint8_t major, uint64_t v) {
+    uint8_t h[9];
+    major <<= 5;
+    if (v < 24) {
+        put_byte(w, major | v);
+    } else if (v <= 0xFF) {
+        h[0] = major | 24; h[1] = v;
+        put(w, h, 2);
+    } else if (v <= 0xFFFF) {
+        h[0] = major | 25; h[1] = v >> 8; h[2] = v;
+        put(w, h, 3);
+    } else if (v <= 0xFFFFFFFF) {
+        h[0] = major | 26; h[1] = v >> 24; h[2] = v >> 16; h[3] = v >> 8; h[4] = v;
+        put(w, h, 5);
+    } else {
+        h[0] = major | 27;
+        for (int i = 0; i < 8; i++) h[1 + i] = v >> (56 - 8 * i);
+        put(w, h, 9);
+    }
+}
+
+static void cbor_key(wbuf_t *w, const char *key) {
+    size_t n = strlen(key);
+    cbor_head(w, 3, n);
+    put(w, key, n);
+}
+
+static void cbor_float(wbuf_t *w, float v) {
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    uint8_t b[5] = { 0xFA, bits >> 24, bits >> 16, bits >> 8, bits };
+    put(w, b, sizeof(b));
+}
+
+static int cbor_encode(const telemetry_sample_t *s, uint8_t *buf, size_t cap) {
+    wbuf_t w = { .p = buf, .end = buf + cap };
+    uint32_t fields = 6 + (s->ts_ms > 0) + (s->uptime_s != 0) + (s->derived ? 3 : 0) + (s->iaq >= 0) + (s->auto_mode >= 0) + (s->phase_id >= 0);
+    cbor_head(&w, 5, fields);
+    if (s->ts_ms > 0) {
+        cbor_key(&w, "ts");
+        cbor_head(&w, 0, s->ts_ms);
+    }
+    if (s->uptime_s) {
+        cbor_key(&w, "t");
+        cbor_head(&w, 0, s->uptime_s);
+    }
+    cbor_key(&w, "tc");
+    cbor_float(&w, s->temperature);
+    cbor_key(&w, "rh");
+    cbor_float(&w, s->humidity);
+    cbor_key(&w, "p");
+    cbor_float(&w, s->pressure);
+    cbor_key(&w, "g");
+    cbor_head(&w, 0, s->gas > 0 ? (uint32_t)(s->gas + 0.5f) : 0);
+    if (s->derived) {
+        cbor_key(&w, "dp");
+        cbor_float(&w, s->dew_point);
+        cbor_key(&w, "vpd");
+        cbor_float(&w, s->vpd);
+        cbor_key(&w, "ah");
+        cbor_float(&w, s->abs_hum);
+    }
+    if (s->iaq >= 0) {
+        cbor_key(&w, "q");
+        cbor_head(&w, 0, s->iaq);
+    }
+    if (s->auto_mode >= 0) {
+        cbor_key(&w, "a");
+        put_byte(&w, s->auto_mode ? 0xF5 : 0xF4);
+    }
+    cbor_key(&w, "f");
+    cbor_head(&w, 0, s->fan);
+    cbor_key(&w, "u");
+    cbor_head(&w, 0, s->humid);
+    if (s->phase_id >= 0) {
+        cbor_key(&w, "ph");
+        cbor_head(&w, 0, s->phase_id);
+    }
+    return finish(&w, buf);
+}
+
+// ------------------------------------------------------------------ Registro
+
+const telemetry_encoder_t telemetry_json = {
+    .name = "json",
+    .content_type = "application/json",
+    .encode = json_encode,
+    .array_open = "[",
+    .array_sep = ",",
+    .array_close = "]",
+};
+
+const telemetry_encoder_t telemetry_cbor = {
+    .name = "cbor",
+    .content_type = "application/cbor",
+    .encode = cbor_encode,
+    .array_open = "\x9f",       // Array de longitud indefinida
+    .array_sep = "",
+    .array_close = "\xff",
+};
+
+const telemetry_encoder_t *telemetry_encoder_find(const char *name) {
+    if (!name || strcmp(name, "json") == 0) return &telemetry_json;
+    if (strcmp(name, "cbor") == 0) return &telemetry_cbor;
+    return NULL;
+}
+
+// ------------------------------------------------------------------ Benchmark
+
+static int printf_encode(const telemetry_sample_t *s, uint8_t *buf, size_t cap) {
+    return snprintf((char *)buf, cap,
+        "{\"temperature\":%.2f,\"humidity\":%.2f,\"pressure\":%.2f,\"gas\":%.0f,\"auto\":%d,\"fan\":%d,\"humid\":%d,\"phase_id\":%d}",
+        s->temperature, s->humidity, s->pressure, s->gas, s->auto_mode, s->fan, s->humid, s->phase_id);
+}
+
+static uint32_t bench_one(int (*encode)(const telemetry_sample_t *, uint8_t *, size_t),
+                          const telemetry_sample_t *s, uint32_t iterations, uint16_t *bytes) {
+    uint8_t buf[TELEMETRY_MAX_LEN];
+    int len = 0;
+    uint32_t start = esp_cpu_get_cycle_count();
+    for (uint32_t i = 0; i < iterations; i++) len = encode(s, buf, sizeof(buf));
+    uint32_t cycles = esp_cpu_get_cycle_count() - start;
+    *bytes = (len > 0) ? len : 0;
+    return cycles / iterations;
+}
+
+void telemetry_codec_benchmark(const telemetry_sample_t *s, uint32_t iterations, telemetry_bench_t *out) {
+    if (iterations == 0) iterations = 1;
+    out->iterations = iterations;
+    out->printf_cycles = bench_one(printf_encode, s, iterations, &out->printf_bytes);
+    out->json_cycles = bench_one(json_encode, s, iterations, &out->json_bytes);
+    out->cbor_cycles = bench_one(cbor_encode, s, iterations, &out->cbor_bytes);
+}
@@ -0,0 +1,74 @@
+#ifndef MAIN_TELEMETRY_CODEC_H_
+#define MAIN_TELEMETRY_CODEC_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Codificadores de muestras de telemetría.
+ *
+ * Hay dos formatos intercambiables con la misma interfaz: JSON (el que entiende
+ * ThingsBoard y el dashboard) y CBOR (RFC 8949, unas 3 veces más pequeño). Ninguno
+ * usa printf de coma flotante: los valores se escriben en punto fijo (JSON) o
+ * como float32 binario (CBOR). Cada endpoint elige el suyo.
+ *
+ * Si la muestra lleva hora real (ts_ms), el JSON va en el formato con marca de
+ * tiempo de ThingsBoard, {"ts":<ms>,"values":{...}}, y el CBOR añade la clave ts.
+ *
+ * Claves JSON: t, temperature, humidity, pressure, gas, dew_point, vpd, abs_hum, iaq,
+ *              auto, fan, humid, phase_id
+ * Claves CBOR: ts, t, tc, rh, p, g, dp, vpd, ah, q, a, f, u, ph
+ */
+
+typedef struct {
+    int64_t ts_ms;          // Época de la adquisición en ms, 0 = la pone el servidor
+    uint32_t uptime_s;      // 0 = no se incluye
+    float temperature;
+    float humidity;
+    float pressure;         // hPa
+    float gas;              // Ohm
+    bool derived;           // Incluir dew_point/vpd/abs_hum
+    float dew_point;        // C
+    float vpd;              // kPa
+    float abs_hum;          // g/m3
+    int16_t iaq;            // 0-500, -1 = no se incluye
+    uint8_t fan;
+    uint8_t humid;
+    int8_t auto_mode;       // -1 = no se incluye
+    int8_t phase_id;        // -1 = no se incluye
+} telemetry_sample_t;
+
+typedef struct {
+    const char *name;           // "json" / "cbor"
+    const char *content_type;
+    // Devuelve los bytes escritos o -1 si no caben en cap
+    int (*encode)(const telemetry_sample_t *s, uint8_t *buf, size_t cap);
+    // Delimitadores para enviar varias muestras en streaming como un array
+    const char *array_open;
+    const char *array_sep;
+    const char *array_close;
+} telemetry_encoder_t;
+
+#define TELEMETRY_MAX_LEN 256   // Peor caso de cualquier codificador
+
+extern const telemetry_encoder_t telemetry_json;
+extern const telemetry_encoder_t telemetry_cbor;
+
+// Busca por nombre ("json"/"cbor"); NULL si no existe
+const telemetry_encoder_t *telemetry_encoder_find(const char *name);
+
+typedef struct {
+    uint32_t iterations;
+    uint32_t printf_cycles;     // Ciclos por muestra con el snprintf("%.2f") anterior
+    uint32_t json_cycles;
+    uint32_t cbor_cycles;
+    uint16_t printf_bytes;
+    uint16_t json_bytes;
+    uint16_t cbor_bytes;
+} telemetry_bench_t;
+
+// Mide ciclos de CPU y bytes por muestra de cada codificador
+void telemetry_codec_benchmark(const telemetry_sample_t *s, uint32_t iterations, telemetry_bench_t *out);
+
+#endif /* MAIN_TELEMETRY_CODEC_H_ */
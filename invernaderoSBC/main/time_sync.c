@@ -0,0 +1,83 @@
+#include <stdlib.h>
+#include <time.h>
+#include <sys/time.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_log.h"
+#include "esp_netif_sntp.h"
+
+#include "time_sync.h"
+
+#define TAG "TIME"
+
+static bool s_synced = false;
+static uint32_t s_syncs = 0;
+static int64_t s_last_sync_us = 0;
+static int64_t s_offset_us = 0;         // Época - monotónico en la última sincronización
+static int32_t s_last_step_ms = 0;
+static portMUX_TYPE s_time_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static inline int64_t wall_us(void) {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (int64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+// Se ejecuta en la tarea de lwIP justo después de ajustar el reloj
+static void on_sync(struct timeval *tv) {
+    int64_t mono = esp_timer_get_time();
+    int64_t offset = (int64_t)tv->tv_sec * 1000000 + tv->tv_usec - mono;
+
+    portENTER_CRITICAL(&s_time_lock);
+    int32_t step = s_synced ? (int32_t)((offset - s_offset_us) / 1000) : 0;
+    s_offset_us = offset;
+    s_last_step_ms = step;
+    s_last_sync_us = mono;
+    s_syncs++;
+    bool first = !s_synced;
+    s_synced = true;
+    portEXIT_CRITICAL(&s_time_lock);
+
+    if (first) ESP_LOGI(TAG, "🕒 Hora sincronizada por SNTP");
+    else ESP_LOGD(TAG, "Resincronizado, corrección %ld ms", (long)step);
+}
+
+void time_sync_init(const char *tz) {
+    setenv("TZ", tz, 1);
+    tzset();
+}
+
+void time_sync_start(const char *server) {
+    static bool started = false;
+    if (started) return;
+    started = true;
+
+    esp_sntp_config_t cfg = ESP_NETIF_SNTP_DEFAULT_CONFIG(server);
+    cfg.sync_cb = on_sync;
+    esp_netif_sntp_init(&cfg);
+}
+
+bool time_is_valid(void) {
+    // El RTC conserva la hora en un reinicio por software aunque SNTP aún no haya respondido
+    return s_synced || time(NULL) >= TIME_EPOCH_VALID;
+}
+
+int64_t time_epoch_us(int64_t mono_us) {
+    // Se usa el reloj actual y no el desfase guardado para seguir los ajustes suaves de SNTP
+    int64_t now_mono = esp_timer_get_time();
+    int64_t now_wall = wall_us();
+    if (now_wall < (int64_t)TIME_EPOCH_VALID * 1000000) return 0;
+    return now_wall - (now_mono - mono_us);
+}
+
+int64_t time_epoch_ms(int64_t mono_us) {
+    return time_epoch_us(mono_us) / 1000;
+}
+
+void time_sync_get_stats(time_sync_stats_t *out) {
+    portENTER_CRITICAL(&s_time_lock);
+    out->syncs = s_syncs;
+    out->last_sync_us = s_last_sync_us;
+    out->last_step_ms = s_last_step_ms;
+    portEXIT_CRITICAL(&s_time_lock);
+    out->valid = time_is_valid();
+}
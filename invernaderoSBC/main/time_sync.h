@@ -0,0 +1,45 @@
+#ifndef MAIN_TIME_SYNC_H_
+#define MAIN_TIME_SYNC_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_timer.h"
+
+/*
+ * Servicio de hora.
+ *
+ * Las marcas de tiempo del firmware son microsegundos monotónicos (esp_timer,
+ * desde el arranque) tomados en el momento de la adquisición. Solo se pasan a
+ * hora real (época Unix) al publicarlas, con el desfase que da SNTP en ese
+ * momento: una muestra tomada antes de sincronizar conserva su instante real
+ * si el reloj se pone en hora antes de enviarla, y los saltos de SNTP no
+ * desordenan nada de lo que se mide en local.
+ */
+
+#define TIME_EPOCH_VALID 1700000000 // Antes de esto el reloj no está en hora
+
+typedef struct {
+    bool valid;                 // Hay hora real (SNTP o RTC conservado tras reinicio)
+    uint32_t syncs;
+    int64_t last_sync_us;       // Monotónico, 0 = nunca
+    int32_t last_step_ms;       // Corrección de la última sincronización respecto a la anterior
+} time_sync_stats_t;
+
+// Zona horaria POSIX para localtime; llamar al arrancar
+void time_sync_init(const char *tz);
+// Arranca SNTP; llamar con IP
+void time_sync_start(const char *server);
+
+// Marca de tiempo monotónica en us
+static inline int64_t time_now_us(void) {
+    return esp_timer_get_time();
+}
+
+bool time_is_valid(void);
+// Convierte una marca monotónica a época en us; 0 si el reloj no está en hora
+int64_t time_epoch_us(int64_t mono_us);
+// Igual, en ms (lo que espera ThingsBoard en "ts")
+int64_t time_epoch_ms(int64_t mono_us);
+void time_sync_get_stats(time_sync_stats_t *out);
+
+#endif /* MAIN_TIME_SYNC_H_ */
@@ -0,0 +1,128 @@
+#include <stdio.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+
+#include "trace.h"
+
+// 4 cubetas lineales (0-3 us) + 4 sub-cubetas por octava hasta 2^26 us (~67 s)
+#define TRACE_SUB_BITS      2
+#define TRACE_SUBS          (1 << TRACE_SUB_BITS)
+#define TRACE_MAX_MSB       25
+#define TRACE_BUCKETS       (TRACE_SUBS + (TRACE_MAX_MSB - TRACE_SUB_BITS + 1) * TRACE_SUBS)
+
+typedef struct {
+    uint32_t buckets[TRACE_BUCKETS];
+    uint32_t count;
+    uint32_t max_us;
+} trace_hist_t;
+
+static trace_hist_t s_hist[TRACE_STAGE_COUNT];
+static portMUX_TYPE s_trace_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static const char *s_stage_names[TRACE_STAGE_COUNT] = {
+    [TRACE_LOOP] = "loop",
+    [TRACE_SENSOR] = "sensor",
+    [TRACE_CONTROL] = "control",
+    [TRACE_OLED] = "oled",
+    [TRACE_TELEMETRY] = "telemetry",
+    [TRACE_SAMPLE_AGE] = "sample_age",
+};
+
+static inline int bucket_index(uint32_t us) {
+    if (us < TRACE_SUBS) return (int)us;
+    int msb = 31 - __builtin_clz(us);
+    if (msb > TRACE_MAX_MSB) return TRACE_BUCKETS - 1;
+    int sub = (us >> (msb - TRACE_SUB_BITS)) & (TRACE_SUBS - 1);
+    return TRACE_SUBS + (msb - TRACE_SUB_BITS) * TRACE_SUBS + sub;
+}
+
+// Límite superior (inclusive) de la cubeta, para informar percentiles conservadores
+static uint32_t bucket_upper(int idx) {
+    if (idx < TRACE_SUBS) return (uint32_t)idx;
+    int octave = (idx - TRACE_SUBS) / TRACE_SUBS;
+    int sub = (idx - TRACE_SUBS) % TRACE_SUBS;
+    uint32_t step = 1u << octave;
+    return ((uint32_t)(TRACE_SUBS + sub) << octave) + step - 1;
+}
+
+void trace_record(trace_stage_t stage, uint32_t elapsed_us) {
+    if (stage >= TRACE_STAGE_COUNT) return;
+    int idx = bucket_index(elapsed_us);
+    trace_hist_t *h = &s_hist[stage];
+    portENTER_CRITICAL(&s_trace_lock);
+    h->buckets[idx]++;
+    h->count++;
+    if (elapsed_us > h->max_us) h->max_us = elapsed_us;
+    portEXIT_CRITICAL(&s_trace_lock);
+}
+
+void trace_end(trace_stage_t stage, int64_t start_us) {
+    int64_t elapsed = esp_timer_get_time() - start_us;
+    if (elapsed < 0) elapsed = 0;
+    if (elapsed > UINT32_MAX) elapsed = UINT32_MAX;
+    trace_record(stage, (uint32_t)elapsed);
+}
+
+static uint32_t percentile(const trace_hist_t *h, uint32_t pct) {
+    if (h->count == 0) return 0;
+    uint32_t rank = (uint32_t)(((uint64_t)h->count * pct + 99) / 100);
+    uint32_t acc = 0;
+    for (int i = 0; i < TRACE_BUCKETS; i++) {
+        acc += h->buckets[i];
+        if (acc >= rank) {
+            uint32_t up = bucket_upper(i);
+            return (up < h->max_us) ? up : h->max_us;
+        }
+    }
+    return h->max_us;
+}
+
+void trace_get_summary(trace_stage_t stage, trace_summary_t *out) {
+    memset(out, 0, sizeof(*out));
+    if (stage >= TRACE_STAGE_COUNT) return;
+
+    // Copia local para no mantener la sección crítica mientras se recorre
+    trace_hist_t snap;
+    portENTER_CRITICAL(&s_trace_lock);
+    memcpy(&snap, &s_hist[stage], sizeof(snap));
+    portEXIT_CRITICAL(&s_trace_lock);
+
+    out->count = snap.count;
+    out->max_us = snap.max_us;
+    out->p50_us = percentile(&snap, 50);
+    out->p95_us = percentile(&snap, 95);
+    out->p99_us = percentile(&snap, 99);
+}
+
+const char *trace_stage_name(trace_stage_t stage) {
+    return (stage < TRACE_STAGE_COUNT) ? s_stage_names[stage] : "?";
+}
+
+void trace_reset(void) {
+    portENTER_CRITICAL(&s_trace_lock);
+    memset(s_hist, 0, sizeof(s_hist));
+    portEXIT_CRITICAL(&s_trace_lock);
+}
+
+int trace_format_json(char *buf, size_t len) {
+    size_t off = 0;
+    int n = snprintf(buf, len, "{");
+    if (n < 0 || (size_t)n >= len) return -1;
+    off = n;
+
+    for (int s = 0; s < TRACE_STAGE_COUNT; s++) {
+        trace_summary_t sum;
+        trace_get_summary((trace_stage_t)s, &sum);
+        n = snprintf(buf + off, len - off,
+            "%s\"%s\":{\"n\":%lu,\"p50\":%lu,\"p95\":%lu,\"p99\":%lu,\"max\":%lu}",
+            s ? "," : "", s_stage_names[s],
+            (unsigned long)sum.count, (unsigned long)sum.p50_us, (unsigned long)sum.p95_us,
+            (unsigned long)sum.p99_us, (unsigned long)sum.max_us);
+        if (n < 0 || (size_t)n >= len - off) return -1;
+        off += n;
+    }
+
+    n = snprintf(buf + off, len - off, "}");
+    if (n < 0 || (size_t)n >= len - off) return -1;
+    return (int)(off + n);
+}
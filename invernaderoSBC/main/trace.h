@@ -0,0 +1,50 @@
+#ifndef MAIN_TRACE_H_
+#define MAIN_TRACE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_timer.h"
+
+/*
+ * Trazas ligeras del bucle de control.
+ *
+ * Cada etapa se mide con un par trace_begin()/trace_end() y el tiempo se
+ * acumula en un histograma de cubetas fijas (4 sub-cubetas por potencia de 2,
+ * error relativo < 25%) que vive en RAM. No hay malloc ni logs en el camino
+ * caliente: trace_end() solo calcula el índice y suma un contador.
+ */
+
+typedef enum {
+    TRACE_LOOP = 0,      // Pasada completa del while(1) de app_main
+    TRACE_SENSOR,        // Medida forzada del BME680 (incluye la espera)
+    TRACE_CONTROL,       // Filtrado + check_auto_control + lecturas de GPIO
+    TRACE_OLED,          // Composición y envío de un cuadro (tarea de pantalla)
+    TRACE_TELEMETRY,     // Formateo y publicación MQTT
+    TRACE_SAMPLE_AGE,    // De la adquisición de la muestra a su entrada en el outbox
+    TRACE_STAGE_COUNT
+} trace_stage_t;
+
+typedef struct {
+    uint32_t count;
+    uint32_t p50_us;
+    uint32_t p95_us;
+    uint32_t p99_us;
+    uint32_t max_us;
+} trace_summary_t;
+
+static inline int64_t trace_begin(void) {
+    return esp_timer_get_time();
+}
+
+void trace_end(trace_stage_t stage, int64_t start_us);
+void trace_record(trace_stage_t stage, uint32_t elapsed_us);
+
+void trace_get_summary(trace_stage_t stage, trace_summary_t *out);
+const char *trace_stage_name(trace_stage_t stage);
+void trace_reset(void);
+
+// Vuelca todos los resúmenes como objeto JSON. Devuelve la longitud escrita
+// (sin el '\0') o -1 si el buffer es demasiado pequeño.
+int trace_format_json(char *buf, size_t len);
+
+#endif /* MAIN_TRACE_H_ */
@@ -0,0 +1,445 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include <esp_http_server.h>
+#include "driver/gpio.h"
+#include "cJSON.h"
+
+#include "web_server.h"
+#include "alarms.h"
+#include "app_state.h"
+#include "history.h"
+#include "iaq.h"
+#include "live_stream.h"
+#include "mqtt_outbox.h"
+#include "psychro.h"
+#include "recipe.h"
+#include "report.h"
+#include "sensor.h"
+#include "telemetry_codec.h"
+#include "time_sync.h"
+#include "trace.h"
+#include "wifi_manager.h"
+
+#define TAG "WEB_SERVER"
+
+#define WEB_MAX_BODY      256   // Límite de cuerpo en POST /api/*
+#define WEB_CHUNK_LEN     1024  // Trozos del dashboard servidos desde flash
+#define WEB_HISTORY_BATCH 16    // Muestras por chunk en /api/history
+#define WEB_HISTORY_SAMPLE 160  // Reserva por muestra del histórico (con ts)
+#define WEB_RECIPE_BODY   2048  // Límite de POST /api/recipe (se reserva en heap)
+#define WEB_ALARMS_JSON   1280
+#define WEB_TASK_STACK    8192  // /api/history (~2.5 KB) y /api/status (1.3 KB + printf de float) en pila
+
+// Dashboard comprimido en tiempo de compilación (ver CMakeLists.txt)
+extern const uint8_t index_html_gz_start[] asm("_binary_index_html_gz_start");
+extern const uint8_t index_html_gz_end[]   asm("_binary_index_html_gz_end");
+
+static httpd_handle_t s_server = NULL;
+
+static esp_err_t send_json(httpd_req_t *req, const char *json) {
+    httpd_resp_set_type(req, "application/json");
+    httpd_resp_set_hdr(req, "Cache-Control", "no-store");
+    return httpd_resp_send(req, json, HTTPD_RESP_USE_STRLEN);
+}
+
+// Lee el cuerpo completo con límite fijo. Devuelve la longitud o -1 si no cabe/falla.
+static int read_body(httpd_req_t *req, char *buf, size_t cap) {
+    if (req->content_len == 0 || req->content_len >= cap) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "body too large or empty");
+        return -1;
+    }
+    size_t off = 0;
+    while (off < req->content_len) {
+        int ret = httpd_req_recv(req, buf + off, req->content_len - off);
+        if (ret == HTTPD_SOCK_ERR_TIMEOUT) continue;
+        if (ret <= 0) return -1;
+        off += ret;
+    }
+    buf[off] = '\0';
+    return (int)off;
+}
+
+static esp_err_t index_get_handler(httpd_req_t *req) {
+    httpd_resp_set_type(req, "text/html");
+    httpd_resp_set_hdr(req, "Content-Encoding", "gzip");
+    httpd_resp_set_hdr(req, "Cache-Control", "max-age=3600");
+
+    // Se envía directamente desde flash, sin copiar a RAM
+    const uint8_t *p = index_html_gz_start;
+    while (p < index_html_gz_end) {
+        size_t n = index_html_gz_end - p;
+        if (n > WEB_CHUNK_LEN) n = WEB_CHUNK_LEN;
+        if (httpd_resp_send_chunk(req, (const char *)p, n) != ESP_OK) {
+            httpd_resp_send_chunk(req, NULL, 0);
+            return ESP_FAIL;
+        }
+        p += n;
+    }
+    return httpd_resp_send_chunk(req, NULL, 0);
+}
+
+static esp_err_t status_get_handler(httpd_req_t *req) {
+    history_sample_t last = {0};
+    bool valid = history_latest(&last);
+    psychro_t psy;
+    psychro_compute(last.temperature, last.humidity, &psy);
+
+    live_stream_stats_t ws;
+    live_stream_get_stats(&ws);
+    wifi_manager_stats_t wifi;
+    wifi_manager_get_stats(&wifi);
+    mqtt_outbox_stats_t outbox;
+    mqtt_outbox_get_stats(&outbox);
+    report_stats_t rep;
+    report_get_stats(&rep);
+    iaq_result_t iaq;
+    bool iaq_ok = iaq_latest(&iaq);
+    time_sync_stats_t ts;
+    time_sync_get_stats(&ts);
+    alarm_stats_t al;
+    alarms_get_stats(&al);
+    sensor_health_t sh;
+    sensor_get_health(&sh);
+
+    char json[1280];
+    snprintf(json, sizeof(json),
+        "{\"valid\":%s,\"temperature\":%.2f,\"humidity\":%.2f,\"pressure\":%.1f,\"gas\":%.0f,"
+        "\"dew_point\":%.2f,\"vpd\":%.2f,\"abs_hum\":%.2f,"
+        "\"auto\":%s,\"phase\":\"%s\",\"fan\":%d,\"humid\":%d,\"mqtt\":%s,\"uptime_s\":%lu,"
+        "\"ws_clients\":%u,\"ws_dropped\":%lu,\"alarms_active\":%lu,"
+        "\"wifi\":{\"rssi\":%d,\"ch\":%u,\"reconnects\":%lu,\"last_ms\":%lu,\"best_ms\":%lu,\"worst_ms\":%lu,"
+        "\"attempts\":%lu,\"fast\":%lu},"
+        "\"outbox\":{\"pending\":%lu,\"sent\":%lu,\"acked\":%lu,\"evicted\":%lu},"
+        "\"report\":{\"sent\":%lu,\"heartbeats\":%lu,\"suppressed\":%lu,\"suppressed_pct\":%.1f},"
+        "\"iaq\":{\"valid\":%s,\"value\":%.0f,\"accuracy\":%d,\"baseline\":%.0f},"
+        "\"time\":{\"valid\":%s,\"epoch_ms\":%lld,\"syncs\":%lu,\"step_ms\":%ld},"
+        "\"sensor\":{\"state\":\"%s\",\"addr\":%u,\"failures\":%lu,\"recoveries\":%lu,\"attempts\":%lu,"
+        "\"bus_resets\":%lu,\"fallback\":%s}}",
+        valid ? "true" : "false", last.temperature, last.humidity, last.pressure, last.gas,
+        psy.dew_point, psy.vpd, psy.abs_hum,
+        modo_automatico ? "true" : "false", fase_actual->nombre,
+        gpio_get_level(PIN_VENTILADOR), gpio_get_level(PIN_HUMIDIFICADOR),
+        mqtt_connected ? "true" : "false", (unsigned long)(esp_timer_get_time() / 1000000),
+        ws.clients, (unsigned long)ws.dropped, (unsigned long)al.active,
+        wifi.rssi, wifi.channel, (unsigned long)wifi.reconnects, (unsigned long)wifi.last_reconnect_ms,
+        (unsigned long)wifi.best_reconnect_ms, (unsigned long)wifi.worst_reconnect_ms,
+        (unsigned long)wifi.attempts, (unsigned long)wifi.fast_attempts,
+        (unsigned long)outbox.pending, (unsigned long)outbox.sent,
+        (unsigned long)outbox.acked, (unsigned long)outbox.evicted,
+        (unsigned long)rep.sent, (unsigned long)rep.heartbeats, (unsigned long)rep.suppressed,
+        report_suppression_pct(&rep),
+        iaq_ok ? "true" : "false", iaq.iaq, iaq.accuracy, iaq.baseline,
+        ts.valid ? "true" : "false", (long long)time_epoch_ms(time_now_us()),
+        (unsigned long)ts.syncs, (long)ts.last_step_ms,
+        sensor_state_name(sh.state), sh.addr, (unsigned long)sh.failures, (unsigned long)sh.recoveries,
+        (unsigned long)sh.attempts, (unsigned long)sh.bus_resets,
+        sensor_fallback_active(time_now_us()) ? "true" : "false");
+    return send_json(req, json);
+}
+
+// GET /api/history?n=<muestras>&fmt=json|cbor
+static esp_err_t history_get_handler(httpd_req_t *req) {
+    int total = history_count();
+    int n = total;
+    const telemetry_encoder_t *enc = &telemetry_json;
+
+    char query[40], val[8];
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK) {
+        if (httpd_query_key_value(query, "n", val, sizeof(val)) == ESP_OK) {
+            int req_n = atoi(val);
+            if (req_n > 0 && req_n < n) n = req_n;
+        }
+        if (httpd_query_key_value(query, "fmt", val, sizeof(val)) == ESP_OK) {
+            enc = telemetry_encoder_find(val);
+            if (!enc) return httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "fmt must be json or cbor");
+        }
+    }
+
+    httpd_resp_set_type(req, enc->content_type);
+    httpd_resp_set_hdr(req, "Cache-Control", "no-store");
+
+    // Streaming por lotes: memoria constante independientemente de n
+    uint8_t chunk[WEB_HISTORY_BATCH * WEB_HISTORY_SAMPLE + 4];
+    size_t off = 0;
+    bool first = true;
+    off += strlcpy((char *)chunk, enc->array_open, sizeof(chunk));
+    for (int i = total - n; i < total; i++) {
+        history_sample_t h;
+        if (!history_get(i, &h)) break;
+        telemetry_sample_t s = {
+            .ts_ms = time_epoch_ms(h.t_us), .uptime_s = (uint32_t)(h.t_us / 1000000), .temperature = h.temperature, .humidity = h.humidity,
+            .pressure = h.pressure, .gas = h.gas, .fan = h.fan, .humid = h.humid,
+            .iaq = -1, .auto_mode = -1, .phase_id = -1,
+        };
+        // El separador solo queda si la muestra se codificó
+        size_t mark = off;
+        if (!first) off += strlcpy((char *)chunk + off, enc->array_sep, sizeof(chunk) - off);
+        int len = enc->encode(&s, chunk + off, sizeof(chunk) - off);
+        if (len > 0) {
+            off += len;
+            first = false;
+        } else {
+            off = mark;
+        }
+        if (sizeof(chunk) - off < WEB_HISTORY_SAMPLE) {
+            if (httpd_resp_send_chunk(req, (const char *)chunk, off) != ESP_OK) {
+                httpd_resp_send_chunk(req, NULL, 0);
+                return ESP_FAIL;
+            }
+            off = 0;
+        }
+    }
+    off += strlcpy((char *)chunk + off, enc->array_close, sizeof(chunk) - off);
+    httpd_resp_send_chunk(req, (const char *)chunk, off);
+    return httpd_resp_send_chunk(req, NULL, 0);
+}
+
+// GET /api/codec?n=<iteraciones>: coste de cada codificador sobre la última muestra
+static esp_err_t codec_get_handler(httpd_req_t *req) {
+    uint32_t iterations = 200;
+    char query[24], val[8];
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK &&
+        httpd_query_key_value(query, "n", val, sizeof(val)) == ESP_OK) {
+        int v = atoi(val);
+        if (v > 0 && v <= 5000) iterations = v;
+    }
+
+    history_sample_t h = { .temperature = 24.37f, .humidity = 88.5f, .pressure = 1013.25f, .gas = 152340.0f };
+    history_latest(&h);
+    telemetry_sample_t s = {
+        .temperature = h.temperature, .humidity = h.humidity, .pressure = h.pressure, .gas = h.gas,
+        .iaq = -1, .fan = h.fan, .humid = h.humid, .auto_mode = modo_automatico,
+        .phase_id = fase_id_actual(),
+    };
+    telemetry_bench_t b;
+    telemetry_codec_benchmark(&s, iterations, &b);
+
+    char json[256];
+    snprintf(json, sizeof(json),
+        "{\"iterations\":%lu,\"printf\":{\"cycles\":%lu,\"bytes\":%u},"
+        "\"json\":{\"cycles\":%lu,\"bytes\":%u},\"cbor\":{\"cycles\":%lu,\"bytes\":%u}}",
+        (unsigned long)b.iterations, (unsigned long)b.printf_cycles, b.printf_bytes,
+        (unsigned long)b.json_cycles, b.json_bytes, (unsigned long)b.cbor_cycles, b.cbor_bytes);
+    return send_json(req, json);
+}
+
+// GET /api/psychro: error y coste de las aproximaciones frente a expf/logf
+static esp_err_t psychro_get_handler(httpd_req_t *req) {
+    psychro_bench_t b;
+    psychro_benchmark(&b);
+
+    char json[192];
+    snprintf(json, sizeof(json),
+        "{\"max_err\":{\"dew_point\":%.4f,\"vpd\":%.4f,\"abs_hum\":%.4f},"
+        "\"cycles\":{\"fast\":%lu,\"reference\":%lu}}",
+        b.max_err_dew, b.max_err_vpd, b.max_err_abs,
+        (unsigned long)b.fast_cycles, (unsigned long)b.ref_cycles);
+    return send_json(req, json);
+}
+
+static esp_err_t config_get_handler(httpd_req_t *req) {
+    char json[256];
+    snprintf(json, sizeof(json),
+        "{\"auto\":%s,\"phase\":\"%s\",\"temp_min\":%.1f,\"temp_max\":%.1f,\"hum_min\":%.1f,\"hum_max\":%.1f}",
+        modo_automatico ? "true" : "false", fase_actual->nombre,
+        fase_actual->temp_min, fase_actual->temp_max, fase_actual->hum_min, fase_actual->hum_max);
+    return send_json(req, json);
+}
+
+// POST /api/config {"phase":"germinacion"|"fructificacion","auto":true|false}
+static esp_err_t config_post_handler(httpd_req_t *req) {
+    char body[WEB_MAX_BODY];
+    if (read_body(req, body, sizeof(body)) < 0) return ESP_FAIL;
+
+    cJSON *root = cJSON_Parse(body);
+    if (!root) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "invalid json");
+        return ESP_FAIL;
+    }
+
+    bool changed = false;
+    cJSON *phase = cJSON_GetObjectItem(root, "phase");
+    if (cJSON_IsString(phase)) {
+        if (strcmp(phase->valuestring, "germinacion") == 0) {
+            recipe_stop();
+            fase_actual = &fase_germinacion;
+            modo_automatico = true;
+            changed = true;
+        } else if (strcmp(phase->valuestring, "fructificacion") == 0) {
+            recipe_stop();
+            fase_actual = &fase_fructificacion;
+            modo_automatico = true;
+            changed = true;
+        } else {
+            cJSON_Delete(root);
+            httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "unknown phase");
+            return ESP_FAIL;
+        }
+    }
+    cJSON *mode = cJSON_GetObjectItem(root, "auto");
+    if (cJSON_IsBool(mode)) {
+        modo_automatico = cJSON_IsTrue(mode);
+        changed = true;
+    }
+    cJSON_Delete(root);
+
+    if (changed) guardar_estado_nvs();
+    return config_get_handler(req);
+}
+
+static esp_err_t recipe_get_handler(httpd_req_t *req) {
+    char *json = malloc(WEB_RECIPE_BODY);
+    if (!json) return httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "no memory");
+    esp_err_t ret;
+    if (recipe_format_json(json, WEB_RECIPE_BODY) < 0) {
+        ret = httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "recipe too large");
+    } else {
+        ret = send_json(req, json);
+    }
+    free(json);
+    return ret;
+}
+
+// POST /api/recipe: receta completa y/o {"running":bool,"phase":n} (ver recipe.h)
+static esp_err_t recipe_post_handler(httpd_req_t *req) {
+    char *body = malloc(WEB_RECIPE_BODY);
+    if (!body) return httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "no memory");
+    int len = read_body(req, body, WEB_RECIPE_BODY);
+    cJSON *root = (len > 0) ? cJSON_ParseWithLength(body, len) : NULL;
+    free(body);
+    if (len < 0) return ESP_FAIL;
+    if (!root) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "invalid json");
+        return ESP_FAIL;
+    }
+
+    char err[64] = "";
+    esp_err_t ret = recipe_apply_json(root, err, sizeof(err));
+    cJSON_Delete(root);
+    if (ret != ESP_OK) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, err[0] ? err : esp_err_to_name(ret));
+        return ESP_FAIL;
+    }
+    return recipe_get_handler(req);
+}
+
+// GET /api/alarms: reglas con sus umbrales ya resueltos contra la fase y su estado
+static esp_err_t alarms_get_handler(httpd_req_t *req) {
+    char *json = malloc(WEB_ALARMS_JSON);
+    if (!json) return httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "no memory");
+    esp_err_t ret;
+    if (alarms_format_rules_json(json, WEB_ALARMS_JSON) < 0) {
+        ret = httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "alarms too large");
+    } else {
+        ret = send_json(req, json);
+    }
+    free(json);
+    return ret;
+}
+
+static esp_err_t actuators_get_handler(httpd_req_t *req) {
+    char json[64];
+    snprintf(json, sizeof(json), "{\"auto\":%s,\"fan\":%d,\"humid\":%d}",
+             modo_automatico ? "true" : "false",
+             gpio_get_level(PIN_VENTILADOR), gpio_get_level(PIN_HUMIDIFICADOR));
+    return send_json(req, json);
+}
+
+// POST /api/actuators {"fan":0|1,"humid":0|1} -> pasa a modo manual, como en Telegram
+static esp_err_t actuators_post_handler(httpd_req_t *req) {
+    char body[WEB_MAX_BODY];
+    if (read_body(req, body, sizeof(body)) < 0) return ESP_FAIL;
+
+    cJSON *root = cJSON_Parse(body);
+    if (!root) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "invalid json");
+        return ESP_FAIL;
+    }
+
+    bool changed = false;
+    cJSON *fan = cJSON_GetObjectItem(root, "fan");
+    cJSON *humid = cJSON_GetObjectItem(root, "humid");
+    // Las forzadas de seguridad también mandan sobre las órdenes manuales
+    uint8_t forzado = alarms_overrides();
+    if (cJSON_IsNumber(fan) || cJSON_IsBool(fan)) {
+        int nivel = cJSON_IsBool(fan) ? cJSON_IsTrue(fan) : (fan->valueint != 0);
+        gpio_set_level(PIN_VENTILADOR, (forzado & ALARM_ACT_FAN_ON) ? 1 : nivel);
+        changed = true;
+    }
+    if (cJSON_IsNumber(humid) || cJSON_IsBool(humid)) {
+        int nivel = cJSON_IsBool(humid) ? cJSON_IsTrue(humid) : (humid->valueint != 0);
+        gpio_set_level(PIN_HUMIDIFICADOR, (forzado & ALARM_ACT_HUMID_OFF) ? 0 : nivel);
+        changed = true;
+    }
+    cJSON_Delete(root);
+
+    if (changed) {
+        modo_automatico = false;
+        guardar_estado_nvs();
+    }
+    return actuators_get_handler(req);
+}
+
+static esp_err_t trace_get_handler(httpd_req_t *req) {
+    char json[768];
+    if (trace_format_json(json, sizeof(json)) < 0) {
+        httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "trace overflow");
+        return ESP_FAIL;
+    }
+
+    // GET /api/trace?reset=1 devuelve el resumen y empieza una ventana nueva
+    char query[16], val[4];
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK &&
+        httpd_query_key_value(query, "reset", val, sizeof(val)) == ESP_OK && val[0] == '1') {
+        trace_reset();
+    }
+
+    return send_json(req, json);
+}
+
+httpd_handle_t web_server_start(void) {
+    if (s_server) return s_server;
+
+    httpd_config_t config = HTTPD_DEFAULT_CONFIG();
+    config.lru_purge_enable = true;
+    config.max_uri_handlers = 16;
+    config.stack_size = WEB_TASK_STACK;
+    if (httpd_start(&s_server, &config) != ESP_OK) {
+        ESP_LOGE(TAG, "No se pudo iniciar el servidor HTTP");
+        s_server = NULL;
+        return NULL;
+    }
+
+    const httpd_uri_t uris[] = {
+        { .uri = "/",              .method = HTTP_GET,  .handler = index_get_handler },
+        { .uri = "/api/status",    .method = HTTP_GET,  .handler = status_get_handler },
+        { .uri = "/api/history",   .method = HTTP_GET,  .handler = history_get_handler },
+        { .uri = "/api/config",    .method = HTTP_GET,  .handler = config_get_handler },
+        { .uri = "/api/config",    .method = HTTP_POST, .handler = config_post_handler },
+        { .uri = "/api/actuators", .method = HTTP_GET,  .handler = actuators_get_handler },
+        { .uri = "/api/actuators", .method = HTTP_POST, .handler = actuators_post_handler },
+        { .uri = "/api/recipe",    .method = HTTP_GET,  .handler = recipe_get_handler },
+        { .uri = "/api/recipe",    .method = HTTP_POST, .handler = recipe_post_handler },
+        { .uri = "/api/alarms",    .method = HTTP_GET,  .handler = alarms_get_handler },
+        { .uri = "/api/trace",     .method = HTTP_GET,  .handler = trace_get_handler },
+        { .uri = "/api/codec",     .method = HTTP_GET,  .handler = codec_get_handler },
+        { .uri = "/api/psychro",   .method = HTTP_GET,  .handler = psychro_get_handler },
+    };
+    for (size_t i = 0; i < sizeof(uris) / sizeof(uris[0]); i++) {
+        httpd_register_uri_handler(s_server, &uris[i]);
+    }
+    live_stream_register(s_server);
+
+    ESP_LOGI(TAG, "Servidor HTTP local iniciado");
+    return s_server;
+}
+
+void web_server_stop(void) {
+    if (s_server) {
+        httpd_stop(s_server);
+        s_server = NULL;
+    }
+}
@@ -0,0 +1,10 @@
+#ifndef MAIN_WEB_SERVER_H_
+#define MAIN_WEB_SERVER_H_
+
+#include <esp_http_server.h>
+
+// Servidor HTTP local en modo STA (independiente del portal de configuración AP).
+httpd_handle_t web_server_start(void);
+void web_server_stop(void);
+
+#endif /* MAIN_WEB_SERVER_H_ */
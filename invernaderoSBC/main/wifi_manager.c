@@ -0,0 +1,356 @@
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "esp_wifi.h"
+#include "esp_event.h"
+#include "esp_netif.h"
+#include "esp_timer.h"
+#include "esp_random.h"
+#include "nvs.h"
+
+#include "wifi_manager.h"
+
+#define TAG "WIFI_MGR"
+
+#define WIFI_NVS_NS         "storage"
+#define WIFI_NVS_KEY        "wifi_creds"
+#define WIFI_CREDS_VERSION  1
+
+#define BACKOFF_BASE_MS     200
+#define BACKOFF_MAX_MS      5000    // Techo bajo: tras reiniciar el router hay que volver cuanto antes
+#define FULL_SCAN_EVERY     4       // Cada N rondas se ignora la caché y se barre completo
+
+typedef struct {
+    char ssid[33];
+    char pass[65];
+    uint8_t bssid[6];
+    uint8_t channel;        // 0 = sin caché
+    int8_t rssi;
+    uint16_t successes;
+    uint32_t last_ok_seq;   // Orden de la última conexión buena (mayor = más reciente)
+} wifi_cred_t;
+
+typedef struct {
+    uint8_t version;
+    uint8_t count;
+    uint32_t seq;
+    wifi_cred_t creds[WIFI_CRED_MAX];
+} wifi_cred_store_t;
+
+static wifi_cred_store_t s_store;
+static uint8_t s_fails[WIFI_CRED_MAX];  // Fallos consecutivos (solo RAM, para no gastar flash)
+static SemaphoreHandle_t s_lock;
+
+static EventGroupHandle_t s_event_group;
+static EventBits_t s_connected_bit;
+static esp_timer_handle_t s_retry_timer;
+static volatile bool s_active = false;  // false mientras el portal de configuración maneja la WiFi
+static volatile bool s_connected = false;
+
+// Estado de la ronda de intentos
+static uint8_t s_order[WIFI_CRED_MAX];
+static uint8_t s_order_n = 0;
+static uint8_t s_attempt = 0;
+static uint8_t s_round = 0;
+static int s_current = -1;              // Credencial en uso/intentándose
+static bool s_current_fast = false;
+
+static int64_t s_lost_at_us = 0;
+static wifi_manager_stats_t s_stats;
+
+/* ---------- Persistencia ---------- */
+
+static void store_save_locked(void) {
+    nvs_handle_t h;
+    if (nvs_open(WIFI_NVS_NS, NVS_READWRITE, &h) != ESP_OK) return;
+    nvs_set_blob(h, WIFI_NVS_KEY, &s_store, sizeof(s_store));
+    nvs_commit(h);
+    nvs_close(h);
+}
+
+static void store_load(void) {
+    memset(&s_store, 0, sizeof(s_store));
+    nvs_handle_t h;
+    if (nvs_open(WIFI_NVS_NS, NVS_READONLY, &h) != ESP_OK) return;
+
+    size_t len = sizeof(s_store);
+    if (nvs_get_blob(h, WIFI_NVS_KEY, &s_store, &len) == ESP_OK &&
+        len == sizeof(s_store) && s_store.version == WIFI_CREDS_VERSION && s_store.count <= WIFI_CRED_MAX) {
+        nvs_close(h);
+        return;
+    }
+    memset(&s_store, 0, sizeof(s_store));
+
+    // Migración desde el formato antiguo de una sola red (w_ssid / w_pass)
+    char ssid[33] = {0}, pass[65] = {0};
+    size_t ssid_len = sizeof(ssid), pass_len = sizeof(pass);
+    bool legacy = nvs_get_str(h, "w_ssid", ssid, &ssid_len) == ESP_OK &&
+                  nvs_get_str(h, "w_pass", pass, &pass_len) == ESP_OK;
+    nvs_close(h);
+
+    s_store.version = WIFI_CREDS_VERSION;
+    if (legacy && ssid[0]) {
+        strlcpy(s_store.creds[0].ssid, ssid, sizeof(s_store.creds[0].ssid));
+        strlcpy(s_store.creds[0].pass, pass, sizeof(s_store.creds[0].pass));
+        s_store.count = 1;
+        store_save_locked();
+        ESP_LOGI(TAG, "Credencial antigua migrada: %s", ssid);
+    }
+}
+
+/* ---------- Ranking ---------- */
+
+static int cred_score(int i) {
+    const wifi_cred_t *c = &s_store.creds[i];
+    int score = c->channel ? c->rssi : -90;
+    if (c->last_ok_seq && c->last_ok_seq == s_store.seq) score += 50; // La última que funcionó
+    score += 2 * (c->successes > 10 ? 10 : c->successes);
+    score -= 10 * (s_fails[i] > 5 ? 5 : s_fails[i]);
+    return score;
+}
+
+static void build_order_locked(void) {
+    s_order_n = s_store.count;
+    for (int i = 0; i < s_order_n; i++) s_order[i] = i;
+    // Inserción: como mucho WIFI_CRED_MAX elementos
+    for (int i = 1; i < s_order_n; i++) {
+        uint8_t v = s_order[i];
+        int sv = cred_score(v);
+        int j = i - 1;
+        while (j >= 0 && cred_score(s_order[j]) < sv) {
+            s_order[j + 1] = s_order[j];
+            j--;
+        }
+        s_order[j + 1] = v;
+    }
+}
+
+/* ---------- Intentos de conexión ---------- */
+
+static void connect_current(void) {
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    if (s_order_n == 0) {
+        xSemaphoreGive(s_lock);
+        ESP_LOGW(TAG, "Sin credenciales guardadas");
+        return;
+    }
+    int idx = s_order[s_attempt % s_order_n];
+    const wifi_cred_t *c = &s_store.creds[idx];
+
+    wifi_config_t cfg = { .sta = { .threshold.authmode = c->pass[0] ? WIFI_AUTH_WPA2_PSK : WIFI_AUTH_OPEN } };
+    strlcpy((char *)cfg.sta.ssid, c->ssid, sizeof(cfg.sta.ssid));
+    strlcpy((char *)cfg.sta.password, c->pass, sizeof(cfg.sta.password));
+
+    bool fast = c->channel != 0 && (s_round % FULL_SCAN_EVERY) != FULL_SCAN_EVERY - 1;
+    if (fast) {
+        // Canal y BSSID conocidos: asociación directa sin barrer los 13 canales
+        cfg.sta.scan_method = WIFI_FAST_SCAN;
+        cfg.sta.channel = c->channel;
+        cfg.sta.bssid_set = true;
+        memcpy(cfg.sta.bssid, c->bssid, sizeof(cfg.sta.bssid));
+    } else {
+        cfg.sta.scan_method = WIFI_ALL_CHANNEL_SCAN;
+        cfg.sta.sort_method = WIFI_CONNECT_AP_BY_SIGNAL;
+    }
+    s_current = idx;
+    s_current_fast = fast;
+    s_stats.attempts++;
+    if (fast) s_stats.fast_attempts++;
+    xSemaphoreGive(s_lock);
+
+    ESP_LOGI(TAG, "Conectando a '%s' (%s)", cfg.sta.ssid, fast ? "canal/BSSID en caché" : "barrido completo");
+    esp_wifi_set_config(WIFI_IF_STA, &cfg);
+    esp_wifi_connect();
+}
+
+static void retry_timer_cb(void *arg) {
+    if (s_active && !s_connected) connect_current();
+}
+
+static uint32_t backoff_ms(uint8_t round) {
+    uint32_t ms = BACKOFF_BASE_MS << (round > 5 ? 5 : round);
+    if (ms > BACKOFF_MAX_MS) ms = BACKOFF_MAX_MS;
+    // Jitter en [ms/2, ms) para no sincronizar con otros equipos tras un corte
+    return ms / 2 + esp_random() % (ms / 2);
+}
+
+static void start_round(bool immediate) {
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    build_order_locked();
+    s_attempt = 0;
+    xSemaphoreGive(s_lock);
+
+    esp_timer_stop(s_retry_timer);
+    if (immediate) {
+        connect_current();
+    } else {
+        uint32_t delay = backoff_ms(s_round);
+        ESP_LOGI(TAG, "Reintento en %lu ms (ronda %u)", (unsigned long)delay, s_round);
+        esp_timer_start_once(s_retry_timer, (uint64_t)delay * 1000);
+    }
+}
+
+static void record_success(void) {
+    wifi_ap_record_t ap;
+    bool have_ap = esp_wifi_sta_get_ap_info(&ap) == ESP_OK;
+
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    int idx = s_current;
+    if (idx < 0 && have_ap) {
+        for (int i = 0; i < s_store.count; i++) {
+            if (strcmp(s_store.creds[i].ssid, (const char *)ap.ssid) == 0) idx = i;
+        }
+    }
+    if (idx >= 0 && idx < s_store.count) {
+        wifi_cred_t *c = &s_store.creds[idx];
+        if (have_ap) {
+            memcpy(c->bssid, ap.bssid, sizeof(c->bssid));
+            c->channel = ap.primary;
+            c->rssi = ap.rssi;
+            s_stats.rssi = ap.rssi;
+            s_stats.channel = ap.primary;
+        }
+        if (c->successes < UINT16_MAX) c->successes++;
+        c->last_ok_seq = ++s_store.seq;
+        s_fails[idx] = 0;
+        strlcpy(s_stats.ssid, c->ssid, sizeof(s_stats.ssid));
+        store_save_locked();
+    }
+    s_current = idx;
+    s_round = 0;
+    xSemaphoreGive(s_lock);
+}
+
+static void wifi_mgr_event_handler(void *arg, esp_event_base_t base, int32_t id, void *data) {
+    if (!s_active) return;
+
+    if (base == WIFI_EVENT && id == WIFI_EVENT_STA_START) {
+        start_round(true);
+    } else if (base == WIFI_EVENT && id == WIFI_EVENT_STA_DISCONNECTED) {
+        xEventGroupClearBits(s_event_group, s_connected_bit);
+        s_stats.rssi = 0;
+        if (s_connected) {
+            // Enlace perdido: primer intento inmediato contra el mismo AP en caché
+            s_connected = false;
+            s_lost_at_us = esp_timer_get_time();
+            s_round = 0;
+            ESP_LOGW(TAG, "Desconectado, reconectando");
+            start_round(true);
+            return;
+        }
+
+        xSemaphoreTake(s_lock, portMAX_DELAY);
+        if (s_current >= 0 && s_fails[s_current] < UINT8_MAX) s_fails[s_current]++;
+        bool round_done = ++s_attempt >= s_order_n;
+        xSemaphoreGive(s_lock);
+
+        if (round_done) {
+            if (s_round < UINT8_MAX) s_round++;
+            start_round(false);
+        } else {
+            connect_current();
+        }
+    } else if (base == IP_EVENT && id == IP_EVENT_STA_GOT_IP) {
+        if (s_connected) return;
+        s_connected = true;
+        esp_timer_stop(s_retry_timer);
+        record_success();
+
+        if (s_lost_at_us) {
+            uint32_t ms = (uint32_t)((esp_timer_get_time() - s_lost_at_us) / 1000);
+            s_stats.reconnects++;
+            s_stats.last_reconnect_ms = ms;
+            if (s_stats.best_reconnect_ms == 0 || ms < s_stats.best_reconnect_ms) s_stats.best_reconnect_ms = ms;
+            if (ms > s_stats.worst_reconnect_ms) s_stats.worst_reconnect_ms = ms;
+            s_lost_at_us = 0;
+            ESP_LOGI(TAG, "Reconectado en %lu ms", (unsigned long)ms);
+        }
+        xEventGroupSetBits(s_event_group, s_connected_bit);
+    }
+}
+
+/* ---------- API pública ---------- */
+
+esp_err_t wifi_manager_init(EventGroupHandle_t event_group, EventBits_t connected_bit) {
+    s_event_group = event_group;
+    s_connected_bit = connected_bit;
+    s_lock = xSemaphoreCreateMutex();
+    if (!s_lock) return ESP_ERR_NO_MEM;
+    store_load();
+
+    const esp_timer_create_args_t timer_args = { .callback = retry_timer_cb, .name = "wifi_retry" };
+    ESP_ERROR_CHECK(esp_timer_create(&timer_args, &s_retry_timer));
+
+    esp_netif_create_default_wifi_sta();
+    wifi_init_config_t cfg = WIFI_INIT_CONFIG_DEFAULT();
+    ESP_ERROR_CHECK(esp_wifi_init(&cfg));
+
+    esp_event_handler_instance_t instance_any_id;
+    esp_event_handler_instance_t instance_got_ip;
+    ESP_ERROR_CHECK(esp_event_handler_instance_register(WIFI_EVENT, ESP_EVENT_ANY_ID, &wifi_mgr_event_handler, NULL, &instance_any_id));
+    ESP_ERROR_CHECK(esp_event_handler_instance_register(IP_EVENT, IP_EVENT_STA_GOT_IP, &wifi_mgr_event_handler, NULL, &instance_got_ip));
+    return ESP_OK;
+}
+
+esp_err_t wifi_manager_start(void) {
+    s_active = true;
+    ESP_ERROR_CHECK(esp_wifi_set_mode(WIFI_MODE_STA));
+    return esp_wifi_start(); // WIFI_EVENT_STA_START lanza la primera ronda
+}
+
+void wifi_manager_adopt_connection(void) {
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    s_current = -1; // Se localiza por SSID en record_success
+    xSemaphoreGive(s_lock);
+    record_success();
+    s_connected = true;
+    s_active = true;
+}
+
+bool wifi_manager_has_credentials(void) {
+    return s_store.count > 0;
+}
+
+esp_err_t wifi_manager_add_credential(const char *ssid, const char *pass) {
+    if (!ssid || !ssid[0] || strlen(ssid) > 32 || strlen(pass) > 64) return ESP_ERR_INVALID_ARG;
+
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    int idx = -1;
+    for (int i = 0; i < s_store.count; i++) {
+        if (strcmp(s_store.creds[i].ssid, ssid) == 0) idx = i;
+    }
+    if (idx < 0) {
+        if (s_store.count < WIFI_CRED_MAX) {
+            idx = s_store.count++;
+        } else {
+            // Lista llena: se sustituye la peor puntuada
+            idx = 0;
+            for (int i = 1; i < s_store.count; i++) {
+                if (cred_score(i) < cred_score(idx)) idx = i;
+            }
+        }
+        memset(&s_store.creds[idx], 0, sizeof(wifi_cred_t));
+        strlcpy(s_store.creds[idx].ssid, ssid, sizeof(s_store.creds[idx].ssid));
+    }
+    wifi_cred_t *c = &s_store.creds[idx];
+    if (strcmp(c->pass, pass) != 0) {
+        strlcpy(c->pass, pass, sizeof(c->pass));
+        c->channel = 0; // La caché ya no es fiable
+    }
+    // Una red recién introducida por el usuario pasa a ser la preferida
+    c->last_ok_seq = ++s_store.seq;
+    s_fails[idx] = 0;
+    s_store.version = WIFI_CREDS_VERSION;
+    store_save_locked();
+    xSemaphoreGive(s_lock);
+
+    ESP_LOGI(TAG, "Credencial guardada: %s (%u redes)", ssid, s_store.count);
+    return ESP_OK;
+}
+
+void wifi_manager_get_stats(wifi_manager_stats_t *out) {
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    *out = s_stats;
+    xSemaphoreGive(s_lock);
+}
@@ -0,0 +1,45 @@
+#ifndef MAIN_WIFI_MANAGER_H_
+#define MAIN_WIFI_MANAGER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
+
+/*
+ * Gestor de la conexión STA con varias redes guardadas.
+ *
+ * Las credenciales (hasta WIFI_CRED_MAX) se guardan en NVS junto con el canal
+ * y el BSSID de la última conexión buena. Se prueban por orden de puntuación
+ * (última usada, RSSI e historial) y, si hay canal/BSSID en caché, se conecta
+ * sin barrido completo. Entre rondas fallidas se espera con backoff
+ * exponencial y jitter.
+ */
+
+#define WIFI_CRED_MAX 5
+
+typedef struct {
+    uint32_t reconnects;        // Reconexiones completadas tras perder el enlace
+    uint32_t attempts;          // Intentos de asociación totales
+    uint32_t fast_attempts;     // Intentos con canal/BSSID en caché
+    uint32_t last_reconnect_ms;
+    uint32_t best_reconnect_ms;
+    uint32_t worst_reconnect_ms;
+    int8_t rssi;                // RSSI de la red actual (0 si desconectado)
+    uint8_t channel;
+    char ssid[33];
+} wifi_manager_stats_t;
+
+// Crea la interfaz STA, inicializa el driver y registra los eventos (sin conectar todavía)
+esp_err_t wifi_manager_init(EventGroupHandle_t event_group, EventBits_t connected_bit);
+// Modo STA y conexión a la mejor red conocida
+esp_err_t wifi_manager_start(void);
+// Toma el control de una conexión ya establecida por el portal de configuración
+void wifi_manager_adopt_connection(void);
+
+bool wifi_manager_has_credentials(void);
+esp_err_t wifi_manager_add_credential(const char *ssid, const char *pass);
+void wifi_manager_get_stats(wifi_manager_stats_t *out);
+
+#endif /* MAIN_WIFI_MANAGER_H_ */